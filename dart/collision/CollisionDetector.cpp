@@ -33,16 +33,61 @@
 #include "dart/collision/CollisionDetector.hpp"
 
 #include <algorithm>
+#include <limits>
+#include <unordered_map>
 
 #include "dart/collision/CollisionGroup.hpp"
 #include "dart/collision/CollisionObject.hpp"
+#include "dart/collision/detail/RaycastShape.hpp"
 #include "dart/common/Console.hpp"
+#include "dart/common/ThreadPool.hpp"
 #include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/ShapeFrame.hpp"
 #include "dart/dynamics/Skeleton.hpp"
 
 namespace dart {
 namespace collision {
 
+namespace {
+
+/// Number of rays handed to a thread at a time by raycastBatch()
+constexpr std::size_t raycastBatchChunkSize = 64u;
+
+/// Shape of a collision group as seen by raycastBatch()
+struct RaycastTarget
+{
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  const dynamics::ShapeFrame* shapeFrame;
+  const dynamics::Shape* shape;
+  Eigen::Isometry3d transform;
+  Eigen::Isometry3d inverseTransform;
+  math::BoundingBox boundingBox;
+};
+
+//==============================================================================
+math::BoundingBox computeSegmentBoundingBox(
+    const Eigen::Vector3d& origin,
+    const Eigen::Vector3d& direction,
+    double length)
+{
+  // Written per axis so that an infinite length along a zero component of the
+  // direction does not give NaN
+  Eigen::Vector3d min = origin;
+  Eigen::Vector3d max = origin;
+  for (int i = 0; i < 3; ++i)
+  {
+    if (direction[i] > 0.0)
+      max[i] += length * direction[i];
+    else if (direction[i] < 0.0)
+      min[i] += length * direction[i];
+  }
+
+  return math::BoundingBox(min, max);
+}
+
+} // anonymous namespace
+
 //==============================================================================
 CollisionDetector::Factory* CollisionDetector::getFactory()
 {
@@ -69,6 +114,173 @@ bool CollisionDetector::raycast(
   return false;
 }
 
+//==============================================================================
+std::size_t CollisionDetector::raycastBatch(
+    CollisionGroup* group,
+    std::size_t numRays,
+    const Eigen::Vector3d* origins,
+    const Eigen::Vector3d* directions,
+    double maxDistance,
+    double* distances,
+    Eigen::Vector3d* normals,
+    const dynamics::ShapeFrame** shapeFrames)
+{
+  // Gather the shapes and their poses up front. ShapeFrames and shapes update
+  // their transforms and bounding boxes lazily, which must not happen from
+  // several threads at once.
+  std::vector<RaycastTarget, Eigen::aligned_allocator<RaycastTarget>> targets;
+  std::unordered_map<const dynamics::ShapeFrame*, std::size_t> targetIndices;
+  targets.reserve(group->getNumShapeFrames());
+  for (std::size_t i = 0u; i < group->getNumShapeFrames(); ++i)
+  {
+    const dynamics::ShapeFrame* shapeFrame = group->getShapeFrame(i);
+    const dynamics::Shape* shape = shapeFrame->getShape().get();
+    if (!shape || !detail::isRaycastSupported(shape->getTypeId()))
+      continue;
+
+    RaycastTarget target;
+    target.shapeFrame = shapeFrame;
+    target.shape = shape;
+    target.transform = shapeFrame->getWorldTransform();
+    target.inverseTransform = target.transform.inverse();
+    target.boundingBox = shape->getBoundingBox();
+    targetIndices.emplace(shapeFrame, targets.size());
+    targets.push_back(target);
+  }
+
+  // Cull the rays through the broadphase of the group: each ray is only tested
+  // against the shapes whose bounding boxes overlap the bounding box of its
+  // segment. The candidates of ray i are candidates[offsets[i]] to
+  // candidates[offsets[i + 1] - 1], in the order of the targets so that ties
+  // are resolved the same way whatever the broadphase.
+  std::vector<math::BoundingBox> rayBoxes;
+  rayBoxes.reserve(numRays);
+  for (std::size_t i = 0u; i < numRays; ++i)
+  {
+    rayBoxes.push_back(
+        computeSegmentBoundingBox(origins[i], directions[i], maxDistance));
+  }
+
+  std::vector<CollisionGroup::BoxOverlap> boxOverlaps;
+  group->computeBoxOverlaps(rayBoxes, boxOverlaps);
+
+  std::vector<std::size_t> offsets(numRays + 1u, 0u);
+  std::vector<std::size_t> candidates;
+  candidates.reserve(boxOverlaps.size());
+  for (const auto& boxOverlap : boxOverlaps)
+  {
+    const auto result = targetIndices.find(boxOverlap.second->getShapeFrame());
+    if (result == targetIndices.end())
+      continue;
+
+    candidates.push_back(result->second);
+    ++offsets[boxOverlap.first + 1u];
+  }
+  for (std::size_t i = 0u; i < numRays; ++i)
+  {
+    offsets[i + 1u] += offsets[i];
+    std::sort(
+        candidates.begin() + offsets[i], candidates.begin() + offsets[i + 1u]);
+  }
+
+  const auto castRay = [&](std::size_t index) {
+    double closest = maxDistance;
+    const RaycastTarget* hitTarget = nullptr;
+    Eigen::Vector3d hitNormal = Eigen::Vector3d::Zero();
+
+    for (std::size_t k = offsets[index]; k < offsets[index + 1u]; ++k)
+    {
+      const RaycastTarget& target = targets[candidates[k]];
+      // Rigid transforms keep the direction unit length
+      const Eigen::Vector3d origin = target.inverseTransform * origins[index];
+      const Eigen::Vector3d direction
+          = target.inverseTransform.linear() * directions[index];
+
+      if (!detail::intersectsBoundingBox(
+              target.boundingBox, origin, direction, closest))
+        continue;
+
+      double distance;
+      Eigen::Vector3d normal;
+      if (detail::raycastShape(
+              *target.shape, origin, direction, closest, distance, normal))
+      {
+        closest = distance;
+        hitTarget = &target;
+        hitNormal = normal;
+      }
+    }
+
+    if (hitTarget)
+    {
+      distances[index] = closest;
+      if (normals)
+        normals[index] = hitTarget->transform.linear() * hitNormal;
+      if (shapeFrames)
+        shapeFrames[index] = hitTarget->shapeFrame;
+    }
+    else
+    {
+      distances[index] = std::numeric_limits<double>::infinity();
+      if (normals)
+        normals[index].setZero();
+      if (shapeFrames)
+        shapeFrames[index] = nullptr;
+    }
+  };
+
+  const std::size_t numChunks
+      = (numRays + raycastBatchChunkSize - 1u) / raycastBatchChunkSize;
+  const auto castChunk = [&](std::size_t chunk) {
+    const std::size_t begin = chunk * raycastBatchChunkSize;
+    const std::size_t end = std::min(numRays, begin + raycastBatchChunkSize);
+    for (std::size_t i = begin; i < end; ++i)
+      castRay(i);
+  };
+
+  const auto pool = getThreadPool();
+  if (pool && numChunks > 1u)
+  {
+    pool->parallelFor(numChunks, castChunk);
+  }
+  else
+  {
+    for (std::size_t chunk = 0u; chunk < numChunks; ++chunk)
+      castChunk(chunk);
+  }
+
+  return static_cast<std::size_t>(std::count_if(
+      distances, distances + numRays, [](double distance) {
+        return distance != std::numeric_limits<double>::infinity();
+      }));
+}
+
+//==============================================================================
+void CollisionDetector::setThreadPool(
+    const std::shared_ptr<common::ThreadPool>& pool)
+{
+  mThreadPool = pool;
+}
+
+//==============================================================================
+std::shared_ptr<common::ThreadPool> CollisionDetector::getThreadPool() const
+{
+  return mThreadPool;
+}
+
+//==============================================================================
+void CollisionDetector::setContactCache(
+    const std::shared_ptr<ContactCache>& cache)
+{
+  mContactCache = cache;
+}
+
+//==============================================================================
+std::shared_ptr<ContactCache> CollisionDetector::getContactCache() const
+{
+  return mContactCache;
+}
+
 //==============================================================================
 std::shared_ptr<CollisionObject> CollisionDetector::claimCollisionObject(
     const dynamics::ShapeFrame* shapeFrame)
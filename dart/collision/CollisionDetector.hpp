@@ -50,9 +50,15 @@
 #include "dart/dynamics/SmartPointer.hpp"
 
 namespace dart {
+
+namespace common {
+class ThreadPool;
+} // namespace common
+
 namespace collision {
 
 class CollisionObject;
+class ContactCache;
 
 class CollisionDetector : public std::enable_shared_from_this<CollisionDetector>
 {
@@ -182,6 +188,71 @@ public:
       const RaycastOption& option = RaycastOption(),
       RaycastResult* result = nullptr);
 
+  /// Casts many rays onto a collision group at once, e.g., the beams of a
+  /// simulated lidar or the pixels of a depth camera. Only the closest hit of
+  /// each ray is reported, and the results are written to buffers provided by
+  /// the caller so that nothing is allocated per ray. The rays are distributed
+  /// over the threads of getThreadPool() if one is set.
+  ///
+  /// The default implementation intersects the rays with the shapes of the
+  /// ShapeFrames in the group directly, so it works with any collision
+  /// detector. It supports spheres, boxes, ellipsoids, cylinders, capsules,
+  /// planes, and meshes; other shapes are not hit. Each ray is only tested
+  /// against the ShapeFrames whose bounding boxes overlap the bounding box of
+  /// the ray, as found by the broadphase of the group; see
+  /// CollisionGroup::computeBoxOverlaps(). DARTCollisionDetector uses its
+  /// sweep and prune, while FCLCollisionDetector and BulletCollisionDetector
+  /// use the default sweep over the current bounding boxes.
+  ///
+  /// \param[in] group The collision group the rays will be casted onto.
+  /// \param[in] numRays The number of rays.
+  /// \param[in] origins The start points of the rays in world coordinates.
+  /// \param[in] directions The unit directions of the rays in world
+  /// coordinates.
+  /// \param[in] maxDistance The length of the rays.
+  /// \param[out] distances For each ray, the distance from its origin to the
+  /// closest hit, or infinity if it hit nothing.
+  /// \param[out] normals For each ray, the surface normal at the closest hit in
+  /// world coordinates, or zero if it hit nothing. Can be nullptr.
+  /// \param[out] shapeFrames For each ray, the ShapeFrame that was hit, or
+  /// nullptr if it hit nothing. Can be nullptr.
+  /// \return The number of rays that hit something.
+  virtual std::size_t raycastBatch(
+      CollisionGroup* group,
+      std::size_t numRays,
+      const Eigen::Vector3d* origins,
+      const Eigen::Vector3d* directions,
+      double maxDistance,
+      double* distances,
+      Eigen::Vector3d* normals = nullptr,
+      const dynamics::ShapeFrame** shapeFrames = nullptr);
+
+  /// Set the thread pool used to run the narrow phase of collide() on the
+  /// candidate pairs found by the broad phase, and to cast the rays of
+  /// raycastBatch(). Pass nullptr, the default, to run them serially;
+  /// common::ThreadPool::getDefault() can be used to opt in.
+  ///
+  /// The contacts are reported in the same order whatever the number of
+  /// threads. Binary queries, i.e., without a CollisionResult or with a single
+  /// contact requested, are always checked serially so that they stop at the
+  /// first colliding pair. Only DARTCollisionDetector runs the narrow phase on
+  /// the pool; FCLCollisionDetector and BulletCollisionDetector check the
+  /// pairs serially.
+  void setThreadPool(const std::shared_ptr<common::ThreadPool>& pool);
+
+  /// Get the thread pool used to run the narrow phase of collide(), or nullptr
+  /// if the narrow phase is run serially.
+  std::shared_ptr<common::ThreadPool> getThreadPool() const;
+
+  /// Set the cache used by collide() to reuse the contacts of object pairs that
+  /// have not moved relative to each other. Pass nullptr, the default, to run
+  /// the narrow phase for every pair. Only DARTCollisionDetector uses the
+  /// cache; FCLCollisionDetector and BulletCollisionDetector ignore it.
+  void setContactCache(const std::shared_ptr<ContactCache>& cache);
+
+  /// Get the contact cache, or nullptr if contacts are not cached
+  std::shared_ptr<ContactCache> getContactCache() const;
+
 protected:
   class CollisionObjectManager;
   class ManagerForUnsharableCollisionObjects;
@@ -208,6 +279,12 @@ protected:
 
 protected:
   std::unique_ptr<CollisionObjectManager> mCollisionObjectManager;
+
+  /// Thread pool set by setThreadPool()
+  std::shared_ptr<common::ThreadPool> mThreadPool;
+
+  /// Contact cache set by setContactCache()
+  std::shared_ptr<ContactCache> mContactCache;
 };
 
 //==============================================================================
@@ -32,16 +32,133 @@
 
 #include "dart/collision/CollisionGroup.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <limits>
 
 #include "dart/collision/CollisionDetector.hpp"
+#include "dart/collision/CollisionFilter.hpp"
 #include "dart/collision/CollisionObject.hpp"
+#include "dart/collision/dart/DARTConvexCollide.hpp"
+#include "dart/collision/dart/detail/ConvexShape.hpp"
+#include "dart/collision/dart/detail/Gjk.hpp"
+#include "dart/collision/detail/UnorderedPairs.hpp"
 #include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/PlaneShape.hpp"
 #include "dart/dynamics/Skeleton.hpp"
+#include "dart/math/Geometry.hpp"
 
 namespace dart {
 namespace collision {
 
+namespace {
+
+// Transform version that forces an object to be pushed to the engine on the
+// next update
+constexpr std::size_t unknownTransformVersion
+    = std::numeric_limits<std::size_t>::max();
+
+//==============================================================================
+bool overlaps(const math::BoundingBox& a, const math::BoundingBox& b)
+{
+  return (a.getMin().array() <= b.getMax().array()).all()
+         && (b.getMin().array() <= a.getMax().array()).all();
+}
+
+//==============================================================================
+// Continuous frame whose shape is swept by collideContinuous()
+struct SweptFrame
+{
+  const dynamics::ShapeFrame* frame;
+  CollisionObject* object;
+  Eigen::Vector3d center;
+  Eigen::Vector3d nextCenter;
+  double radius;
+  double minMotion;
+};
+
+//==============================================================================
+// Sweep the shape of swept.frame along its motion relative to otherFrame over
+// the time step. The center is swept by translation, and the rotation about it
+// is covered by inflating the shape by the furthest distance that one of its
+// points can rotate. Return true and set contact if it hits the shape of
+// otherFrame.
+bool sweepShape(
+    const SweptFrame& swept,
+    const dynamics::ShapeFrame* otherFrame,
+    double timeStep,
+    Contact& contact)
+{
+  const dynamics::Shape* otherShape = otherFrame->getShape().get();
+  if (!otherShape)
+    return false;
+
+  const auto otherTypeId = otherShape->getTypeId();
+  const bool isPlane = (otherTypeId == dynamics::Shape::TypeId::PLANE);
+  if (!isPlane && !isConvexShape(otherTypeId))
+    return false;
+
+  // Follow the center in the frame of the other shape, which may be moving as
+  // well, and express the relative motion in world coordinates
+  const Eigen::Isometry3d& otherTf = otherFrame->getWorldTransform();
+  const Eigen::Isometry3d nextOtherTf
+      = otherTf * math::expMap(timeStep * otherFrame->getSpatialVelocity());
+  const Eigen::Vector3d motion
+      = otherTf.linear()
+        * (nextOtherTf.inverse() * swept.nextCenter
+           - otherTf.inverse() * swept.center);
+  const double reach
+      = timeStep * swept.radius
+        * (swept.frame->getAngularVelocity()
+           - otherFrame->getAngularVelocity())
+              .norm();
+  if (motion.norm() + reach < swept.minMotion)
+    return false;
+
+  const detail::ConvexShape shape(
+      *swept.frame->getShape(), swept.frame->getWorldTransform());
+
+  if (isPlane)
+  {
+    const auto* plane = static_cast<const dynamics::PlaneShape*>(otherShape);
+    const Eigen::Vector3d normal = otherTf.linear() * plane->getNormal();
+    const double offset
+        = plane->getOffset() + normal.dot(otherTf.translation());
+
+    // A shape that already reaches the plane is left to collide(), and one
+    // that does not reach it within the time step is ignored
+    const Eigen::Vector3d deepest = shape.support(-normal);
+    const double gap = normal.dot(deepest) - offset;
+    const double approach = std::max(-normal.dot(motion), 0.0) + reach;
+    if (gap <= 0.0 || gap > approach)
+      return false;
+
+    contact.point = deepest - gap * normal;
+    contact.normal = normal;
+    contact.penetrationDepth = -gap;
+    return true;
+  }
+
+  const detail::ConvexShape otherConvexShape(*otherShape, otherTf);
+  const detail::MinkowskiDifference md(shape, otherConvexShape);
+
+  double fraction;
+  Eigen::Vector3d normal;
+  Eigen::Vector3d point;
+  if (!detail::castGjk(md, motion, fraction, normal, point, reach))
+    return false;
+
+  // The inflated shape may hit before the shape itself does, so the depth is
+  // the distance that is left between the shape and the hit point right now
+  const double gap = normal.dot(shape.support(-normal) - point);
+  contact.point = point;
+  contact.normal = normal;
+  contact.penetrationDepth = -std::max(gap, 0.0);
+  return true;
+}
+
+} // anonymous namespace
+
 //==============================================================================
 CollisionGroup::CollisionGroup(const CollisionDetectorPtr& collisionDetector)
   : mCollisionDetector(collisionDetector), mUpdateAutomatically(true)
@@ -87,29 +204,73 @@ void CollisionGroup::subscribeTo()
   // Do nothing
 }
 
+//==============================================================================
+void CollisionGroup::subscribeTo(
+    const std::vector<dynamics::ConstSkeletonPtr>& skeletons)
+{
+  std::vector<CollisionObject*> pendingObjects;
+
+  for (const auto& skeleton : skeletons)
+    subscribeToSkeleton(skeleton, &pendingObjects);
+
+  if (!pendingObjects.empty())
+    addCollisionObjectsToEngine(pendingObjects);
+}
+
+//==============================================================================
+void CollisionGroup::subscribeToSkeleton(
+    const dynamics::ConstSkeletonPtr& skeleton,
+    std::vector<CollisionObject*>* pendingObjects)
+{
+  const auto inserted = mSkeletonSources.insert(SkeletonSources::value_type(
+      skeleton.get(), SkeletonSource(skeleton, skeleton->getVersion())));
+
+  if (!inserted.second)
+    return;
+
+  SkeletonSource& entry = inserted.first->second;
+
+  const std::size_t numBodies = skeleton->getNumBodyNodes();
+  for (std::size_t i = 0u; i < numBodies; ++i)
+  {
+    const dynamics::BodyNode* bn = skeleton->getBodyNode(i);
+
+    const auto& collisionShapeNodes
+        = bn->getShapeNodesWith<dynamics::CollisionAspect>();
+
+    auto& childInfo
+        = entry.mChildren
+              .insert(std::make_pair(
+                  bn, SkeletonSource::ChildInfo(bn->getVersion())))
+              .first->second;
+
+    for (const auto& shapeNode : collisionShapeNodes)
+    {
+      entry.mObjects.insert(
+          {shapeNode,
+           addShapeFrameImpl(shapeNode, skeleton.get(), pendingObjects)});
+      childInfo.mFrames.insert(shapeNode);
+    }
+  }
+}
+
 //==============================================================================
 void CollisionGroup::removeShapeFrame(const dynamics::ShapeFrame* shapeFrame)
 {
   if (!shapeFrame)
     return;
 
-  const auto search = std::find_if(
-      mObjectInfoList.begin(),
-      mObjectInfoList.end(),
-      [&](const std::unique_ptr<ObjectInfo>& info) {
-        return info->mFrame == shapeFrame;
-      });
-
-  if (mObjectInfoList.end() == search)
+  const auto mapSearch = mObjectInfoMap.find(shapeFrame);
+  if (mObjectInfoMap.end() == mapSearch)
     return;
 
-  removeCollisionObjectFromEngine((*search)->mObject.get());
+  ObjectInfo* info = mapSearch->second;
 
   // Since the user is explicitly telling us to remove this ShapeFrame, we can
   // no longer remain subscribed to any sources that were providing this
   // ShapeFrame. Otherwise, this ShapeFrame would just reappear instantly the
   // next time an update is performed.
-  for (const void* source : (*search)->mSources)
+  for (const void* source : info->mSources)
   {
     if (nullptr == source)
       continue;
@@ -124,16 +285,41 @@ void CollisionGroup::removeShapeFrame(const dynamics::ShapeFrame* shapeFrame)
     mBodyNodeSources.erase(static_cast<const dynamics::BodyNode*>(source));
   }
 
-  mObjectInfoList.erase(search);
-  mObserver.removeShapeFrame(shapeFrame);
+  eraseObjectInfos({shapeFrame});
 }
 
 //==============================================================================
 void CollisionGroup::removeShapeFrames(
     const std::vector<const dynamics::ShapeFrame*>& shapeFrames)
 {
+  std::unordered_set<const dynamics::ShapeFrame*> removed;
+  removed.reserve(shapeFrames.size());
+
   for (const auto& shapeFrame : shapeFrames)
-    removeShapeFrame(shapeFrame);
+  {
+    const auto mapSearch = mObjectInfoMap.find(shapeFrame);
+    if (mObjectInfoMap.end() == mapSearch)
+      continue;
+
+    // See removeShapeFrame() for why the sources need to be unsubscribed
+    for (const void* source : mapSearch->second->mSources)
+    {
+      if (nullptr == source)
+        continue;
+
+      if (mSkeletonSources.erase(
+              static_cast<const dynamics::MetaSkeleton*>(source))
+          > 0)
+        continue;
+
+      mBodyNodeSources.erase(static_cast<const dynamics::BodyNode*>(source));
+    }
+
+    removed.insert(shapeFrame);
+  }
+
+  if (!removed.empty())
+    eraseObjectInfos(removed);
 }
 
 //==============================================================================
@@ -148,19 +334,14 @@ void CollisionGroup::removeAllShapeFrames()
   removeAllCollisionObjectsFromEngine();
 
   mObjectInfoList.clear();
+  mObjectInfoMap.clear();
   mObserver.removeAllShapeFrames();
 }
 
 //==============================================================================
 bool CollisionGroup::hasShapeFrame(const dynamics::ShapeFrame* shapeFrame) const
 {
-  return std::find_if(
-             mObjectInfoList.begin(),
-             mObjectInfoList.end(),
-             [&](const std::unique_ptr<ObjectInfo>& info) {
-               return info->mFrame == shapeFrame;
-             })
-         != mObjectInfoList.end();
+  return mObjectInfoMap.find(shapeFrame) != mObjectInfoMap.end();
 }
 
 //==============================================================================
@@ -190,6 +371,101 @@ bool CollisionGroup::collide(
   return mCollisionDetector->collide(this, option, result);
 }
 
+//==============================================================================
+bool CollisionGroup::collideContinuous(
+    double timeStep, const CollisionOption& option, CollisionResult* result)
+{
+  if (!result || 0u == option.maxNumContacts)
+    return false;
+
+  if (mUpdateAutomatically)
+    update();
+
+  std::vector<SweptFrame> sweptFrames;
+  std::vector<math::BoundingBox> sweptBoxes;
+
+  for (const auto& info : mObjectInfoList)
+  {
+    const dynamics::ShapeFrame* frame = info->mFrame;
+    const auto* aspect = frame->getCollisionAspect();
+    if (!aspect || !aspect->getContinuous())
+      continue;
+
+    const dynamics::Shape* shape = frame->getShape().get();
+    if (!shape || !isConvexShape(shape->getTypeId()))
+      continue;
+
+    const math::BoundingBox& boundingBox = shape->getBoundingBox();
+    const Eigen::Vector3d localCenter = boundingBox.computeCenter();
+    const Eigen::Vector3d halfExtents = boundingBox.computeHalfExtents();
+    const double radius = halfExtents.norm();
+    const double minMotion = 0.5 * halfExtents.minCoeff();
+
+    const Eigen::Vector3d center = frame->getWorldTransform() * localCenter;
+    const Eigen::Vector3d displacement
+        = timeStep * frame->getLinearVelocity(localCenter);
+    const double reach
+        = timeStep * radius * frame->getAngularVelocity().norm();
+    if (displacement.norm() + reach < minMotion)
+      continue;
+
+    // No point of the shape rotates further than the reach about the center
+    CollisionObject* object = info->mObject.get();
+    const math::BoundingBox box = object->computeWorldBoundingBox();
+    const Eigen::Vector3d margin = Eigen::Vector3d::Constant(reach);
+    sweptBoxes.emplace_back(
+        box.getMin() + displacement.cwiseMin(0.0) - margin,
+        box.getMax() + displacement.cwiseMax(0.0) + margin);
+    sweptFrames.push_back(
+        {frame, object, center, center + displacement, radius, minMotion});
+  }
+
+  if (sweptFrames.empty())
+    return false;
+
+  updateEngineData();
+
+  std::vector<BoxOverlap> boxOverlaps;
+  computeBoxOverlaps(sweptBoxes, boxOverlaps);
+
+  detail::UnorderedPairs<CollisionObject> contactPairs;
+  for (const auto& contact : result->getContacts())
+    contactPairs.addPair(contact.collisionObject1, contact.collisionObject2);
+
+  const auto& filter = option.collisionFilter;
+  auto found = false;
+
+  for (const auto& boxOverlap : boxOverlaps)
+  {
+    const SweptFrame& swept = sweptFrames[boxOverlap.first];
+    CollisionObject* object1 = swept.object;
+    CollisionObject* object2 = boxOverlap.second;
+    if (object1 == object2)
+      continue;
+
+    if (filter && filter->ignoresCollision(object1, object2))
+      continue;
+
+    if (contactPairs.contains(object1, object2))
+      continue;
+
+    Contact contact;
+    if (!sweepShape(swept, object2->getShapeFrame(), timeStep, contact))
+      continue;
+
+    contact.collisionObject1 = object1;
+    contact.collisionObject2 = object2;
+    result->addContact(contact);
+    contactPairs.addPair(object1, object2);
+    found = true;
+
+    if (result->getNumContacts() >= option.maxNumContacts)
+      return true;
+  }
+
+  return found;
+}
+
 //==============================================================================
 bool CollisionGroup::collide(
     CollisionGroup* otherGroup,
@@ -237,6 +513,30 @@ bool CollisionGroup::raycast(
   return mCollisionDetector->raycast(this, from, to, option, result);
 }
 
+//==============================================================================
+std::size_t CollisionGroup::raycastBatch(
+    std::size_t numRays,
+    const Eigen::Vector3d* origins,
+    const Eigen::Vector3d* directions,
+    double maxDistance,
+    double* distances,
+    Eigen::Vector3d* normals,
+    const dynamics::ShapeFrame** shapeFrames)
+{
+  if (mUpdateAutomatically)
+    update();
+
+  return mCollisionDetector->raycastBatch(
+      this,
+      numRays,
+      origins,
+      directions,
+      maxDistance,
+      distances,
+      normals,
+      shapeFrames);
+}
+
 //==============================================================================
 void CollisionGroup::setAutomaticUpdate(const bool automatic)
 {
@@ -264,20 +564,18 @@ void CollisionGroup::update()
 //==============================================================================
 void CollisionGroup::removeDeletedShapeFrames()
 {
+  if (mObserver.mDeletedFrames.empty())
+    return;
+
+  std::unordered_set<const dynamics::ShapeFrame*> removed;
   for (auto shapeFrame : mObserver.mDeletedFrames)
   {
-    const auto search = std::find_if(
-        mObjectInfoList.begin(),
-        mObjectInfoList.end(),
-        [&](const std::unique_ptr<ObjectInfo>& info) {
-          return info->mFrame == shapeFrame;
-        });
-
-    if (mObjectInfoList.end() == search)
+    const auto mapSearch = mObjectInfoMap.find(shapeFrame);
+    if (mObjectInfoMap.end() == mapSearch)
       continue;
 
     // Clear out the ShapeFrame from any subscriber that it might have
-    for (const void* source : (*search)->mSources)
+    for (const void* source : mapSearch->second->mSources)
     {
       if (nullptr == source)
         continue;
@@ -297,19 +595,109 @@ void CollisionGroup::removeDeletedShapeFrames()
         bodySearch->second.mObjects.erase(shapeFrame);
     }
 
-    removeCollisionObjectFromEngine((*search)->mObject.get());
-    mObjectInfoList.erase(search);
+    removed.insert(shapeFrame);
   }
 
   mObserver.mDeletedFrames.clear();
+
+  // The deleted frames must not be dereferenced anymore, so they are not
+  // handed back to the observer.
+  if (!removed.empty())
+    eraseObjectInfos(removed, false);
 }
 
 //==============================================================================
 void CollisionGroup::updateEngineData()
 {
+  mUpdatedObjects.clear();
+
   for (const auto& info : mObjectInfoList)
+  {
+    const std::size_t transformVersion
+        = info->mFrame->getWorldTransformVersion();
+
+    // The vertices of soft meshes change without their frames moving
+    const dynamics::ConstShapePtr& shape = info->mFrame->getShape();
+    const bool isSoftMesh
+        = shape && shape->getTypeId() == dynamics::Shape::TypeId::SOFT_MESH;
+
+    if (transformVersion == info->mLastKnownTransformVersion && !isSoftMesh)
+      continue;
+
     info->mObject->updateEngineData();
+    info->mLastKnownTransformVersion = transformVersion;
+    mUpdatedObjects.push_back(info->mObject.get());
+  }
+
+  refitCollisionGroupEngineData(mUpdatedObjects);
+}
+
+//==============================================================================
+void CollisionGroup::computeBoxOverlaps(
+    const std::vector<math::BoundingBox>& boxes,
+    std::vector<BoxOverlap>& boxOverlaps)
+{
+  boxOverlaps.clear();
+
+  if (boxes.empty() || mObjectInfoList.empty())
+    return;
+
+  std::vector<std::pair<math::BoundingBox, CollisionObject*>> aabbs;
+  aabbs.reserve(mObjectInfoList.size());
+  for (const auto& info : mObjectInfoList)
+  {
+    CollisionObject* object = info->mObject.get();
+    aabbs.emplace_back(object->computeWorldBoundingBox(), object);
+  }
+
+  // Sweep and prune along the axis along which the objects are spread the
+  // most: once sorted by the minimum of their bounding boxes, each box only
+  // visits the objects that start before it ends.
+  Eigen::Vector3d lower = Eigen::Vector3d::Constant(
+      std::numeric_limits<double>::infinity());
+  Eigen::Vector3d upper = -lower;
+  for (const auto& aabb : aabbs)
+  {
+    const Eigen::Vector3d center = aabb.first.computeCenter();
+    if (!center.allFinite())
+      continue;
+
+    lower = lower.cwiseMin(center);
+    upper = upper.cwiseMax(center);
+  }
+
+  int axis = 0;
+  if ((lower.array() <= upper.array()).all())
+    (upper - lower).maxCoeff(&axis);
+
+  std::stable_sort(
+      aabbs.begin(),
+      aabbs.end(),
+      [axis](
+          const std::pair<math::BoundingBox, CollisionObject*>& a,
+          const std::pair<math::BoundingBox, CollisionObject*>& b) {
+        return a.first.getMin()[axis] < b.first.getMin()[axis];
+      });
+
+  for (std::size_t i = 0u; i < boxes.size(); ++i)
+  {
+    const double max = boxes[i].getMax()[axis];
 
+    for (const auto& aabb : aabbs)
+    {
+      if (aabb.first.getMin()[axis] > max)
+        break;
+
+      if (overlaps(boxes[i], aabb.first))
+        boxOverlaps.emplace_back(i, aabb.second);
+    }
+  }
+}
+
+//==============================================================================
+void CollisionGroup::refitCollisionGroupEngineData(
+    const std::vector<CollisionObject*>& /*updatedObjects*/)
+{
   updateCollisionGroupEngineData();
 }
 
@@ -346,23 +734,23 @@ void CollisionGroup::ShapeFrameObserver::handleDestructionNotification(
 
 //==============================================================================
 auto CollisionGroup::addShapeFrameImpl(
-    const dynamics::ShapeFrame* shapeFrame, const void* source) -> ObjectInfo*
+    const dynamics::ShapeFrame* shapeFrame,
+    const void* source,
+    std::vector<CollisionObject*>* pendingObjects) -> ObjectInfo*
 {
   if (!shapeFrame)
     return nullptr;
 
-  auto it = std::find_if(
-      mObjectInfoList.begin(),
-      mObjectInfoList.end(),
-      [&](const std::unique_ptr<ObjectInfo>& info) {
-        return info->mFrame == shapeFrame;
-      });
+  auto it = mObjectInfoMap.find(shapeFrame);
 
-  if (it == mObjectInfoList.end())
+  if (it == mObjectInfoMap.end())
   {
     auto collObj = mCollisionDetector->claimCollisionObject(shapeFrame);
 
-    addCollisionObjectToEngine(collObj.get());
+    if (pendingObjects)
+      pendingObjects->push_back(collObj.get());
+    else
+      addCollisionObjectToEngine(collObj.get());
 
     const dynamics::ConstShapePtr& shape = shapeFrame->getShape();
 
@@ -375,15 +763,17 @@ auto CollisionGroup::addShapeFrameImpl(
                                                 collObj,
                                                 shape ? shape->getID() : 0,
                                                 shape ? shape->getVersion() : 0,
+                                                unknownTransformVersion,
                                                 {}});
     mObserver.addShapeFrame(shapeFrame);
 
-    it = --mObjectInfoList.end();
+    it = mObjectInfoMap.insert({shapeFrame, mObjectInfoList.back().get()})
+             .first;
   }
 
-  (*it)->mSources.insert(source);
+  it->second->mSources.insert(source);
 
-  return it->get();
+  return it->second;
 }
 
 //==============================================================================
@@ -393,25 +783,39 @@ void CollisionGroup::removeShapeFrameInternal(
   if (!shapeFrame)
     return;
 
-  const auto search = std::find_if(
-      mObjectInfoList.begin(),
-      mObjectInfoList.end(),
-      [&](const std::unique_ptr<ObjectInfo>& info) {
-        return info->mFrame == shapeFrame;
-      });
-
-  if (mObjectInfoList.end() == search)
+  const auto search = mObjectInfoMap.find(shapeFrame);
+  if (mObjectInfoMap.end() == search)
     return;
 
-  std::unordered_set<const void*>& objectSources = (*search)->mSources;
+  std::unordered_set<const void*>& objectSources = search->second->mSources;
   objectSources.erase(source);
 
   if (objectSources.empty())
-  {
-    removeCollisionObjectFromEngine((*search)->mObject.get());
-    mObjectInfoList.erase(search);
-    mObserver.removeShapeFrame(shapeFrame);
-  }
+    eraseObjectInfos({shapeFrame});
+}
+
+//==============================================================================
+void CollisionGroup::eraseObjectInfos(
+    const std::unordered_set<const dynamics::ShapeFrame*>& shapeFrames,
+    bool stopObserving)
+{
+  // Keep the order of the remaining objects intact so that the contact results
+  // stay deterministic (see the dev note on mObjectInfoList).
+  const auto newEnd = std::remove_if(
+      mObjectInfoList.begin(),
+      mObjectInfoList.end(),
+      [&](const std::unique_ptr<ObjectInfo>& info) {
+        if (shapeFrames.count(info->mFrame) == 0)
+          return false;
+
+        removeCollisionObjectFromEngine(info->mObject.get());
+        mObjectInfoMap.erase(info->mFrame);
+        if (stopObserving)
+          mObserver.removeShapeFrame(info->mFrame);
+        return true;
+      });
+
+  mObjectInfoList.erase(newEnd, mObjectInfoList.end());
 }
 
 //==============================================================================
@@ -626,6 +1030,7 @@ bool CollisionGroup::updateShapeFrame(ObjectInfo* object)
 
     object->mLastKnownShapeID = currentID;
     object->mLastKnownVersion = currentVersion;
+    object->mLastKnownTransformVersion = unknownTransformVersion;
 
     return true;
   }
@@ -45,6 +45,7 @@
 #include "dart/collision/SmartPointer.hpp"
 #include "dart/common/Observer.hpp"
 #include "dart/dynamics/SmartPointer.hpp"
+#include "dart/math/Geometry.hpp"
 
 namespace dart {
 namespace collision {
@@ -52,6 +53,8 @@ namespace collision {
 class CollisionGroup
 {
 public:
+  friend class CollisionDetector;
+
   /// Constructor
   CollisionGroup(const CollisionDetectorPtr& collisionDetector);
   // CollisionGroup also can be created from CollisionDetector::create()
@@ -139,13 +142,19 @@ public:
   /// template.
   void subscribeTo();
 
+  /// Subscribe to all the skeletons at once. This is equivalent to subscribing
+  /// to each skeleton individually, but the new CollisionObjects are handed to
+  /// the collision detection engine in a single batch.
+  void subscribeTo(const std::vector<dynamics::ConstSkeletonPtr>& skeletons);
+
   /// Remove a ShapeFrame from this CollisionGroup. If this ShapeFrame was being
   /// provided by any subscriptions, then calling this function will unsubscribe
   /// from those subscriptions, because otherwise this ShapeFrame would simply
   /// be put back into the CollisionGroup the next time the group gets updated.
   void removeShapeFrame(const dynamics::ShapeFrame* shapeFrame);
 
-  /// Remove ShapeFrames from this CollisionGroup
+  /// Remove ShapeFrames from this CollisionGroup. Like removeShapeFrame(), this
+  /// unsubscribes from any sources that were providing the ShapeFrames.
   void removeShapeFrames(
       const std::vector<const dynamics::ShapeFrame*>& shapeFrames);
 
@@ -227,6 +236,32 @@ public:
       const CollisionOption& option = CollisionOption(false, 1u, nullptr),
       CollisionResult* result = nullptr);
 
+  /// Look for the contacts that the continuous ShapeFrames of this group, i.e.,
+  /// those whose CollisionAspect has the Continuous property set, are about to
+  /// make within the next timeStep, and add them to result.
+  ///
+  /// Each continuous ShapeFrame with a convex shape is swept along the motion
+  /// of its bounding box center given by the current velocities, relative to
+  /// every other ShapeFrame of the group. The rotation over the time step is
+  /// covered conservatively: the shape is inflated by the furthest distance
+  /// that a point of its bounding box can rotate about the center, so a
+  /// spinning shape may report a contact that it would just miss. The targets
+  /// are found by the broadphase from the swept bounding box and their current
+  /// bounding boxes, and are hit if they are convex shapes (see
+  /// isConvexShape()) or planes.
+  /// Only the pairs that are not in contact in result yet are considered, so
+  /// this is meant to run after collide() with the same result.
+  ///
+  /// The added contacts are speculative: the shapes are not touching yet, and
+  /// the negative penetration depth is the distance that is left between them
+  /// along the contact normal. Frames whose points move less than half the
+  /// smallest half extent of their bounding box are skipped, since collide()
+  /// catches them anyway. Returns right away if no ShapeFrame is continuous.
+  ///
+  /// \return True if a contact was added.
+  bool collideContinuous(
+      double timeStep, const CollisionOption& option, CollisionResult* result);
+
   /// Perform collision check with other CollisionGroup.
   ///
   /// Return false if the engine type of the other CollisionGroup is different
@@ -278,6 +313,19 @@ public:
       const RaycastOption& option = RaycastOption(),
       RaycastResult* result = nullptr);
 
+  /// Casts many rays onto this collision group at once. See
+  /// CollisionDetector::raycastBatch() for the details.
+  ///
+  /// \return The number of rays that hit something.
+  std::size_t raycastBatch(
+      std::size_t numRays,
+      const Eigen::Vector3d* origins,
+      const Eigen::Vector3d* directions,
+      double maxDistance,
+      double* distances,
+      Eigen::Vector3d* normals = nullptr,
+      const dynamics::ShapeFrame** shapeFrames = nullptr);
+
   /// Set whether this CollisionGroup will automatically check for updates.
   void setAutomaticUpdate(bool automatic = true);
 
@@ -305,6 +353,9 @@ public:
 protected:
   /// Update engine data. This function should be called before the collision
   /// detection is performed by the engine in most cases.
+  ///
+  /// Only the CollisionObjects whose ShapeFrames moved since the last call, or
+  /// that were added or refreshed since then, are pushed to the engine.
   void updateEngineData();
 
   /// Initialize the collision detection engine data such as broadphase
@@ -330,6 +381,27 @@ protected:
   /// This function will be called ahead of every collision checking.
   virtual void updateCollisionGroupEngineData() = 0;
 
+  /// Update the collision detection engine data after the engine data of the
+  /// given CollisionObjects was updated, e.g., by refitting the broadphase for
+  /// these objects only. This function will be called ahead of every collision
+  /// checking, possibly with no objects. By default, it calls
+  /// updateCollisionGroupEngineData().
+  virtual void refitCollisionGroupEngineData(
+      const std::vector<CollisionObject*>& updatedObjects);
+
+  /// Index of a query box paired with a CollisionObject whose bounding box
+  /// overlaps it
+  using BoxOverlap = std::pair<std::size_t, CollisionObject*>;
+
+  /// Find the CollisionObjects of this group whose world bounding boxes
+  /// overlap each of the given boxes, using the broadphase of the engine. The
+  /// overlaps are grouped by box, in the order of the boxes. By default, the
+  /// current bounding boxes of the objects are computed and swept along one
+  /// axis.
+  virtual void computeBoxOverlaps(
+      const std::vector<math::BoundingBox>& boxes,
+      std::vector<BoxOverlap>& boxOverlaps);
+
 protected:
   /// Collision detector
   CollisionDetectorPtr mCollisionDetector;
@@ -357,6 +429,10 @@ protected:
     /// shape frame
     std::size_t mLastKnownVersion;
 
+    /// The world transform version of the shape frame when mObject was last
+    /// pushed to the engine
+    std::size_t mLastKnownTransformVersion;
+
     /// The set of all sources that indicate that this object should be in this
     /// group. In the current implementation, this may consist of:
     /// user (nullptr), Skeleton subscription, and/or BodyNode subscription.
@@ -384,6 +460,10 @@ protected:
   // original and copy are not guranteed to be the same as we copy std::map
   // (e.g., by world cloning).
 
+  /// Lookup table from each ShapeFrame in mObjectInfoList to its ObjectInfo,
+  /// so that finding a ShapeFrame does not require a linear search.
+  std::unordered_map<const dynamics::ShapeFrame*, ObjectInfo*> mObjectInfoMap;
+
 private:
   /// This class watches when ShapeFrames get deleted so that they can be safely
   /// removes from the CollisionGroup. We cannot have a weak_ptr to a ShapeFrame
@@ -427,8 +507,27 @@ private:
   /// Implementation of addShapeFrame. The source argument tells us whether this
   /// ShapeFrame is being requested explicitly by the user or implicitly through
   /// a BodyNode, Skeleton, or other CollisionGroup.
+  ///
+  /// If pendingObjects is not a nullptr, newly created CollisionObjects are
+  /// appended to it instead of being added to the engine, and the caller is
+  /// responsible for passing them to addCollisionObjectsToEngine().
   ObjectInfo* addShapeFrameImpl(
-      const dynamics::ShapeFrame* shapeFrame, const void* source);
+      const dynamics::ShapeFrame* shapeFrame,
+      const void* source,
+      std::vector<CollisionObject*>* pendingObjects = nullptr);
+
+  /// Subscribe to a single skeleton, forwarding pendingObjects to
+  /// addShapeFrameImpl().
+  void subscribeToSkeleton(
+      const dynamics::ConstSkeletonPtr& skeleton,
+      std::vector<CollisionObject*>* pendingObjects);
+
+  /// Remove the ShapeFrames in the given set from mObjectInfoList in a single
+  /// pass. The CollisionObjects are removed from the engine as well. Pass
+  /// false for stopObserving when the ShapeFrames have already been destroyed.
+  void eraseObjectInfos(
+      const std::unordered_set<const dynamics::ShapeFrame*>& shapeFrames,
+      bool stopObserving = true);
 
   /// Internal version of removeShapeFrame. This will only remove the ShapeFrame
   /// if it is unsubscribed from all sources.
@@ -439,6 +538,10 @@ private:
   /// automatically. Default is true.
   bool mUpdateAutomatically;
 
+  /// CollisionObjects updated by the last updateEngineData(). This is only kept
+  /// as a member to avoid reallocating it on every call.
+  std::vector<CollisionObject*> mUpdatedObjects;
+
   /// \private This struct is used to store sources of ShapeFrames that the
   /// CollisionGroup is subscribed to, alongside the last version number of that
   /// source, as known by this CollisionGroup.
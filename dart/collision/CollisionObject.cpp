@@ -32,6 +32,8 @@
 
 #include "dart/collision/CollisionObject.hpp"
 
+#include <limits>
+
 #include "dart/collision/CollisionDetector.hpp"
 #include "dart/dynamics/ShapeFrame.hpp"
 
@@ -68,6 +70,34 @@ const Eigen::Isometry3d& CollisionObject::getTransform() const
   return mShapeFrame->getWorldTransform();
 }
 
+//==============================================================================
+math::BoundingBox CollisionObject::computeWorldBoundingBox() const
+{
+  const auto shape = getShape();
+
+  if (shape)
+  {
+    const math::BoundingBox& localAabb = shape->getBoundingBox();
+    const Eigen::Vector3d center = localAabb.computeCenter();
+    const Eigen::Vector3d halfExtents = localAabb.computeHalfExtents();
+
+    if (center.allFinite() && halfExtents.allFinite())
+    {
+      const Eigen::Isometry3d& tf = getTransform();
+      const Eigen::Vector3d worldCenter = tf * center;
+      const Eigen::Vector3d worldHalfExtents
+          = tf.linear().cwiseAbs() * halfExtents;
+
+      return math::BoundingBox(
+          worldCenter - worldHalfExtents, worldCenter + worldHalfExtents);
+    }
+  }
+
+  const double inf = std::numeric_limits<double>::infinity();
+  return math::BoundingBox(
+      Eigen::Vector3d::Constant(-inf), Eigen::Vector3d::Constant(inf));
+}
+
 //==============================================================================
 CollisionObject::CollisionObject(
     CollisionDetector* collisionDetector,
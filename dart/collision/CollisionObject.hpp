@@ -37,6 +37,7 @@
 
 #include "dart/collision/SmartPointer.hpp"
 #include "dart/dynamics/SmartPointer.hpp"
+#include "dart/math/Geometry.hpp"
 
 namespace dart {
 namespace collision {
@@ -64,6 +65,11 @@ public:
   /// Return the transformation of this CollisionObject in world coordinates
   const Eigen::Isometry3d& getTransform() const;
 
+  /// Compute the axis-aligned bounding box of the shape in world coordinates.
+  /// Shapes without a finite bounding box, e.g., PlaneShape, give an infinite
+  /// box.
+  math::BoundingBox computeWorldBoundingBox() const;
+
 protected:
   /// Contructor
   CollisionObject(
@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/collision/ContactCache.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "dart/collision/CollisionObject.hpp"
+#include "dart/dynamics/Shape.hpp"
+#include "dart/math/Constants.hpp"
+
+namespace dart {
+namespace collision {
+
+namespace {
+
+// Number of calls to ContactCache::update() after which a pair that was not
+// looked up is dropped
+constexpr std::size_t maxUnusedUpdates = 4u;
+
+//==============================================================================
+void getShapeIdAndVersion(
+    const CollisionObject* object, std::size_t& id, std::size_t& version)
+{
+  const dynamics::ConstShapePtr shape = object->getShape();
+  id = shape ? shape->getID() : 0u;
+  version = shape ? shape->getVersion() : 0u;
+}
+
+} // anonymous namespace
+
+//==============================================================================
+ContactCache::ContactCache(
+    double translationThreshold, double rotationThreshold)
+  : mTranslationThreshold(translationThreshold),
+    mRotationThreshold(rotationThreshold),
+    mUpdateCount(0u),
+    mNumHits(0u)
+{
+  // Do nothing
+}
+
+//==============================================================================
+void ContactCache::setTranslationThreshold(double threshold)
+{
+  mTranslationThreshold = threshold;
+}
+
+//==============================================================================
+double ContactCache::getTranslationThreshold() const
+{
+  return mTranslationThreshold;
+}
+
+//==============================================================================
+void ContactCache::setRotationThreshold(double threshold)
+{
+  mRotationThreshold = threshold;
+}
+
+//==============================================================================
+double ContactCache::getRotationThreshold() const
+{
+  return mRotationThreshold;
+}
+
+//==============================================================================
+bool ContactCache::find(
+    const CollisionObject* object1,
+    const CollisionObject* object2,
+    const CollisionOption& option,
+    CollisionResult& result)
+{
+  const auto it = mEntries.find(Key(object1, object2));
+  if (it == mEntries.end())
+    return false;
+
+  Entry& entry = it->second;
+
+  if (entry.enableContact != option.enableContact
+      || entry.maxNumContacts != option.maxNumContacts)
+    return false;
+
+  std::size_t shapeId1;
+  std::size_t shapeVersion1;
+  std::size_t shapeId2;
+  std::size_t shapeVersion2;
+  getShapeIdAndVersion(object1, shapeId1, shapeVersion1);
+  getShapeIdAndVersion(object2, shapeId2, shapeVersion2);
+  if (shapeId1 != entry.shapeId1 || shapeVersion1 != entry.shapeVersion1
+      || shapeId2 != entry.shapeId2 || shapeVersion2 != entry.shapeVersion2)
+    return false;
+
+  const Eigen::Isometry3d relativeTransform
+      = object1->getTransform().inverse() * object2->getTransform();
+
+  const Eigen::Vector3d translationChange
+      = relativeTransform.translation()
+        - entry.relativeTransform.translation();
+  if (translationChange.squaredNorm()
+      > mTranslationThreshold * mTranslationThreshold)
+    return false;
+
+  // The rotation angle of R follows from trace(R) = 1 + 2 cos(angle)
+  const double cosAngle
+      = 0.5
+        * ((entry.relativeTransform.linear().transpose()
+            * relativeTransform.linear())
+               .trace()
+           - 1.0);
+  const double maxAngle = std::min(mRotationThreshold, math::constantsd::pi());
+  if (cosAngle < std::cos(maxAngle))
+    return false;
+
+  entry.lastUsed = mUpdateCount;
+
+  for (const auto& cached : entry.contacts)
+  {
+    Contact contact = cached.contact;
+
+    const Eigen::Isometry3d& tf1 = contact.collisionObject1->getTransform();
+    const Eigen::Isometry3d& tf2 = contact.collisionObject2->getTransform();
+
+    // Both objects may have moved a little since the contact was found, so the
+    // point is put halfway between where each of them carries it.
+    contact.point = 0.5 * (tf1 * cached.localPoint1 + tf2 * cached.localPoint2);
+    contact.normal = tf1.linear() * cached.localNormal;
+    contact.force = tf1.linear() * cached.localForce;
+
+    result.addContact(contact);
+  }
+
+  ++mNumHits;
+
+  return true;
+}
+
+//==============================================================================
+void ContactCache::store(
+    const CollisionObject* object1,
+    const CollisionObject* object2,
+    const CollisionOption& option,
+    const CollisionResult& result)
+{
+  Entry& entry = mEntries[Key(object1, object2)];
+
+  entry.relativeTransform
+      = object1->getTransform().inverse() * object2->getTransform();
+  getShapeIdAndVersion(object1, entry.shapeId1, entry.shapeVersion1);
+  getShapeIdAndVersion(object2, entry.shapeId2, entry.shapeVersion2);
+  entry.enableContact = option.enableContact;
+  entry.maxNumContacts = option.maxNumContacts;
+  entry.lastUsed = mUpdateCount;
+
+  entry.contacts.clear();
+  entry.contacts.reserve(result.getNumContacts());
+  for (const auto& contact : result.getContacts())
+  {
+    CachedContact cached;
+    cached.contact = contact;
+
+    // Contacts of the pair normally refer to the pair's objects, but they are
+    // filled in here if a narrow phase left them out.
+    if (!cached.contact.collisionObject1 || !cached.contact.collisionObject2)
+    {
+      cached.contact.collisionObject1 = const_cast<CollisionObject*>(object1);
+      cached.contact.collisionObject2 = const_cast<CollisionObject*>(object2);
+    }
+
+    const Eigen::Isometry3d& tf1
+        = cached.contact.collisionObject1->getTransform();
+    const Eigen::Isometry3d& tf2
+        = cached.contact.collisionObject2->getTransform();
+
+    cached.localPoint1 = tf1.inverse() * contact.point;
+    cached.localPoint2 = tf2.inverse() * contact.point;
+    cached.localNormal = tf1.linear().transpose() * contact.normal;
+    cached.localForce = tf1.linear().transpose() * contact.force;
+
+    entry.contacts.push_back(cached);
+  }
+}
+
+//==============================================================================
+void ContactCache::update()
+{
+  ++mUpdateCount;
+
+  for (auto it = mEntries.begin(); it != mEntries.end();)
+  {
+    if (it->second.lastUsed + maxUnusedUpdates < mUpdateCount)
+      it = mEntries.erase(it);
+    else
+      ++it;
+  }
+}
+
+//==============================================================================
+void ContactCache::clear()
+{
+  mEntries.clear();
+  mNumHits = 0u;
+}
+
+//==============================================================================
+std::size_t ContactCache::getNumPairs() const
+{
+  return mEntries.size();
+}
+
+//==============================================================================
+std::size_t ContactCache::getNumHits() const
+{
+  return mNumHits;
+}
+
+//==============================================================================
+std::size_t ContactCache::KeyHash::operator()(const Key& key) const
+{
+  std::size_t seed = std::hash<const CollisionObject*>()(key.first);
+  seed ^= std::hash<const CollisionObject*>()(key.second) + 0x9e3779b9
+          + (seed << 6) + (seed >> 2);
+
+  return seed;
+}
+
+} // namespace collision
+} // namespace dart
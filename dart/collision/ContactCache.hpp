@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_COLLISION_CONTACTCACHE_HPP_
+#define DART_COLLISION_CONTACTCACHE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Geometry>
+
+#include "dart/collision/CollisionOption.hpp"
+#include "dart/collision/CollisionResult.hpp"
+#include "dart/collision/Contact.hpp"
+
+namespace dart {
+namespace collision {
+
+class CollisionObject;
+
+/// ContactCache remembers the contacts found by the narrow phase for pairs of
+/// CollisionObjects, so that they can be reused as long as the two objects
+/// have not moved relative to each other. This saves the narrow phase for
+/// resting contacts, e.g., in a stack of boxes.
+///
+/// The contacts are stored in the frames of the two objects and moved along
+/// with them when they are reused. A cached pair is invalidated when the
+/// relative pose of the objects changes by more than the translation or
+/// rotation threshold since the contacts were computed, or when the shape or
+/// the shape version of either object changes.
+///
+/// A ContactCache is enabled by passing it to
+/// CollisionDetector::setContactCache(). It is used by DARTCollisionDetector
+/// for the checks that fill a CollisionResult.
+class ContactCache
+{
+public:
+  /// Constructor. The thresholds bound the change of the relative pose of two
+  /// objects, in meters and radians respectively, under which their cached
+  /// contacts are reused.
+  explicit ContactCache(
+      double translationThreshold = 1e-6, double rotationThreshold = 1e-6);
+
+  /// Set the translation threshold in meters
+  void setTranslationThreshold(double threshold);
+
+  /// Get the translation threshold in meters
+  double getTranslationThreshold() const;
+
+  /// Set the rotation threshold in radians
+  void setRotationThreshold(double threshold);
+
+  /// Get the rotation threshold in radians
+  double getRotationThreshold() const;
+
+  /// Add the cached contacts of the pair (object1, object2) to result and
+  /// return true if they are still valid for the current poses and shapes of
+  /// the objects and were computed with the same option. Return false
+  /// otherwise, in which case the narrow phase has to be run.
+  ///
+  /// find() may be called concurrently for different pairs, but not
+  /// concurrently with store(), clear(), or update().
+  bool find(
+      const CollisionObject* object1,
+      const CollisionObject* object2,
+      const CollisionOption& option,
+      CollisionResult& result);
+
+  /// Cache the contacts of result, which the narrow phase found for the pair
+  /// (object1, object2) with the given option
+  void store(
+      const CollisionObject* object1,
+      const CollisionObject* object2,
+      const CollisionOption& option,
+      const CollisionResult& result);
+
+  /// Called by the collision detectors before each collision check. Pairs that
+  /// were not looked up during the last few checks are dropped, so that the
+  /// cache does not keep the pairs of objects that were removed or destroyed.
+  void update();
+
+  /// Drop all the cached pairs
+  void clear();
+
+  /// Get the number of cached pairs
+  std::size_t getNumPairs() const;
+
+  /// Get the number of find() calls that reused cached contacts since the
+  /// construction or the last call to clear()
+  std::size_t getNumHits() const;
+
+protected:
+  /// Contact stored in the frames of its collision objects
+  struct CachedContact
+  {
+    /// The contact as it was found, with the world quantities below replaced
+    /// when it is reused
+    Contact contact;
+
+    /// Contact point in the frame of contact.collisionObject1
+    Eigen::Vector3d localPoint1;
+
+    /// Contact point in the frame of contact.collisionObject2
+    Eigen::Vector3d localPoint2;
+
+    /// Contact normal in the frame of contact.collisionObject1
+    Eigen::Vector3d localNormal;
+
+    /// Contact force in the frame of contact.collisionObject1
+    Eigen::Vector3d localForce;
+  };
+
+  struct Entry
+  {
+    /// Pose of the second object in the frame of the first one when the
+    /// contacts were computed
+    Eigen::Isometry3d relativeTransform;
+
+    /// IDs and versions of the shapes of the two objects
+    std::size_t shapeId1;
+    std::size_t shapeVersion1;
+    std::size_t shapeId2;
+    std::size_t shapeVersion2;
+
+    /// Options the contacts were computed with
+    bool enableContact;
+    std::size_t maxNumContacts;
+
+    /// Value of mUpdateCount when this entry was last looked up or stored
+    std::size_t lastUsed;
+
+    std::vector<CachedContact> contacts;
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+  };
+
+  using Key = std::pair<const CollisionObject*, const CollisionObject*>;
+
+  struct KeyHash
+  {
+    std::size_t operator()(const Key& key) const;
+  };
+
+  using EntryMap = std::unordered_map<
+      Key,
+      Entry,
+      KeyHash,
+      std::equal_to<Key>,
+      Eigen::aligned_allocator<std::pair<const Key, Entry>>>;
+
+  /// Cached pairs
+  EntryMap mEntries;
+
+  /// Translation threshold in meters
+  double mTranslationThreshold;
+
+  /// Rotation threshold in radians
+  double mRotationThreshold;
+
+  /// Number of calls to update()
+  std::size_t mUpdateCount;
+
+  /// Number of successful find() calls
+  std::atomic<std::size_t> mNumHits;
+};
+
+} // namespace collision
+} // namespace dart
+
+#endif // DART_COLLISION_CONTACTCACHE_HPP_
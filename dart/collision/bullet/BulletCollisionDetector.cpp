@@ -57,6 +57,7 @@
 #include "dart/dynamics/MeshShape.hpp"
 #include "dart/dynamics/MultiSphereConvexHullShape.hpp"
 #include "dart/dynamics/PlaneShape.hpp"
+#include "dart/dynamics/SdfShape.hpp"
 #include "dart/dynamics/Shape.hpp"
 #include "dart/dynamics/ShapeFrame.hpp"
 #include "dart/dynamics/SoftMeshShape.hpp"
@@ -666,6 +667,26 @@ BulletCollisionDetector::createBulletCollisionShape(
     // const auto heightMap = static_cast<const HeightmapShaped*>(shape.get());
     // return createBulletCollisionShapeFromHeightmap(heightMap);
   }
+  else if (shape->is<SdfShape>())
+  {
+    assert(dynamic_cast<const SdfShape*>(shape.get()));
+
+    // Bullet has no signed distance field query. The grid box contains the
+    // solid, so the contacts are conservative.
+    dtwarn << "[BulletCollisionDetector::createBulletCollisionShape] "
+           << "Bullet does not support SdfShape. Approximating it by the box "
+           << "of its grid; use DARTCollisionDetector for exact contacts.\n";
+
+    const auto& boundingBox = shape->getBoundingBox();
+    auto bulletCollisionShape = std::make_unique<btBoxShape>(
+        convertVector3(boundingBox.computeHalfExtents()));
+    const btTransform relativeShapeTransform(
+        btMatrix3x3::getIdentity(),
+        convertVector3(boundingBox.computeCenter()));
+
+    return std::make_unique<BulletCollisionShape>(
+        std::move(bulletCollisionShape), relativeShapeTransform);
+  }
   else
   {
     dterr << "[BulletCollisionDetector::createBulletCollisionShape] "
@@ -32,13 +32,18 @@
 
 #include "dart/collision/dart/DARTCollide.hpp"
 #include "dart/collision/CollisionObject.hpp"
+#include "dart/collision/dart/DARTConvexCollide.hpp"
+#include "dart/collision/dart/DARTSdfCollide.hpp"
 
+#include <array>
 #include <memory>
+#include <utility>
 
 #include "dart/dynamics/BodyNode.hpp"
 #include "dart/dynamics/BoxShape.hpp"
 #include "dart/dynamics/CylinderShape.hpp"
 #include "dart/dynamics/EllipsoidShape.hpp"
+#include "dart/dynamics/PlaneShape.hpp"
 #include "dart/dynamics/SphereShape.hpp"
 #include "dart/math/Helpers.hpp"
 
@@ -1529,131 +1534,437 @@ int collideCylinderPlane(
   return 0;
 }
 
+namespace {
+
+using ShapeTypeId = dynamics::Shape::TypeId;
+using ConvexAlgorithm = DARTCollisionDetector::ConvexCollisionAlgorithm;
+
+/// Narrowphase routine for a particular pair of shape types
+using CollideFunction = int (*)(
+    CollisionObject* o1,
+    CollisionObject* o2,
+    const dynamics::Shape& shape1,
+    const dynamics::Shape& shape2,
+    ConvexAlgorithm convexAlgorithm,
+    CollisionResult& result);
+
 //==============================================================================
-int collide(CollisionObject* o1, CollisionObject* o2, CollisionResult& result)
+// Ellipsoids are treated as spheres with their first radius
+template <typename SphereT>
+double getSphereRadius(const dynamics::Shape& shape);
+
+template <>
+double getSphereRadius<dynamics::SphereShape>(const dynamics::Shape& shape)
 {
-  // TODO(JS): We could make the contact point computation as optional for
-  // the case that we want only binary check.
+  return static_cast<const dynamics::SphereShape&>(shape).getRadius();
+}
 
-  const auto& shape1 = o1->getShape();
-  const auto& shape2 = o2->getShape();
+template <>
+double getSphereRadius<dynamics::EllipsoidShape>(const dynamics::Shape& shape)
+{
+  return static_cast<const dynamics::EllipsoidShape&>(shape).getRadii()[0];
+}
+
+//==============================================================================
+const Eigen::Vector3d& getBoxSize(const dynamics::Shape& shape)
+{
+  return static_cast<const dynamics::BoxShape&>(shape).getSize();
+}
+
+//==============================================================================
+template <typename SphereT1, typename SphereT2>
+int collideSpheres(
+    CollisionObject* o1,
+    CollisionObject* o2,
+    const dynamics::Shape& shape1,
+    const dynamics::Shape& shape2,
+    ConvexAlgorithm /*convexAlgorithm*/,
+    CollisionResult& result)
+{
+  return collideSphereSphere(
+      o1,
+      o2,
+      getSphereRadius<SphereT1>(shape1),
+      o1->getTransform(),
+      getSphereRadius<SphereT2>(shape2),
+      o2->getTransform(),
+      result);
+}
 
-  const auto& shapeType1 = shape1->getType();
-  const auto& shapeType2 = shape2->getType();
+//==============================================================================
+template <typename SphereT>
+int collideSphereWithBox(
+    CollisionObject* o1,
+    CollisionObject* o2,
+    const dynamics::Shape& shape1,
+    const dynamics::Shape& shape2,
+    ConvexAlgorithm /*convexAlgorithm*/,
+    CollisionResult& result)
+{
+  return collideSphereBox(
+      o1,
+      o2,
+      getSphereRadius<SphereT>(shape1),
+      o1->getTransform(),
+      getBoxSize(shape2),
+      o2->getTransform(),
+      result);
+}
 
-  const Eigen::Isometry3d& T1 = o1->getTransform();
-  const Eigen::Isometry3d& T2 = o2->getTransform();
+//==============================================================================
+template <typename SphereT>
+int collideBoxWithSphere(
+    CollisionObject* o1,
+    CollisionObject* o2,
+    const dynamics::Shape& shape1,
+    const dynamics::Shape& shape2,
+    ConvexAlgorithm /*convexAlgorithm*/,
+    CollisionResult& result)
+{
+  return collideBoxSphere(
+      o1,
+      o2,
+      getBoxSize(shape1),
+      o1->getTransform(),
+      getSphereRadius<SphereT>(shape2),
+      o2->getTransform(),
+      result);
+}
 
-  if (dynamics::SphereShape::getStaticType() == shapeType1)
+//==============================================================================
+int collideBoxes(
+    CollisionObject* o1,
+    CollisionObject* o2,
+    const dynamics::Shape& shape1,
+    const dynamics::Shape& shape2,
+    ConvexAlgorithm /*convexAlgorithm*/,
+    CollisionResult& result)
+{
+  return collideBoxBox(
+      o1,
+      o2,
+      getBoxSize(shape1),
+      o1->getTransform(),
+      getBoxSize(shape2),
+      o2->getTransform(),
+      result);
+}
+
+//==============================================================================
+int collideConvexShapes(
+    CollisionObject* o1,
+    CollisionObject* o2,
+    const dynamics::Shape& shape1,
+    const dynamics::Shape& shape2,
+    ConvexAlgorithm convexAlgorithm,
+    CollisionResult& result)
+{
+  return collideConvexConvex(
+      o1,
+      o2,
+      shape1,
+      o1->getTransform(),
+      shape2,
+      o2->getTransform(),
+      result,
+      convexAlgorithm);
+}
+
+//==============================================================================
+int collideConvexWithPlane(
+    CollisionObject* o1,
+    CollisionObject* o2,
+    const dynamics::Shape& shape1,
+    const dynamics::Shape& shape2,
+    ConvexAlgorithm /*convexAlgorithm*/,
+    CollisionResult& result)
+{
+  const auto& plane = static_cast<const dynamics::PlaneShape&>(shape2);
+
+  return collideConvexPlane(
+      o1,
+      o2,
+      shape1,
+      o1->getTransform(),
+      plane.getNormal(),
+      plane.getOffset(),
+      o2->getTransform(),
+      result);
+}
+
+//==============================================================================
+int collidePlaneWithConvex(
+    CollisionObject* o1,
+    CollisionObject* o2,
+    const dynamics::Shape& shape1,
+    const dynamics::Shape& shape2,
+    ConvexAlgorithm /*convexAlgorithm*/,
+    CollisionResult& result)
+{
+  const auto& plane = static_cast<const dynamics::PlaneShape&>(shape1);
+
+  const auto numContacts = result.getNumContacts();
+  const int numNewContacts = collideConvexPlane(
+      o2,
+      o1,
+      shape2,
+      o2->getTransform(),
+      plane.getNormal(),
+      plane.getOffset(),
+      o1->getTransform(),
+      result);
+
+  // Flip the contacts so that their normals point from o2 to o1
+  for (auto i = numContacts; i < result.getNumContacts(); ++i)
   {
-    const auto* sphere0
-        = static_cast<const dynamics::SphereShape*>(shape1.get());
+    auto& contact = result.getContact(i);
+    std::swap(contact.collisionObject1, contact.collisionObject2);
+    contact.normal = -contact.normal;
+  }
 
-    if (dynamics::SphereShape::getStaticType() == shapeType2)
-    {
-      const auto* sphere1
-          = static_cast<const dynamics::SphereShape*>(shape2.get());
+  return numNewContacts;
+}
 
-      return collideSphereSphere(
-          o1, o2, sphere0->getRadius(), T1, sphere1->getRadius(), T2, result);
-    }
-    else if (dynamics::BoxShape::getStaticType() == shapeType2)
-    {
-      const auto* box1 = static_cast<const dynamics::BoxShape*>(shape2.get());
+//==============================================================================
+template <typename S>
+int collideConvexWithHeightmap(
+    CollisionObject* o1,
+    CollisionObject* o2,
+    const dynamics::Shape& shape1,
+    const dynamics::Shape& shape2,
+    ConvexAlgorithm /*convexAlgorithm*/,
+    CollisionResult& result)
+{
+  return collideConvexHeightmap(
+      o1,
+      o2,
+      shape1,
+      o1->getTransform(),
+      static_cast<const dynamics::HeightmapShape<S>&>(shape2),
+      o2->getTransform(),
+      result);
+}
 
-      return collideSphereBox(
-          o1, o2, sphere0->getRadius(), T1, box1->getSize(), T2, result);
-    }
-    else if (dynamics::EllipsoidShape::getStaticType() == shapeType2)
-    {
-      const auto* ellipsoid1
-          = static_cast<const dynamics::EllipsoidShape*>(shape2.get());
-
-      return collideSphereSphere(
-          o1,
-          o2,
-          sphere0->getRadius(),
-          T1,
-          ellipsoid1->getRadii()[0],
-          T2,
-          result);
-    }
+//==============================================================================
+template <typename S>
+int collideHeightmapWithConvex(
+    CollisionObject* o1,
+    CollisionObject* o2,
+    const dynamics::Shape& shape1,
+    const dynamics::Shape& shape2,
+    ConvexAlgorithm /*convexAlgorithm*/,
+    CollisionResult& result)
+{
+  const auto numContacts = result.getNumContacts();
+  const int numNewContacts = collideConvexHeightmap(
+      o2,
+      o1,
+      shape2,
+      o2->getTransform(),
+      static_cast<const dynamics::HeightmapShape<S>&>(shape1),
+      o1->getTransform(),
+      result);
+
+  // Flip the contacts so that their normals point from o2 to o1
+  for (auto i = numContacts; i < result.getNumContacts(); ++i)
+  {
+    auto& contact = result.getContact(i);
+    std::swap(contact.collisionObject1, contact.collisionObject2);
+    contact.normal = -contact.normal;
   }
-  else if (dynamics::BoxShape::getStaticType() == shapeType1)
+
+  return numNewContacts;
+}
+
+//==============================================================================
+int collideSdfWithSampled(
+    CollisionObject* o1,
+    CollisionObject* o2,
+    const dynamics::Shape& shape1,
+    const dynamics::Shape& shape2,
+    ConvexAlgorithm /*convexAlgorithm*/,
+    CollisionResult& result)
+{
+  return collideSdfSampled(
+      o1,
+      o2,
+      static_cast<const dynamics::SdfShape&>(shape1),
+      o1->getTransform(),
+      shape2,
+      o2->getTransform(),
+      result);
+}
+
+//==============================================================================
+int collideSampledWithSdf(
+    CollisionObject* o1,
+    CollisionObject* o2,
+    const dynamics::Shape& shape1,
+    const dynamics::Shape& shape2,
+    ConvexAlgorithm /*convexAlgorithm*/,
+    CollisionResult& result)
+{
+  const auto numContacts = result.getNumContacts();
+  const int numNewContacts = collideSdfSampled(
+      o2,
+      o1,
+      static_cast<const dynamics::SdfShape&>(shape2),
+      o2->getTransform(),
+      shape1,
+      o1->getTransform(),
+      result);
+
+  // Flip the contacts so that their normals point from o2 to o1
+  for (auto i = numContacts; i < result.getNumContacts(); ++i)
   {
-    const auto* box0 = static_cast<const dynamics::BoxShape*>(shape1.get());
+    auto& contact = result.getContact(i);
+    std::swap(contact.collisionObject1, contact.collisionObject2);
+    contact.normal = -contact.normal;
+  }
 
-    if (dynamics::SphereShape::getStaticType() == shapeType2)
-    {
-      const auto* sphere1
-          = static_cast<const dynamics::SphereShape*>(shape2.get());
+  return numNewContacts;
+}
 
-      return collideBoxSphere(
-          o1, o2, box0->getSize(), T1, sphere1->getRadius(), T2, result);
-    }
-    else if (dynamics::BoxShape::getStaticType() == shapeType2)
+//==============================================================================
+int collideUnsupported(
+    CollisionObject* /*o1*/,
+    CollisionObject* /*o2*/,
+    const dynamics::Shape& shape1,
+    const dynamics::Shape& shape2,
+    ConvexAlgorithm /*convexAlgorithm*/,
+    CollisionResult& /*result*/)
+{
+  dterr << "[DARTCollisionDetector] Attempting to check for an "
+        << "unsupported shape pair: [" << shape1.getType() << "] - ["
+        << shape2.getType() << "]. Returning false.\n";
+
+  return false;
+}
+
+//==============================================================================
+/// Table of the narrowphase routines indexed by the type IDs of both shapes
+class CollideFunctionTable
+{
+public:
+  CollideFunctionTable()
+  {
+    using dynamics::EllipsoidShape;
+    using dynamics::SphereShape;
+
+    for (auto& row : mFunctions)
+      row.fill(&collideUnsupported);
+
+    set(ShapeTypeId::SPHERE,
+        ShapeTypeId::SPHERE,
+        &collideSpheres<SphereShape, SphereShape>);
+    set(ShapeTypeId::SPHERE,
+        ShapeTypeId::ELLIPSOID,
+        &collideSpheres<SphereShape, EllipsoidShape>);
+    set(ShapeTypeId::ELLIPSOID,
+        ShapeTypeId::SPHERE,
+        &collideSpheres<EllipsoidShape, SphereShape>);
+    set(ShapeTypeId::ELLIPSOID,
+        ShapeTypeId::ELLIPSOID,
+        &collideSpheres<EllipsoidShape, EllipsoidShape>);
+
+    set(ShapeTypeId::SPHERE,
+        ShapeTypeId::BOX,
+        &collideSphereWithBox<SphereShape>);
+    set(ShapeTypeId::ELLIPSOID,
+        ShapeTypeId::BOX,
+        &collideSphereWithBox<EllipsoidShape>);
+    set(ShapeTypeId::BOX,
+        ShapeTypeId::SPHERE,
+        &collideBoxWithSphere<SphereShape>);
+    set(ShapeTypeId::BOX,
+        ShapeTypeId::ELLIPSOID,
+        &collideBoxWithSphere<EllipsoidShape>);
+
+    set(ShapeTypeId::BOX, ShapeTypeId::BOX, &collideBoxes);
+
+    // Every other pair of convex shapes goes through the generic routines
+    for (std::size_t i = 0u; i < NumTypeIds; ++i)
     {
-      const auto* box1 = static_cast<const dynamics::BoxShape*>(shape2.get());
+      const auto type1 = static_cast<ShapeTypeId>(i);
+      if (!isConvexShape(type1))
+        continue;
 
-      return collideBoxBox(
-          o1, o2, box0->getSize(), T1, box1->getSize(), T2, result);
+      for (std::size_t j = 0u; j < NumTypeIds; ++j)
+      {
+        const auto type2 = static_cast<ShapeTypeId>(j);
+        if (isConvexShape(type2) && get(type1, type2) == &collideUnsupported)
+          set(type1, type2, &collideConvexShapes);
+      }
+
+      set(type1, ShapeTypeId::PLANE, &collideConvexWithPlane);
+      set(ShapeTypeId::PLANE, type1, &collidePlaneWithConvex);
+      set(type1,
+          ShapeTypeId::HEIGHTMAP_FLOAT,
+          &collideConvexWithHeightmap<float>);
+      set(ShapeTypeId::HEIGHTMAP_FLOAT,
+          type1,
+          &collideHeightmapWithConvex<float>);
+      set(type1,
+          ShapeTypeId::HEIGHTMAP_DOUBLE,
+          &collideConvexWithHeightmap<double>);
+      set(ShapeTypeId::HEIGHTMAP_DOUBLE,
+          type1,
+          &collideHeightmapWithConvex<double>);
     }
-    else if (dynamics::EllipsoidShape::getStaticType() == shapeType2)
+
+    // Signed distance fields sample the surface of the other shape
+    for (std::size_t i = 0u; i < NumTypeIds; ++i)
     {
-      const auto* ellipsoid1
-          = static_cast<const dynamics::EllipsoidShape*>(shape2.get());
+      const auto type = static_cast<ShapeTypeId>(i);
+      if (!isSdfSampledShape(type))
+        continue;
 
-      return collideBoxSphere(
-          o1, o2, box0->getSize(), T1, ellipsoid1->getRadii()[0], T2, result);
+      set(ShapeTypeId::SDF, type, &collideSdfWithSampled);
+      set(type, ShapeTypeId::SDF, &collideSampledWithSdf);
     }
   }
-  else if (dynamics::EllipsoidShape::getStaticType() == shapeType1)
-  {
-    const auto* ellipsoid0
-        = static_cast<const dynamics::EllipsoidShape*>(shape1.get());
 
-    if (dynamics::SphereShape::getStaticType() == shapeType2)
-    {
-      const auto* sphere1
-          = static_cast<const dynamics::SphereShape*>(shape2.get());
-
-      return collideSphereSphere(
-          o1,
-          o2,
-          ellipsoid0->getRadii()[0],
-          T1,
-          sphere1->getRadius(),
-          T2,
-          result);
-    }
-    else if (dynamics::BoxShape::getStaticType() == shapeType2)
-    {
-      const auto* box1 = static_cast<const dynamics::BoxShape*>(shape2.get());
+  CollideFunction get(ShapeTypeId type1, ShapeTypeId type2) const
+  {
+    return mFunctions[static_cast<std::size_t>(type1)]
+                     [static_cast<std::size_t>(type2)];
+  }
 
-      return collideSphereBox(
-          o1, o2, ellipsoid0->getRadii()[0], T1, box1->getSize(), T2, result);
-    }
-    else if (dynamics::EllipsoidShape::getStaticType() == shapeType2)
-    {
-      const auto* ellipsoid1
-          = static_cast<const dynamics::EllipsoidShape*>(shape2.get());
-
-      return collideSphereSphere(
-          o1,
-          o2,
-          ellipsoid0->getRadii()[0],
-          T1,
-          ellipsoid1->getRadii()[0],
-          T2,
-          result);
-    }
+private:
+  void set(ShapeTypeId type1, ShapeTypeId type2, CollideFunction function)
+  {
+    mFunctions[static_cast<std::size_t>(type1)]
+              [static_cast<std::size_t>(type2)]
+        = function;
   }
 
-  dterr << "[DARTCollisionDetector] Attempting to check for an "
-        << "unsupported shape pair: [" << shape1->getType() << "] - ["
-        << shape2->getType() << "]. Returning false.\n";
+  static constexpr std::size_t NumTypeIds
+      = static_cast<std::size_t>(ShapeTypeId::NUM_TYPE_IDS);
 
-  return false;
+  std::array<std::array<CollideFunction, NumTypeIds>, NumTypeIds> mFunctions;
+};
+
+} // anonymous namespace
+
+//==============================================================================
+int collide(
+    CollisionObject* o1,
+    CollisionObject* o2,
+    CollisionResult& result,
+    DARTCollisionDetector::ConvexCollisionAlgorithm convexAlgorithm)
+{
+  // TODO(JS): We could make the contact point computation as optional for
+  // the case that we want only binary check.
+
+  static const CollideFunctionTable table;
+
+  const auto& shape1 = o1->getShape();
+  const auto& shape2 = o2->getShape();
+
+  const CollideFunction function
+      = table.get(shape1->getTypeId(), shape2->getTypeId());
+
+  return function(o1, o2, *shape1, *shape2, convexAlgorithm, result);
 }
 
 } // namespace collision
@@ -36,11 +36,17 @@
 #include <vector>
 #include <Eigen/Dense>
 #include "dart/collision/CollisionDetector.hpp"
+#include "dart/collision/dart/DARTCollisionDetector.hpp"
 
 namespace dart {
 namespace collision {
 
-int collide(CollisionObject* o1, CollisionObject* o2, CollisionResult& result);
+int collide(
+    CollisionObject* o1,
+    CollisionObject* o2,
+    CollisionResult& result,
+    DARTCollisionDetector::ConvexCollisionAlgorithm convexAlgorithm
+    = DARTCollisionDetector::GJK_EPA);
 
 int collideBoxBox(
     CollisionObject* o1,
@@ -32,27 +32,75 @@
 
 #include "dart/collision/dart/DARTCollisionDetector.hpp"
 
+#include <cmath>
+#include <functional>
+#include <unordered_map>
+
 #include "dart/collision/CollisionFilter.hpp"
 #include "dart/collision/CollisionObject.hpp"
+#include "dart/collision/ContactCache.hpp"
 #include "dart/collision/dart/DARTCollide.hpp"
 #include "dart/collision/dart/DARTCollisionGroup.hpp"
 #include "dart/collision/dart/DARTCollisionObject.hpp"
-#include "dart/dynamics/BoxShape.hpp"
+#include "dart/collision/dart/DARTConvexCollide.hpp"
+#include "dart/common/ThreadPool.hpp"
 #include "dart/dynamics/EllipsoidShape.hpp"
+#include "dart/dynamics/HeightmapShape.hpp"
+#include "dart/dynamics/PlaneShape.hpp"
+#include "dart/dynamics/SdfShape.hpp"
 #include "dart/dynamics/ShapeFrame.hpp"
-#include "dart/dynamics/SphereShape.hpp"
 
 namespace dart {
 namespace collision {
 
 namespace {
 
+/// Spatial hash of the contact points that have been added to a
+/// CollisionResult, so that repeated points can be rejected without comparing
+/// against every contact found so far.
+class ContactPointSet
+{
+public:
+  explicit ContactPointSet(double tol);
+
+  /// Return true if a point closer than the tolerance has been inserted
+  bool containsClose(const Eigen::Vector3d& point) const;
+
+  /// Insert a point
+  void insert(const Eigen::Vector3d& point);
+
+private:
+  struct CellHash
+  {
+    std::size_t operator()(const Eigen::Vector3d& cell) const;
+  };
+
+  Eigen::Vector3d computeCell(const Eigen::Vector3d& point) const;
+
+  double mTolerance;
+
+  std::unordered_multimap<Eigen::Vector3d, Eigen::Vector3d, CellHash> mPoints;
+};
+
 bool checkPair(
     CollisionObject* o1,
     CollisionObject* o2,
     const CollisionOption& option,
+    DARTCollisionDetector::ConvexCollisionAlgorithm algorithm,
+    ContactPointSet& points,
+    ContactCache* cache,
     CollisionResult* result = nullptr);
 
+bool checkPairs(
+    const std::vector<std::pair<std::size_t, std::size_t>>& pairs,
+    const std::vector<CollisionObject*>& objects1,
+    const std::vector<CollisionObject*>& objects2,
+    const CollisionOption& option,
+    DARTCollisionDetector::ConvexCollisionAlgorithm algorithm,
+    ContactCache* cache,
+    common::ThreadPool* pool,
+    CollisionResult* result);
+
 bool isClose(
     const Eigen::Vector3d& pos1, const Eigen::Vector3d& pos2, double tol);
 
@@ -61,7 +109,11 @@ void postProcess(
     CollisionObject* o2,
     const CollisionOption& option,
     CollisionResult& totalResult,
-    const CollisionResult& pairResult);
+    const CollisionResult& pairResult,
+    ContactPointSet& points);
+
+// Tolerance used to reject repeated contact points
+constexpr double contactPointTolerance = 3.0e-12;
 
 } // anonymous namespace
 
@@ -83,7 +135,10 @@ std::shared_ptr<DARTCollisionDetector> DARTCollisionDetector::create()
 std::shared_ptr<CollisionDetector>
 DARTCollisionDetector::cloneWithoutCollisionObjects() const
 {
-  return DARTCollisionDetector::create();
+  auto cloned = DARTCollisionDetector::create();
+  cloned->setConvexCollisionAlgorithm(mConvexCollisionAlgorithm);
+
+  return cloned;
 }
 
 //==============================================================================
@@ -141,38 +196,25 @@ bool DARTCollisionDetector::collide(
   if (objects.empty())
     return false;
 
-  auto collisionFound = false;
-  const auto& filter = option.collisionFilter;
-
-  for (auto i = 0u; i < objects.size() - 1; ++i)
-  {
-    auto* collObj1 = objects[i];
-
-    for (auto j = i + 1u; j < objects.size(); ++j)
-    {
-      auto* collObj2 = objects[j];
-
-      if (filter && filter->ignoresCollision(collObj1, collObj2))
-        continue;
-
-      collisionFound = checkPair(collObj1, collObj2, option, result);
-
-      if (result)
-      {
-        if (result->getNumContacts() >= option.maxNumContacts)
-          return true;
-      }
-      else
-      {
-        // If no result is passed, stop checking when the first contact is found
-        if (collisionFound)
-          return true;
-      }
-    }
-  }
-
-  // Either no collision found or not reached the maximum number of contacts
-  return collisionFound;
+  // Broadphase: only the pairs whose AABBs overlap reach the narrowphase
+  std::vector<DARTCollisionGroup::IndexPair> pairs;
+  casted->updateBroadPhase();
+  casted->computeOverlappingPairs(pairs);
+
+  // Binary checks neither read nor age the cache
+  ContactCache* cache = result ? mContactCache.get() : nullptr;
+  if (cache)
+    cache->update();
+
+  return checkPairs(
+      pairs,
+      objects,
+      objects,
+      option,
+      mConvexCollisionAlgorithm,
+      cache,
+      getThreadPool().get(),
+      result);
 }
 
 //==============================================================================
@@ -203,38 +245,26 @@ bool DARTCollisionDetector::collide(
   if (objects1.empty() || objects2.empty())
     return false;
 
-  auto collisionFound = false;
-  const auto& filter = option.collisionFilter;
-
-  for (auto i = 0u; i < objects1.size(); ++i)
-  {
-    auto* collObj1 = objects1[i];
-
-    for (auto j = 0u; j < objects2.size(); ++j)
-    {
-      auto* collObj2 = objects2[j];
-
-      if (filter && filter->ignoresCollision(collObj1, collObj2))
-        continue;
-
-      collisionFound = checkPair(collObj1, collObj2, option, result);
-
-      if (result)
-      {
-        if (result->getNumContacts() >= option.maxNumContacts)
-          return true;
-      }
-      else
-      {
-        // If no result is passed, stop checking when the first contact is found
-        if (collisionFound)
-          return true;
-      }
-    }
-  }
-
-  // Either no collision found or not reached the maximum number of contacts
-  return collisionFound;
+  // Broadphase: both groups are swept along the same axis
+  casted1->updateBroadPhase();
+  casted2->updateBroadPhase(casted1->mSweepAxis);
+  std::vector<DARTCollisionGroup::IndexPair> pairs;
+  casted1->computeOverlappingPairs(*casted2, pairs);
+
+  // Binary checks neither read nor age the cache
+  ContactCache* cache = result ? mContactCache.get() : nullptr;
+  if (cache)
+    cache->update();
+
+  return checkPairs(
+      pairs,
+      objects1,
+      objects2,
+      option,
+      mConvexCollisionAlgorithm,
+      cache,
+      getThreadPool().get(),
+      result);
 }
 
 //==============================================================================
@@ -263,7 +293,22 @@ double DARTCollisionDetector::distance(
 }
 
 //==============================================================================
-DARTCollisionDetector::DARTCollisionDetector() : CollisionDetector()
+void DARTCollisionDetector::setConvexCollisionAlgorithm(
+    ConvexCollisionAlgorithm algorithm)
+{
+  mConvexCollisionAlgorithm = algorithm;
+}
+
+//==============================================================================
+DARTCollisionDetector::ConvexCollisionAlgorithm
+DARTCollisionDetector::getConvexCollisionAlgorithm() const
+{
+  return mConvexCollisionAlgorithm;
+}
+
+//==============================================================================
+DARTCollisionDetector::DARTCollisionDetector()
+  : CollisionDetector(), mConvexCollisionAlgorithm(GJK_EPA)
 {
   mCollisionObjectManager.reset(new ManagerForSharableCollisionObjects(this));
 }
@@ -275,29 +320,43 @@ void warnUnsupportedShapeType(const dynamics::ShapeFrame* shapeFrame)
     return;
 
   const auto& shape = shapeFrame->getShape();
-  const auto& shapeType = shape->getType();
+  const auto shapeTypeId = shape->getTypeId();
 
-  if (shapeType == dynamics::SphereShape::getStaticType())
-    return;
-
-  if (shapeType == dynamics::BoxShape::getStaticType())
-    return;
-
-  if (shapeType == dynamics::EllipsoidShape::getStaticType())
+  if (shapeTypeId == dynamics::EllipsoidShape::getStaticTypeId())
   {
     const auto& ellipsoid
         = std::static_pointer_cast<const dynamics::EllipsoidShape>(shape);
 
     if (ellipsoid->isSphere())
       return;
+
+    dtwarn << "[DARTCollisionDetector] EllipsoidShape whose radii are not "
+           << "equal is treated as a sphere of its first radius against "
+           << "SphereShape, BoxShape and other EllipsoidShapes.\n";
+    return;
+  }
+
+  if (isConvexShape(shapeTypeId))
+    return;
+
+  if (shapeTypeId == dynamics::PlaneShape::getStaticTypeId())
+    return;
+
+  if (shapeTypeId == dynamics::SdfShape::getStaticTypeId())
+    return;
+
+  if (shapeTypeId == dynamics::HeightmapShapef::getStaticTypeId()
+      || shapeTypeId == dynamics::HeightmapShaped::getStaticTypeId())
+  {
+    return;
   }
 
   dterr << "[DARTCollisionDetector] Attempting to create shape type ["
-        << shapeType << "] that is not supported "
-        << "by DARTCollisionDetector. Currently, only BoxShape and "
-        << "EllipsoidShape (only when all the radii are equal) are "
-        << "supported. This shape will always get penetrated by other "
-        << "objects.\n";
+        << shape->getType() << "] that is not supported "
+        << "by DARTCollisionDetector. Currently, only the convex primitive "
+        << "shapes, MultiSphereConvexHullShape, MeshShape (as its convex "
+        << "hull), PlaneShape, HeightmapShape and SdfShape are supported. "
+        << "This shape will always get penetrated by other objects.\n";
 }
 
 //==============================================================================
@@ -318,27 +377,223 @@ void DARTCollisionDetector::refreshCollisionObject(CollisionObject* /*object*/)
 
 namespace {
 
+//==============================================================================
+ContactPointSet::ContactPointSet(double tol) : mTolerance(tol)
+{
+  // Do nothing
+}
+
+//==============================================================================
+bool ContactPointSet::containsClose(const Eigen::Vector3d& point) const
+{
+  if (mPoints.empty())
+    return false;
+
+  // A point closer than the tolerance can only be in one of the neighboring
+  // cells since the cells are as large as the tolerance.
+  const Eigen::Vector3d cell = computeCell(point);
+  for (int x = -1; x <= 1; ++x)
+  {
+    for (int y = -1; y <= 1; ++y)
+    {
+      for (int z = -1; z <= 1; ++z)
+      {
+        const auto range = mPoints.equal_range(cell + Eigen::Vector3d(x, y, z));
+        for (auto it = range.first; it != range.second; ++it)
+        {
+          if (isClose(point, it->second, mTolerance))
+            return true;
+        }
+      }
+    }
+  }
+
+  return false;
+}
+
+//==============================================================================
+void ContactPointSet::insert(const Eigen::Vector3d& point)
+{
+  mPoints.emplace(computeCell(point), point);
+}
+
+//==============================================================================
+std::size_t ContactPointSet::CellHash::operator()(
+    const Eigen::Vector3d& cell) const
+{
+  std::size_t seed = 0u;
+  for (int i = 0; i < 3; ++i)
+  {
+    seed ^= std::hash<double>()(cell[i]) + 0x9e3779b9 + (seed << 6)
+            + (seed >> 2);
+  }
+
+  return seed;
+}
+
+//==============================================================================
+Eigen::Vector3d ContactPointSet::computeCell(
+    const Eigen::Vector3d& point) const
+{
+  return (point / mTolerance).array().floor();
+}
+
 //==============================================================================
 bool checkPair(
     CollisionObject* o1,
     CollisionObject* o2,
     const CollisionOption& option,
+    DARTCollisionDetector::ConvexCollisionAlgorithm algorithm,
+    ContactPointSet& points,
+    ContactCache* cache,
     CollisionResult* result)
 {
   CollisionResult pairResult;
 
-  // Perform narrow-phase detection
-  collide(o1, o2, pairResult);
+  if (!cache || !cache->find(o1, o2, option, pairResult))
+  {
+    // Perform narrow-phase detection
+    collide(o1, o2, pairResult, algorithm);
+
+    if (cache)
+      cache->store(o1, o2, option, pairResult);
+  }
 
   // Early return for binary check
   if (!result)
     return pairResult.isCollision();
 
-  postProcess(o1, o2, option, *result, pairResult);
+  postProcess(o1, o2, option, *result, pairResult, points);
 
   return pairResult.isCollision();
 }
 
+//==============================================================================
+bool checkPairs(
+    const std::vector<std::pair<std::size_t, std::size_t>>& pairs,
+    const std::vector<CollisionObject*>& objects1,
+    const std::vector<CollisionObject*>& objects2,
+    const CollisionOption& option,
+    DARTCollisionDetector::ConvexCollisionAlgorithm algorithm,
+    ContactCache* cache,
+    common::ThreadPool* pool,
+    CollisionResult* result)
+{
+  auto collisionFound = false;
+  const auto& filter = option.collisionFilter;
+  ContactPointSet points(contactPointTolerance);
+
+  // Binary queries and queries for a single contact are usually answered by
+  // the first colliding pair, so they are checked one pair at a time.
+  if (!result || option.maxNumContacts == 1u || !pool
+      || pool->getNumThreads() < 2u)
+  {
+    for (const auto& pair : pairs)
+    {
+      auto* collObj1 = objects1[pair.first];
+      auto* collObj2 = objects2[pair.second];
+
+      if (filter && filter->ignoresCollision(collObj1, collObj2))
+        continue;
+
+      if (checkPair(
+              collObj1,
+              collObj2,
+              option,
+              algorithm,
+              points,
+              cache,
+              result))
+        collisionFound = true;
+
+      if (result)
+      {
+        if (result->getNumContacts() >= option.maxNumContacts)
+          return true;
+      }
+      else
+      {
+        // If no result is passed, stop checking when the first contact is
+        // found
+        if (collisionFound)
+          return true;
+      }
+    }
+
+    // Either no collision found or not reached the maximum number of contacts
+    return collisionFound;
+  }
+
+  // Otherwise the pairs are checked in batches. The narrow phase of the pairs
+  // of a batch runs on the pool, while the collision filter, the cache and the
+  // merging of the contacts are handled on this thread in pair order, so the
+  // contacts do not depend on the number of threads. The narrow phase only
+  // reads the world transforms, which were updated by the broadphase.
+  struct PairCheck
+  {
+    CollisionObject* collObj1;
+    CollisionObject* collObj2;
+    CollisionResult pairResult;
+    bool isCached;
+  };
+
+  const std::size_t batchSize = 4u * pool->getNumThreads();
+  std::vector<PairCheck> batch;
+  batch.reserve(batchSize);
+  std::vector<std::size_t> misses;
+  misses.reserve(batchSize);
+
+  auto next = pairs.begin();
+  while (next != pairs.end())
+  {
+    batch.clear();
+    misses.clear();
+    for (; next != pairs.end() && batch.size() < batchSize; ++next)
+    {
+      auto* collObj1 = objects1[next->first];
+      auto* collObj2 = objects2[next->second];
+
+      if (filter && filter->ignoresCollision(collObj1, collObj2))
+        continue;
+
+      batch.push_back(PairCheck{collObj1, collObj2, CollisionResult(), false});
+      auto& check = batch.back();
+      check.isCached
+          = cache && cache->find(collObj1, collObj2, option, check.pairResult);
+      if (!check.isCached)
+        misses.push_back(batch.size() - 1u);
+    }
+
+    pool->parallelFor(misses.size(), [&](std::size_t i) {
+      auto& check = batch[misses[i]];
+      collide(check.collObj1, check.collObj2, check.pairResult, algorithm);
+    });
+
+    for (const auto& check : batch)
+    {
+      if (cache && !check.isCached)
+        cache->store(check.collObj1, check.collObj2, option, check.pairResult);
+
+      postProcess(
+          check.collObj1,
+          check.collObj2,
+          option,
+          *result,
+          check.pairResult,
+          points);
+
+      if (check.pairResult.isCollision())
+        collisionFound = true;
+
+      if (result->getNumContacts() >= option.maxNumContacts)
+        return true;
+    }
+  }
+
+  // Either no collision found or not reached the maximum number of contacts
+  return collisionFound;
+}
+
 //==============================================================================
 bool isClose(
     const Eigen::Vector3d& pos1, const Eigen::Vector3d& pos2, double tol)
@@ -352,34 +607,23 @@ void postProcess(
     CollisionObject* o2,
     const CollisionOption& option,
     CollisionResult& totalResult,
-    const CollisionResult& pairResult)
+    const CollisionResult& pairResult,
+    ContactPointSet& points)
 {
   if (!pairResult.isCollision())
     return;
 
-  // Don't add repeated points
-  const auto tol = 3.0e-12;
-
-  for (auto pairContact : pairResult.getContacts())
+  for (const auto& pairContact : pairResult.getContacts())
   {
-    auto foundClose = false;
-
-    for (auto totalContact : totalResult.getContacts())
-    {
-      if (isClose(pairContact.point, totalContact.point, tol))
-      {
-        foundClose = true;
-        break;
-      }
-    }
-
-    if (foundClose)
+    // Don't add repeated points
+    if (points.containsClose(pairContact.point))
       continue;
 
     auto contact = pairContact;
     contact.collisionObject1 = o1;
     contact.collisionObject2 = o2;
     totalResult.addContact(contact);
+    points.insert(contact.point);
 
     if (totalResult.getNumContacts() >= option.maxNumContacts)
       break;
@@ -46,6 +46,19 @@ class DARTCollisionDetector : public CollisionDetector
 public:
   using CollisionDetector::createCollisionGroup;
 
+  /// Algorithm computing the penetration of the convex shape pairs that have
+  /// no dedicated routine (e.g., capsules, cones, cylinders and meshes).
+  ///
+  /// GJK_EPA: GJK followed by the expanding polytope algorithm. Returns the
+  /// minimum penetration depth.
+  /// MPR: Minkowski portal refinement. Usually faster than GJK_EPA, but the
+  /// penetration is measured along the line between the shape centers.
+  enum ConvexCollisionAlgorithm
+  {
+    GJK_EPA = 0,
+    MPR
+  };
+
   static std::shared_ptr<DARTCollisionDetector> create();
 
   // Documentation inherited
@@ -87,6 +100,12 @@ public:
       const DistanceOption& option = DistanceOption(false, 0.0, nullptr),
       DistanceResult* result = nullptr) override;
 
+  /// Set the algorithm used for general convex shape pairs
+  void setConvexCollisionAlgorithm(ConvexCollisionAlgorithm algorithm);
+
+  /// Get the algorithm used for general convex shape pairs
+  ConvexCollisionAlgorithm getConvexCollisionAlgorithm() const;
+
 protected:
   /// Constructor
   DARTCollisionDetector();
@@ -98,6 +117,9 @@ protected:
   // Documentation inherited
   void refreshCollisionObject(CollisionObject* object) override;
 
+  /// Algorithm used for general convex shape pairs
+  ConvexCollisionAlgorithm mConvexCollisionAlgorithm;
+
 private:
   static Registrar<DARTCollisionDetector> mRegistrar;
 };
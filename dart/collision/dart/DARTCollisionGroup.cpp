@@ -32,6 +32,10 @@
 
 #include "dart/collision/dart/DARTCollisionGroup.hpp"
 
+#include <algorithm>
+#include <cassert>
+#include <unordered_set>
+
 #include "dart/collision/CollisionObject.hpp"
 
 namespace dart {
@@ -40,7 +44,7 @@ namespace collision {
 //==============================================================================
 DARTCollisionGroup::DARTCollisionGroup(
     const CollisionDetectorPtr& collisionDetector)
-  : CollisionGroup(collisionDetector)
+  : CollisionGroup(collisionDetector), mSweepAxis(0)
 {
   // Do nothing
 }
@@ -58,6 +62,8 @@ void DARTCollisionGroup::addCollisionObjectToEngine(CollisionObject* object)
       == mCollisionObjects.end())
   {
     mCollisionObjects.push_back(object);
+    mAabbs.clear();
+    mSortedIndices.clear();
   }
 }
 
@@ -65,8 +71,18 @@ void DARTCollisionGroup::addCollisionObjectToEngine(CollisionObject* object)
 void DARTCollisionGroup::addCollisionObjectsToEngine(
     const std::vector<CollisionObject*>& collObjects)
 {
+  std::unordered_set<CollisionObject*> existing(
+      mCollisionObjects.begin(), mCollisionObjects.end());
+
+  mCollisionObjects.reserve(mCollisionObjects.size() + collObjects.size());
   for (auto collObject : collObjects)
-    addCollisionObjectToEngine(collObject);
+  {
+    if (existing.insert(collObject).second)
+      mCollisionObjects.push_back(collObject);
+  }
+
+  mAabbs.clear();
+  mSortedIndices.clear();
 }
 
 //==============================================================================
@@ -75,12 +91,16 @@ void DARTCollisionGroup::removeCollisionObjectFromEngine(
 {
   mCollisionObjects.erase(
       std::remove(mCollisionObjects.begin(), mCollisionObjects.end(), object));
+  mAabbs.clear();
+  mSortedIndices.clear();
 }
 
 //==============================================================================
 void DARTCollisionGroup::removeAllCollisionObjectsFromEngine()
 {
   mCollisionObjects.clear();
+  mAabbs.clear();
+  mSortedIndices.clear();
 }
 
 //==============================================================================
@@ -89,5 +109,232 @@ void DARTCollisionGroup::updateCollisionGroupEngineData()
   // Do nothing
 }
 
+//==============================================================================
+void DARTCollisionGroup::refitCollisionGroupEngineData(
+    const std::vector<CollisionObject*>& updatedObjects)
+{
+  // All the AABBs are recomputed after objects were added or removed
+  if (mAabbs.size() != mCollisionObjects.size())
+    return;
+
+  for (const auto* object : updatedObjects)
+  {
+    const auto result = mObjectIndices.find(object);
+    if (result != mObjectIndices.end())
+      mStaleAabbIndices.push_back(result->second);
+  }
+}
+
+//==============================================================================
+static bool overlaps(const math::BoundingBox& a, const math::BoundingBox& b)
+{
+  return (a.getMin().array() <= b.getMax().array()).all()
+         && (b.getMin().array() <= a.getMax().array()).all();
+}
+
+//==============================================================================
+void DARTCollisionGroup::updateBroadPhase(int axis)
+{
+  // Collects the objects that moved since the last update
+  updateEngineData();
+
+  const std::size_t numObjects = mCollisionObjects.size();
+
+  if (mAabbs.size() != numObjects)
+  {
+    mAabbs.resize(numObjects);
+    mObjectIndices.clear();
+    for (std::size_t i = 0u; i < numObjects; ++i)
+    {
+      mAabbs[i] = mCollisionObjects[i]->computeWorldBoundingBox();
+      mObjectIndices.emplace(mCollisionObjects[i], i);
+    }
+  }
+  else
+  {
+    for (const std::size_t index : mStaleAabbIndices)
+      mAabbs[index] = mCollisionObjects[index]->computeWorldBoundingBox();
+  }
+  mStaleAabbIndices.clear();
+
+  if (axis < 0)
+  {
+    // Sweep along the axis with the largest variance of the AABB centers so
+    // that the fewest objects overlap along it.
+    Eigen::Vector3d sum = Eigen::Vector3d::Zero();
+    Eigen::Vector3d sumSq = Eigen::Vector3d::Zero();
+    std::size_t numFinite = 0u;
+    for (const auto& aabb : mAabbs)
+    {
+      const Eigen::Vector3d center = aabb.computeCenter();
+      if (!center.allFinite())
+        continue;
+
+      sum += center;
+      sumSq += center.cwiseProduct(center);
+      ++numFinite;
+    }
+
+    axis = mSweepAxis;
+    if (numFinite > 1u)
+    {
+      const Eigen::Vector3d variance
+          = sumSq / numFinite
+            - (sum / numFinite).cwiseProduct(sum / numFinite);
+      variance.maxCoeff(&axis);
+    }
+  }
+
+  const auto minOf = [&](std::size_t index) {
+    return mAabbs[index].getMin()[mSweepAxis];
+  };
+
+  if (axis != mSweepAxis || mSortedIndices.size() != numObjects)
+  {
+    mSweepAxis = axis;
+    mSortedIndices.resize(numObjects);
+    for (std::size_t i = 0u; i < numObjects; ++i)
+      mSortedIndices[i] = i;
+
+    std::sort(
+        mSortedIndices.begin(),
+        mSortedIndices.end(),
+        [&](std::size_t a, std::size_t b) { return minOf(a) < minOf(b); });
+
+    return;
+  }
+
+  // Objects usually move only a little between two updates, so the previous
+  // order is almost sorted and insertion sort runs in close to linear time.
+  for (std::size_t i = 1u; i < numObjects; ++i)
+  {
+    const std::size_t index = mSortedIndices[i];
+    const double key = minOf(index);
+
+    std::size_t j = i;
+    while (j > 0u && minOf(mSortedIndices[j - 1u]) > key)
+    {
+      mSortedIndices[j] = mSortedIndices[j - 1u];
+      --j;
+    }
+    mSortedIndices[j] = index;
+  }
+}
+
+//==============================================================================
+void DARTCollisionGroup::computeBoxOverlaps(
+    const std::vector<math::BoundingBox>& boxes,
+    std::vector<BoxOverlap>& boxOverlaps)
+{
+  updateBroadPhase();
+
+  boxOverlaps.clear();
+
+  for (std::size_t i = 0u; i < boxes.size(); ++i)
+  {
+    const math::BoundingBox& box = boxes[i];
+    const double max = box.getMax()[mSweepAxis];
+
+    for (const std::size_t index : mSortedIndices)
+    {
+      const math::BoundingBox& aabb = mAabbs[index];
+      if (aabb.getMin()[mSweepAxis] > max)
+        break;
+
+      if (overlaps(box, aabb))
+        boxOverlaps.emplace_back(i, mCollisionObjects[index]);
+    }
+  }
+}
+
+//==============================================================================
+void DARTCollisionGroup::computeOverlappingPairs(
+    std::vector<IndexPair>& pairs) const
+{
+  pairs.clear();
+
+  const std::size_t numObjects = mSortedIndices.size();
+  for (std::size_t i = 0u; i < numObjects; ++i)
+  {
+    const std::size_t index1 = mSortedIndices[i];
+    const math::BoundingBox& aabb1 = mAabbs[index1];
+    const double max1 = aabb1.getMax()[mSweepAxis];
+
+    for (std::size_t j = i + 1u; j < numObjects; ++j)
+    {
+      const std::size_t index2 = mSortedIndices[j];
+      const math::BoundingBox& aabb2 = mAabbs[index2];
+
+      if (aabb2.getMin()[mSweepAxis] > max1)
+        break;
+
+      if (!overlaps(aabb1, aabb2))
+        continue;
+
+      pairs.emplace_back(std::min(index1, index2), std::max(index1, index2));
+    }
+  }
+
+  std::sort(pairs.begin(), pairs.end());
+}
+
+//==============================================================================
+void DARTCollisionGroup::computeOverlappingPairs(
+    const DARTCollisionGroup& other, std::vector<IndexPair>& pairs) const
+{
+  assert(mSweepAxis == other.mSweepAxis);
+
+  pairs.clear();
+
+  // Sweep over the merged order of both groups. Each object is only tested
+  // against the objects of the other group that start before it ends.
+  const std::size_t numObjects1 = mSortedIndices.size();
+  const std::size_t numObjects2 = other.mSortedIndices.size();
+  std::size_t i = 0u;
+  std::size_t j = 0u;
+  while (i < numObjects1 && j < numObjects2)
+  {
+    const std::size_t index1 = mSortedIndices[i];
+    const std::size_t index2 = other.mSortedIndices[j];
+    const math::BoundingBox& aabb1 = mAabbs[index1];
+    const math::BoundingBox& aabb2 = other.mAabbs[index2];
+
+    if (aabb1.getMin()[mSweepAxis] <= aabb2.getMin()[mSweepAxis])
+    {
+      const double max1 = aabb1.getMax()[mSweepAxis];
+      for (std::size_t k = j; k < numObjects2; ++k)
+      {
+        const std::size_t otherIndex = other.mSortedIndices[k];
+        const math::BoundingBox& otherAabb = other.mAabbs[otherIndex];
+
+        if (otherAabb.getMin()[mSweepAxis] > max1)
+          break;
+
+        if (overlaps(aabb1, otherAabb))
+          pairs.emplace_back(index1, otherIndex);
+      }
+      ++i;
+    }
+    else
+    {
+      const double max2 = aabb2.getMax()[mSweepAxis];
+      for (std::size_t k = i; k < numObjects1; ++k)
+      {
+        const std::size_t thisIndex = mSortedIndices[k];
+        const math::BoundingBox& thisAabb = mAabbs[thisIndex];
+
+        if (thisAabb.getMin()[mSweepAxis] > max2)
+          break;
+
+        if (overlaps(thisAabb, aabb2))
+          pairs.emplace_back(thisIndex, index2);
+      }
+      ++j;
+    }
+  }
+
+  std::sort(pairs.begin(), pairs.end());
+}
+
 } // namespace collision
 } // namespace dart
@@ -33,7 +33,12 @@
 #ifndef DART_COLLISION_DART_DARTCOLLISIONGROUP_HPP_
 #define DART_COLLISION_DART_DARTCOLLISIONGROUP_HPP_
 
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include "dart/collision/CollisionGroup.hpp"
+#include "dart/math/Geometry.hpp"
 
 namespace dart {
 namespace collision {
@@ -71,9 +76,62 @@ protected:
   // Documentation inherited
   void updateCollisionGroupEngineData() override;
 
+  // Documentation inherited
+  void refitCollisionGroupEngineData(
+      const std::vector<CollisionObject*>& updatedObjects) override;
+
+  // Documentation inherited
+  void computeBoxOverlaps(
+      const std::vector<math::BoundingBox>& boxes,
+      std::vector<BoxOverlap>& boxOverlaps) override;
+
+  /// Pair of indices into mCollisionObjects of two different groups, or of the
+  /// same group with first < second.
+  using IndexPair = std::pair<std::size_t, std::size_t>;
+
+  /// Recompute the world AABBs of the collision objects that moved since the
+  /// last call and re-sort the objects along the sweep axis. If axis is
+  /// negative, the axis along which the objects are spread the most is chosen.
+  void updateBroadPhase(int axis = -1);
+
+  /// Compute the pairs of objects in this group whose AABBs overlap. The pairs
+  /// are sorted in the order the brute-force i < j loop would visit them.
+  ///
+  /// updateBroadPhase() must be called beforehand.
+  void computeOverlappingPairs(std::vector<IndexPair>& pairs) const;
+
+  /// Compute the pairs of objects between this group and other whose AABBs
+  /// overlap. The first index of each pair refers to this group.
+  ///
+  /// updateBroadPhase() must be called beforehand on both groups with the same
+  /// sweep axis.
+  void computeOverlappingPairs(
+      const DARTCollisionGroup& other, std::vector<IndexPair>& pairs) const;
+
 protected:
   /// CollisionObjects added to this DARTCollisionGroup
   std::vector<CollisionObject*> mCollisionObjects;
+
+  /// World AABBs of mCollisionObjects, as of the last updateBroadPhase(). It is
+  /// cleared when objects are added or removed so that all of them are
+  /// recomputed.
+  std::vector<math::BoundingBox> mAabbs;
+
+  /// Indices into mCollisionObjects of the objects whose AABBs have to be
+  /// recomputed by the next updateBroadPhase()
+  std::vector<std::size_t> mStaleAabbIndices;
+
+  /// Index of each of mCollisionObjects, as of the last time all the AABBs were
+  /// recomputed
+  std::unordered_map<const CollisionObject*, std::size_t> mObjectIndices;
+
+  /// Indices into mCollisionObjects sorted by the minimum of their AABBs along
+  /// mSweepAxis. The order is kept between updates so that re-sorting is
+  /// cheap when the objects move coherently.
+  std::vector<std::size_t> mSortedIndices;
+
+  /// Axis used for sweep and prune
+  int mSweepAxis;
 };
 
 } // namespace collision
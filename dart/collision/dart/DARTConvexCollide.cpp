@@ -0,0 +1,821 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/collision/dart/DARTConvexCollide.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include "dart/collision/CollisionObject.hpp"
+#include "dart/collision/dart/detail/ConvexShape.hpp"
+#include "dart/collision/dart/detail/Epa.hpp"
+#include "dart/collision/dart/detail/Gjk.hpp"
+#include "dart/collision/dart/detail/MinkowskiDifference.hpp"
+#include "dart/collision/dart/detail/Mpr.hpp"
+
+namespace dart {
+namespace collision {
+
+namespace {
+
+using ShapeTypeId = dynamics::Shape::TypeId;
+using detail::ConvexShape;
+using detail::MinkowskiDifference;
+using detail::Penetration;
+using detail::Simplex;
+using detail::featureTolerance;
+using detail::maxFeaturePoints;
+using detail::penetrationTolerance;
+
+// Maximum number of points produced by clipping two features
+constexpr int maxClipPoints = 4 * maxFeaturePoints;
+
+// Maximum number of contact points reported for a shape pair
+constexpr int maxManifoldPoints = 4;
+
+//==============================================================================
+int clipFeatures(
+    const Eigen::Vector3d* reference,
+    int numReference,
+    const Eigen::Vector3d* incident,
+    int numIncident,
+    const Eigen::Vector3d& normal,
+    double size,
+    Eigen::Vector3d* clipped)
+{
+  Eigen::Vector3d u;
+  Eigen::Vector3d v;
+  detail::computeOrthonormalBasis(normal, u, v);
+
+  const auto project = [&](const Eigen::Vector3d& point) {
+    return Eigen::Vector2d(point.dot(u), point.dot(v));
+  };
+  const auto cross = [](const Eigen::Vector2d& a, const Eigen::Vector2d& b) {
+    return a[0] * b[1] - a[1] * b[0];
+  };
+
+  double area = 0.0;
+  for (int i = 0; i < numReference; ++i)
+  {
+    area += cross(
+        project(reference[i]), project(reference[(i + 1) % numReference]));
+  }
+
+  const double tolerance = penetrationTolerance * size;
+
+  if (std::abs(area) <= tolerance * size)
+  {
+    // Edge against edge: keep the overlap of the incident edge with the
+    // reference edge when both are parallel
+    if (numIncident != 2)
+      return 0;
+
+    int first = 0;
+    int last = 1;
+    for (int i = 0; i < numReference; ++i)
+    {
+      for (int j = i + 1; j < numReference; ++j)
+      {
+        if ((reference[j] - reference[i]).squaredNorm()
+            > (reference[last] - reference[first]).squaredNorm())
+        {
+          first = i;
+          last = j;
+        }
+      }
+    }
+
+    const Eigen::Vector2d r0 = project(reference[first]);
+    const Eigen::Vector2d edge = project(reference[last]) - r0;
+    const Eigen::Vector2d p0 = project(incident[0]);
+    const Eigen::Vector2d p1 = project(incident[1]);
+    const Eigen::Vector2d incidentEdge = p1 - p0;
+
+    if (std::abs(cross(edge, incidentEdge))
+        > featureTolerance * edge.norm() * incidentEdge.norm())
+    {
+      return 0;
+    }
+
+    const double lengthSquared = edge.squaredNorm();
+    if (lengthSquared <= tolerance * tolerance)
+      return 0;
+
+    const double t0 = (p0 - r0).dot(edge) / lengthSquared;
+    const double t1 = (p1 - r0).dot(edge) / lengthSquared;
+    if (std::abs(t1 - t0) <= std::numeric_limits<double>::epsilon())
+      return 0;
+
+    const double tMin = std::max(std::min(t0, t1), 0.0);
+    const double tMax = std::min(std::max(t0, t1), 1.0);
+    if (tMin > tMax)
+      return 0;
+
+    clipped[0] = incident[0]
+                 + ((tMin - t0) / (t1 - t0)) * (incident[1] - incident[0]);
+    clipped[1] = incident[0]
+                 + ((tMax - t0) / (t1 - t0)) * (incident[1] - incident[0]);
+    return 2;
+  }
+
+  // Sutherland-Hodgman clipping of the incident polygon by the edges of the
+  // reference polygon
+  const double orientation = area > 0.0 ? 1.0 : -1.0;
+
+  std::array<Eigen::Vector3d, maxClipPoints> buffer;
+  Eigen::Vector3d* input = clipped;
+  Eigen::Vector3d* output = buffer.data();
+
+  int numInput = numIncident;
+  for (int i = 0; i < numIncident; ++i)
+    input[i] = incident[i];
+
+  for (int i = 0; i < numReference && numInput > 0; ++i)
+  {
+    const Eigen::Vector2d r0 = project(reference[i]);
+    const Eigen::Vector2d edge
+        = project(reference[(i + 1) % numReference]) - r0;
+
+    int numOutput = 0;
+    for (int j = 0; j < numInput; ++j)
+    {
+      const Eigen::Vector3d& current = input[j];
+      const Eigen::Vector3d& next = input[(j + 1) % numInput];
+      const double currentSide
+          = orientation * cross(edge, project(current) - r0);
+      const double nextSide = orientation * cross(edge, project(next) - r0);
+
+      if (currentSide >= 0.0 && numOutput < maxClipPoints)
+        output[numOutput++] = current;
+
+      if ((currentSide >= 0.0) != (nextSide >= 0.0)
+          && numOutput < maxClipPoints)
+      {
+        const double t = currentSide / (currentSide - nextSide);
+        output[numOutput++] = current + t * (next - current);
+      }
+    }
+
+    std::swap(input, output);
+    numInput = numOutput;
+  }
+
+  if (input != clipped)
+  {
+    for (int i = 0; i < numInput; ++i)
+      clipped[i] = input[i];
+  }
+
+  return numInput;
+}
+
+//==============================================================================
+int reduceContactPoints(
+    const Eigen::Vector3d* points,
+    const double* depths,
+    int numPoints,
+    const Eigen::Vector3d& normal,
+    int* indices)
+{
+  if (numPoints <= maxManifoldPoints)
+  {
+    for (int i = 0; i < numPoints; ++i)
+      indices[i] = i;
+    return numPoints;
+  }
+
+  // Keep the deepest point, the point furthest from it, and the two points
+  // that span the largest area on both sides of the line through them.
+  int deepest = 0;
+  for (int i = 1; i < numPoints; ++i)
+  {
+    if (depths[i] > depths[deepest])
+      deepest = i;
+  }
+
+  int furthest = deepest;
+  double maxDistance = 0.0;
+  for (int i = 0; i < numPoints; ++i)
+  {
+    const double distance = (points[i] - points[deepest]).squaredNorm();
+    if (distance > maxDistance)
+    {
+      maxDistance = distance;
+      furthest = i;
+    }
+  }
+
+  int numIndices = 0;
+  indices[numIndices++] = deepest;
+  if (furthest == deepest)
+    return numIndices;
+  indices[numIndices++] = furthest;
+
+  const Eigen::Vector3d line = points[furthest] - points[deepest];
+  int left = -1;
+  int right = -1;
+  double maxLeft = 0.0;
+  double maxRight = 0.0;
+  for (int i = 0; i < numPoints; ++i)
+  {
+    const double side = line.cross(points[i] - points[deepest]).dot(normal);
+    if (side > maxLeft)
+    {
+      maxLeft = side;
+      left = i;
+    }
+    else if (side < maxRight)
+    {
+      maxRight = side;
+      right = i;
+    }
+  }
+
+  if (left >= 0)
+    indices[numIndices++] = left;
+  if (right >= 0)
+    indices[numIndices++] = right;
+
+  return numIndices;
+}
+
+//==============================================================================
+void addContact(
+    CollisionObject* o1,
+    CollisionObject* o2,
+    const Eigen::Vector3d& point,
+    const Eigen::Vector3d& normal,
+    double depth,
+    CollisionResult& result)
+{
+  Contact contact;
+  contact.collisionObject1 = o1;
+  contact.collisionObject2 = o2;
+  contact.point = point;
+  contact.normal = normal;
+  contact.penetrationDepth = depth;
+  result.addContact(contact);
+}
+
+} // anonymous namespace
+
+//==============================================================================
+bool isConvexShape(dynamics::Shape::TypeId typeId)
+{
+  switch (typeId)
+  {
+    case ShapeTypeId::SPHERE:
+    case ShapeTypeId::BOX:
+    case ShapeTypeId::ELLIPSOID:
+    case ShapeTypeId::CYLINDER:
+    case ShapeTypeId::CAPSULE:
+    case ShapeTypeId::CONE:
+    case ShapeTypeId::PYRAMID:
+    case ShapeTypeId::MULTISPHERE_CONVEX_HULL:
+    case ShapeTypeId::MESH:
+      return true;
+    default:
+      return false;
+  }
+}
+
+//==============================================================================
+int collideConvexConvex(
+    CollisionObject* o1,
+    CollisionObject* o2,
+    const dynamics::Shape& shape0,
+    const Eigen::Isometry3d& T0,
+    const dynamics::Shape& shape1,
+    const Eigen::Isometry3d& T1,
+    CollisionResult& result,
+    DARTCollisionDetector::ConvexCollisionAlgorithm algorithm)
+{
+  const ConvexShape shapeA(shape0, T0);
+  const ConvexShape shapeB(shape1, T1);
+  const MinkowskiDifference md(shapeA, shapeB);
+
+  Penetration penetration;
+  if (algorithm == DARTCollisionDetector::MPR)
+  {
+    if (!detail::runMpr(md, penetration))
+      return 0;
+  }
+  else
+  {
+    Simplex simplex;
+    int size = 0;
+    if (!detail::runGjk(md, simplex, size))
+      return 0;
+    if (!detail::runEpa(md, simplex, size, penetration))
+      return 0;
+  }
+
+  if (penetration.depth <= 0.0)
+    return 0;
+
+  // Contact normals point from o2 to o1
+  const Eigen::Vector3d normal = -penetration.normal;
+
+  // Try to build a manifold out of the features of both shapes that face each
+  // other
+  std::array<Eigen::Vector3d, maxFeaturePoints> featureA;
+  std::array<Eigen::Vector3d, maxFeaturePoints> featureB;
+  const int numFeatureA = shapeA.computeFeature(-normal, featureA.data());
+  const int numFeatureB = shapeB.computeFeature(normal, featureB.data());
+
+  if (numFeatureA >= 2 && numFeatureB >= 2)
+  {
+    const double size = md.getSize();
+    std::array<Eigen::Vector3d, maxClipPoints> points;
+    std::array<double, maxClipPoints> depths;
+    int numPoints = 0;
+
+    // The feature with more vertices is the reference, the other is clipped
+    if (numFeatureA >= numFeatureB)
+    {
+      const double minA = shapeA.support(-normal).dot(normal);
+      const int numClipped = clipFeatures(
+          featureA.data(),
+          numFeatureA,
+          featureB.data(),
+          numFeatureB,
+          normal,
+          size,
+          points.data());
+      for (int i = 0; i < numClipped; ++i)
+      {
+        const double depth = points[i].dot(normal) - minA;
+        if (depth <= 0.0)
+          continue;
+        depths[numPoints] = depth;
+        points[numPoints++] = points[i] - 0.5 * depth * normal;
+      }
+    }
+    else
+    {
+      const double maxB = shapeB.support(normal).dot(normal);
+      const int numClipped = clipFeatures(
+          featureB.data(),
+          numFeatureB,
+          featureA.data(),
+          numFeatureA,
+          normal,
+          size,
+          points.data());
+      for (int i = 0; i < numClipped; ++i)
+      {
+        const double depth = maxB - points[i].dot(normal);
+        if (depth <= 0.0)
+          continue;
+        depths[numPoints] = depth;
+        points[numPoints++] = points[i] + 0.5 * depth * normal;
+      }
+    }
+
+    // Remove the points repeated by clipping
+    int numUnique = 0;
+    for (int i = 0; i < numPoints; ++i)
+    {
+      bool repeated = false;
+      for (int j = 0; j < numUnique && !repeated; ++j)
+      {
+        repeated = (points[i] - points[j]).norm()
+                   <= penetrationTolerance * size;
+      }
+
+      if (!repeated)
+      {
+        points[numUnique] = points[i];
+        depths[numUnique] = depths[i];
+        ++numUnique;
+      }
+    }
+
+    if (numUnique >= 2)
+    {
+      std::array<int, maxManifoldPoints> indices;
+      const int numContacts = reduceContactPoints(
+          points.data(), depths.data(), numUnique, normal, indices.data());
+      for (int i = 0; i < numContacts; ++i)
+      {
+        addContact(
+            o1, o2, points[indices[i]], normal, depths[indices[i]], result);
+      }
+      return numContacts;
+    }
+  }
+
+  addContact(
+      o1,
+      o2,
+      0.5 * (penetration.pointA + penetration.pointB),
+      normal,
+      penetration.depth,
+      result);
+
+  return 1;
+}
+
+//==============================================================================
+int collideConvexPlane(
+    CollisionObject* o1,
+    CollisionObject* o2,
+    const dynamics::Shape& shape0,
+    const Eigen::Isometry3d& T0,
+    const Eigen::Vector3d& plane_normal,
+    double plane_offset,
+    const Eigen::Isometry3d& T1,
+    CollisionResult& result)
+{
+  const ConvexShape shape(shape0, T0);
+
+  const Eigen::Vector3d normal = T1.linear() * plane_normal;
+  const double offset = plane_offset + normal.dot(T1.translation());
+
+  const Eigen::Vector3d deepest = shape.support(-normal);
+  const double maxDepth = offset - deepest.dot(normal);
+  if (maxDepth <= 0.0)
+    return 0;
+
+  std::array<Eigen::Vector3d, maxFeaturePoints> feature;
+  const int numFeature = shape.computeFeature(-normal, feature.data());
+
+  std::array<Eigen::Vector3d, maxFeaturePoints> points;
+  std::array<double, maxFeaturePoints> depths;
+  int numPoints = 0;
+  for (int i = 0; i < numFeature; ++i)
+  {
+    const double depth = offset - feature[i].dot(normal);
+    if (depth <= 0.0)
+      continue;
+    depths[numPoints] = depth;
+    points[numPoints++] = feature[i] + 0.5 * depth * normal;
+  }
+
+  if (numPoints == 0)
+  {
+    depths[numPoints] = maxDepth;
+    points[numPoints++] = deepest + 0.5 * maxDepth * normal;
+  }
+
+  std::array<int, maxManifoldPoints> indices;
+  const int numContacts = reduceContactPoints(
+      points.data(), depths.data(), numPoints, normal, indices.data());
+  for (int i = 0; i < numContacts; ++i)
+    addContact(o1, o2, points[indices[i]], normal, depths[indices[i]], result);
+
+  return numContacts;
+}
+
+namespace {
+
+//==============================================================================
+/// Contact point between a convex shape and a height map
+struct HeightmapContact
+{
+  Eigen::Vector3d point;
+  Eigen::Vector3d normal;
+  double depth;
+};
+
+//==============================================================================
+/// Return true if the projection of \c point along \c normal lies inside of
+/// the triangle, whose vertices are counterclockwise around \c normal
+bool isAboveTriangle(
+    const Eigen::Vector3d* triangle,
+    const Eigen::Vector3d& normal,
+    const Eigen::Vector3d& point)
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    const Eigen::Vector3d& a = triangle[i];
+    const Eigen::Vector3d& b = triangle[(i + 1) % 3];
+    if ((b - a).cross(point - a).dot(normal) < 0.0)
+      return false;
+  }
+
+  return true;
+}
+
+//==============================================================================
+/// Append the contacts between a convex shape and a triangle of a height map.
+/// The triangle is given in the frame \c T1 of the height map,
+/// counterclockwise around its upward normal, and is the top of a column that
+/// goes down to the height \c bottom. A convex shape that overlaps the column
+/// is pushed back along the normal of the triangle, unless it only touches one
+/// of its edges or vertices, which gives an edge contact instead.
+void collideConvexTriangle(
+    const ConvexShape& shape,
+    const Eigen::Vector3d* triangle,
+    double bottom,
+    const Eigen::Isometry3d& T1,
+    std::vector<HeightmapContact>& faceContacts,
+    std::vector<HeightmapContact>& edgeContacts)
+{
+  std::array<Eigen::Vector3d, 6> column;
+  for (int i = 0; i < 3; ++i)
+  {
+    column[i] = triangle[i];
+    column[i + 3] = Eigen::Vector3d(triangle[i].x(), triangle[i].y(), bottom);
+  }
+
+  const ConvexShape prism(column.data(), 6, T1);
+  const MinkowskiDifference md(shape, prism);
+  Simplex simplex;
+  int size = 0;
+  if (!detail::runGjk(md, simplex, size))
+    return;
+
+  std::array<Eigen::Vector3d, 3> points;
+  for (int i = 0; i < 3; ++i)
+    points[i] = T1 * triangle[i];
+  const Eigen::Vector3d normal
+      = (points[1] - points[0]).cross(points[2] - points[0]).normalized();
+  const double offset = normal.dot(points[0]);
+
+  const Eigen::Vector3d deepest = shape.support(-normal);
+  const double maxDepth = offset - deepest.dot(normal);
+  if (maxDepth <= 0.0)
+    return;
+
+  // Face contact: the touching feature of the convex shape is clipped against
+  // the triangle
+  std::array<Eigen::Vector3d, maxFeaturePoints> feature;
+  const int numFeature = shape.computeFeature(-normal, feature.data());
+  const auto numContacts = faceContacts.size();
+  if (numFeature >= 2)
+  {
+    std::array<Eigen::Vector3d, maxClipPoints> clipped;
+    const int numClipped = clipFeatures(
+        points.data(),
+        3,
+        feature.data(),
+        numFeature,
+        normal,
+        md.getSize(),
+        clipped.data());
+    for (int i = 0; i < numClipped; ++i)
+    {
+      const double depth = offset - clipped[i].dot(normal);
+      if (depth > 0.0)
+      {
+        faceContacts.push_back(
+            {clipped[i] + 0.5 * depth * normal, normal, depth});
+      }
+    }
+  }
+  else if (isAboveTriangle(points.data(), normal, deepest))
+  {
+    faceContacts.push_back(
+        {deepest + 0.5 * maxDepth * normal, normal, maxDepth});
+  }
+
+  if (faceContacts.size() > numContacts)
+    return;
+
+  // Edge or vertex contact: penetration with the triangle itself
+  const ConvexShape face(triangle, 3, T1);
+  const MinkowskiDifference faceMd(shape, face);
+  Penetration penetration;
+  size = 0;
+  if (detail::runGjk(faceMd, simplex, size)
+      && detail::runEpa(faceMd, simplex, size, penetration)
+      && penetration.depth > 0.0 && -penetration.normal.dot(normal) > 0.0)
+  {
+    edgeContacts.push_back({0.5 * (penetration.pointA + penetration.pointB),
+                            -penetration.normal,
+                            penetration.depth});
+    return;
+  }
+
+  // The convex shape is below the surface: push it back up
+  faceContacts.push_back({deepest + 0.5 * maxDepth * normal, normal, maxDepth});
+}
+
+} // anonymous namespace
+
+//==============================================================================
+template <typename S>
+int collideConvexHeightmap(
+    CollisionObject* o1,
+    CollisionObject* o2,
+    const dynamics::Shape& shape0,
+    const Eigen::Isometry3d& T0,
+    const dynamics::HeightmapShape<S>& heightmap,
+    const Eigen::Isometry3d& T1,
+    CollisionResult& result)
+{
+  const auto& heights = heightmap.getHeightField();
+  const Eigen::Index numRows = heights.rows();
+  const Eigen::Index numCols = heights.cols();
+  if (numRows < 2 || numCols < 2 || heightmap.getNumPyramidLevels() == 0u)
+    return 0;
+
+  const Eigen::Vector3d scale = heightmap.getScale().template cast<double>();
+
+  // Bounding box of the convex shape in the frame of the height map
+  const Eigen::Isometry3d T = T1.inverse() * T0;
+  const auto& boundingBox = shape0.getBoundingBox();
+  const Eigen::Vector3d center
+      = T * (0.5 * (boundingBox.getMin() + boundingBox.getMax()));
+  const Eigen::Vector3d halfExtents
+      = T.linear().cwiseAbs() * (0.5 * boundingBox.computeFullExtents());
+  const Eigen::Vector3d min = center - halfExtents;
+  const Eigen::Vector3d max = center + halfExtents;
+
+  // Range of the cells under the bounding box. The vertex (r, c) of the height
+  // map is at ((c - (numCols - 1) / 2) sx, ((numRows - 1) / 2 - r) sy, h sz).
+  const double halfWidth = 0.5 * static_cast<double>(numCols - 1);
+  const double halfDepth = 0.5 * static_cast<double>(numRows - 1);
+  const double minCol = min.x() / scale.x() + halfWidth;
+  const double maxCol = max.x() / scale.x() + halfWidth;
+  const double minRow = halfDepth - max.y() / scale.y();
+  const double maxRow = halfDepth - min.y() / scale.y();
+  if (maxCol < 0.0 || minCol > static_cast<double>(numCols - 1)
+      || maxRow < 0.0 || minRow > static_cast<double>(numRows - 1))
+  {
+    return 0;
+  }
+
+  const auto toIndex = [](double coordinate, Eigen::Index maxIndex) {
+    return std::min(
+        maxIndex,
+        std::max<Eigen::Index>(
+            0, static_cast<Eigen::Index>(std::floor(coordinate))));
+  };
+  const Eigen::Index col0 = toIndex(minCol, numCols - 2);
+  const Eigen::Index col1 = toIndex(maxCol, numCols - 2);
+  const Eigen::Index row0 = toIndex(minRow, numRows - 2);
+  const Eigen::Index row1 = toIndex(maxRow, numRows - 2);
+
+  // Cells and tiles that are entirely below the convex shape are skipped
+  const auto isBelow = [&](S height) { return height * scale.z() < min.z(); };
+
+  const ConvexShape shape(shape0, T0);
+  const double bottom = heightmap.getMinHeight() * scale.z();
+
+  const auto vertex = [&](Eigen::Index row, Eigen::Index col) {
+    return Eigen::Vector3d(
+        (static_cast<double>(col) - halfWidth) * scale.x(),
+        (halfDepth - static_cast<double>(row)) * scale.y(),
+        heights(row, col) * scale.z());
+  };
+
+  std::vector<HeightmapContact> faceContacts;
+  std::vector<HeightmapContact> edgeContacts;
+
+  // Walk down the min/max pyramid from its single coarsest tile
+  struct Tile
+  {
+    std::size_t level;
+    Eigen::Index row;
+    Eigen::Index col;
+  };
+  std::vector<Tile> tiles;
+  tiles.push_back({heightmap.getNumPyramidLevels() - 1u, 0, 0});
+
+  const auto tileSize = static_cast<Eigen::Index>(
+      dynamics::HeightmapShape<S>::getPyramidTileSize());
+
+  while (!tiles.empty())
+  {
+    const Tile tile = tiles.back();
+    tiles.pop_back();
+
+    const auto& maxHeights = heightmap.getPyramidMaxHeights(tile.level);
+    if (isBelow(maxHeights(tile.row, tile.col)))
+      continue;
+
+    if (tile.level > 0u)
+    {
+      const auto& children = heightmap.getPyramidMaxHeights(tile.level - 1u);
+      const Eigen::Index span = tileSize << (tile.level - 1u);
+      for (Eigen::Index r = 2 * tile.row; r < 2 * tile.row + 2; ++r)
+      {
+        for (Eigen::Index c = 2 * tile.col; c < 2 * tile.col + 2; ++c)
+        {
+          if (r >= children.rows() || c >= children.cols())
+            continue;
+          if (r * span > row1 || (r + 1) * span <= row0)
+            continue;
+          if (c * span > col1 || (c + 1) * span <= col0)
+            continue;
+          tiles.push_back({tile.level - 1u, r, c});
+        }
+      }
+      continue;
+    }
+
+    const Eigen::Index firstRow = std::max(row0, tile.row * tileSize);
+    const Eigen::Index lastRow = std::min(row1, (tile.row + 1) * tileSize - 1);
+    const Eigen::Index firstCol = std::max(col0, tile.col * tileSize);
+    const Eigen::Index lastCol = std::min(col1, (tile.col + 1) * tileSize - 1);
+    for (Eigen::Index r = firstRow; r <= lastRow; ++r)
+    {
+      for (Eigen::Index c = firstCol; c <= lastCol; ++c)
+      {
+        const S maxHeight = std::max(
+            std::max(heights(r, c), heights(r, c + 1)),
+            std::max(heights(r + 1, c), heights(r + 1, c + 1)));
+        if (isBelow(maxHeight))
+          continue;
+
+        // Two triangles per cell, counterclockwise seen from above
+        const std::array<Eigen::Vector3d, 3> lower
+            = {{vertex(r + 1, c), vertex(r + 1, c + 1), vertex(r, c + 1)}};
+        const std::array<Eigen::Vector3d, 3> upper
+            = {{vertex(r + 1, c), vertex(r, c + 1), vertex(r, c)}};
+        collideConvexTriangle(
+            shape, lower.data(), bottom, T1, faceContacts, edgeContacts);
+        collideConvexTriangle(
+            shape, upper.data(), bottom, T1, faceContacts, edgeContacts);
+      }
+    }
+  }
+
+  // The edges between two triangles that both touch the convex shape would
+  // give it spurious normals, so the edge contacts only count when the convex
+  // shape rests on edges alone, e.g., a sphere on a ridge
+  const auto& contacts = faceContacts.empty() ? edgeContacts : faceContacts;
+  if (contacts.empty())
+    return 0;
+
+  // Keep a manifold of the contact points around their average normal
+  std::vector<Eigen::Vector3d> points;
+  std::vector<double> depths;
+  Eigen::Vector3d normal = Eigen::Vector3d::Zero();
+  for (const auto& contact : contacts)
+  {
+    points.push_back(contact.point);
+    depths.push_back(contact.depth);
+    normal += contact.depth * contact.normal;
+  }
+  normal.normalize();
+
+  std::array<int, maxManifoldPoints> indices;
+  const int numContacts = reduceContactPoints(
+      points.data(),
+      depths.data(),
+      static_cast<int>(points.size()),
+      normal,
+      indices.data());
+  for (int i = 0; i < numContacts; ++i)
+  {
+    const auto& contact = contacts[indices[i]];
+    addContact(o1, o2, contact.point, contact.normal, contact.depth, result);
+  }
+
+  return numContacts;
+}
+
+template int collideConvexHeightmap<float>(
+    CollisionObject* o1,
+    CollisionObject* o2,
+    const dynamics::Shape& shape0,
+    const Eigen::Isometry3d& T0,
+    const dynamics::HeightmapShape<float>& heightmap,
+    const Eigen::Isometry3d& T1,
+    CollisionResult& result);
+
+template int collideConvexHeightmap<double>(
+    CollisionObject* o1,
+    CollisionObject* o2,
+    const dynamics::Shape& shape0,
+    const Eigen::Isometry3d& T0,
+    const dynamics::HeightmapShape<double>& heightmap,
+    const Eigen::Isometry3d& T1,
+    CollisionResult& result);
+
+} // namespace collision
+} // namespace dart
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_COLLISION_DART_DARTCONVEXCOLLIDE_HPP_
+#define DART_COLLISION_DART_DARTCONVEXCOLLIDE_HPP_
+
+#include <Eigen/Dense>
+
+#include "dart/collision/dart/DARTCollisionDetector.hpp"
+#include "dart/dynamics/HeightmapShape.hpp"
+#include "dart/dynamics/Shape.hpp"
+
+namespace dart {
+namespace collision {
+
+/// Return true if the shape can be handled by the generic convex routines,
+/// i.e., if it provides a support function. MeshShape is treated as the convex
+/// hull of its vertices.
+bool isConvexShape(dynamics::Shape::TypeId typeId);
+
+/// Penetration query between two convex shapes using their support functions.
+/// The penetration normal and depth are computed by GJK/EPA or MPR depending
+/// on \c algorithm. When both shapes touch with a face or an edge, up to four
+/// contact points are generated by clipping the touching features against
+/// each other.
+int collideConvexConvex(
+    CollisionObject* o1,
+    CollisionObject* o2,
+    const dynamics::Shape& shape0,
+    const Eigen::Isometry3d& T0,
+    const dynamics::Shape& shape1,
+    const Eigen::Isometry3d& T1,
+    CollisionResult& result,
+    DARTCollisionDetector::ConvexCollisionAlgorithm algorithm
+    = DARTCollisionDetector::GJK_EPA);
+
+/// Penetration query between a convex shape and the half-space below a plane.
+/// Every vertex of the touching feature of the convex shape that lies below
+/// the plane becomes a contact point (up to four).
+int collideConvexPlane(
+    CollisionObject* o1,
+    CollisionObject* o2,
+    const dynamics::Shape& shape0,
+    const Eigen::Isometry3d& T0,
+    const Eigen::Vector3d& plane_normal,
+    double plane_offset,
+    const Eigen::Isometry3d& T1,
+    CollisionResult& result);
+
+/// Penetration query between a convex shape and a height map. Only the cells
+/// under the bounding box of the convex shape are visited, and whole tiles of
+/// cells that are below it are skipped using the min/max height pyramid of the
+/// height map. Each triangle of the height map is the top of a column that goes
+/// down to the minimum height, so the convex shape is pushed back up even when
+/// it has sunk below the surface. The contact points of all the triangles are
+/// reduced to a manifold of up to four points.
+template <typename S>
+int collideConvexHeightmap(
+    CollisionObject* o1,
+    CollisionObject* o2,
+    const dynamics::Shape& shape0,
+    const Eigen::Isometry3d& T0,
+    const dynamics::HeightmapShape<S>& heightmap,
+    const Eigen::Isometry3d& T1,
+    CollisionResult& result);
+
+} // namespace collision
+} // namespace dart
+
+#endif // DART_COLLISION_DART_DARTCONVEXCOLLIDE_HPP_
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/collision/dart/DARTSdfCollide.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <assimp/scene.h>
+
+#include "dart/collision/CollisionObject.hpp"
+#include "dart/dynamics/BoxShape.hpp"
+#include "dart/dynamics/CapsuleShape.hpp"
+#include "dart/dynamics/EllipsoidShape.hpp"
+#include "dart/dynamics/MeshShape.hpp"
+#include "dart/dynamics/SphereShape.hpp"
+
+namespace dart {
+namespace collision {
+
+using ShapeTypeId = dynamics::Shape::TypeId;
+
+namespace {
+
+// Maximum number of contact points generated for a pair of shapes
+constexpr std::size_t maxSdfContacts = 8u;
+
+/// Sample sphere in the frame of the sampled shape
+struct SampleSphere
+{
+  Eigen::Vector3d center;
+  double radius;
+};
+
+//==============================================================================
+/// Appends the corners, the edge midpoints and the face centers of the box
+/// [-halfSize, halfSize], projected onto the ellipsoid of the same radii when
+/// \c ellipsoid is true
+void addBoxSamples(
+    const Eigen::Vector3d& halfSize,
+    bool ellipsoid,
+    std::vector<SampleSphere>& samples)
+{
+  for (int x = -1; x <= 1; ++x)
+  {
+    for (int y = -1; y <= 1; ++y)
+    {
+      for (int z = -1; z <= 1; ++z)
+      {
+        if (x == 0 && y == 0 && z == 0)
+          continue;
+
+        Eigen::Vector3d direction(x, y, z);
+        if (ellipsoid)
+          direction.normalize();
+        samples.push_back({halfSize.cwiseProduct(direction), 0.0});
+      }
+    }
+  }
+}
+
+//==============================================================================
+void computeSamples(
+    const dynamics::Shape& shape, std::vector<SampleSphere>& samples)
+{
+  switch (shape.getTypeId())
+  {
+    case ShapeTypeId::SPHERE:
+    {
+      const auto& sphere = static_cast<const dynamics::SphereShape&>(shape);
+      samples.push_back({Eigen::Vector3d::Zero(), sphere.getRadius()});
+      break;
+    }
+    case ShapeTypeId::ELLIPSOID:
+    {
+      const auto& ellipsoid
+          = static_cast<const dynamics::EllipsoidShape&>(shape);
+      if (ellipsoid.isSphere())
+        samples.push_back({Eigen::Vector3d::Zero(), ellipsoid.getRadii()[0]});
+      else
+        addBoxSamples(ellipsoid.getRadii(), true, samples);
+      break;
+    }
+    case ShapeTypeId::BOX:
+    {
+      const auto& box = static_cast<const dynamics::BoxShape&>(shape);
+      addBoxSamples(0.5 * box.getSize(), false, samples);
+      break;
+    }
+    case ShapeTypeId::CAPSULE:
+    {
+      // Overlapping spheres along the axis, at most one radius apart
+      const auto& capsule = static_cast<const dynamics::CapsuleShape&>(shape);
+      const double radius = capsule.getRadius();
+      const double height = capsule.getHeight();
+      const int numSegments
+          = std::max(1, static_cast<int>(std::ceil(height / radius)));
+      for (int i = 0; i <= numSegments; ++i)
+      {
+        const double z = height * (static_cast<double>(i) / numSegments - 0.5);
+        samples.push_back({Eigen::Vector3d(0.0, 0.0, z), radius});
+      }
+      break;
+    }
+    case ShapeTypeId::MESH:
+    {
+      const auto& mesh = static_cast<const dynamics::MeshShape&>(shape);
+      const aiScene* scene = mesh.getMesh();
+      const Eigen::Vector3d& scale = mesh.getScale();
+      for (std::size_t i = 0u; scene && i < scene->mNumMeshes; ++i)
+      {
+        const aiMesh* aiMesh = scene->mMeshes[i];
+        for (std::size_t j = 0u; j < aiMesh->mNumVertices; ++j)
+        {
+          const aiVector3D& vertex = aiMesh->mVertices[j];
+          const Eigen::Vector3d point(vertex.x, vertex.y, vertex.z);
+          samples.push_back({scale.cwiseProduct(point), 0.0});
+        }
+      }
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+} // anonymous namespace
+
+//==============================================================================
+bool isSdfSampledShape(dynamics::Shape::TypeId typeId)
+{
+  switch (typeId)
+  {
+    case ShapeTypeId::SPHERE:
+    case ShapeTypeId::ELLIPSOID:
+    case ShapeTypeId::BOX:
+    case ShapeTypeId::CAPSULE:
+    case ShapeTypeId::MESH:
+      return true;
+    default:
+      return false;
+  }
+}
+
+//==============================================================================
+int collideSdfSampled(
+    CollisionObject* o1,
+    CollisionObject* o2,
+    const dynamics::SdfShape& sdf,
+    const Eigen::Isometry3d& T0,
+    const dynamics::Shape& shape1,
+    const Eigen::Isometry3d& T1,
+    CollisionResult& result)
+{
+  // Transform from the frame of the sampled shape to the frame of the field
+  const Eigen::Isometry3d T = T0.inverse() * T1;
+
+  // Early out when the bounding sphere of the sampled shape is clear of the
+  // field
+  const auto& boundingBox = shape1.getBoundingBox();
+  const Eigen::Vector3d center
+      = 0.5 * (boundingBox.getMin() + boundingBox.getMax());
+  const double boundingRadius = 0.5 * boundingBox.computeFullExtents().norm();
+  if (sdf.getSignedDistance(T * center) > boundingRadius)
+    return 0;
+
+  std::vector<SampleSphere> samples;
+  computeSamples(shape1, samples);
+
+  struct Candidate
+  {
+    Eigen::Vector3d point;
+    Eigen::Vector3d normal;
+    double depth;
+  };
+  std::vector<Candidate> candidates;
+
+  Eigen::Vector3d gradient;
+  for (const auto& sample : samples)
+  {
+    const Eigen::Vector3d position = T * sample.center;
+    const double distance = sdf.getSignedDistance(position, &gradient);
+    const double depth = sample.radius - distance;
+    if (depth <= 0.0)
+      continue;
+
+    // Halfway between the deepest point of the sample and the surface of the
+    // field
+    const Eigen::Vector3d point
+        = position - 0.5 * (sample.radius + distance) * gradient;
+    candidates.push_back({T0 * point, -(T0.linear() * gradient), depth});
+  }
+
+  if (candidates.size() > maxSdfContacts)
+  {
+    std::partial_sort(
+        candidates.begin(),
+        candidates.begin() + maxSdfContacts,
+        candidates.end(),
+        [](const Candidate& a, const Candidate& b) {
+          return a.depth > b.depth;
+        });
+    candidates.resize(maxSdfContacts);
+  }
+
+  for (const auto& candidate : candidates)
+  {
+    Contact contact;
+    contact.collisionObject1 = o1;
+    contact.collisionObject2 = o2;
+    contact.point = candidate.point;
+    contact.normal = candidate.normal;
+    contact.penetrationDepth = candidate.depth;
+    result.addContact(contact);
+  }
+
+  return static_cast<int>(candidates.size());
+}
+
+} // namespace collision
+} // namespace dart
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_COLLISION_DART_DARTSDFCOLLIDE_HPP_
+#define DART_COLLISION_DART_DARTSDFCOLLIDE_HPP_
+
+#include <Eigen/Dense>
+
+#include "dart/collision/CollisionResult.hpp"
+#include "dart/dynamics/SdfShape.hpp"
+
+namespace dart {
+namespace collision {
+
+class CollisionObject;
+
+/// Return true if the shape can be tested against an SdfShape, i.e., if it
+/// can be represented by a set of sample spheres (points for a zero radius):
+/// spheres, ellipsoids, boxes, capsules and meshes.
+bool isSdfSampledShape(dynamics::Shape::TypeId typeId);
+
+/// Penetration query between a signed distance field and a shape represented
+/// by its sample spheres. The field is evaluated once per sample, so the cost
+/// is linear in the number of samples (e.g., the vertices of a mesh). Up to
+/// eight of the deepest samples become contact points, whose normals point
+/// from the sampled shape to the field.
+int collideSdfSampled(
+    CollisionObject* o1,
+    CollisionObject* o2,
+    const dynamics::SdfShape& sdf,
+    const Eigen::Isometry3d& T0,
+    const dynamics::Shape& shape1,
+    const Eigen::Isometry3d& T1,
+    CollisionResult& result);
+
+} // namespace collision
+} // namespace dart
+
+#endif // DART_COLLISION_DART_DARTSDFCOLLIDE_HPP_
@@ -0,0 +1,558 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/collision/dart/detail/ConvexShape.hpp"
+
+#include <array>
+#include <cmath>
+#include <limits>
+
+#include "dart/dynamics/BoxShape.hpp"
+#include "dart/dynamics/CapsuleShape.hpp"
+#include "dart/dynamics/ConeShape.hpp"
+#include "dart/dynamics/CylinderShape.hpp"
+#include "dart/dynamics/EllipsoidShape.hpp"
+#include "dart/dynamics/MeshShape.hpp"
+#include "dart/dynamics/MultiSphereConvexHullShape.hpp"
+#include "dart/dynamics/PyramidShape.hpp"
+#include "dart/dynamics/SphereShape.hpp"
+#include "dart/math/Constants.hpp"
+
+namespace dart {
+namespace collision {
+namespace detail {
+
+namespace {
+
+using ShapeTypeId = dynamics::Shape::TypeId;
+
+// Directions, in the plane orthogonal to the feature direction, in which the
+// extreme points of a feature are kept
+constexpr double halfSqrt2 = 0.70710678118654752440;
+constexpr std::array<std::array<double, 2>, maxFeaturePoints> featureDirections
+    = {{{{1.0, 0.0}},
+        {{halfSqrt2, halfSqrt2}},
+        {{0.0, 1.0}},
+        {{-halfSqrt2, halfSqrt2}},
+        {{-1.0, 0.0}},
+        {{-halfSqrt2, -halfSqrt2}},
+        {{0.0, -1.0}},
+        {{halfSqrt2, -halfSqrt2}}}};
+
+// Number of segments approximating the circular faces of cylinders and cones
+// when their contact features are computed
+constexpr int numCircleSegments = 8;
+
+//==============================================================================
+/// Keeps the extreme points of a set of points in a fixed number of
+/// directions orthogonal to \c dir, which approximates their convex hull
+/// without any allocation.
+class FeatureCollector
+{
+public:
+  FeatureCollector(const Eigen::Vector3d& dir, double minDistance);
+
+  void add(const Eigen::Vector3d& point);
+
+  int getPoints(Eigen::Vector3d* points, double tolerance) const;
+
+private:
+  Eigen::Vector3d mDir;
+  Eigen::Vector3d mU;
+  Eigen::Vector3d mV;
+  double mMinDistance;
+  std::array<double, maxFeaturePoints> mScores;
+  std::array<Eigen::Vector3d, maxFeaturePoints> mPoints;
+};
+
+//==============================================================================
+FeatureCollector::FeatureCollector(
+    const Eigen::Vector3d& dir, double minDistance)
+  : mDir(dir), mMinDistance(minDistance)
+{
+  computeOrthonormalBasis(mDir, mU, mV);
+  mScores.fill(-std::numeric_limits<double>::infinity());
+}
+
+//==============================================================================
+void FeatureCollector::add(const Eigen::Vector3d& point)
+{
+  if (point.dot(mDir) < mMinDistance)
+    return;
+
+  const double x = point.dot(mU);
+  const double y = point.dot(mV);
+  for (int i = 0; i < maxFeaturePoints; ++i)
+  {
+    const double score
+        = x * featureDirections[i][0] + y * featureDirections[i][1];
+    if (score > mScores[i])
+    {
+      mScores[i] = score;
+      mPoints[i] = point;
+    }
+  }
+}
+
+//==============================================================================
+int FeatureCollector::getPoints(Eigen::Vector3d* points, double tolerance) const
+{
+  // The extreme points are visited counterclockwise around mDir, so removing
+  // the repeated ones leaves a convex polygon
+  int numPoints = 0;
+  for (int i = 0; i < maxFeaturePoints; ++i)
+  {
+    if (!std::isfinite(mScores[i]))
+      continue;
+
+    bool repeated = false;
+    for (int j = 0; j < numPoints && !repeated; ++j)
+      repeated = (points[j] - mPoints[i]).squaredNorm()
+                 <= tolerance * tolerance;
+
+    if (!repeated)
+      points[numPoints++] = mPoints[i];
+  }
+
+  return numPoints;
+}
+
+} // anonymous namespace
+
+//==============================================================================
+void computeOrthonormalBasis(
+    const Eigen::Vector3d& dir, Eigen::Vector3d& u, Eigen::Vector3d& v)
+{
+  if (std::abs(dir[0]) < 0.57735)
+    u = Eigen::Vector3d::UnitX().cross(dir).normalized();
+  else
+    u = Eigen::Vector3d::UnitY().cross(dir).normalized();
+  v = dir.cross(u);
+}
+
+//==============================================================================
+ConvexShape::ConvexShape(
+    const dynamics::Shape& shape, const Eigen::Isometry3d& tf)
+  : mShape(&shape),
+    mPoints(nullptr),
+    mNumPoints(0),
+    mTypeId(shape.getTypeId()),
+    mTransform(tf),
+    mSize(shape.getBoundingBox().computeFullExtents().norm())
+{
+  // Do nothing
+}
+
+//==============================================================================
+ConvexShape::ConvexShape(
+    const Eigen::Vector3d* points, int numPoints, const Eigen::Isometry3d& tf)
+  : mShape(nullptr),
+    mPoints(points),
+    mNumPoints(numPoints),
+    mTypeId(ShapeTypeId::OTHER),
+    mTransform(tf),
+    mSize(0.0)
+{
+  assert(numPoints > 0);
+
+  Eigen::Vector3d min = points[0];
+  Eigen::Vector3d max = points[0];
+  for (int i = 1; i < numPoints; ++i)
+  {
+    min = min.cwiseMin(points[i]);
+    max = max.cwiseMax(points[i]);
+  }
+  mSize = (max - min).norm();
+}
+
+//==============================================================================
+Eigen::Vector3d ConvexShape::support(const Eigen::Vector3d& dir) const
+{
+  return mTransform
+         * computeLocalSupport(mTransform.linear().transpose() * dir);
+}
+
+//==============================================================================
+Eigen::Vector3d ConvexShape::center() const
+{
+  if (mTypeId == ShapeTypeId::OTHER)
+  {
+    Eigen::Vector3d sum = Eigen::Vector3d::Zero();
+    for (int i = 0; i < mNumPoints; ++i)
+      sum += mPoints[i];
+
+    return mTransform * (sum / static_cast<double>(mNumPoints));
+  }
+
+  if (mTypeId == ShapeTypeId::MULTISPHERE_CONVEX_HULL)
+  {
+    const auto& spheres
+        = static_cast<const dynamics::MultiSphereConvexHullShape&>(*mShape)
+              .getSpheres();
+
+    Eigen::Vector3d sum = Eigen::Vector3d::Zero();
+    for (const auto& sphere : spheres)
+      sum += sphere.second;
+    if (!spheres.empty())
+      sum /= static_cast<double>(spheres.size());
+
+    return mTransform * sum;
+  }
+
+  if (mTypeId == ShapeTypeId::MESH)
+  {
+    const auto& mesh = static_cast<const dynamics::MeshShape&>(*mShape);
+    const aiScene* scene = mesh.getMesh();
+
+    Eigen::Vector3d sum = Eigen::Vector3d::Zero();
+    std::size_t count = 0u;
+    for (std::size_t i = 0u; scene && i < scene->mNumMeshes; ++i)
+    {
+      const aiMesh* aiMesh = scene->mMeshes[i];
+      for (std::size_t j = 0u; j < aiMesh->mNumVertices; ++j)
+      {
+        const aiVector3D& vertex = aiMesh->mVertices[j];
+        sum += Eigen::Vector3d(vertex.x, vertex.y, vertex.z);
+      }
+      count += aiMesh->mNumVertices;
+    }
+    if (count > 0u)
+      sum = mesh.getScale().cwiseProduct(sum / static_cast<double>(count));
+
+    return mTransform * sum;
+  }
+
+  // The other shapes are centered at the origin of their frame
+  return mTransform.translation();
+}
+
+//==============================================================================
+double ConvexShape::getSize() const
+{
+  return mSize;
+}
+
+//==============================================================================
+Eigen::Vector3d ConvexShape::computeLocalSupport(
+    const Eigen::Vector3d& dir) const
+{
+  switch (mTypeId)
+  {
+    case ShapeTypeId::SPHERE:
+    {
+      const double radius
+          = static_cast<const dynamics::SphereShape&>(*mShape).getRadius();
+      const double norm = dir.norm();
+      if (norm < std::sqrt(degenerateTolerance))
+        return Eigen::Vector3d(radius, 0.0, 0.0);
+      return (radius / norm) * dir;
+    }
+    case ShapeTypeId::ELLIPSOID:
+    {
+      const Eigen::Vector3d radii
+          = static_cast<const dynamics::EllipsoidShape&>(*mShape).getRadii();
+      const Eigen::Vector3d scaled = radii.cwiseProduct(dir);
+      const double norm = scaled.norm();
+      if (norm < std::sqrt(degenerateTolerance))
+        return Eigen::Vector3d(radii[0], 0.0, 0.0);
+      return radii.cwiseProduct(scaled) / norm;
+    }
+    case ShapeTypeId::BOX:
+    {
+      const Eigen::Vector3d halfSize
+          = 0.5 * static_cast<const dynamics::BoxShape&>(*mShape).getSize();
+      return Eigen::Vector3d(
+          dir[0] < 0.0 ? -halfSize[0] : halfSize[0],
+          dir[1] < 0.0 ? -halfSize[1] : halfSize[1],
+          dir[2] < 0.0 ? -halfSize[2] : halfSize[2]);
+    }
+    case ShapeTypeId::CYLINDER:
+    {
+      const auto& cylinder
+          = static_cast<const dynamics::CylinderShape&>(*mShape);
+      const double radius = cylinder.getRadius();
+      const double halfHeight = 0.5 * cylinder.getHeight();
+      const double radial = std::hypot(dir[0], dir[1]);
+      Eigen::Vector3d point(0.0, 0.0, dir[2] < 0.0 ? -halfHeight : halfHeight);
+      if (radial > std::sqrt(degenerateTolerance))
+      {
+        point[0] = radius * dir[0] / radial;
+        point[1] = radius * dir[1] / radial;
+      }
+      return point;
+    }
+    case ShapeTypeId::CAPSULE:
+    {
+      const auto& capsule = static_cast<const dynamics::CapsuleShape&>(*mShape);
+      const double radius = capsule.getRadius();
+      const double halfHeight = 0.5 * capsule.getHeight();
+      const double norm = dir.norm();
+      Eigen::Vector3d point(0.0, 0.0, dir[2] < 0.0 ? -halfHeight : halfHeight);
+      if (norm > std::sqrt(degenerateTolerance))
+        point += (radius / norm) * dir;
+      return point;
+    }
+    case ShapeTypeId::CONE:
+    {
+      const auto& cone = static_cast<const dynamics::ConeShape&>(*mShape);
+      const double radius = cone.getRadius();
+      const double halfHeight = 0.5 * cone.getHeight();
+      const double radial = std::hypot(dir[0], dir[1]);
+      Eigen::Vector3d rim(0.0, 0.0, -halfHeight);
+      if (radial > std::sqrt(degenerateTolerance))
+      {
+        rim[0] = radius * dir[0] / radial;
+        rim[1] = radius * dir[1] / radial;
+      }
+      const Eigen::Vector3d apex(0.0, 0.0, halfHeight);
+      return apex.dot(dir) > rim.dot(dir) ? apex : rim;
+    }
+    case ShapeTypeId::PYRAMID:
+    {
+      const auto& pyramid = static_cast<const dynamics::PyramidShape&>(*mShape);
+      const double halfHeight = 0.5 * pyramid.getHeight();
+      const Eigen::Vector3d apex(0.0, 0.0, halfHeight);
+      const Eigen::Vector3d base(
+          dir[0] < 0.0 ? -0.5 * pyramid.getBaseWidth()
+                       : 0.5 * pyramid.getBaseWidth(),
+          dir[1] < 0.0 ? -0.5 * pyramid.getBaseDepth()
+                       : 0.5 * pyramid.getBaseDepth(),
+          -halfHeight);
+      return apex.dot(dir) > base.dot(dir) ? apex : base;
+    }
+    case ShapeTypeId::MULTISPHERE_CONVEX_HULL:
+    {
+      const auto& spheres
+          = static_cast<const dynamics::MultiSphereConvexHullShape&>(*mShape)
+                .getSpheres();
+      const double norm = dir.norm();
+      const Eigen::Vector3d unitDir = norm > std::sqrt(degenerateTolerance)
+                                          ? Eigen::Vector3d(dir / norm)
+                                          : Eigen::Vector3d::UnitX();
+
+      Eigen::Vector3d best = Eigen::Vector3d::Zero();
+      double maxDistance = -std::numeric_limits<double>::infinity();
+      for (const auto& sphere : spheres)
+      {
+        const Eigen::Vector3d point = sphere.second + sphere.first * unitDir;
+        const double distance = point.dot(unitDir);
+        if (distance > maxDistance)
+        {
+          maxDistance = distance;
+          best = point;
+        }
+      }
+      return best;
+    }
+    case ShapeTypeId::MESH:
+    {
+      const auto& mesh = static_cast<const dynamics::MeshShape&>(*mShape);
+      const aiScene* scene = mesh.getMesh();
+
+      // Scaling the direction instead of the vertices gives the same maximum
+      const Eigen::Vector3d& scale = mesh.getScale();
+      const Eigen::Vector3d scaledDir = scale.cwiseProduct(dir);
+
+      Eigen::Vector3d best = Eigen::Vector3d::Zero();
+      double maxDistance = -std::numeric_limits<double>::infinity();
+      for (std::size_t i = 0u; scene && i < scene->mNumMeshes; ++i)
+      {
+        const aiMesh* aiMesh = scene->mMeshes[i];
+        for (std::size_t j = 0u; j < aiMesh->mNumVertices; ++j)
+        {
+          const aiVector3D& vertex = aiMesh->mVertices[j];
+          const double distance = vertex.x * scaledDir[0]
+                                  + vertex.y * scaledDir[1]
+                                  + vertex.z * scaledDir[2];
+          if (distance > maxDistance)
+          {
+            maxDistance = distance;
+            best = Eigen::Vector3d(vertex.x, vertex.y, vertex.z);
+          }
+        }
+      }
+      return scale.cwiseProduct(best);
+    }
+    case ShapeTypeId::OTHER:
+    {
+      int best = 0;
+      for (int i = 1; i < mNumPoints; ++i)
+      {
+        if (mPoints[i].dot(dir) > mPoints[best].dot(dir))
+          best = i;
+      }
+      return mPoints[best];
+    }
+    default:
+      return Eigen::Vector3d::Zero();
+  }
+}
+
+//==============================================================================
+template <typename Visitor>
+void ConvexShape::visitFeatureCandidates(
+    const Eigen::Vector3d& dir, Visitor&& visitor) const
+{
+  switch (mTypeId)
+  {
+    case ShapeTypeId::BOX:
+    {
+      const Eigen::Vector3d halfSize
+          = 0.5 * static_cast<const dynamics::BoxShape&>(*mShape).getSize();
+      for (int i = 0; i < 8; ++i)
+      {
+        visitor(Eigen::Vector3d(
+            (i & 1) ? halfSize[0] : -halfSize[0],
+            (i & 2) ? halfSize[1] : -halfSize[1],
+            (i & 4) ? halfSize[2] : -halfSize[2]));
+      }
+      break;
+    }
+    case ShapeTypeId::CYLINDER:
+    case ShapeTypeId::CONE:
+    {
+      double radius;
+      double halfHeight;
+      if (mTypeId == ShapeTypeId::CYLINDER)
+      {
+        const auto& cylinder
+            = static_cast<const dynamics::CylinderShape&>(*mShape);
+        radius = cylinder.getRadius();
+        halfHeight = 0.5 * cylinder.getHeight();
+      }
+      else
+      {
+        const auto& cone = static_cast<const dynamics::ConeShape&>(*mShape);
+        radius = cone.getRadius();
+        halfHeight = 0.5 * cone.getHeight();
+        visitor(Eigen::Vector3d(0.0, 0.0, halfHeight));
+      }
+
+      // Start the polygons at the support direction so that the side lines
+      // are part of the candidates
+      const double startAngle = std::atan2(dir[1], dir[0]);
+      for (int i = 0; i < numCircleSegments; ++i)
+      {
+        const double angle
+            = startAngle + 2.0 * math::constantsd::pi() * i / numCircleSegments;
+        const double x = radius * std::cos(angle);
+        const double y = radius * std::sin(angle);
+        visitor(Eigen::Vector3d(x, y, -halfHeight));
+        if (mTypeId == ShapeTypeId::CYLINDER)
+          visitor(Eigen::Vector3d(x, y, halfHeight));
+      }
+      break;
+    }
+    case ShapeTypeId::CAPSULE:
+    {
+      const auto& capsule = static_cast<const dynamics::CapsuleShape&>(*mShape);
+      const Eigen::Vector3d offset = capsule.getRadius() * dir;
+      const double halfHeight = 0.5 * capsule.getHeight();
+      visitor(Eigen::Vector3d(0.0, 0.0, -halfHeight) + offset);
+      visitor(Eigen::Vector3d(0.0, 0.0, halfHeight) + offset);
+      break;
+    }
+    case ShapeTypeId::PYRAMID:
+    {
+      const auto& pyramid = static_cast<const dynamics::PyramidShape&>(*mShape);
+      const double halfWidth = 0.5 * pyramid.getBaseWidth();
+      const double halfDepth = 0.5 * pyramid.getBaseDepth();
+      const double halfHeight = 0.5 * pyramid.getHeight();
+      visitor(Eigen::Vector3d(0.0, 0.0, halfHeight));
+      visitor(Eigen::Vector3d(halfWidth, halfDepth, -halfHeight));
+      visitor(Eigen::Vector3d(-halfWidth, halfDepth, -halfHeight));
+      visitor(Eigen::Vector3d(-halfWidth, -halfDepth, -halfHeight));
+      visitor(Eigen::Vector3d(halfWidth, -halfDepth, -halfHeight));
+      break;
+    }
+    case ShapeTypeId::MULTISPHERE_CONVEX_HULL:
+    {
+      const auto& spheres
+          = static_cast<const dynamics::MultiSphereConvexHullShape&>(*mShape)
+                .getSpheres();
+      for (const auto& sphere : spheres)
+        visitor(sphere.second + sphere.first * dir);
+      break;
+    }
+    case ShapeTypeId::MESH:
+    {
+      const auto& mesh = static_cast<const dynamics::MeshShape&>(*mShape);
+      const aiScene* scene = mesh.getMesh();
+      const Eigen::Vector3d& scale = mesh.getScale();
+      for (std::size_t i = 0u; scene && i < scene->mNumMeshes; ++i)
+      {
+        const aiMesh* aiMesh = scene->mMeshes[i];
+        for (std::size_t j = 0u; j < aiMesh->mNumVertices; ++j)
+        {
+          const aiVector3D& vertex = aiMesh->mVertices[j];
+          visitor(scale.cwiseProduct(
+              Eigen::Vector3d(vertex.x, vertex.y, vertex.z)));
+        }
+      }
+      break;
+    }
+    case ShapeTypeId::OTHER:
+    {
+      for (int i = 0; i < mNumPoints; ++i)
+        visitor(mPoints[i]);
+      break;
+    }
+    default:
+      // Spheres and ellipsoids only touch with a single point
+      break;
+  }
+}
+
+//==============================================================================
+int ConvexShape::computeFeature(
+    const Eigen::Vector3d& dir, Eigen::Vector3d* points) const
+{
+  const Eigen::Vector3d localDir = mTransform.linear().transpose() * dir;
+  const Eigen::Vector3d localSupport = computeLocalSupport(localDir);
+
+  FeatureCollector collector(
+      localDir, localSupport.dot(localDir) - featureTolerance * mSize);
+  collector.add(localSupport);
+  visitFeatureCandidates(
+      localDir, [&](const Eigen::Vector3d& point) { collector.add(point); });
+
+  const int numPoints
+      = collector.getPoints(points, penetrationTolerance * mSize);
+  for (int i = 0; i < numPoints; ++i)
+    points[i] = mTransform * points[i];
+
+  return numPoints;
+}
+
+} // namespace detail
+} // namespace collision
+} // namespace dart
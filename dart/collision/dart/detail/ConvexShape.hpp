@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_COLLISION_DART_DETAIL_CONVEXSHAPE_HPP_
+#define DART_COLLISION_DART_DETAIL_CONVEXSHAPE_HPP_
+
+#include <Eigen/Geometry>
+
+#include "dart/dynamics/Shape.hpp"
+
+namespace dart {
+namespace collision {
+namespace detail {
+
+// Maximum number of vertices describing the feature (vertex, edge or face) of
+// a shape that touches the other shape
+constexpr int maxFeaturePoints = 8;
+
+// Vertices closer than this fraction of the shape size to the supporting
+// plane are considered to be part of the touching feature
+constexpr double featureTolerance = 1e-2;
+
+// Tolerance of the penetration depth, relative to the size of the shapes
+constexpr double penetrationTolerance = 1e-6;
+
+// Squared length below which a direction is considered degenerate
+constexpr double degenerateTolerance = 1e-24;
+
+/// Compute two unit vectors that form a right-handed orthonormal basis with
+/// the unit vector \c dir
+void computeOrthonormalBasis(
+    const Eigen::Vector3d& dir, Eigen::Vector3d& u, Eigen::Vector3d& v);
+
+//==============================================================================
+/// Convex shape placed in the world, described by its support function
+class ConvexShape
+{
+public:
+  ConvexShape(const dynamics::Shape& shape, const Eigen::Isometry3d& tf);
+
+  /// Constructor for the convex hull of a set of points given in the frame
+  /// \c tf, e.g., a triangle of a height map
+  ConvexShape(
+      const Eigen::Vector3d* points,
+      int numPoints,
+      const Eigen::Isometry3d& tf);
+
+  /// Return the point of the shape furthest along \c dir
+  Eigen::Vector3d support(const Eigen::Vector3d& dir) const;
+
+  /// Return a point inside of the shape
+  Eigen::Vector3d center() const;
+
+  /// Compute the vertices of the feature furthest along the unit vector
+  /// \c dir, ordered counterclockwise around \c dir. Curved faces are
+  /// approximated by polygons.
+  int computeFeature(const Eigen::Vector3d& dir, Eigen::Vector3d* points) const;
+
+  /// Return the diagonal length of the bounding box of the shape
+  double getSize() const;
+
+private:
+  Eigen::Vector3d computeLocalSupport(const Eigen::Vector3d& dir) const;
+
+  template <typename Visitor>
+  void visitFeatureCandidates(
+      const Eigen::Vector3d& dir, Visitor&& visitor) const;
+
+  /// Shape, or nullptr for the convex hull of mPoints
+  const dynamics::Shape* mShape;
+
+  const Eigen::Vector3d* mPoints;
+
+  int mNumPoints;
+
+  dynamics::Shape::TypeId mTypeId;
+
+  const Eigen::Isometry3d& mTransform;
+
+  double mSize;
+};
+
+} // namespace detail
+} // namespace collision
+} // namespace dart
+
+#endif // DART_COLLISION_DART_DETAIL_CONVEXSHAPE_HPP_
@@ -0,0 +1,305 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/collision/dart/detail/Epa.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace dart {
+namespace collision {
+namespace detail {
+
+namespace {
+
+constexpr int maxEpaIterations = 64;
+constexpr int maxEpaVertices = maxEpaIterations + 4;
+constexpr int maxEpaFaces = 4 * maxEpaVertices;
+constexpr int maxEpaHorizonEdges = 2 * maxEpaVertices;
+
+//==============================================================================
+/// Turn the simplex found by GJK into a tetrahedron when the origin lies on
+/// one of its lower dimensional features
+bool completeSimplex(const MinkowskiDifference& md, Simplex& simplex, int& size)
+{
+  const double tolerance = penetrationTolerance * md.getSize();
+
+  if (size == 1)
+  {
+    for (int i = 0; i < 6 && size == 1; ++i)
+    {
+      Eigen::Vector3d dir = Eigen::Vector3d::Zero();
+      dir[i / 2] = (i % 2) ? -1.0 : 1.0;
+      const SupportPoint point = md.support(dir);
+      if ((point.w - simplex[0].w).norm() > tolerance)
+        simplex[size++] = point;
+    }
+  }
+
+  if (size == 2)
+  {
+    const Eigen::Vector3d line = (simplex[1].w - simplex[0].w).normalized();
+    Eigen::Vector3d u;
+    Eigen::Vector3d v;
+    computeOrthonormalBasis(line, u, v);
+    const std::array<Eigen::Vector3d, 4> dirs = {{u, -u, v, -v}};
+    for (int i = 0; i < 4 && size == 2; ++i)
+    {
+      const SupportPoint point = md.support(dirs[i]);
+      const Eigen::Vector3d offset = point.w - simplex[0].w;
+      if ((offset - offset.dot(line) * line).norm() > tolerance)
+        simplex[size++] = point;
+    }
+  }
+
+  if (size == 3)
+  {
+    const Eigen::Vector3d normal
+        = (simplex[1].w - simplex[0].w)
+              .cross(simplex[2].w - simplex[0].w)
+              .normalized();
+    for (int i = 0; i < 2 && size == 3; ++i)
+    {
+      const SupportPoint point = md.support(i == 0 ? normal : -normal);
+      if (std::abs(normal.dot(point.w - simplex[0].w)) > tolerance)
+        simplex[size++] = point;
+    }
+  }
+
+  return size == 4;
+}
+
+//==============================================================================
+struct EpaFace
+{
+  std::array<int, 3> vertices;
+  Eigen::Vector3d normal;
+  double distance;
+  bool alive;
+};
+
+//==============================================================================
+template <typename Vertices>
+EpaFace makeEpaFace(const Vertices& vertices, int i0, int i1, int i2)
+{
+  EpaFace face;
+  face.vertices = {{i0, i1, i2}};
+  face.normal = (vertices[i1].w - vertices[i0].w)
+                    .cross(vertices[i2].w - vertices[i0].w);
+  face.alive = true;
+
+  const double norm = face.normal.norm();
+  if (norm * norm < degenerateTolerance)
+  {
+    // Never expanded nor visible
+    face.normal.setZero();
+    face.distance = std::numeric_limits<double>::infinity();
+    return face;
+  }
+
+  face.normal /= norm;
+  face.distance = face.normal.dot(vertices[i0].w);
+  return face;
+}
+
+} // anonymous namespace
+
+//==============================================================================
+bool runEpa(
+    const MinkowskiDifference& md,
+    Simplex& simplex,
+    int size,
+    Penetration& penetration)
+{
+  if (!completeSimplex(md, simplex, size))
+    return false;
+
+  std::array<SupportPoint, maxEpaVertices> vertices;
+  std::array<EpaFace, maxEpaFaces> faces;
+  std::array<std::pair<int, int>, maxEpaHorizonEdges> edges;
+  std::array<int, maxEpaFaces> visibleFaces;
+
+  for (int i = 0; i < 4; ++i)
+    vertices[i] = simplex[i];
+
+  // Orient the tetrahedron so that the faces below point outwards
+  const double volume = (vertices[1].w - vertices[0].w)
+                            .cross(vertices[2].w - vertices[0].w)
+                            .dot(vertices[3].w - vertices[0].w);
+  if (std::abs(volume) < degenerateTolerance)
+    return false;
+  if (volume > 0.0)
+    std::swap(vertices[1], vertices[2]);
+
+  int numVertices = 4;
+  int numFaces = 0;
+  faces[numFaces++] = makeEpaFace(vertices, 0, 1, 2);
+  faces[numFaces++] = makeEpaFace(vertices, 0, 3, 1);
+  faces[numFaces++] = makeEpaFace(vertices, 0, 2, 3);
+  faces[numFaces++] = makeEpaFace(vertices, 1, 3, 2);
+  int numAliveFaces = numFaces;
+
+  const double tolerance = penetrationTolerance * md.getSize();
+  int closest = 0;
+
+  for (int iteration = 0; iteration < maxEpaIterations; ++iteration)
+  {
+    closest = -1;
+    for (int i = 0; i < numFaces; ++i)
+    {
+      if (faces[i].alive
+          && (closest < 0 || faces[i].distance < faces[closest].distance))
+      {
+        closest = i;
+      }
+    }
+
+    if (closest < 0 || !std::isfinite(faces[closest].distance))
+      return false;
+
+    const EpaFace& face = faces[closest];
+    const SupportPoint point = md.support(face.normal);
+    if (point.w.dot(face.normal) - face.distance < tolerance)
+      break;
+
+    if (numVertices == maxEpaVertices)
+      break;
+
+    // Collect the faces that can see the new point and the boundary of the
+    // hole their removal leaves. The polytope is only modified once there is
+    // room for the new faces: bailing out of a half-updated polytope could
+    // leave a hole and report a face that isn't on its boundary.
+    int numVisible = 0;
+    int numEdges = 0;
+    bool overflow = false;
+    for (int i = 0; i < numFaces && !overflow; ++i)
+    {
+      const EpaFace& visible = faces[i];
+      if (!visible.alive
+          || visible.normal.dot(point.w - vertices[visible.vertices[0]].w)
+                 <= 0.0)
+      {
+        continue;
+      }
+
+      visibleFaces[numVisible++] = i;
+      for (int j = 0; j < 3; ++j)
+      {
+        const std::pair<int, int> edge(
+            visible.vertices[j], visible.vertices[(j + 1) % 3]);
+
+        int shared = -1;
+        for (int k = 0; k < numEdges && shared < 0; ++k)
+        {
+          if (edges[k].first == edge.second && edges[k].second == edge.first)
+            shared = k;
+        }
+
+        if (shared >= 0)
+        {
+          edges[shared] = edges[--numEdges];
+        }
+        else if (numEdges < maxEpaHorizonEdges)
+        {
+          edges[numEdges++] = edge;
+        }
+        else
+        {
+          overflow = true;
+          break;
+        }
+      }
+    }
+
+    // Stop with the current polytope, whose closest face is still a lower
+    // bound of the penetration depth
+    if (overflow || numAliveFaces - numVisible + numEdges > maxEpaFaces)
+      break;
+
+    for (int i = 0; i < numVisible; ++i)
+      faces[visibleFaces[i]].alive = false;
+    numAliveFaces -= numVisible;
+
+    // Compact the removed faces away when running out of space
+    if (numFaces + numEdges > maxEpaFaces)
+    {
+      numFaces = static_cast<int>(
+          std::remove_if(
+              faces.begin(),
+              faces.begin() + numFaces,
+              [](const EpaFace& f) { return !f.alive; })
+          - faces.begin());
+    }
+
+    const int newVertex = numVertices++;
+    vertices[newVertex] = point;
+    for (int i = 0; i < numEdges; ++i)
+    {
+      faces[numFaces++] = makeEpaFace(
+          vertices, edges[i].first, edges[i].second, newVertex);
+    }
+    numAliveFaces += numEdges;
+  }
+
+  // The loop may exit before the closest face of the last expansion was
+  // searched, in which case it is searched again
+  closest = -1;
+  for (int i = 0; i < numFaces; ++i)
+  {
+    if (faces[i].alive
+        && (closest < 0 || faces[i].distance < faces[closest].distance))
+    {
+      closest = i;
+    }
+  }
+
+  if (closest < 0 || !std::isfinite(faces[closest].distance))
+    return false;
+
+  const EpaFace& face = faces[closest];
+  setPenetrationFromTriangle(
+      vertices[face.vertices[0]],
+      vertices[face.vertices[1]],
+      vertices[face.vertices[2]],
+      penetration);
+  penetration.normal = face.normal;
+  penetration.depth = face.distance;
+
+  return true;
+}
+
+} // namespace detail
+} // namespace collision
+} // namespace dart
@@ -0,0 +1,401 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/collision/dart/detail/Gjk.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <Eigen/LU>
+
+namespace dart {
+namespace collision {
+namespace detail {
+
+namespace {
+
+constexpr int maxGjkIterations = 64;
+
+//==============================================================================
+/// Reduce the simplex to the feature closest to the origin and update the
+/// search direction. Return true if the simplex encloses or touches the origin.
+bool updateSimplex(Simplex& simplex, int& size, Eigen::Vector3d& dir)
+{
+  // The newest point is always the last one
+  if (size == 2)
+  {
+    const SupportPoint& a = simplex[1];
+    const Eigen::Vector3d ab = simplex[0].w - a.w;
+    const Eigen::Vector3d ao = -a.w;
+
+    if (ab.dot(ao) > 0.0)
+    {
+      dir = ab.cross(ao).cross(ab);
+      return isDegenerate(dir);
+    }
+
+    simplex[0] = a;
+    size = 1;
+    dir = ao;
+    return false;
+  }
+
+  if (size == 3)
+  {
+    const SupportPoint a = simplex[2];
+    const SupportPoint b = simplex[1];
+    const SupportPoint c = simplex[0];
+    const Eigen::Vector3d ab = b.w - a.w;
+    const Eigen::Vector3d ac = c.w - a.w;
+    const Eigen::Vector3d ao = -a.w;
+    const Eigen::Vector3d abc = ab.cross(ac);
+
+    if (abc.cross(ac).dot(ao) > 0.0)
+    {
+      if (ac.dot(ao) > 0.0)
+      {
+        simplex[0] = c;
+        simplex[1] = a;
+        size = 2;
+        dir = ac.cross(ao).cross(ac);
+        return isDegenerate(dir);
+      }
+    }
+    else if (ab.cross(abc).dot(ao) <= 0.0)
+    {
+      // The origin projects inside of the triangle
+      const double side = abc.dot(ao);
+      if (side > 0.0)
+      {
+        dir = abc;
+      }
+      else if (side < 0.0)
+      {
+        simplex[0] = b;
+        simplex[1] = c;
+        dir = -abc;
+      }
+      else
+      {
+        return true;
+      }
+      return isDegenerate(dir);
+    }
+
+    if (ab.dot(ao) > 0.0)
+    {
+      simplex[0] = b;
+      simplex[1] = a;
+      size = 2;
+      dir = ab.cross(ao).cross(ab);
+      return isDegenerate(dir);
+    }
+
+    simplex[0] = a;
+    size = 1;
+    dir = ao;
+    return false;
+  }
+
+  // Tetrahedron: the origin is known to be on the inner side of the face that
+  // doesn't contain the newest point, so only the other three are checked.
+  const SupportPoint& a = simplex[3];
+  const Eigen::Vector3d ao = -a.w;
+  for (int i = 0; i < 3; ++i)
+  {
+    const SupportPoint& p = simplex[i];
+    const SupportPoint& q = simplex[(i + 1) % 3];
+    const SupportPoint& r = simplex[(i + 2) % 3];
+
+    Eigen::Vector3d normal = (p.w - a.w).cross(q.w - a.w);
+    if (normal.dot(r.w - a.w) > 0.0)
+      normal = -normal;
+
+    if (normal.dot(ao) > 0.0)
+    {
+      const SupportPoint newP = p;
+      const SupportPoint newQ = q;
+      const SupportPoint newA = a;
+      simplex[0] = newQ;
+      simplex[1] = newP;
+      simplex[2] = newA;
+      size = 3;
+      return updateSimplex(simplex, size, dir);
+    }
+  }
+
+  return true;
+}
+
+//==============================================================================
+/// Keep the points of the simplex whose weight is positive
+void compactSimplex(Simplex& simplex, std::array<double, 4>& weights, int& size)
+{
+  int numKept = 0;
+  for (int i = 0; i < size; ++i)
+  {
+    if (weights[i] > 0.0)
+    {
+      simplex[numKept] = simplex[i];
+      weights[numKept] = weights[i];
+      ++numKept;
+    }
+  }
+  size = numKept;
+}
+
+//==============================================================================
+/// Return the point closest to the origin of the simplex whose points are
+/// translated by \c offset, and reduce the simplex to the points needed to
+/// express it, whose barycentric weights are set. A tetrahedron that encloses
+/// the origin is kept whole.
+Eigen::Vector3d reduceToClosestPoint(
+    Simplex& simplex,
+    std::array<double, 4>& weights,
+    int& size,
+    const Eigen::Vector3d& offset)
+{
+  std::array<Eigen::Vector3d, 4> points;
+  for (int i = 0; i < size; ++i)
+    points[i] = simplex[i].w + offset;
+
+  if (size == 1)
+  {
+    weights[0] = 1.0;
+    return points[0];
+  }
+
+  if (size == 2)
+  {
+    const Eigen::Vector3d segment = points[1] - points[0];
+    double t = 1.0;
+    if (!isDegenerate(segment))
+    {
+      t = -points[0].dot(segment) / segment.squaredNorm();
+      t = std::min(1.0, std::max(0.0, t));
+    }
+    weights[0] = 1.0 - t;
+    weights[1] = t;
+    compactSimplex(simplex, weights, size);
+    return points[0] + t * segment;
+  }
+
+  if (size == 3)
+  {
+    Eigen::Vector3d barycentric;
+    const Eigen::Vector3d closest = computeClosestPointToOrigin(
+        points[0], points[1], points[2], barycentric);
+    for (int i = 0; i < 3; ++i)
+      weights[i] = barycentric[i];
+    compactSimplex(simplex, weights, size);
+    return closest;
+  }
+
+  // Tetrahedron: the closest point lies on one of the faces that the origin is
+  // outside of, if any
+  const double volume = (points[1] - points[0])
+                            .cross(points[2] - points[0])
+                            .dot(points[3] - points[0]);
+  const bool flat = std::abs(volume) < degenerateTolerance;
+  bool inside = !flat;
+  double minSquaredDistance = std::numeric_limits<double>::infinity();
+  Eigen::Vector3d closest = Eigen::Vector3d::Zero();
+  std::array<double, 4> closestWeights = {{0.0, 0.0, 0.0, 0.0}};
+  for (int i = 0; i < 4; ++i)
+  {
+    // Face opposite to point i
+    const int i0 = (i + 1) % 4;
+    const int i1 = (i + 2) % 4;
+    const int i2 = (i + 3) % 4;
+    Eigen::Vector3d faceNormal
+        = (points[i1] - points[i0]).cross(points[i2] - points[i0]);
+    if (faceNormal.dot(points[i] - points[i0]) > 0.0)
+      faceNormal = -faceNormal;
+    if (!flat && faceNormal.dot(points[i0]) >= 0.0)
+      continue;
+    inside = false;
+
+    Eigen::Vector3d barycentric;
+    const Eigen::Vector3d point = computeClosestPointToOrigin(
+        points[i0], points[i1], points[i2], barycentric);
+    if (point.squaredNorm() < minSquaredDistance)
+    {
+      minSquaredDistance = point.squaredNorm();
+      closest = point;
+      closestWeights.fill(0.0);
+      closestWeights[i0] = barycentric[0];
+      closestWeights[i1] = barycentric[1];
+      closestWeights[i2] = barycentric[2];
+    }
+  }
+
+  if (inside)
+  {
+    // Barycentric coordinates of the origin
+    Eigen::Matrix3d edges;
+    for (int i = 0; i < 3; ++i)
+      edges.col(i) = points[i + 1] - points[0];
+    const Eigen::Vector3d coordinates = edges.inverse() * -points[0];
+    weights[0] = 1.0 - coordinates.sum();
+    for (int i = 0; i < 3; ++i)
+      weights[i + 1] = coordinates[i];
+    return Eigen::Vector3d::Zero();
+  }
+
+  weights = closestWeights;
+  compactSimplex(simplex, weights, size);
+  return closest;
+}
+
+} // anonymous namespace
+
+//==============================================================================
+bool runGjk(const MinkowskiDifference& md, Simplex& simplex, int& size)
+{
+  Eigen::Vector3d dir = md.center().w;
+  if (isDegenerate(dir))
+    dir = Eigen::Vector3d::UnitX();
+
+  simplex[0] = md.support(dir);
+  size = 1;
+  dir = -simplex[0].w;
+  if (isDegenerate(dir))
+    return true;
+
+  for (int i = 0; i < maxGjkIterations; ++i)
+  {
+    const SupportPoint point = md.support(dir);
+    if (point.w.dot(dir) < 0.0)
+      return false;
+
+    simplex[size++] = point;
+    if (updateSimplex(simplex, size, dir))
+      return true;
+  }
+
+  // GJK cycles when the origin is within round-off of the boundary of the
+  // Minkowski difference. Reporting a separation would let the shapes sink
+  // into each other, so the shapes are assumed to intersect and EPA, which
+  // expands the simplex until it reaches the boundary, measures the depth.
+  return true;
+}
+
+//==============================================================================
+bool castGjk(
+    const MinkowskiDifference& md,
+    const Eigen::Vector3d& motion,
+    double& fraction,
+    Eigen::Vector3d& normal,
+    Eigen::Vector3d& point,
+    double margin)
+{
+  // A moved by fraction * motion meets B when the origin enters the Minkowski
+  // difference moved along with it. The fraction only ever grows, each time
+  // up to a support plane that still separates the origin from the moved
+  // difference, so it never passes the time of impact. The margin inflates A
+  // by a ball, which moves its support plane towards the origin.
+  const double tolerance = penetrationTolerance * md.getSize();
+
+  Simplex simplex;
+  std::array<double, 4> weights;
+  int size = 0;
+  Eigen::Vector3d offset = Eigen::Vector3d::Zero();
+  Eigen::Vector3d dir = md.center().w;
+  bool moved = false;
+  fraction = 0.0;
+
+  for (int i = 0; i < maxGjkIterations; ++i)
+  {
+    if (dir.squaredNorm() <= tolerance * tolerance)
+      break;
+
+    const SupportPoint support = md.support(-dir);
+    const double distance
+        = dir.dot(support.w + offset) - margin * dir.norm();
+    bool progress = false;
+    if (distance > 0.0)
+    {
+      const double approach = dir.dot(motion);
+      if (approach >= 0.0)
+        return false;
+
+      fraction -= distance / approach;
+      if (fraction > 1.0)
+        return false;
+
+      offset = fraction * motion;
+      normal = dir;
+      moved = true;
+      progress = true;
+    }
+
+    bool repeated = false;
+    for (int j = 0; j < size && !repeated; ++j)
+      repeated = (simplex[j].w - support.w).squaredNorm()
+                 <= tolerance * tolerance;
+    if (!repeated)
+    {
+      simplex[size++] = support;
+      progress = true;
+    }
+
+    if (!progress)
+      break;
+
+    dir = reduceToClosestPoint(simplex, weights, size, offset);
+    if (size == 4)
+      break;
+  }
+
+  // Shapes that touch before moving are left to the discrete check, while
+  // separated shapes that are closer than the margin hit right away
+  if (!moved)
+  {
+    if (margin <= 0.0 || size == 4
+        || dir.squaredNorm() <= tolerance * tolerance)
+      return false;
+
+    normal = dir;
+  }
+
+  normal.normalize();
+  point.setZero();
+  for (int i = 0; i < size; ++i)
+    point += weights[i] * simplex[i].b;
+
+  return true;
+}
+
+} // namespace detail
+} // namespace collision
+} // namespace dart
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_COLLISION_DART_DETAIL_GJK_HPP_
+#define DART_COLLISION_DART_DETAIL_GJK_HPP_
+
+#include <array>
+
+#include "dart/collision/dart/detail/MinkowskiDifference.hpp"
+
+namespace dart {
+namespace collision {
+namespace detail {
+
+/// Simplex of GJK, whose newest point is always the last one
+using Simplex = std::array<SupportPoint, 4>;
+
+//==============================================================================
+/// Run GJK on the Minkowski difference of two shapes. Return false if the
+/// shapes are separated, and true if they intersect or touch, in which case
+/// the first \c size points of \c simplex enclose or touch the origin. If GJK
+/// doesn't converge, the shapes are too close to be told apart and true is
+/// returned as well, so that EPA decides on the penetration.
+bool runGjk(const MinkowskiDifference& md, Simplex& simplex, int& size);
+
+//==============================================================================
+/// Sweep shape A of the Minkowski difference along \c motion towards the fixed
+/// shape B with the GJK ray cast of van den Bergen. Return true if A hits B
+/// before it has moved by the whole motion, in which case \c fraction is the
+/// fraction of the motion at which the shapes touch, \c normal is the unit
+/// contact normal pointing from B to A, and \c point is the point of B that A
+/// touches. Return false if the shapes don't meet, or already touch before A
+/// moves.
+///
+/// A positive \c margin inflates A by a ball of that radius. Shapes that are
+/// separated but closer than the margin then hit at fraction 0, with the
+/// normal along their closest points.
+bool castGjk(
+    const MinkowskiDifference& md,
+    const Eigen::Vector3d& motion,
+    double& fraction,
+    Eigen::Vector3d& normal,
+    Eigen::Vector3d& point,
+    double margin = 0.0);
+
+} // namespace detail
+} // namespace collision
+} // namespace dart
+
+#endif // DART_COLLISION_DART_DETAIL_GJK_HPP_
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/collision/dart/detail/MinkowskiDifference.hpp"
+
+namespace dart {
+namespace collision {
+namespace detail {
+
+//==============================================================================
+MinkowskiDifference::MinkowskiDifference(
+    const ConvexShape& shapeA, const ConvexShape& shapeB)
+  : mShapeA(shapeA), mShapeB(shapeB)
+{
+  // Do nothing
+}
+
+//==============================================================================
+SupportPoint MinkowskiDifference::support(const Eigen::Vector3d& dir) const
+{
+  SupportPoint point;
+  point.a = mShapeA.support(dir);
+  point.b = mShapeB.support(-dir);
+  point.w = point.a - point.b;
+  return point;
+}
+
+//==============================================================================
+SupportPoint MinkowskiDifference::center() const
+{
+  SupportPoint point;
+  point.a = mShapeA.center();
+  point.b = mShapeB.center();
+  point.w = point.a - point.b;
+  return point;
+}
+
+//==============================================================================
+double MinkowskiDifference::getSize() const
+{
+  return mShapeA.getSize() + mShapeB.getSize();
+}
+
+//==============================================================================
+bool isDegenerate(const Eigen::Vector3d& dir)
+{
+  return dir.squaredNorm() < degenerateTolerance;
+}
+
+//==============================================================================
+Eigen::Vector3d computeClosestPointToOrigin(
+    const Eigen::Vector3d& a,
+    const Eigen::Vector3d& b,
+    const Eigen::Vector3d& c,
+    Eigen::Vector3d& barycentric)
+{
+  // See Ericson, Real-Time Collision Detection, Section 5.1.5
+  const Eigen::Vector3d ab = b - a;
+  const Eigen::Vector3d ac = c - a;
+  const Eigen::Vector3d ap = -a;
+
+  const double d1 = ab.dot(ap);
+  const double d2 = ac.dot(ap);
+  if (d1 <= 0.0 && d2 <= 0.0)
+  {
+    barycentric << 1.0, 0.0, 0.0;
+    return a;
+  }
+
+  const Eigen::Vector3d bp = -b;
+  const double d3 = ab.dot(bp);
+  const double d4 = ac.dot(bp);
+  if (d3 >= 0.0 && d4 <= d3)
+  {
+    barycentric << 0.0, 1.0, 0.0;
+    return b;
+  }
+
+  const double vc = d1 * d4 - d3 * d2;
+  if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0)
+  {
+    const double v = d1 / (d1 - d3);
+    barycentric << 1.0 - v, v, 0.0;
+    return a + v * ab;
+  }
+
+  const Eigen::Vector3d cp = -c;
+  const double d5 = ab.dot(cp);
+  const double d6 = ac.dot(cp);
+  if (d6 >= 0.0 && d5 <= d6)
+  {
+    barycentric << 0.0, 0.0, 1.0;
+    return c;
+  }
+
+  const double vb = d5 * d2 - d1 * d6;
+  if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0)
+  {
+    const double w = d2 / (d2 - d6);
+    barycentric << 1.0 - w, 0.0, w;
+    return a + w * ac;
+  }
+
+  const double va = d3 * d6 - d5 * d4;
+  if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0)
+  {
+    const double w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+    barycentric << 0.0, 1.0 - w, w;
+    return b + w * (c - b);
+  }
+
+  const double denom = 1.0 / (va + vb + vc);
+  const double v = vb * denom;
+  const double w = vc * denom;
+  barycentric << 1.0 - v - w, v, w;
+  return a + v * ab + w * ac;
+}
+
+//==============================================================================
+void setPenetrationFromTriangle(
+    const SupportPoint& p0,
+    const SupportPoint& p1,
+    const SupportPoint& p2,
+    Penetration& penetration)
+{
+  Eigen::Vector3d barycentric;
+  const Eigen::Vector3d closest
+      = computeClosestPointToOrigin(p0.w, p1.w, p2.w, barycentric);
+
+  penetration.depth = closest.norm();
+  if (penetration.depth > 0.0)
+    penetration.normal = closest / penetration.depth;
+  penetration.pointA = barycentric[0] * p0.a + barycentric[1] * p1.a
+                       + barycentric[2] * p2.a;
+  penetration.pointB = barycentric[0] * p0.b + barycentric[1] * p1.b
+                       + barycentric[2] * p2.b;
+}
+
+} // namespace detail
+} // namespace collision
+} // namespace dart
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_COLLISION_DART_DETAIL_MINKOWSKIDIFFERENCE_HPP_
+#define DART_COLLISION_DART_DETAIL_MINKOWSKIDIFFERENCE_HPP_
+
+#include "dart/collision/dart/detail/ConvexShape.hpp"
+
+namespace dart {
+namespace collision {
+namespace detail {
+
+//==============================================================================
+/// Point of the Minkowski difference A - B along with the points of A and B
+/// that generate it
+struct SupportPoint
+{
+  Eigen::Vector3d w;
+  Eigen::Vector3d a;
+  Eigen::Vector3d b;
+};
+
+//==============================================================================
+/// Minkowski difference A - B of two convex shapes, described by its support
+/// function
+class MinkowskiDifference
+{
+public:
+  MinkowskiDifference(const ConvexShape& shapeA, const ConvexShape& shapeB);
+
+  SupportPoint support(const Eigen::Vector3d& dir) const;
+
+  SupportPoint center() const;
+
+  double getSize() const;
+
+private:
+  const ConvexShape& mShapeA;
+  const ConvexShape& mShapeB;
+};
+
+//==============================================================================
+/// Result of a penetration query. The normal points from A to B, so moving A
+/// by -depth * normal separates the shapes.
+struct Penetration
+{
+  Eigen::Vector3d normal;
+  double depth;
+  Eigen::Vector3d pointA;
+  Eigen::Vector3d pointB;
+};
+
+//==============================================================================
+/// Return true if \c dir is too short to be used as a search direction
+bool isDegenerate(const Eigen::Vector3d& dir);
+
+//==============================================================================
+/// Return the point of the triangle abc closest to the origin, and set
+/// \c barycentric to its barycentric coordinates
+Eigen::Vector3d computeClosestPointToOrigin(
+    const Eigen::Vector3d& a,
+    const Eigen::Vector3d& b,
+    const Eigen::Vector3d& c,
+    Eigen::Vector3d& barycentric);
+
+//==============================================================================
+/// Set the penetration from the point of the triangle of support points that
+/// is closest to the origin
+void setPenetrationFromTriangle(
+    const SupportPoint& p0,
+    const SupportPoint& p1,
+    const SupportPoint& p2,
+    Penetration& penetration);
+
+} // namespace detail
+} // namespace collision
+} // namespace dart
+
+#endif // DART_COLLISION_DART_DETAIL_MINKOWSKIDIFFERENCE_HPP_
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/collision/dart/detail/Mpr.hpp"
+
+#include <utility>
+
+namespace dart {
+namespace collision {
+namespace detail {
+
+namespace {
+
+constexpr int maxMprIterations = 64;
+
+} // anonymous namespace
+
+//==============================================================================
+bool runMpr(const MinkowskiDifference& md, Penetration& penetration)
+{
+  const double tolerance = penetrationTolerance * md.getSize();
+
+  // Phase 1: find a portal, i.e., a triangle of support points crossed by the
+  // ray from an interior point towards the origin
+  SupportPoint v0 = md.center();
+  if (isDegenerate(v0.w))
+    v0.w[0] += tolerance;
+
+  Eigen::Vector3d normal = -v0.w;
+  SupportPoint v1 = md.support(normal);
+  if (v1.w.dot(normal) <= 0.0)
+    return false;
+
+  normal = v1.w.cross(v0.w);
+  if (isDegenerate(normal))
+  {
+    // The origin lies on the segment between v0 and v1
+    penetration.depth = v1.w.norm();
+    penetration.normal = v1.w / penetration.depth;
+    penetration.pointA = v1.a;
+    penetration.pointB = v1.b;
+    return true;
+  }
+
+  SupportPoint v2 = md.support(normal);
+  if (v2.w.dot(normal) <= 0.0)
+    return false;
+
+  normal = (v1.w - v0.w).cross(v2.w - v0.w);
+  if (normal.dot(v0.w) > 0.0)
+  {
+    std::swap(v1, v2);
+    normal = -normal;
+  }
+
+  SupportPoint v3;
+  int iteration = 0;
+  for (; iteration < maxMprIterations; ++iteration)
+  {
+    v3 = md.support(normal);
+    if (v3.w.dot(normal) <= 0.0)
+      return false;
+
+    if (v1.w.cross(v3.w).dot(v0.w) < 0.0)
+    {
+      v2 = v3;
+      normal = (v1.w - v0.w).cross(v3.w - v0.w);
+      continue;
+    }
+
+    if (v3.w.cross(v2.w).dot(v0.w) < 0.0)
+    {
+      v1 = v3;
+      normal = (v3.w - v0.w).cross(v2.w - v0.w);
+      continue;
+    }
+
+    break;
+  }
+
+  if (iteration == maxMprIterations)
+    return false;
+
+  // Phase 2: move the portal towards the boundary of the Minkowski difference
+  for (iteration = 0; iteration < maxMprIterations; ++iteration)
+  {
+    normal = (v2.w - v1.w).cross(v3.w - v1.w);
+    if (isDegenerate(normal))
+      return false;
+    normal.normalize();
+
+    const SupportPoint v4 = md.support(normal);
+    if ((v4.w - v3.w).dot(normal) <= tolerance)
+      break;
+
+    // The origin is outside of the support plane
+    if (v4.w.dot(normal) < 0.0)
+      return false;
+
+    const Eigen::Vector3d e = v4.w.cross(v0.w);
+    if (v1.w.dot(e) > 0.0)
+    {
+      if (v2.w.dot(e) > 0.0)
+        v1 = v4;
+      else
+        v3 = v4;
+    }
+    else
+    {
+      if (v3.w.dot(e) > 0.0)
+        v2 = v4;
+      else
+        v1 = v4;
+    }
+  }
+
+  // The origin is outside of the final portal
+  if (normal.dot(v1.w) < 0.0)
+    return false;
+
+  setPenetrationFromTriangle(v1, v2, v3, penetration);
+
+  return true;
+}
+
+} // namespace detail
+} // namespace collision
+} // namespace dart
@@ -138,35 +138,7 @@ template <typename... Others>
 void CollisionGroup::subscribeTo(
     const dynamics::ConstSkeletonPtr& skeleton, const Others&... others)
 {
-  const auto inserted = mSkeletonSources.insert(SkeletonSources::value_type(
-      skeleton.get(), SkeletonSource(skeleton, skeleton->getVersion())));
-
-  if (inserted.second)
-  {
-    SkeletonSource& entry = inserted.first->second;
-
-    const std::size_t numBodies = skeleton->getNumBodyNodes();
-    for (std::size_t i = 0u; i < numBodies; ++i)
-    {
-      const dynamics::BodyNode* bn = skeleton->getBodyNode(i);
-
-      const auto& collisionShapeNodes
-          = bn->getShapeNodesWith<dynamics::CollisionAspect>();
-
-      auto& childInfo
-          = entry.mChildren
-                .insert(std::make_pair(
-                    bn, SkeletonSource::ChildInfo(bn->getVersion())))
-                .first->second;
-
-      for (const auto& shapeNode : collisionShapeNodes)
-      {
-        entry.mObjects.insert(
-            {shapeNode, addShapeFrameImpl(shapeNode, skeleton.get())});
-        childInfo.mFrames.insert(shapeNode);
-      }
-    }
-  }
+  subscribeToSkeleton(skeleton, nullptr);
 
   subscribeTo(others...);
 }
@@ -0,0 +1,533 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/collision/detail/RaycastShape.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <assimp/scene.h>
+
+#include "dart/dynamics/BoxShape.hpp"
+#include "dart/dynamics/CapsuleShape.hpp"
+#include "dart/dynamics/CylinderShape.hpp"
+#include "dart/dynamics/EllipsoidShape.hpp"
+#include "dart/dynamics/MeshShape.hpp"
+#include "dart/dynamics/PlaneShape.hpp"
+#include "dart/dynamics/SphereShape.hpp"
+
+namespace dart {
+namespace collision {
+namespace detail {
+
+namespace {
+
+constexpr double epsilon = 1e-12;
+
+/// Part of a ray inside a convex shape, with the surface normals where the ray
+/// enters and leaves it
+struct RayInterval
+{
+  double tIn;
+  double tOut;
+  Eigen::Vector3d normalIn;
+  Eigen::Vector3d normalOut;
+};
+
+//==============================================================================
+bool finishConvex(
+    const RayInterval& interval,
+    double maxDistance,
+    double& distance,
+    Eigen::Vector3d& normal)
+{
+  if (interval.tOut < 0.0 || interval.tIn > interval.tOut)
+    return false;
+
+  if (interval.tIn >= 0.0)
+  {
+    distance = interval.tIn;
+    normal = interval.normalIn;
+  }
+  else
+  {
+    distance = interval.tOut;
+    normal = interval.normalOut;
+  }
+
+  return distance <= maxDistance;
+}
+
+//==============================================================================
+bool intersectEllipsoid(
+    const Eigen::Vector3d& center,
+    const Eigen::Vector3d& radii,
+    const Eigen::Vector3d& origin,
+    const Eigen::Vector3d& direction,
+    RayInterval& interval)
+{
+  // Scale the ellipsoid to the unit sphere and solve a t^2 + 2 b t + c = 0
+  const Eigen::Vector3d o = (origin - center).cwiseQuotient(radii);
+  const Eigen::Vector3d d = direction.cwiseQuotient(radii);
+
+  const double a = d.squaredNorm();
+  const double b = o.dot(d);
+  const double c = o.squaredNorm() - 1.0;
+  const double discriminant = b * b - a * c;
+  if (discriminant < 0.0)
+    return false;
+
+  const double root = std::sqrt(discriminant);
+  interval.tIn = (-b - root) / a;
+  interval.tOut = (-b + root) / a;
+
+  const Eigen::Vector3d invRadii2 = radii.cwiseProduct(radii).cwiseInverse();
+  interval.normalIn
+      = (origin + interval.tIn * direction - center).cwiseProduct(invRadii2);
+  interval.normalIn.normalize();
+  interval.normalOut
+      = (origin + interval.tOut * direction - center).cwiseProduct(invRadii2);
+  interval.normalOut.normalize();
+
+  return true;
+}
+
+//==============================================================================
+bool intersectBox(
+    const Eigen::Vector3d& halfSize,
+    const Eigen::Vector3d& origin,
+    const Eigen::Vector3d& direction,
+    RayInterval& interval)
+{
+  interval.tIn = -std::numeric_limits<double>::infinity();
+  interval.tOut = std::numeric_limits<double>::infinity();
+  int axisIn = 0;
+  int axisOut = 0;
+
+  for (int i = 0; i < 3; ++i)
+  {
+    if (std::abs(direction[i]) < epsilon)
+    {
+      if (std::abs(origin[i]) > halfSize[i])
+        return false;
+
+      continue;
+    }
+
+    const double inv = 1.0 / direction[i];
+    double t1 = (-halfSize[i] - origin[i]) * inv;
+    double t2 = (halfSize[i] - origin[i]) * inv;
+    if (t1 > t2)
+      std::swap(t1, t2);
+
+    if (t1 > interval.tIn)
+    {
+      interval.tIn = t1;
+      axisIn = i;
+    }
+
+    if (t2 < interval.tOut)
+    {
+      interval.tOut = t2;
+      axisOut = i;
+    }
+  }
+
+  interval.normalIn.setZero();
+  interval.normalIn[axisIn] = direction[axisIn] > 0.0 ? -1.0 : 1.0;
+  interval.normalOut.setZero();
+  interval.normalOut[axisOut] = direction[axisOut] > 0.0 ? 1.0 : -1.0;
+
+  return true;
+}
+
+//==============================================================================
+bool intersectCylinder(
+    double radius,
+    double halfHeight,
+    const Eigen::Vector3d& origin,
+    const Eigen::Vector3d& direction,
+    RayInterval& interval)
+{
+  // Side of the infinite cylinder along the z-axis
+  const double a
+      = direction.x() * direction.x() + direction.y() * direction.y();
+  const double b = origin.x() * direction.x() + origin.y() * direction.y();
+  const double c = origin.x() * origin.x() + origin.y() * origin.y()
+                   - radius * radius;
+
+  if (a < epsilon)
+  {
+    if (c > 0.0)
+      return false;
+
+    interval.tIn = -std::numeric_limits<double>::infinity();
+    interval.tOut = std::numeric_limits<double>::infinity();
+  }
+  else
+  {
+    const double discriminant = b * b - a * c;
+    if (discriminant < 0.0)
+      return false;
+
+    const double root = std::sqrt(discriminant);
+    interval.tIn = (-b - root) / a;
+    interval.tOut = (-b + root) / a;
+
+    const Eigen::Vector3d pointIn = origin + interval.tIn * direction;
+    const Eigen::Vector3d pointOut = origin + interval.tOut * direction;
+    interval.normalIn = Eigen::Vector3d(pointIn.x(), pointIn.y(), 0.0);
+    interval.normalIn /= radius;
+    interval.normalOut = Eigen::Vector3d(pointOut.x(), pointOut.y(), 0.0);
+    interval.normalOut /= radius;
+  }
+
+  // Caps
+  if (std::abs(direction.z()) < epsilon)
+    return std::abs(origin.z()) <= halfHeight;
+
+  double t1 = (-halfHeight - origin.z()) / direction.z();
+  double t2 = (halfHeight - origin.z()) / direction.z();
+  if (t1 > t2)
+    std::swap(t1, t2);
+
+  const double sign = direction.z() > 0.0 ? 1.0 : -1.0;
+
+  if (t1 > interval.tIn)
+  {
+    interval.tIn = t1;
+    interval.normalIn = Eigen::Vector3d(0.0, 0.0, -sign);
+  }
+
+  if (t2 < interval.tOut)
+  {
+    interval.tOut = t2;
+    interval.normalOut = Eigen::Vector3d(0.0, 0.0, sign);
+  }
+
+  return interval.tIn <= interval.tOut;
+}
+
+//==============================================================================
+bool intersectCapsule(
+    double radius,
+    double halfHeight,
+    const Eigen::Vector3d& origin,
+    const Eigen::Vector3d& direction,
+    RayInterval& interval)
+{
+  // A capsule is the union of a cylinder and two spheres. The union is convex,
+  // so the ray enters it where it enters the first part and leaves it where it
+  // leaves the last one.
+  bool hit = false;
+  const auto merge = [&](const RayInterval& part) {
+    if (!hit || part.tIn < interval.tIn)
+    {
+      interval.tIn = part.tIn;
+      interval.normalIn = part.normalIn;
+    }
+
+    if (!hit || part.tOut > interval.tOut)
+    {
+      interval.tOut = part.tOut;
+      interval.normalOut = part.normalOut;
+    }
+
+    hit = true;
+  };
+
+  RayInterval part;
+  if (intersectCylinder(radius, halfHeight, origin, direction, part))
+    merge(part);
+
+  const Eigen::Vector3d radii = Eigen::Vector3d::Constant(radius);
+  for (const double z : {-halfHeight, halfHeight})
+  {
+    if (intersectEllipsoid(
+            Eigen::Vector3d(0.0, 0.0, z), radii, origin, direction, part))
+      merge(part);
+  }
+
+  return hit;
+}
+
+//==============================================================================
+bool raycastPlane(
+    const dynamics::PlaneShape& plane,
+    const Eigen::Vector3d& origin,
+    const Eigen::Vector3d& direction,
+    double maxDistance,
+    double& distance,
+    Eigen::Vector3d& normal)
+{
+  const Eigen::Vector3d& planeNormal = plane.getNormal();
+  const double denominator = planeNormal.dot(direction);
+  if (std::abs(denominator) < epsilon)
+    return false;
+
+  const double t = (plane.getOffset() - planeNormal.dot(origin)) / denominator;
+  if (t < 0.0 || t > maxDistance)
+    return false;
+
+  distance = t;
+  normal = denominator < 0.0 ? planeNormal : Eigen::Vector3d(-planeNormal);
+
+  return true;
+}
+
+//==============================================================================
+bool raycastMesh(
+    const dynamics::MeshShape& mesh,
+    const Eigen::Vector3d& origin,
+    const Eigen::Vector3d& direction,
+    double maxDistance,
+    double& distance,
+    Eigen::Vector3d& normal)
+{
+  const aiScene* scene = mesh.getMesh();
+  if (!scene)
+    return false;
+
+  const Eigen::Vector3d& scale = mesh.getScale();
+  const auto vertex = [&](const aiMesh* subMesh, unsigned int index) {
+    const aiVector3D& v = subMesh->mVertices[index];
+    return Eigen::Vector3d(v.x * scale.x(), v.y * scale.y(), v.z * scale.z());
+  };
+
+  bool hit = false;
+  double closest = maxDistance;
+
+  for (unsigned int i = 0u; i < scene->mNumMeshes; ++i)
+  {
+    const aiMesh* subMesh = scene->mMeshes[i];
+
+    for (unsigned int j = 0u; j < subMesh->mNumFaces; ++j)
+    {
+      const aiFace& face = subMesh->mFaces[j];
+      if (face.mNumIndices != 3u)
+        continue;
+
+      // Moller-Trumbore ray-triangle intersection
+      const Eigen::Vector3d v0 = vertex(subMesh, face.mIndices[0]);
+      const Eigen::Vector3d edge1 = vertex(subMesh, face.mIndices[1]) - v0;
+      const Eigen::Vector3d edge2 = vertex(subMesh, face.mIndices[2]) - v0;
+
+      const Eigen::Vector3d p = direction.cross(edge2);
+      const double det = edge1.dot(p);
+      if (std::abs(det) < epsilon)
+        continue;
+
+      const double invDet = 1.0 / det;
+      const Eigen::Vector3d s = origin - v0;
+      const double u = s.dot(p) * invDet;
+      if (u < 0.0 || u > 1.0)
+        continue;
+
+      const Eigen::Vector3d q = s.cross(edge1);
+      const double v = direction.dot(q) * invDet;
+      if (v < 0.0 || u + v > 1.0)
+        continue;
+
+      const double t = edge2.dot(q) * invDet;
+      if (t < 0.0 || t > closest)
+        continue;
+
+      hit = true;
+      closest = t;
+      normal = edge1.cross(edge2).normalized();
+      if (normal.dot(direction) > 0.0)
+        normal = -normal;
+    }
+  }
+
+  if (hit)
+    distance = closest;
+
+  return hit;
+}
+
+} // anonymous namespace
+
+//==============================================================================
+bool raycastShape(
+    const dynamics::Shape& shape,
+    const Eigen::Vector3d& origin,
+    const Eigen::Vector3d& direction,
+    double maxDistance,
+    double& distance,
+    Eigen::Vector3d& normal)
+{
+  using dynamics::Shape;
+
+  RayInterval interval;
+
+  switch (shape.getTypeId())
+  {
+    case Shape::TypeId::SPHERE:
+    {
+      const double radius
+          = static_cast<const dynamics::SphereShape&>(shape).getRadius();
+      if (!intersectEllipsoid(
+              Eigen::Vector3d::Zero(),
+              Eigen::Vector3d::Constant(radius),
+              origin,
+              direction,
+              interval))
+        return false;
+      break;
+    }
+    case Shape::TypeId::BOX:
+    {
+      const auto& box = static_cast<const dynamics::BoxShape&>(shape);
+      if (!intersectBox(0.5 * box.getSize(), origin, direction, interval))
+        return false;
+      break;
+    }
+    case Shape::TypeId::ELLIPSOID:
+    {
+      const auto& ellipsoid
+          = static_cast<const dynamics::EllipsoidShape&>(shape);
+      if (!intersectEllipsoid(
+              Eigen::Vector3d::Zero(),
+              ellipsoid.getRadii(),
+              origin,
+              direction,
+              interval))
+        return false;
+      break;
+    }
+    case Shape::TypeId::CYLINDER:
+    {
+      const auto& cylinder = static_cast<const dynamics::CylinderShape&>(shape);
+      if (!intersectCylinder(
+              cylinder.getRadius(),
+              0.5 * cylinder.getHeight(),
+              origin,
+              direction,
+              interval))
+        return false;
+      break;
+    }
+    case Shape::TypeId::CAPSULE:
+    {
+      const auto& capsule = static_cast<const dynamics::CapsuleShape&>(shape);
+      if (!intersectCapsule(
+              capsule.getRadius(),
+              0.5 * capsule.getHeight(),
+              origin,
+              direction,
+              interval))
+        return false;
+      break;
+    }
+    case Shape::TypeId::PLANE:
+      return raycastPlane(
+          static_cast<const dynamics::PlaneShape&>(shape),
+          origin,
+          direction,
+          maxDistance,
+          distance,
+          normal);
+    case Shape::TypeId::MESH:
+      return raycastMesh(
+          static_cast<const dynamics::MeshShape&>(shape),
+          origin,
+          direction,
+          maxDistance,
+          distance,
+          normal);
+    default:
+      return false;
+  }
+
+  return finishConvex(interval, maxDistance, distance, normal);
+}
+
+//==============================================================================
+bool intersectsBoundingBox(
+    const math::BoundingBox& box,
+    const Eigen::Vector3d& origin,
+    const Eigen::Vector3d& direction,
+    double maxDistance)
+{
+  double tMin = 0.0;
+  double tMax = maxDistance;
+
+  for (int i = 0; i < 3; ++i)
+  {
+    if (direction[i] == 0.0)
+    {
+      if (origin[i] < box.getMin()[i] || origin[i] > box.getMax()[i])
+        return false;
+
+      continue;
+    }
+
+    const double inv = 1.0 / direction[i];
+    double t1 = (box.getMin()[i] - origin[i]) * inv;
+    double t2 = (box.getMax()[i] - origin[i]) * inv;
+    if (t1 > t2)
+      std::swap(t1, t2);
+
+    tMin = std::max(tMin, t1);
+    tMax = std::min(tMax, t2);
+    if (tMin > tMax)
+      return false;
+  }
+
+  return true;
+}
+
+//==============================================================================
+bool isRaycastSupported(dynamics::Shape::TypeId typeId)
+{
+  using dynamics::Shape;
+
+  switch (typeId)
+  {
+    case Shape::TypeId::SPHERE:
+    case Shape::TypeId::BOX:
+    case Shape::TypeId::ELLIPSOID:
+    case Shape::TypeId::CYLINDER:
+    case Shape::TypeId::CAPSULE:
+    case Shape::TypeId::PLANE:
+    case Shape::TypeId::MESH:
+      return true;
+    default:
+      return false;
+  }
+}
+
+} // namespace detail
+} // namespace collision
+} // namespace dart
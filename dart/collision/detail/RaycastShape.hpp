@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_COLLISION_DETAIL_RAYCASTSHAPE_HPP_
+#define DART_COLLISION_DETAIL_RAYCASTSHAPE_HPP_
+
+#include <Eigen/Geometry>
+
+#include "dart/dynamics/Shape.hpp"
+#include "dart/math/Geometry.hpp"
+
+namespace dart {
+namespace collision {
+namespace detail {
+
+/// Intersect a ray with a shape, both given in the frame of the shape.
+///
+/// The ray starts at origin and runs along the unit vector direction for at
+/// most maxDistance. On a hit, distance is set to the distance from origin to
+/// the first point where the ray crosses the surface of the shape, normal to
+/// the outward surface normal at that point, and true is returned. A ray that
+/// starts inside a solid shape hits it where it leaves it.
+///
+/// Spheres, boxes, ellipsoids, cylinders, capsules, planes, and meshes are
+/// supported. Other shapes are never hit.
+bool raycastShape(
+    const dynamics::Shape& shape,
+    const Eigen::Vector3d& origin,
+    const Eigen::Vector3d& direction,
+    double maxDistance,
+    double& distance,
+    Eigen::Vector3d& normal);
+
+/// Return whether the segment that starts at origin and runs along direction
+/// for maxDistance overlaps box
+bool intersectsBoundingBox(
+    const math::BoundingBox& box,
+    const Eigen::Vector3d& origin,
+    const Eigen::Vector3d& direction,
+    double maxDistance);
+
+/// Return whether the shape type is supported by raycastShape()
+bool isRaycastSupported(dynamics::Shape::TypeId typeId);
+
+} // namespace detail
+} // namespace collision
+} // namespace dart
+
+#endif // DART_COLLISION_DETAIL_RAYCASTSHAPE_HPP_
@@ -49,6 +49,7 @@
 #include "dart/dynamics/MeshShape.hpp"
 #include "dart/dynamics/PlaneShape.hpp"
 #include "dart/dynamics/PyramidShape.hpp"
+#include "dart/dynamics/SdfShape.hpp"
 #include "dart/dynamics/Shape.hpp"
 #include "dart/dynamics/ShapeFrame.hpp"
 #include "dart/dynamics/SoftMeshShape.hpp"
@@ -270,6 +271,42 @@ template <class BV>
   return model;
 }
 
+//==============================================================================
+// Create a mesh of an axis-aligned box given by its corners
+template <class BV>
+::fcl::BVHModel<BV>* createBox(
+    const Eigen::Vector3d& _min, const Eigen::Vector3d& _max)
+{
+  int faces[6][4] = {{0, 1, 2, 3},
+                     {3, 2, 6, 7},
+                     {7, 6, 5, 4},
+                     {4, 5, 1, 0},
+                     {5, 6, 2, 1},
+                     {7, 4, 0, 3}};
+
+  // Same vertex order as createCube()
+  std::vector<fcl::Vector3> v(8);
+  for (int i = 0; i < 8; ++i)
+  {
+    const bool x = i >= 4;
+    const bool y = (i % 4) == 2 || (i % 4) == 3;
+    const bool z = (i % 4) == 1 || (i % 4) == 2;
+    v[i] = FCLTypes::convertVector3(Eigen::Vector3d(
+        x ? _max[0] : _min[0], y ? _max[1] : _min[1], z ? _max[2] : _min[2]));
+  }
+
+  ::fcl::BVHModel<BV>* model = new ::fcl::BVHModel<BV>;
+  model->beginModel();
+
+  for (int i = 0; i < 6; i++)
+  {
+    model->addTriangle(v[faces[i][0]], v[faces[i][1]], v[faces[i][2]]);
+    model->addTriangle(v[faces[i][0]], v[faces[i][2]], v[faces[i][3]]);
+  }
+  model->endModel();
+  return model;
+}
+
 //==============================================================================
 template <class BV>
 ::fcl::BVHModel<BV>* createEllipsoid(float _sizeX, float _sizeY, float _sizeZ)
@@ -906,9 +943,9 @@ FCLCollisionDetector::createFCLCollisionGeometry(
 #endif // HAVE_OCTOMAP
 
   fcl::CollisionGeometry* geom = nullptr;
-  const auto& shapeType = shape->getType();
+  const auto shapeTypeId = shape->getTypeId();
 
-  if (SphereShape::getStaticType() == shapeType)
+  if (SphereShape::getStaticTypeId() == shapeTypeId)
   {
     assert(dynamic_cast<const SphereShape*>(shape.get()));
 
@@ -921,7 +958,7 @@ FCLCollisionDetector::createFCLCollisionGeometry(
       geom = createEllipsoid<fcl::OBBRSS>(
           radius * 2.0, radius * 2.0, radius * 2.0);
   }
-  else if (BoxShape::getStaticType() == shapeType)
+  else if (BoxShape::getStaticTypeId() == shapeTypeId)
   {
     assert(dynamic_cast<const BoxShape*>(shape.get()));
 
@@ -933,7 +970,7 @@ FCLCollisionDetector::createFCLCollisionGeometry(
     else
       geom = createCube<fcl::OBBRSS>(size[0], size[1], size[2]);
   }
-  else if (EllipsoidShape::getStaticType() == shapeType)
+  else if (EllipsoidShape::getStaticTypeId() == shapeTypeId)
   {
     assert(dynamic_cast<const EllipsoidShape*>(shape.get()));
 
@@ -955,7 +992,7 @@ FCLCollisionDetector::createFCLCollisionGeometry(
           radii[0] * 2.0, radii[1] * 2.0, radii[2] * 2.0);
     }
   }
-  else if (CylinderShape::getStaticType() == shapeType)
+  else if (CylinderShape::getStaticTypeId() == shapeTypeId)
   {
     assert(dynamic_cast<const CylinderShape*>(shape.get()));
 
@@ -976,7 +1013,7 @@ FCLCollisionDetector::createFCLCollisionGeometry(
       geom = createCylinder<fcl::OBBRSS>(radius, radius, height, 16, 16);
     }
   }
-  else if (ConeShape::getStaticType() == shapeType)
+  else if (ConeShape::getStaticTypeId() == shapeTypeId)
   {
     assert(dynamic_cast<const ConeShape*>(shape.get()));
 
@@ -1003,7 +1040,7 @@ FCLCollisionDetector::createFCLCollisionGeometry(
       geom = fclMesh;
     }
   }
-  else if (PyramidShape::getStaticType() == shapeType)
+  else if (PyramidShape::getStaticTypeId() == shapeTypeId)
   {
     assert(dynamic_cast<const PyramidShape*>(shape.get()));
 
@@ -1011,7 +1048,7 @@ FCLCollisionDetector::createFCLCollisionGeometry(
     // Use mesh since FCL doesn't support pyramid shape.
     geom = createPyramid<fcl::OBBRSS>(*pyramid, fcl::Transform3());
   }
-  else if (PlaneShape::getStaticType() == shapeType)
+  else if (PlaneShape::getStaticTypeId() == shapeTypeId)
   {
     if (FCLCollisionDetector::PRIMITIVE == type)
     {
@@ -1030,7 +1067,7 @@ FCLCollisionDetector::createFCLCollisionGeometry(
              << "the size is [1000 0 1000].\n";
     }
   }
-  else if (MeshShape::getStaticType() == shapeType)
+  else if (MeshShape::getStaticTypeId() == shapeTypeId)
   {
     assert(dynamic_cast<const MeshShape*>(shape.get()));
 
@@ -1040,7 +1077,7 @@ FCLCollisionDetector::createFCLCollisionGeometry(
 
     geom = createMesh<fcl::OBBRSS>(scale[0], scale[1], scale[2], aiScene);
   }
-  else if (SoftMeshShape::getStaticType() == shapeType)
+  else if (SoftMeshShape::getStaticTypeId() == shapeTypeId)
   {
     assert(dynamic_cast<const SoftMeshShape*>(shape.get()));
 
@@ -1050,7 +1087,7 @@ FCLCollisionDetector::createFCLCollisionGeometry(
     geom = createSoftMesh<fcl::OBBRSS>(aiMesh);
   }
 #if HAVE_OCTOMAP
-  else if (VoxelGridShape::getStaticType() == shapeType)
+  else if (VoxelGridShape::getStaticTypeId() == shapeTypeId)
   {
 #  if FCL_HAVE_OCTOMAP
     assert(dynamic_cast<const VoxelGridShape*>(shape.get()));
@@ -1069,11 +1106,24 @@ FCLCollisionDetector::createFCLCollisionGeometry(
 #  endif // FCL_HAVE_OCTOMAP
   }
 #endif // HAVE_OCTOMAP
+  else if (SdfShape::getStaticTypeId() == shapeTypeId)
+  {
+    assert(dynamic_cast<const SdfShape*>(shape.get()));
+
+    // FCL has no signed distance field query. The grid box contains the
+    // solid, so the contacts are conservative.
+    dtwarn << "[FCLCollisionDetector::createFCLCollisionGeometry] "
+           << "FCL does not support SdfShape. Approximating it by the box of "
+           << "its grid; use DARTCollisionDetector for exact contacts.\n";
+
+    const auto& boundingBox = shape->getBoundingBox();
+    geom = createBox<fcl::OBBRSS>(boundingBox.getMin(), boundingBox.getMax());
+  }
   else
   {
     dterr << "[FCLCollisionDetector::createFCLCollisionGeometry] "
-          << "Attempting to create an unsupported shape type [" << shapeType
-          << "]. Creating a sphere with 0.1 radius "
+          << "Attempting to create an unsupported shape type ["
+          << shape->getType() << "]. Creating a sphere with 0.1 radius "
           << "instead.\n";
 
     geom = createEllipsoid<fcl::OBBRSS>(0.1, 0.1, 0.1);
@@ -66,13 +66,20 @@ void FCLCollisionGroup::addCollisionObjectToEngine(CollisionObject* object)
 void FCLCollisionGroup::addCollisionObjectsToEngine(
     const std::vector<CollisionObject*>& collObjects)
 {
+  std::vector<dart::collision::fcl::CollisionObject*> fclObjects;
+  fclObjects.reserve(collObjects.size());
+
   for (auto collObj : collObjects)
   {
     auto casted = static_cast<FCLCollisionObject*>(collObj);
 
-    mBroadPhaseAlg->registerObject(casted->getFCLCollisionObject());
+    fclObjects.push_back(casted->getFCLCollisionObject());
   }
 
+  // Registering all the objects at once lets the broadphase build its tree in
+  // a single pass instead of inserting the objects one by one.
+  mBroadPhaseAlg->registerObjects(fclObjects);
+
   initializeEngineData();
 }
 
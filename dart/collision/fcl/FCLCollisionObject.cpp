@@ -74,7 +74,7 @@ void FCLCollisionObject::updateEngineData()
   auto shape = mShapeFrame->getShape().get();
 
   // Update soft-body's vertices
-  if (shape->getType() == dynamics::SoftMeshShape::getStaticType())
+  if (shape->getTypeId() == dynamics::SoftMeshShape::getStaticTypeId())
   {
     assert(dynamic_cast<const SoftMeshShape*>(shape));
     auto softMeshShape = static_cast<const SoftMeshShape*>(shape);
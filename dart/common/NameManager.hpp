@@ -35,6 +35,7 @@
 
 #include <map>
 #include <string>
+#include <unordered_map>
 
 namespace dart {
 namespace common {
@@ -174,6 +175,12 @@ protected:
 
   /// The chunk of text that gets appended to a duplicate name
   std::string mAffix;
+
+  /// The duplication number last issued for each base name. Every smaller
+  /// number is known to be taken as long as no name gets removed, so
+  /// issueNewName() can start searching from it instead of from 1. Cleared
+  /// whenever a name is removed or the pattern changes.
+  mutable std::unordered_map<std::string, int> mLastIssuedCount;
 };
 
 } // namespace common
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "dart/common/ThreadPool.hpp"
+
+#include <algorithm>
+
+namespace dart {
+namespace common {
+
+namespace {
+
+/// Set on the worker threads of every pool, so that nested parallel loops run
+/// serially instead of waiting for a pool that is busy with their parent loop
+thread_local bool tIsPoolWorker = false;
+
+} // namespace
+
+//==============================================================================
+ThreadPool::ThreadPool(std::size_t _numThreads)
+  : mTask(nullptr),
+    mCount(0u),
+    mNext(0u),
+    mNumPendingWorkers(0u),
+    mJobId(0u),
+    mStop(false)
+{
+  const std::size_t numWorkers = std::max<std::size_t>(_numThreads, 1u) - 1u;
+  mWorkers.reserve(numWorkers);
+  for (std::size_t i = 0u; i < numWorkers; ++i)
+    mWorkers.emplace_back(&ThreadPool::runWorker, this);
+}
+
+//==============================================================================
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStop = true;
+  }
+  mWakeCondition.notify_all();
+
+  for (std::thread& worker : mWorkers)
+    worker.join();
+}
+
+//==============================================================================
+std::size_t ThreadPool::getNumThreads() const
+{
+  return mWorkers.size() + 1u;
+}
+
+//==============================================================================
+void ThreadPool::parallelFor(
+    std::size_t _count, const std::function<void(std::size_t)>& _task)
+{
+  std::unique_lock<std::mutex> jobLock(mJobMutex, std::defer_lock);
+  if (_count < 2u || mWorkers.empty() || tIsPoolWorker || !jobLock.try_lock())
+  {
+    for (std::size_t i = 0u; i < _count; ++i)
+      _task(i);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mTask = &_task;
+    mCount = _count;
+    mNext = 0u;
+    mNumPendingWorkers = mWorkers.size();
+    ++mJobId;
+  }
+  mWakeCondition.notify_all();
+
+  runTasks();
+
+  std::unique_lock<std::mutex> lock(mMutex);
+  mDoneCondition.wait(lock, [this] { return mNumPendingWorkers == 0u; });
+  mTask = nullptr;
+
+  if (mException)
+  {
+    std::exception_ptr exception = nullptr;
+    std::swap(exception, mException);
+    std::rethrow_exception(exception);
+  }
+}
+
+//==============================================================================
+std::shared_ptr<ThreadPool> ThreadPool::getDefault()
+{
+  static const std::shared_ptr<ThreadPool> pool
+      = std::make_shared<ThreadPool>(std::thread::hardware_concurrency());
+
+  return pool;
+}
+
+//==============================================================================
+void ThreadPool::runWorker()
+{
+  tIsPoolWorker = true;
+
+  std::size_t lastJobId = 0u;
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      mWakeCondition.wait(
+          lock, [&] { return mStop || mJobId != lastJobId; });
+
+      if (mStop)
+        return;
+
+      lastJobId = mJobId;
+    }
+
+    runTasks();
+
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      if (--mNumPendingWorkers == 0u)
+        mDoneCondition.notify_one();
+    }
+  }
+}
+
+//==============================================================================
+void ThreadPool::runTasks()
+{
+  std::size_t i;
+  while ((i = mNext.fetch_add(1u)) < mCount)
+  {
+    try
+    {
+      (*mTask)(i);
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      if (!mException)
+        mException = std::current_exception();
+
+      // Skip the remaining iterations
+      mNext = mCount;
+    }
+  }
+}
+
+} // namespace common
+} // namespace dart
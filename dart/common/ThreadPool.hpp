@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef DART_COMMON_THREADPOOL_HPP_
+#define DART_COMMON_THREADPOOL_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dart {
+namespace common {
+
+/// ThreadPool keeps a fixed set of worker threads around to run the data
+/// parallel loops of DART (e.g., per-tree dynamics passes) without paying for
+/// thread creation on every call.
+///
+/// Only one parallelFor() runs on a pool at a time. A parallelFor() that is
+/// issued while the pool is busy, or from inside one of its tasks, simply runs
+/// serially on the calling thread, so it is always safe to call.
+class ThreadPool
+{
+public:
+  /// Constructor. _numThreads is the total number of threads used by
+  /// parallelFor(), including the calling thread, so a pool of one thread
+  /// runs everything serially.
+  explicit ThreadPool(std::size_t _numThreads);
+
+  /// Destructor. Waits for the worker threads to finish.
+  ~ThreadPool();
+
+  /// Get the number of threads used by parallelFor(), including the calling
+  /// thread
+  std::size_t getNumThreads() const;
+
+  /// Call _task(i) for every i in [0, _count) and return once all of them are
+  /// done. The calls are distributed over the threads of this pool and the
+  /// calling thread, in no particular order.
+  ///
+  /// If a call throws, the calls that have not started yet are skipped and
+  /// the first exception is rethrown on the calling thread once the running
+  /// calls are done.
+  void parallelFor(
+      std::size_t _count, const std::function<void(std::size_t)>& _task);
+
+  /// Get the pool shared by DART. It uses one thread per hardware thread and
+  /// is created on first use.
+  static std::shared_ptr<ThreadPool> getDefault();
+
+private:
+  /// Main loop of the worker threads
+  void runWorker();
+
+  /// Pick and run tasks of the current parallelFor() until none are left
+  void runTasks();
+
+  /// Worker threads
+  std::vector<std::thread> mWorkers;
+
+  /// Serializes the calls to parallelFor()
+  std::mutex mJobMutex;
+
+  /// Protects the job description and the counters below
+  std::mutex mMutex;
+
+  /// Wakes up the workers when a job is posted or the pool is destroyed
+  std::condition_variable mWakeCondition;
+
+  /// Wakes up the caller of parallelFor() when all the workers are done
+  std::condition_variable mDoneCondition;
+
+  /// Task of the current job
+  const std::function<void(std::size_t)>* mTask;
+
+  /// Number of iterations of the current job
+  std::size_t mCount;
+
+  /// Next iteration to be picked
+  std::atomic<std::size_t> mNext;
+
+  /// First exception thrown by a task of the current job
+  std::exception_ptr mException;
+
+  /// Number of workers that have not finished the current job yet
+  std::size_t mNumPendingWorkers;
+
+  /// Incremented for every job so that workers can tell a new job apart
+  std::size_t mJobId;
+
+  /// Set when the pool is destroyed
+  bool mStop;
+};
+
+} // namespace common
+} // namespace dart
+
+#endif // DART_COMMON_THREADPOOL_HPP_
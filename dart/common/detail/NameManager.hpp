@@ -73,6 +73,7 @@ bool NameManager<T>::setPattern(const std::string& _newPattern)
   std::size_t prefix_end = std::min(name_start, number_start);
   std::size_t infix_end = std::max(name_start, number_start);
 
+  mLastIssuedCount.clear();
   mPrefix = _newPattern.substr(0, prefix_end);
   mInfix = _newPattern.substr(prefix_end + 2, infix_end - prefix_end - 2);
   mAffix = _newPattern.substr(infix_end + 2);
@@ -87,7 +88,8 @@ std::string NameManager<T>::issueNewName(const std::string& _name) const
   if (!hasName(_name))
     return _name;
 
-  int count = 1;
+  const auto lastIssued = mLastIssuedCount.find(_name);
+  int count = (lastIssued == mLastIssuedCount.end()) ? 1 : lastIssued->second;
   std::string newName;
   do
   {
@@ -99,6 +101,8 @@ std::string NameManager<T>::issueNewName(const std::string& _name) const
     newName = ss.str();
   } while (hasName(newName));
 
+  mLastIssuedCount[_name] = count - 1;
+
   dtmsg << "[NameManager::issueNewName] (" << mManagerName << ") The name ["
         << _name << "] is a duplicate, so it has been renamed to [" << newName
         << "]\n";
@@ -162,6 +166,7 @@ bool NameManager<T>::removeName(const std::string& _name)
     mReverseMap.erase(rit);
 
   mMap.erase(it);
+  mLastIssuedCount.clear();
 
   return true;
 }
@@ -182,6 +187,7 @@ bool NameManager<T>::removeObject(const T& _obj)
     mMap.erase(it);
 
   mReverseMap.erase(rit);
+  mLastIssuedCount.clear();
 
   return true;
 }
@@ -200,6 +206,7 @@ void NameManager<T>::clear()
 {
   mMap.clear();
   mReverseMap.clear();
+  mLastIssuedCount.clear();
 }
 
 //==============================================================================
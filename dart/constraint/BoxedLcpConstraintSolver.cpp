@@ -32,6 +32,7 @@
 
 #include "dart/constraint/BoxedLcpConstraintSolver.hpp"
 
+#include <algorithm>
 #include <cassert>
 #ifndef NDEBUG
 #  include <iomanip>
@@ -44,6 +45,7 @@
 #include "dart/constraint/ConstraintBase.hpp"
 #include "dart/constraint/DantzigBoxedLcpSolver.hpp"
 #include "dart/constraint/PgsBoxedLcpSolver.hpp"
+#include "dart/dynamics/Skeleton.hpp"
 #include "dart/lcpsolver/Lemke.hpp"
 
 namespace dart {
@@ -79,7 +81,7 @@ BoxedLcpConstraintSolver::BoxedLcpConstraintSolver(
 //==============================================================================
 BoxedLcpConstraintSolver::BoxedLcpConstraintSolver(
     BoxedLcpSolverPtr boxedLcpSolver, BoxedLcpSolverPtr secondaryBoxedLcpSolver)
-  : ConstraintSolver()
+  : ConstraintSolver(), mLcpRecording(false)
 {
   if (boxedLcpSolver)
   {
@@ -144,6 +146,90 @@ ConstBoxedLcpSolverPtr BoxedLcpConstraintSolver::getSecondaryBoxedLcpSolver()
   return mSecondaryBoxedLcpSolver;
 }
 
+//==============================================================================
+void BoxedLcpConstraintSolver::setLcpRecording(bool recording)
+{
+  mLcpRecording = recording;
+
+  if (!mLcpRecording)
+    clearLcpRecords();
+}
+
+//==============================================================================
+bool BoxedLcpConstraintSolver::isLcpRecording() const
+{
+  return mLcpRecording;
+}
+
+//==============================================================================
+const std::vector<BoxedLcpConstraintSolver::LcpRecord>&
+BoxedLcpConstraintSolver::getLcpRecords() const
+{
+  return mLcpRecords;
+}
+
+//==============================================================================
+void BoxedLcpConstraintSolver::clearLcpRecords()
+{
+  mLcpRecords.clear();
+}
+
+//==============================================================================
+void BoxedLcpConstraintSolver::recordLcp(ConstrainedGroup& group)
+{
+  const std::size_t numConstraints = group.getNumConstraints();
+  const std::size_t n = group.getTotalDimension();
+
+  mLcpRecords.emplace_back();
+  LcpRecord& record = mLcpRecords.back();
+  record.mA = mA.leftCols(n);
+  record.mLo = mLo;
+  record.mHi = mHi;
+  record.mFIndex = mFIndex;
+
+  // Repeat the impulse tests, reading the generalized velocity changes of the
+  // Skeletons that each constraint excites
+  std::vector<std::size_t> excited;
+  for (std::size_t i = 0; i < numConstraints; ++i)
+  {
+    const ConstraintBasePtr& constraint = group.getConstraint(i);
+
+    constraint->excite();
+
+    excited.clear();
+    for (const auto& skeleton : mSkeletons)
+    {
+      if (!skeleton->isImpulseApplied())
+        continue;
+
+      const auto it = std::find(
+          record.mSkeletons.begin(), record.mSkeletons.end(), skeleton);
+      excited.push_back(
+          static_cast<std::size_t>(it - record.mSkeletons.begin()));
+
+      if (it == record.mSkeletons.end())
+      {
+        record.mSkeletons.push_back(skeleton);
+        record.mImpulseResponses.push_back(
+            Eigen::MatrixXd::Zero(skeleton->getNumDofs(), n));
+      }
+    }
+
+    for (std::size_t j = 0; j < constraint->getDimension(); ++j)
+    {
+      constraint->applyUnitImpulse(j);
+
+      for (const std::size_t k : excited)
+      {
+        record.mImpulseResponses[k].col(mOffset[i] + j)
+            = record.mSkeletons[k]->getVelocityChanges();
+      }
+    }
+
+    constraint->unexcite();
+  }
+}
+
 //==============================================================================
 void BoxedLcpConstraintSolver::solveConstrainedGroup(ConstrainedGroup& group)
 {
@@ -235,6 +321,9 @@ void BoxedLcpConstraintSolver::solveConstrainedGroup(ConstrainedGroup& group)
 
   assert(isSymmetric(n, mA.data()));
 
+  if (mLcpRecording)
+    recordLcp(group);
+
   // Print LCP formulation
   //  dtdbg << "Before solve:" << std::endl;
   //  print(n, A, x, lo, hi, b, w, findex);
@@ -296,6 +385,9 @@ void BoxedLcpConstraintSolver::solveConstrainedGroup(ConstrainedGroup& group)
     mX.setZero();
   }
 
+  if (mLcpRecording)
+    mLcpRecords.back().mX = mX;
+
   // Print LCP formulation
   //  dtdbg << "After solve:" << std::endl;
   //  print(n, A, x, lo, hi, b, w, findex);
@@ -42,6 +42,37 @@ namespace constraint {
 class BoxedLcpConstraintSolver : public ConstraintSolver
 {
 public:
+  /// Boxed LCP of a ConstrainedGroup as solved by solveConstrainedGroup(),
+  /// together with the response of the Skeletons to each constraint impulse.
+  /// It is what differentiating the constraint impulses needs.
+  struct LcpRecord
+  {
+    /// Skeletons whose velocities the constraint impulses of the group change
+    std::vector<dynamics::SkeletonPtr> mSkeletons;
+
+    /// Changes of the generalized velocities of mSkeletons[k] caused by a
+    /// unit impulse of each constraint row. Each matrix has one row per DOF
+    /// of the Skeleton and one column per constraint row.
+    std::vector<Eigen::MatrixXd> mImpulseResponses;
+
+    /// LCP matrix including the constraint force mixing
+    Eigen::MatrixXd mA;
+
+    /// Constraint impulses solved by the LCP solver
+    Eigen::VectorXd mX;
+
+    /// Lower bounds, or the negative friction coefficient of the rows whose
+    /// mFIndex is not -1
+    Eigen::VectorXd mLo;
+
+    /// Upper bounds, or the friction coefficient of the rows whose mFIndex
+    /// is not -1
+    Eigen::VectorXd mHi;
+
+    /// Index of the normal row that bounds each friction row, or -1
+    Eigen::VectorXi mFIndex;
+  };
+
   /// Constructor
   ///
   /// \param[in] timeStep Simulation time step
@@ -97,7 +128,24 @@ public:
   /// failed
   ConstBoxedLcpSolverPtr getSecondaryBoxedLcpSolver() const;
 
+  /// Sets whether solve() records the boxed LCP of each ConstrainedGroup. This
+  /// costs one velocity copy per Skeleton and constraint row, so it's disabled
+  /// by default.
+  void setLcpRecording(bool recording);
+
+  /// Returns whether solve() records the boxed LCP of each ConstrainedGroup
+  bool isLcpRecording() const;
+
+  /// Returns the boxed LCPs recorded since the last call of clearLcpRecords()
+  const std::vector<LcpRecord>& getLcpRecords() const;
+
+  /// Clears the recorded boxed LCPs
+  void clearLcpRecords();
+
 protected:
+  /// Records the LCP terms of the group before the LCP solver modifies them
+  void recordLcp(ConstrainedGroup& group);
+
   // Documentation inherited.
   void solveConstrainedGroup(ConstrainedGroup& group) override;
 
@@ -154,6 +202,12 @@ protected:
   /// Cache data for boxed LCP formulation
   Eigen::VectorXi mOffset;
 
+  /// Whether solve() records the boxed LCP of each ConstrainedGroup
+  bool mLcpRecording;
+
+  /// Boxed LCPs recorded since the last call of clearLcpRecords()
+  std::vector<LcpRecord> mLcpRecords;
+
 #ifndef NDEBUG
 private:
   /// Return true if the matrix is symmetric
@@ -33,6 +33,7 @@
 #include "dart/constraint/ConstraintSolver.hpp"
 
 #include <algorithm>
+#include <unordered_set>
 
 #include "dart/collision/CollisionFilter.hpp"
 #include "dart/collision/CollisionGroup.hpp"
@@ -113,14 +114,38 @@ void ConstraintSolver::addSkeleton(const SkeletonPtr& skeleton)
 
   mCollisionGroup->subscribeTo(skeleton);
   mSkeletons.push_back(skeleton);
+  mSkeletonSet.insert(skeleton.get());
   mConstrainedGroups.reserve(mSkeletons.size());
 }
 
 //==============================================================================
 void ConstraintSolver::addSkeletons(const std::vector<SkeletonPtr>& skeletons)
 {
+  std::vector<ConstSkeletonPtr> added;
+  added.reserve(skeletons.size());
+
   for (const auto& skeleton : skeletons)
-    addSkeleton(skeleton);
+  {
+    assert(
+        skeleton
+        && "Null pointer skeleton is now allowed to add to ConstraintSover.");
+
+    if (!mSkeletonSet.insert(skeleton.get()).second)
+    {
+      dtwarn << "[ConstraintSolver::addSkeletons] Attempting to add "
+             << "skeleton '" << skeleton->getName()
+             << "', which already exists in the ConstraintSolver.\n";
+      continue;
+    }
+
+    mSkeletons.push_back(skeleton);
+    added.push_back(skeleton);
+  }
+
+  // Subscribing to all the skeletons at once lets the collision group register
+  // the new collision objects with the engine in a single batch.
+  mCollisionGroup->subscribeTo(added);
+  mConstrainedGroups.reserve(mSkeletons.size());
 }
 
 //==============================================================================
@@ -136,25 +161,59 @@ void ConstraintSolver::removeSkeleton(const SkeletonPtr& skeleton)
       skeleton
       && "Null pointer skeleton is now allowed to add to ConstraintSover.");
 
-  if (!containSkeleton(skeleton))
-  {
-    dtwarn << "[ConstraintSolver::removeSkeleton] Attempting to remove "
-           << "skeleton '" << skeleton->getName()
-           << "', which doesn't exist in the ConstraintSolver.\n";
-  }
-
-  mCollisionGroup->removeShapeFramesOf(skeleton.get());
-  mSkeletons.erase(
-      remove(mSkeletons.begin(), mSkeletons.end(), skeleton), mSkeletons.end());
-  mConstrainedGroups.reserve(mSkeletons.size());
+  removeSkeletons({skeleton});
 }
 
 //==============================================================================
 void ConstraintSolver::removeSkeletons(
     const std::vector<SkeletonPtr>& skeletons)
 {
+  std::unordered_set<const Skeleton*> removed;
+  removed.reserve(skeletons.size());
+
+  std::vector<const ShapeFrame*> shapeFrames;
   for (const auto& skeleton : skeletons)
-    removeSkeleton(skeleton);
+  {
+    assert(
+        skeleton
+        && "Null pointer skeleton is now allowed to add to ConstraintSover.");
+
+    if (!containSkeleton(skeleton))
+    {
+      dtwarn << "[ConstraintSolver::removeSkeleton] Attempting to remove "
+             << "skeleton '" << skeleton->getName()
+             << "', which doesn't exist in the ConstraintSolver.\n";
+    }
+
+    if (!removed.insert(skeleton.get()).second)
+      continue;
+
+    for (std::size_t i = 0u; i < skeleton->getNumBodyNodes(); ++i)
+    {
+      const auto collisionShapeNodes
+          = skeleton->getBodyNode(i)->getShapeNodesWith<CollisionAspect>();
+      shapeFrames.insert(
+          shapeFrames.end(),
+          collisionShapeNodes.begin(),
+          collisionShapeNodes.end());
+    }
+  }
+
+  mCollisionGroup->removeShapeFrames(shapeFrames);
+
+  mSkeletons.erase(
+      std::remove_if(
+          mSkeletons.begin(),
+          mSkeletons.end(),
+          [&](const SkeletonPtr& skeleton) {
+            return removed.count(skeleton.get()) > 0;
+          }),
+      mSkeletons.end());
+
+  for (const auto* skeleton : removed)
+    mSkeletonSet.erase(skeleton);
+
+  mConstrainedGroups.reserve(mSkeletons.size());
 }
 
 //==============================================================================
@@ -162,6 +221,7 @@ void ConstraintSolver::removeAllSkeletons()
 {
   mCollisionGroup->removeAllShapeFrames();
   mSkeletons.clear();
+  mSkeletonSet.clear();
 }
 
 //==============================================================================
@@ -398,15 +458,7 @@ bool ConstraintSolver::containSkeleton(const ConstSkeletonPtr& _skeleton) const
   assert(
       _skeleton != nullptr && "Not allowed to insert null pointer skeleton.");
 
-  for (std::vector<SkeletonPtr>::const_iterator it = mSkeletons.begin();
-       it != mSkeletons.end();
-       ++it)
-  {
-    if ((*it) == _skeleton)
-      return true;
-  }
-
-  return false;
+  return mSkeletonSet.count(_skeleton.get()) > 0;
 }
 
 //==============================================================================
@@ -415,6 +467,7 @@ bool ConstraintSolver::checkAndAddSkeleton(const SkeletonPtr& skeleton)
   if (!containSkeleton(skeleton))
   {
     mSkeletons.push_back(skeleton);
+    mSkeletonSet.insert(skeleton.get());
     return true;
   }
   else
@@ -474,6 +527,12 @@ void ConstraintSolver::updateConstraints()
 
   mCollisionGroup->collide(mCollisionOption, &mCollisionResult);
 
+  // Contacts that fast continuous ShapeNodes are about to make within this
+  // time step, so that they cannot pass through thin objects between steps
+  const auto numDiscreteContacts = mCollisionResult.getNumContacts();
+  mCollisionGroup->collideContinuous(
+      mTimeStep, mCollisionOption, &mCollisionResult);
+
   // Destroy previous contact constraints
   mContactConstraints.clear();
 
@@ -527,10 +586,14 @@ void ConstraintSolver::updateConstraints()
     DART_SUPPRESS_DEPRECATED_END
 
     // If penetration depth is negative, then the collision isn't really
-    // happening and the contact point should be ignored.
+    // happening and the contact point should be ignored, unless it is a
+    // speculative contact found by collideContinuous(). SoftContactConstraint
+    // has no notion of the gap that is left, so speculative contacts are only
+    // kept between rigid bodies.
     // TODO(MXG): Investigate ways to leverage the proximity information of a
     //            negative penetration to improve collision handling.
-    if (contact.penetrationDepth < 0.0)
+    if (contact.penetrationDepth < 0.0
+        && (i < numDiscreteContacts || isSoftContact(contact)))
       continue;
 
     if (isSoftContact(contact))
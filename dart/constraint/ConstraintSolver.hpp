@@ -33,6 +33,7 @@
 #ifndef DART_CONSTRAINT_CONSTRAINTSOVER_HPP_
 #define DART_CONSTRAINT_CONSTRAINTSOVER_HPP_
 
+#include <unordered_set>
 #include <vector>
 
 #include <Eigen/Dense>
@@ -232,6 +233,9 @@ protected:
   /// Skeleton list
   std::vector<dynamics::SkeletonPtr> mSkeletons;
 
+  /// The skeletons in mSkeletons, for constant time lookups
+  std::unordered_set<const dynamics::Skeleton*> mSkeletonSet;
+
   /// Contact constraints those are automatically created
   std::vector<ContactConstraintPtr> mContactConstraints;
 
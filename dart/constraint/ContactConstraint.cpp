@@ -460,7 +460,13 @@ void ContactConstraint::getInformation(ConstraintInfo* info)
     //------------------------------------------------------------------------
     // A. Penetration correction
     double bouncingVelocity = mContact.penetrationDepth - mErrorAllowance;
-    if (bouncingVelocity < 0.0)
+    if (mContact.penetrationDepth < 0.0)
+    {
+      // Speculative contact: the bodies may still approach each other by the
+      // remaining gap within this time step
+      bouncingVelocity = mContact.penetrationDepth * info->invTimeStep;
+    }
+    else if (bouncingVelocity < 0.0)
     {
       bouncingVelocity = 0.0;
     }
@@ -471,8 +477,8 @@ void ContactConstraint::getInformation(ConstraintInfo* info)
         bouncingVelocity = mMaxErrorReductionVelocity;
     }
 
-    // B. Restitution
-    if (mIsBounceOn)
+    // B. Restitution, which waits until the bodies actually touch
+    if (mIsBounceOn && mContact.penetrationDepth >= 0.0)
     {
       double& negativeRelativeVel = info->b[0];
       double restitutionVel = negativeRelativeVel * mRestitutionCoeff;
@@ -517,7 +523,13 @@ void ContactConstraint::getInformation(ConstraintInfo* info)
     //------------------------------------------------------------------------
     // A. Penetration correction
     double bouncingVelocity = mContact.penetrationDepth - DART_ERROR_ALLOWANCE;
-    if (bouncingVelocity < 0.0)
+    if (mContact.penetrationDepth < 0.0)
+    {
+      // Speculative contact: the bodies may still approach each other by the
+      // remaining gap within this time step
+      bouncingVelocity = mContact.penetrationDepth * info->invTimeStep;
+    }
+    else if (bouncingVelocity < 0.0)
     {
       bouncingVelocity = 0.0;
     }
@@ -528,8 +540,8 @@ void ContactConstraint::getInformation(ConstraintInfo* info)
         bouncingVelocity = mMaxErrorReductionVelocity;
     }
 
-    // B. Restitution
-    if (mIsBounceOn)
+    // B. Restitution, which waits until the bodies actually touch
+    if (mIsBounceOn && mContact.penetrationDepth >= 0.0)
     {
       double& negativeRelativeVel = info->b[0];
       double restitutionVel = negativeRelativeVel * mRestitutionCoeff;
@@ -113,8 +113,8 @@ SoftContactConstraint::SoftContactConstraint(
   // Select colling point mass based on trimesh ID
   if (mSoftBodyNode1)
   {
-    if (contact.collisionObject1->getShape()->getType()
-        == dynamics::SoftMeshShape::getStaticType())
+    if (contact.collisionObject1->getShape()->getTypeId()
+        == dynamics::SoftMeshShape::getStaticTypeId())
     {
       mPointMass1 = selectCollidingPointMass(
           mSoftBodyNode1, contact.point, contact.triID1);
@@ -123,8 +123,8 @@ SoftContactConstraint::SoftContactConstraint(
   }
   if (mSoftBodyNode2)
   {
-    if (contact.collisionObject2->getShape()->getType()
-        == dynamics::SoftMeshShape::getStaticType())
+    if (contact.collisionObject2->getShape()->getTypeId()
+        == dynamics::SoftMeshShape::getStaticTypeId())
     {
       mPointMass2 = selectCollidingPointMass(
           mSoftBodyNode2, contact.point, contact.triID2);
@@ -1523,6 +1523,8 @@ void BodyNode::dirtyTransform()
     SET_FLAGS(mGravityForces);
     SET_FLAGS(mCoriolisAndGravityForces);
     SET_FLAGS(mExternalForces);
+    SET_FLAGS(mCentroidalMomentumMatrix);
+    SET_FLAGS(mCentroidalMomentumBias);
   }
 
   // Child BodyNodes and other generic Entities are notified separately to allow
@@ -1550,6 +1552,7 @@ void BodyNode::dirtyVelocity()
   {
     SET_FLAGS(mCoriolisForces);
     SET_FLAGS(mCoriolisAndGravityForces);
+    SET_FLAGS(mCentroidalMomentumBias);
   }
 
   // Child BodyNodes and other generic Entities are notified separately to allow
@@ -1614,6 +1617,7 @@ void BodyNode::dirtyCoriolisForces()
 {
   SKEL_SET_FLAGS(mCoriolisForces);
   SKEL_SET_FLAGS(mCoriolisAndGravityForces);
+  SKEL_SET_FLAGS(mCentroidalMomentumBias);
 }
 
 //==============================================================================
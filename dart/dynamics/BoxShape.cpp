@@ -63,6 +63,12 @@ const std::string& BoxShape::getStaticType()
   return type;
 }
 
+//==============================================================================
+Shape::TypeId BoxShape::getTypeId() const
+{
+  return getStaticTypeId();
+}
+
 //==============================================================================
 double BoxShape::computeVolume(const Eigen::Vector3d& size)
 {
@@ -53,6 +53,15 @@ public:
   /// Returns shape type for this class
   static const std::string& getStaticType();
 
+  // Documentation inherited.
+  TypeId getTypeId() const override;
+
+  /// Returns shape type ID for this class
+  static constexpr TypeId getStaticTypeId()
+  {
+    return TypeId::BOX;
+  }
+
   /// \brief Set size of this box.
   void setSize(const Eigen::Vector3d& _size);
 
@@ -61,6 +61,12 @@ const std::string& CapsuleShape::getStaticType()
   return type;
 }
 
+//==============================================================================
+Shape::TypeId CapsuleShape::getTypeId() const
+{
+  return getStaticTypeId();
+}
+
 //==============================================================================
 double CapsuleShape::getRadius() const
 {
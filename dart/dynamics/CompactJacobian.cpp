@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "dart/dynamics/CompactJacobian.hpp"
+
+#include <cassert>
+
+namespace dart {
+namespace dynamics {
+
+//==============================================================================
+CompactJacobian::CompactJacobian(std::size_t _numDofs)
+  : mNumDofs(_numDofs), mBlock(6, 0)
+{
+  // Do nothing
+}
+
+//==============================================================================
+CompactJacobian::CompactJacobian(
+    std::size_t _numDofs,
+    const std::vector<std::size_t>& _indices,
+    const math::Jacobian& _block)
+  : mNumDofs(_numDofs), mIndices(_indices), mBlock(_block)
+{
+  assert(static_cast<std::size_t>(mBlock.cols()) == mIndices.size());
+#ifndef NDEBUG
+  for (const std::size_t index : mIndices)
+    assert(index < mNumDofs);
+#endif
+}
+
+//==============================================================================
+std::size_t CompactJacobian::getNumDofs() const
+{
+  return mNumDofs;
+}
+
+//==============================================================================
+std::size_t CompactJacobian::getNumDependentDofs() const
+{
+  return mIndices.size();
+}
+
+//==============================================================================
+const std::vector<std::size_t>& CompactJacobian::getIndices() const
+{
+  return mIndices;
+}
+
+//==============================================================================
+const math::Jacobian& CompactJacobian::getBlock() const
+{
+  return mBlock;
+}
+
+//==============================================================================
+math::Jacobian& CompactJacobian::getBlock()
+{
+  return mBlock;
+}
+
+//==============================================================================
+math::Jacobian CompactJacobian::toDense() const
+{
+  math::Jacobian J = math::Jacobian::Zero(6, mNumDofs);
+  for (std::size_t i = 0; i < mIndices.size(); ++i)
+    J.col(mIndices[i]) = mBlock.col(i);
+
+  return J;
+}
+
+//==============================================================================
+Eigen::Vector6d CompactJacobian::multiply(const Eigen::VectorXd& _dq) const
+{
+  assert(static_cast<std::size_t>(_dq.size()) == mNumDofs);
+
+  Eigen::Vector6d result = Eigen::Vector6d::Zero();
+  for (std::size_t i = 0; i < mIndices.size(); ++i)
+    result.noalias() += mBlock.col(i) * _dq[mIndices[i]];
+
+  return result;
+}
+
+//==============================================================================
+Eigen::VectorXd CompactJacobian::transposeMultiply(
+    const Eigen::Vector6d& _f) const
+{
+  Eigen::VectorXd result = Eigen::VectorXd::Zero(mNumDofs);
+  addTransposeMultiplyTo(_f, result);
+
+  return result;
+}
+
+//==============================================================================
+void CompactJacobian::addTransposeMultiplyTo(
+    const Eigen::Vector6d& _f, Eigen::VectorXd& _result) const
+{
+  assert(static_cast<std::size_t>(_result.size()) == mNumDofs);
+
+  for (std::size_t i = 0; i < mIndices.size(); ++i)
+    _result[mIndices[i]] += mBlock.col(i).dot(_f);
+}
+
+//==============================================================================
+Eigen::Matrix6d CompactJacobian::multiplyInvMass(
+    const Eigen::MatrixXd& _invMassMatrix) const
+{
+  return multiplyInvMass(_invMassMatrix, *this);
+}
+
+//==============================================================================
+Eigen::Matrix6d CompactJacobian::multiplyInvMass(
+    const Eigen::MatrixXd& _invMassMatrix, const CompactJacobian& _other) const
+{
+  assert(static_cast<std::size_t>(_invMassMatrix.rows()) == mNumDofs);
+  assert(static_cast<std::size_t>(_invMassMatrix.cols()) == mNumDofs);
+  assert(_other.mNumDofs == mNumDofs);
+
+  // M^{-1} * _other^T restricted to the rows of this Jacobian: k x 6
+  const std::size_t numRows = mIndices.size();
+  const std::size_t numCols = _other.mIndices.size();
+  Eigen::Matrix<double, Eigen::Dynamic, 6> invMassOtherT
+      = Eigen::Matrix<double, Eigen::Dynamic, 6>::Zero(numRows, 6);
+
+  for (std::size_t j = 0; j < numCols; ++j)
+  {
+    const std::size_t col = _other.mIndices[j];
+    for (std::size_t i = 0; i < numRows; ++i)
+    {
+      invMassOtherT.row(i).noalias() += _invMassMatrix(mIndices[i], col)
+                                        * _other.mBlock.col(j).transpose();
+    }
+  }
+
+  return mBlock * invMassOtherT;
+}
+
+} // namespace dynamics
+} // namespace dart
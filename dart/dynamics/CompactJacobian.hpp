@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef DART_DYNAMICS_COMPACTJACOBIAN_HPP_
+#define DART_DYNAMICS_COMPACTJACOBIAN_HPP_
+
+#include <vector>
+
+#include "dart/math/MathTypes.hpp"
+
+namespace dart {
+namespace dynamics {
+
+/// CompactJacobian stores a spatial Jacobian of a Skeleton by its nonzero
+/// columns only: a list of generalized coordinate indices (in the Skeleton)
+/// and a 6 x k block holding the columns for those coordinates. The Jacobian
+/// of a JacobianNode only depends on the coordinates of its ancestor Joints,
+/// so k is usually much smaller than the number of coordinates of the
+/// Skeleton.
+///
+/// The products below only touch the k stored columns. The full-width vectors
+/// and matrices that they accept must be sized by getNumDofs().
+class CompactJacobian
+{
+public:
+  /// Construct a zero Jacobian for a Skeleton with _numDofs coordinates
+  explicit CompactJacobian(std::size_t _numDofs = 0u);
+
+  /// Construct from a list of coordinate indices and the matching columns.
+  /// The indices must be distinct and less than _numDofs.
+  CompactJacobian(
+      std::size_t _numDofs,
+      const std::vector<std::size_t>& _indices,
+      const math::Jacobian& _block);
+
+  /// Get the number of columns of the dense version of this Jacobian
+  std::size_t getNumDofs() const;
+
+  /// Get the number of stored (dependent) columns
+  std::size_t getNumDependentDofs() const;
+
+  /// Get the coordinate indices of the stored columns
+  const std::vector<std::size_t>& getIndices() const;
+
+  /// Get the stored 6 x k block
+  const math::Jacobian& getBlock() const;
+
+  /// Get the stored 6 x k block
+  math::Jacobian& getBlock();
+
+  /// Get the dense 6 x getNumDofs() version of this Jacobian
+  math::Jacobian toDense() const;
+
+  /// Compute J * _dq where _dq holds all the coordinates of the Skeleton
+  Eigen::Vector6d multiply(const Eigen::VectorXd& _dq) const;
+
+  /// Compute J^T * _f. The result holds all the coordinates of the Skeleton.
+  Eigen::VectorXd transposeMultiply(const Eigen::Vector6d& _f) const;
+
+  /// Add J^T * _f to _result, which holds all the coordinates of the Skeleton
+  void addTransposeMultiplyTo(
+      const Eigen::Vector6d& _f, Eigen::VectorXd& _result) const;
+
+  /// Compute J * M^{-1} * J^T given the inverse mass matrix of the Skeleton
+  Eigen::Matrix6d multiplyInvMass(const Eigen::MatrixXd& _invMassMatrix) const;
+
+  /// Compute J * M^{-1} * _other^T given the inverse mass matrix of the
+  /// Skeleton. Both Jacobians must belong to the same Skeleton.
+  Eigen::Matrix6d multiplyInvMass(
+      const Eigen::MatrixXd& _invMassMatrix,
+      const CompactJacobian& _other) const;
+
+protected:
+  /// Number of coordinates of the Skeleton
+  std::size_t mNumDofs;
+
+  /// Coordinate indices of the stored columns
+  std::vector<std::size_t> mIndices;
+
+  /// Stored columns
+  math::Jacobian mBlock;
+};
+
+} // namespace dynamics
+} // namespace dart
+
+#endif // DART_DYNAMICS_COMPACTJACOBIAN_HPP_
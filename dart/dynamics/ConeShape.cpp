@@ -61,6 +61,12 @@ const std::string& ConeShape::getStaticType()
   return type;
 }
 
+//==============================================================================
+Shape::TypeId ConeShape::getTypeId() const
+{
+  return getStaticTypeId();
+}
+
 //==============================================================================
 double ConeShape::getRadius() const
 {
@@ -54,6 +54,15 @@ public:
   /// Get shape type string for this shape.
   static const std::string& getStaticType();
 
+  // Documentation inherited.
+  TypeId getTypeId() const override;
+
+  /// Returns shape type ID for this class
+  static constexpr TypeId getStaticTypeId()
+  {
+    return TypeId::CONE;
+  }
+
   /// Get the radius of the circular base.
   double getRadius() const;
 
@@ -59,6 +59,12 @@ const std::string& CylinderShape::getStaticType()
   return type;
 }
 
+//==============================================================================
+Shape::TypeId CylinderShape::getTypeId() const
+{
+  return getStaticTypeId();
+}
+
 //==============================================================================
 double CylinderShape::getRadius() const
 {
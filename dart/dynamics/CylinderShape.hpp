@@ -50,6 +50,15 @@ public:
   /// Returns shape type for this class
   static const std::string& getStaticType();
 
+  // Documentation inherited.
+  TypeId getTypeId() const override;
+
+  /// Returns shape type ID for this class
+  static constexpr TypeId getStaticTypeId()
+  {
+    return TypeId::CYLINDER;
+  }
+
   /// \brief
   double getRadius() const;
 
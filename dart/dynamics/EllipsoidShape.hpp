@@ -55,6 +55,15 @@ public:
   /// Returns shape type for this class
   static const std::string& getStaticType();
 
+  // Documentation inherited.
+  TypeId getTypeId() const override;
+
+  /// Returns shape type ID for this class
+  static constexpr TypeId getStaticTypeId()
+  {
+    return TypeId::ELLIPSOID;
+  }
+
   /// \brief Set diameters of this ellipsoid.
   /// \deprecated Deprecated in 6.2. Please use setDiameters() instead.
   DART_DEPRECATED(6.2)
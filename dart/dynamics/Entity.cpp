@@ -140,7 +140,8 @@ void Entity::dirtyTransform()
 
   // The actual transform hasn't updated yet. But when its getter is called,
   // the transformation will be updated automatically.
-  mTransformUpdatedSignal.raise(this);
+  if (mTransformUpdatedSignal.getNumConnections() > 0)
+    mTransformUpdatedSignal.raise(this);
 }
 
 //==============================================================================
@@ -162,7 +163,8 @@ void Entity::dirtyVelocity()
 
   // The actual velocity hasn't updated yet. But when its getter is called,
   // the velocity will be updated automatically.
-  mVelocityChangedSignal.raise(this);
+  if (mVelocityChangedSignal.getNumConnections() > 0)
+    mVelocityChangedSignal.raise(this);
 }
 
 //==============================================================================
@@ -184,7 +186,8 @@ void Entity::dirtyAcceleration()
 
   // The actual acceleration hasn't updated yet. But when its getter is called,
   // the acceleration will be updated automatically.
-  mAccelerationChangedSignal.raise(this);
+  if (mAccelerationChangedSignal.getNumConnections() > 0)
+    mAccelerationChangedSignal.raise(this);
 }
 
 //==============================================================================
@@ -193,6 +196,14 @@ bool Entity::needsAccelerationUpdate() const
   return mNeedAccelerationUpdate;
 }
 
+//==============================================================================
+bool Entity::hasConnectedUpdateSignals() const
+{
+  return mTransformUpdatedSignal.getNumConnections() > 0
+         || mVelocityChangedSignal.getNumConnections() > 0
+         || mAccelerationChangedSignal.getNumConnections() > 0;
+}
+
 //==============================================================================
 Entity::Entity(ConstructFrameTag)
   : mParentFrame(nullptr),
@@ -148,6 +148,10 @@ public:
   /// Returns true iff an acceleration update is needed for this Entity
   bool needsAccelerationUpdate() const;
 
+  /// Returns true iff a slot is connected to the transform, velocity or
+  /// acceleration signal of this Entity
+  bool hasConnectedUpdateSignals() const;
+
 protected:
   /// Used when constructing a Frame class, because the Frame constructor will
   /// take care of setting up the parameters you pass into it
@@ -97,14 +97,28 @@ const Eigen::Isometry3d& Frame::getWorldTransform() const
 
   if (mNeedTransformUpdate)
   {
-    mWorldTransform
+    const Eigen::Isometry3d worldTransform
         = mParentFrame->getWorldTransform() * getRelativeTransform();
+    if (worldTransform.matrix() != mWorldTransform.matrix())
+    {
+      mWorldTransform = worldTransform;
+      ++mWorldTransformVersion;
+    }
     mNeedTransformUpdate = false;
   }
 
   return mWorldTransform;
 }
 
+//==============================================================================
+std::size_t Frame::getWorldTransformVersion() const
+{
+  // Bring the world transform up to date so that a pending change is counted
+  getWorldTransform();
+
+  return mWorldTransformVersion;
+}
+
 //==============================================================================
 Eigen::Isometry3d Frame::getTransform(const Frame* _withRespectTo) const
 {
@@ -483,8 +497,10 @@ void Frame::dirtyTransform()
   dirtyVelocity(); // Global Velocity depends on the Global Transform
 
   // Always trigger the signal, in case a new subscriber has registered in the
-  // time since the last signal
-  mTransformUpdatedSignal.raise(this);
+  // time since the last signal. Skip it when nobody is listening, which is the
+  // common case during whole-skeleton state writes.
+  if (mTransformUpdatedSignal.getNumConnections() > 0)
+    mTransformUpdatedSignal.raise(this);
 
   // If we already know we need to update, just quit
   if (mNeedTransformUpdate)
@@ -503,7 +519,8 @@ void Frame::dirtyVelocity()
 
   // Always trigger the signal, in case a new subscriber has registered in the
   // time since the last signal
-  mVelocityChangedSignal.raise(this);
+  if (mVelocityChangedSignal.getNumConnections() > 0)
+    mVelocityChangedSignal.raise(this);
 
   // If we already know we need to update, just quit
   if (mNeedVelocityUpdate)
@@ -520,7 +537,8 @@ void Frame::dirtyAcceleration()
 {
   // Always trigger the signal, in case a new subscriber has registered in the
   // time since the last signal
-  mAccelerationChangedSignal.raise(this);
+  if (mAccelerationChangedSignal.getNumConnections() > 0)
+    mAccelerationChangedSignal.raise(this);
 
   // If we already know we need to update, just quit
   if (mNeedAccelerationUpdate)
@@ -536,6 +554,7 @@ void Frame::dirtyAcceleration()
 Frame::Frame(Frame* _refFrame)
   : Entity(ConstructFrame),
     mWorldTransform(Eigen::Isometry3d::Identity()),
+    mWorldTransformVersion(0u),
     mVelocity(Eigen::Vector6d::Zero()),
     mAcceleration(Eigen::Vector6d::Zero()),
     mAmWorld(false),
@@ -553,7 +572,10 @@ Frame::Frame() : Frame(ConstructAbstract)
 
 //==============================================================================
 Frame::Frame(ConstructAbstractTag)
-  : Entity(Entity::ConstructAbstract), mAmWorld(false), mAmShapeFrame(false)
+  : Entity(Entity::ConstructAbstract),
+    mWorldTransformVersion(0u),
+    mAmWorld(false),
+    mAmShapeFrame(false)
 {
   dterr << "[Frame::constructor] You are calling a constructor for the Frame "
         << "class which is only meant to be used by pure abstract classes. If "
@@ -619,6 +641,7 @@ void Frame::processRemovedEntity(Entity*)
 Frame::Frame(ConstructWorldTag)
   : Entity(this, true),
     mWorldTransform(Eigen::Isometry3d::Identity()),
+    mWorldTransformVersion(0u),
     mVelocity(Eigen::Vector6d::Zero()),
     mAcceleration(Eigen::Vector6d::Zero()),
     mAmWorld(true),
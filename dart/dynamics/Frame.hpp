@@ -85,6 +85,11 @@ public:
   /// Get the transform of this Frame with respect to the World Frame
   const Eigen::Isometry3d& getWorldTransform() const;
 
+  /// Get a number that changes whenever the world transform of this Frame
+  /// changes. Comparing it with a previously stored value is a cheap way to
+  /// tell whether the Frame has moved since then.
+  std::size_t getWorldTransformVersion() const;
+
   /// Get the transform of this Frame with respect to some other Frame
   Eigen::Isometry3d getTransform(
       const Frame* _withRespectTo = Frame::World()) const;
@@ -307,6 +312,10 @@ protected:
   /// Do not use directly! Use getWorldTransform() to access this quantity
   mutable Eigen::Isometry3d mWorldTransform;
 
+  /// Incremented by getWorldTransform() whenever the recomputed world transform
+  /// differs from the previous one
+  mutable std::size_t mWorldTransformVersion;
+
   /// Total velocity of this Frame, in the coordinates of this Frame
   ///
   /// Do not use directly! Use getSpatialVelocity() to access this quantity
@@ -521,6 +521,18 @@ protected:
   // Documentation inherited
   void registerDofs() override;
 
+  // Documentation inherited
+  bool copyPositionsFrom(
+      const Eigen::VectorXd& values, std::size_t offset) override;
+
+  // Documentation inherited
+  bool copyVelocitiesFrom(
+      const Eigen::VectorXd& values, std::size_t offset) override;
+
+  // Documentation inherited
+  bool copyAccelerationsFrom(
+      const Eigen::VectorXd& values, std::size_t offset) override;
+
   //----------------------------------------------------------------------------
   /// \{ \name Recursive dynamics routines
   //----------------------------------------------------------------------------
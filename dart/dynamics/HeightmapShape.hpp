@@ -33,6 +33,9 @@
 #ifndef DART_DYNAMICS_HEIGHTMAPSHAPE_HPP_
 #define DART_DYNAMICS_HEIGHTMAPSHAPE_HPP_
 
+#include <type_traits>
+#include <vector>
+
 #include "dart/dynamics/Shape.hpp"
 
 namespace dart {
@@ -64,6 +67,16 @@ public:
   /// Returns shape type for this class
   static const std::string& getStaticType();
 
+  // Documentation inherited.
+  TypeId getTypeId() const override;
+
+  /// Returns shape type ID for this class
+  static constexpr TypeId getStaticTypeId()
+  {
+    return std::is_same<S, float>::value ? TypeId::HEIGHTMAP_FLOAT
+                                         : TypeId::HEIGHTMAP_DOUBLE;
+  }
+
   /// \copydoc Shape::computeInertia()
   ///
   /// This base class computes the intertia based on the bounding box.
@@ -128,7 +141,9 @@ public:
   /// Returns the height field.
   const HeightField& getHeightField() const;
 
-  /// Returns the modified height field. See also setHeightField().
+  /// Returns the modified height field. See also setHeightField(). The
+  /// min/max heights and the height pyramid are computed again the next time
+  /// they are queried.
   HeightField& getHeightFieldModifiable() const;
 
   /// Flips the y values in the height field.
@@ -140,12 +155,33 @@ public:
   /// Returns the height dimension of the height field
   std::size_t getDepth() const;
 
-  /// Returns the minimum height set by setHeightField()
+  /// Returns the minimum height of the height field
   S getMinHeight() const;
 
-  /// Returns the maximum height set by setHeightField()
+  /// Returns the maximum height of the height field
   S getMaxHeight() const;
 
+  /// Returns the number of cells along each side of the tiles at the finest
+  /// level of the min/max height pyramid.
+  static constexpr std::size_t getPyramidTileSize()
+  {
+    return 8u;
+  }
+
+  /// Returns the number of levels of the min/max height pyramid. The tiles of
+  /// level \e l are made of 2^l x 2^l tiles of the finest level, and the
+  /// coarsest level has a single tile.
+  std::size_t getNumPyramidLevels() const;
+
+  /// Returns the minimum heights of the tiles of the given pyramid level,
+  /// including the borders they share with their neighbors. Rows and columns
+  /// follow the ones of the height field.
+  const HeightField& getPyramidMinHeights(std::size_t level) const;
+
+  /// Returns the maximum heights of the tiles of the given pyramid level. See
+  /// also getPyramidMinHeights().
+  const HeightField& getPyramidMaxHeights(std::size_t level) const;
+
   /// Set the color of this arrow
   void notifyColorUpdated(const Eigen::Vector4d& color) override;
 
@@ -165,6 +201,10 @@ protected:
   /// \param[out] max Maxinum of box
   void computeBoundingBox(Eigen::Vector3d& min, Eigen::Vector3d& max) const;
 
+  /// Computes the min/max heights and the min/max height pyramid from the
+  /// height field.
+  void updatePyramid() const;
+
 private:
   /// Scale of the heightmap
   Vector3 mScale;
@@ -173,12 +213,24 @@ private:
   mutable HeightField mHeights;
 
   /// Minimum heights.
-  /// Is computed each time the height field is set with setHeightField().
-  S mMinHeight;
+  /// Is computed together with the pyramid.
+  mutable S mMinHeight;
 
   /// Maximum heights.
-  /// Is computed each time the height field is set with setHeightField().
-  S mMaxHeight;
+  /// Is computed together with the pyramid.
+  mutable S mMaxHeight;
+
+  /// Minimum heights of the tiles of each pyramid level, from the finest one.
+  /// Is computed each time the height field is set or flipped.
+  mutable std::vector<HeightField> mPyramidMinHeights;
+
+  /// Maximum heights of the tiles of each pyramid level, from the finest one.
+  mutable std::vector<HeightField> mPyramidMaxHeights;
+
+  /// Whether the height field may have been changed through
+  /// getHeightFieldModifiable() since the min/max heights and the pyramid were
+  /// computed
+  mutable bool mIsPyramidDirty;
 };
 
 using HeightmapShapef = HeightmapShape<float>;
@@ -0,0 +1,457 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/dynamics/InverseDynamics.hpp"
+
+#include <algorithm>
+#include <typeinfo>
+
+#include "dart/common/ThreadPool.hpp"
+#include "dart/dynamics/BallJoint.hpp"
+#include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/FreeJoint.hpp"
+#include "dart/dynamics/PrismaticJoint.hpp"
+#include "dart/dynamics/RevoluteJoint.hpp"
+#include "dart/dynamics/ScrewJoint.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+#include "dart/dynamics/UniversalJoint.hpp"
+#include "dart/dynamics/WeldJoint.hpp"
+#include "dart/math/Constants.hpp"
+#include "dart/math/Geometry.hpp"
+
+namespace dart {
+namespace dynamics {
+
+//==============================================================================
+InverseDynamics::InverseDynamics(
+    const Skeleton& _skel,
+    bool _withExternalForces,
+    bool _withDampingForces,
+    bool _withSpringForces)
+  : mGravity(Eigen::Vector3d::Zero()),
+    mTimeStep(0.0),
+    mWithExternalForces(_withExternalForces),
+    mWithDampingForces(_withDampingForces),
+    mWithSpringForces(_withSpringForces)
+{
+  update(_skel);
+}
+
+//==============================================================================
+bool InverseDynamics::isSupported(const Skeleton& _skel)
+{
+  if (_skel.getNumSoftBodyNodes() > 0u)
+    return false;
+
+  for (std::size_t i = 0u; i < _skel.getNumBodyNodes(); ++i)
+  {
+    const BodyNode* bodyNode = _skel.getBodyNode(i);
+    const BodyNode* parent = bodyNode->getParentBodyNode();
+
+    // The recursion relies on parents being indexed before their children
+    if (parent && parent->getIndexInSkeleton() >= i)
+      return false;
+
+    // Derived Joint types may change the kinematics, so only the exact types
+    // are accepted
+    const std::type_info& type = typeid(*bodyNode->getParentJoint());
+    if (type != typeid(WeldJoint) && type != typeid(RevoluteJoint)
+        && type != typeid(PrismaticJoint) && type != typeid(ScrewJoint)
+        && type != typeid(UniversalJoint) && type != typeid(BallJoint)
+        && type != typeid(FreeJoint))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+//==============================================================================
+void InverseDynamics::update(const Skeleton& _skel)
+{
+  assert(isSupported(_skel));
+
+  const std::size_t numBodies = _skel.getNumBodyNodes();
+  const int numDofs = static_cast<int>(_skel.getNumDofs());
+
+  mBodies.resize(numBodies);
+  mDampingCoefficients.setZero(numDofs);
+  mSpringStiffnesses.setZero(numDofs);
+  mRestPositions.setZero(numDofs);
+  mGravity = _skel.getGravity();
+  mTimeStep = _skel.getTimeStep();
+
+  for (std::size_t i = 0u; i < numBodies; ++i)
+  {
+    const BodyNode* bodyNode = _skel.getBodyNode(i);
+    const Joint* joint = bodyNode->getParentJoint();
+    const BodyNode* parent = bodyNode->getParentBodyNode();
+    Body& body = mBodies[i];
+
+    body.mParent = parent ? static_cast<int>(parent->getIndexInSkeleton()) : -1;
+    body.mNumDofs = static_cast<int>(joint->getNumDofs());
+    body.mDofStart
+        = body.mNumDofs > 0 ? static_cast<int>(joint->getIndexInSkeleton(0u))
+                            : 0;
+    body.mParentToJoint = joint->getTransformFromParentBodyNode();
+    body.mChildToJoint = joint->getTransformFromChildBodyNode();
+    body.mJointToChild = body.mChildToJoint.inverse();
+    body.mAxis1.setZero();
+    body.mAxis2.setZero();
+
+    const Eigen::Isometry3d& childToJoint = body.mChildToJoint;
+    const std::type_info& type = typeid(*joint);
+    if (type == typeid(RevoluteJoint))
+    {
+      body.mJointType = JointType::REVOLUTE;
+      body.mAxis1 = static_cast<const RevoluteJoint*>(joint)->getAxis();
+      body.mJ = math::AdTAngular(childToJoint, body.mAxis1);
+    }
+    else if (type == typeid(PrismaticJoint))
+    {
+      body.mJointType = JointType::PRISMATIC;
+      body.mAxis1 = static_cast<const PrismaticJoint*>(joint)->getAxis();
+      body.mJ = math::AdTLinear(childToJoint, body.mAxis1);
+    }
+    else if (type == typeid(ScrewJoint))
+    {
+      const ScrewJoint* screwJoint = static_cast<const ScrewJoint*>(joint);
+      body.mJointType = JointType::SCREW;
+
+      // mAxis1 holds the angular part and mAxis2 the linear part of the screw
+      body.mAxis1 = screwJoint->getAxis();
+      body.mAxis2 = screwJoint->getAxis() * screwJoint->getPitch()
+                    / (2.0 * math::constantsd::pi());
+
+      Eigen::Vector6d S;
+      S << body.mAxis1, body.mAxis2;
+      body.mJ = math::AdT(childToJoint, S);
+    }
+    else if (type == typeid(UniversalJoint))
+    {
+      const UniversalJoint* universalJoint
+          = static_cast<const UniversalJoint*>(joint);
+      body.mJointType = JointType::UNIVERSAL;
+      body.mAxis1 = universalJoint->getAxis1();
+      body.mAxis2 = universalJoint->getAxis2();
+
+      // Only the second column is constant
+      body.mJ.setZero(6, 2);
+      body.mJ.col(1) = math::AdTAngular(childToJoint, body.mAxis2);
+    }
+    else if (type == typeid(BallJoint))
+    {
+      body.mJointType = JointType::BALL;
+      body.mJ = math::getAdTMatrix(childToJoint).leftCols<3>();
+    }
+    else if (type == typeid(FreeJoint))
+    {
+      body.mJointType = JointType::FREE;
+      body.mJ = math::getAdTMatrix(childToJoint);
+    }
+    else
+    {
+      body.mJointType = JointType::WELD;
+      body.mJ.resize(6, 0);
+    }
+
+    body.mI = bodyNode->getSpatialInertia();
+    body.mGravityMode = bodyNode->getGravityMode();
+    if (mWithExternalForces)
+      body.mFext = bodyNode->getExternalForceLocal();
+    else
+      body.mFext.setZero();
+
+    for (int k = 0; k < body.mNumDofs; ++k)
+    {
+      const int index = body.mDofStart + k;
+      if (mWithDampingForces)
+        mDampingCoefficients[index] = joint->getDampingCoefficient(k);
+      if (mWithSpringForces)
+        mSpringStiffnesses[index] = joint->getSpringStiffness(k);
+      mRestPositions[index] = joint->getRestPosition(k);
+    }
+  }
+}
+
+//==============================================================================
+std::size_t InverseDynamics::getNumDofs() const
+{
+  return static_cast<std::size_t>(mRestPositions.size());
+}
+
+//==============================================================================
+Eigen::VectorXd InverseDynamics::compute(
+    const Eigen::VectorXd& _positions,
+    const Eigen::VectorXd& _velocities,
+    const Eigen::VectorXd& _accelerations) const
+{
+  const int numDofs = static_cast<int>(getNumDofs());
+  assert(_positions.size() == numDofs);
+  assert(_velocities.size() == numDofs);
+  assert(_accelerations.size() == numDofs);
+
+  Eigen::VectorXd forces(numDofs);
+  BodyStates states(mBodies.size());
+  compute(
+      _positions.data(),
+      _velocities.data(),
+      _accelerations.data(),
+      forces.data(),
+      states);
+
+  return forces;
+}
+
+//==============================================================================
+void InverseDynamics::compute(
+    const Eigen::MatrixXd& _positions,
+    const Eigen::MatrixXd& _velocities,
+    const Eigen::MatrixXd& _accelerations,
+    Eigen::MatrixXd& _forces,
+    common::ThreadPool* _pool) const
+{
+  const int numDofs = static_cast<int>(getNumDofs());
+  const std::size_t numSamples = static_cast<std::size_t>(_positions.cols());
+  assert(_positions.rows() == numDofs);
+  assert(
+      _velocities.rows() == numDofs && _velocities.cols() == _positions.cols());
+  assert(
+      _accelerations.rows() == numDofs
+      && _accelerations.cols() == _positions.cols());
+
+  _forces.resize(numDofs, _positions.cols());
+  if (numSamples == 0u)
+    return;
+
+  // Each task handles a contiguous range of samples so that the scratch space
+  // is allocated once per task instead of once per sample. A few tasks per
+  // thread balance the load when the threads progress at different speeds.
+  const std::size_t numThreads = _pool ? _pool->getNumThreads() : 1u;
+  const std::size_t numTasks = std::min(numSamples, 4u * numThreads);
+  const std::size_t samplesPerTask = (numSamples + numTasks - 1u) / numTasks;
+
+  const auto task = [&](std::size_t _taskIndex) {
+    const std::size_t begin = _taskIndex * samplesPerTask;
+    const std::size_t end = std::min(begin + samplesPerTask, numSamples);
+
+    BodyStates states(mBodies.size());
+    for (std::size_t i = begin; i < end; ++i)
+    {
+      const Eigen::Index col = static_cast<Eigen::Index>(i);
+      compute(
+          _positions.col(col).data(),
+          _velocities.col(col).data(),
+          _accelerations.col(col).data(),
+          _forces.col(col).data(),
+          states);
+    }
+  };
+
+  if (_pool && numTasks > 1u)
+  {
+    _pool->parallelFor(numTasks, task);
+  }
+  else
+  {
+    for (std::size_t i = 0u; i < numTasks; ++i)
+      task(i);
+  }
+}
+
+//==============================================================================
+void InverseDynamics::compute(
+    const double* _positions,
+    const double* _velocities,
+    const double* _accelerations,
+    double* _forces,
+    BodyStates& _states) const
+{
+  const std::size_t numBodies = mBodies.size();
+
+  // Forward recursion: transforms, velocities and accelerations
+  for (std::size_t i = 0u; i < numBodies; ++i)
+  {
+    const Body& body = mBodies[i];
+    BodyState& state = _states[i];
+
+    const int n = body.mNumDofs;
+    const Eigen::Map<const Eigen::VectorXd> q(_positions + body.mDofStart, n);
+    const Eigen::Map<const Eigen::VectorXd> dq(_velocities + body.mDofStart, n);
+    const Eigen::Map<const Eigen::VectorXd> ddq(
+        _accelerations + body.mDofStart, n);
+
+    // Relative transform, joint velocity and the Jacobian terms of the joint
+    // acceleration
+    Eigen::Vector6d jointVelocity = Eigen::Vector6d::Zero();
+    Eigen::Vector6d jointAcceleration = Eigen::Vector6d::Zero();
+    switch (body.mJointType)
+    {
+      case JointType::WELD:
+        state.mT = body.mParentToJoint * body.mJointToChild;
+        break;
+      case JointType::REVOLUTE:
+        state.mT = body.mParentToJoint * math::expAngular(body.mAxis1 * q[0])
+                   * body.mJointToChild;
+        break;
+      case JointType::PRISMATIC:
+        state.mT = body.mParentToJoint
+                   * Eigen::Translation3d(body.mAxis1 * q[0])
+                   * body.mJointToChild;
+        break;
+      case JointType::SCREW:
+      {
+        Eigen::Vector6d S;
+        S << body.mAxis1, body.mAxis2;
+        state.mT = body.mParentToJoint * math::expMap(S * q[0])
+                   * body.mJointToChild;
+        break;
+      }
+      case JointType::UNIVERSAL:
+      {
+        state.mT = body.mParentToJoint
+                   * Eigen::AngleAxisd(q[0], body.mAxis1)
+                   * Eigen::AngleAxisd(q[1], body.mAxis2)
+                   * body.mJointToChild;
+
+        // The first column depends on the second coordinate, see
+        // UniversalJoint::getRelativeJacobianStatic()
+        const Eigen::Vector6d J0 = math::AdTAngular(
+            body.mChildToJoint * math::expAngular(-body.mAxis2 * q[1]),
+            body.mAxis1);
+        const Eigen::Vector6d& J1 = body.mJ.col(1);
+        jointVelocity = J0 * dq[0] + J1 * dq[1];
+        jointAcceleration = J0 * ddq[0] + J1 * ddq[1]
+                            - math::ad(J1 * dq[1], J0) * dq[0];
+        break;
+      }
+      case JointType::BALL:
+        state.mT = body.mParentToJoint
+                   * Eigen::Isometry3d(math::expMapRot(q.head<3>()))
+                   * body.mJointToChild;
+        break;
+      case JointType::FREE:
+      {
+        Eigen::Isometry3d Q = Eigen::Isometry3d::Identity();
+        Q.linear() = math::expMapRot(q.head<3>());
+        Q.translation() = q.tail<3>();
+        state.mT = body.mParentToJoint * Q * body.mJointToChild;
+        break;
+      }
+    }
+
+    // The Jacobians of the other joint types are constant
+    if (body.mJointType != JointType::UNIVERSAL && n > 0)
+    {
+      jointVelocity.noalias() = body.mJ * dq;
+      jointAcceleration.noalias() = body.mJ * ddq;
+    }
+
+    if (body.mParent >= 0)
+    {
+      const BodyState& parentState
+          = _states[static_cast<std::size_t>(body.mParent)];
+      state.mR = parentState.mR * state.mT.linear();
+      state.mV = math::AdInvT(state.mT, parentState.mV) + jointVelocity;
+      state.mA = math::AdInvT(state.mT, parentState.mA) + jointAcceleration
+                 + math::ad(state.mV, jointVelocity);
+    }
+    else
+    {
+      state.mR = state.mT.linear();
+      state.mV = jointVelocity;
+      state.mA = jointAcceleration + math::ad(state.mV, jointVelocity);
+    }
+
+    // Body force of this body alone, see BodyNode::updateTransmittedForceID()
+    state.mF.noalias() = body.mI * state.mA;
+    state.mF -= body.mFext;
+    if (body.mGravityMode)
+    {
+      Eigen::Vector6d gravity = Eigen::Vector6d::Zero();
+      gravity.tail<3>().noalias() = state.mR.transpose() * mGravity;
+      state.mF.noalias() -= body.mI * gravity;
+    }
+    state.mF -= math::dad(state.mV, body.mI * state.mV);
+  }
+
+  // Backward recursion: body forces and joint forces
+  for (std::size_t i = numBodies; i-- > 0u;)
+  {
+    const Body& body = mBodies[i];
+    const BodyState& state = _states[i];
+
+    const int n = body.mNumDofs;
+    if (n > 0)
+    {
+      const int start = body.mDofStart;
+      Eigen::Map<Eigen::VectorXd> tau(_forces + start, n);
+
+      if (body.mJointType == JointType::UNIVERSAL)
+      {
+        const double q1 = _positions[start + 1];
+        const Eigen::Vector6d J0 = math::AdTAngular(
+            body.mChildToJoint * math::expAngular(-body.mAxis2 * q1),
+            body.mAxis1);
+        tau[0] = J0.dot(state.mF);
+        tau[1] = body.mJ.col(1).dot(state.mF);
+      }
+      else
+      {
+        tau.noalias() = body.mJ.transpose() * state.mF;
+      }
+
+      // Implicit damping and spring forces, see GenericJoint::updateForceID()
+      for (int k = 0; k < n; ++k)
+      {
+        const int index = start + k;
+        const double q = _positions[index];
+        const double dq = _velocities[index];
+        const double ddq = _accelerations[index];
+        tau[k] += mDampingCoefficients[index] * (dq + ddq * mTimeStep);
+        tau[k] += mSpringStiffnesses[index]
+                  * (q - mRestPositions[index] + dq * mTimeStep
+                     + ddq * mTimeStep * mTimeStep);
+      }
+    }
+
+    if (body.mParent >= 0)
+    {
+      _states[static_cast<std::size_t>(body.mParent)].mF
+          += math::dAdInvT(state.mT, state.mF);
+    }
+  }
+}
+
+} // namespace dynamics
+} // namespace dart
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_DYNAMICS_INVERSEDYNAMICS_HPP_
+#define DART_DYNAMICS_INVERSEDYNAMICS_HPP_
+
+#include <memory>
+
+#include <Eigen/Dense>
+
+#include "dart/common/Memory.hpp"
+#include "dart/math/MathTypes.hpp"
+
+namespace dart {
+
+namespace common {
+class ThreadPool;
+} // namespace common
+
+namespace dynamics {
+
+class Skeleton;
+
+/// InverseDynamics evaluates the recursive Newton-Euler algorithm of
+/// Skeleton::computeInverseDynamics() for many states at once, e.g., for every
+/// sample of a motion trajectory.
+///
+/// The constructor takes a snapshot of the Skeleton: its topology, Joint
+/// parameters, inertias, gravity, time step, external forces and joint
+/// damping and spring coefficients. compute() then evaluates the joint
+/// kinematics in closed form from the given positions, so it neither modifies
+/// the Skeleton nor goes through its dirty flags, and it is safe to call from
+/// several threads. Changes made to the Skeleton after construction are not
+/// seen until update() is called.
+///
+/// Only Skeletons for which isSupported() returns true can be handled.
+/// Skeleton::computeInverseDynamics() for trajectories falls back to clones of
+/// the Skeleton for the others.
+class InverseDynamics
+{
+public:
+  /// Constructor. The flags have the same meaning as in
+  /// Skeleton::computeInverseDynamics().
+  explicit InverseDynamics(
+      const Skeleton& _skel,
+      bool _withExternalForces = false,
+      bool _withDampingForces = false,
+      bool _withSpringForces = false);
+
+  /// Return true if _skel has no SoftBodyNodes and all of its Joints are
+  /// WeldJoints, RevoluteJoints, PrismaticJoints, ScrewJoints,
+  /// UniversalJoints, BallJoints or FreeJoints
+  static bool isSupported(const Skeleton& _skel);
+
+  /// Take a new snapshot of _skel, keeping the flags given to the constructor
+  void update(const Skeleton& _skel);
+
+  /// Get the number of generalized coordinates of the snapshot
+  std::size_t getNumDofs() const;
+
+  /// Compute the joint forces for a single state
+  Eigen::VectorXd compute(
+      const Eigen::VectorXd& _positions,
+      const Eigen::VectorXd& _velocities,
+      const Eigen::VectorXd& _accelerations) const;
+
+  /// Compute the joint forces for a trajectory. Each column of _positions,
+  /// _velocities and _accelerations is one sample, and the matching column of
+  /// _forces receives its joint forces. The samples are distributed over
+  /// _pool, or computed serially if _pool is nullptr.
+  void compute(
+      const Eigen::MatrixXd& _positions,
+      const Eigen::MatrixXd& _velocities,
+      const Eigen::MatrixXd& _accelerations,
+      Eigen::MatrixXd& _forces,
+      common::ThreadPool* _pool = nullptr) const;
+
+protected:
+  /// Joint types with closed form kinematics
+  enum class JointType : unsigned char
+  {
+    WELD,
+    REVOLUTE,
+    PRISMATIC,
+    SCREW,
+    UNIVERSAL,
+    BALL,
+    FREE
+  };
+
+  /// Constant per-BodyNode quantities of the snapshot
+  struct Body
+  {
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    /// Index of the parent BodyNode in the Skeleton, or -1 for a root
+    int mParent;
+
+    /// Type of the parent Joint
+    JointType mJointType;
+
+    /// Index of the first generalized coordinate of the parent Joint
+    int mDofStart;
+
+    /// Number of generalized coordinates of the parent Joint
+    int mNumDofs;
+
+    /// Transform from the parent BodyNode to the parent Joint
+    Eigen::Isometry3d mParentToJoint;
+
+    /// Transform from this BodyNode to the parent Joint
+    Eigen::Isometry3d mChildToJoint;
+
+    /// Inverse of mChildToJoint
+    Eigen::Isometry3d mJointToChild;
+
+    /// Joint axes: the axis of revolute, prismatic and screw Joints, or the
+    /// first and the second axis of universal Joints
+    Eigen::Vector3d mAxis1;
+    Eigen::Vector3d mAxis2;
+
+    /// Relative Jacobian of the parent Joint. It is only constant for Joints
+    /// other than UniversalJoints.
+    math::Jacobian mJ;
+
+    /// Spatial inertia
+    Eigen::Matrix6d mI;
+
+    /// External force, or zero if external forces are not taken into account
+    Eigen::Vector6d mFext;
+
+    /// Whether gravity acts on this BodyNode
+    bool mGravityMode;
+  };
+
+  /// Per-BodyNode quantities of one state
+  struct BodyState
+  {
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+    /// Transform from the parent BodyNode
+    Eigen::Isometry3d mT;
+
+    /// Rotation relative to the world
+    Eigen::Matrix3d mR;
+
+    /// Spatial velocity
+    Eigen::Vector6d mV;
+
+    /// Spatial acceleration
+    Eigen::Vector6d mA;
+
+    /// Body force
+    Eigen::Vector6d mF;
+  };
+
+  using BodyStates = common::aligned_vector<BodyState>;
+
+  /// Compute the joint forces for one state using _states as scratch space
+  void compute(
+      const double* _positions,
+      const double* _velocities,
+      const double* _accelerations,
+      double* _forces,
+      BodyStates& _states) const;
+
+  /// Per-BodyNode quantities of the snapshot
+  common::aligned_vector<Body> mBodies;
+
+  /// Damping coefficient of each generalized coordinate, or zero if damping
+  /// forces are not taken into account
+  Eigen::VectorXd mDampingCoefficients;
+
+  /// Spring stiffness of each generalized coordinate, or zero if spring forces
+  /// are not taken into account
+  Eigen::VectorXd mSpringStiffnesses;
+
+  /// Rest position of each generalized coordinate
+  Eigen::VectorXd mRestPositions;
+
+  /// Gravity of the Skeleton
+  Eigen::Vector3d mGravity;
+
+  /// Time step of the Skeleton, used by the implicit damping and spring forces
+  double mTimeStep;
+
+  /// Whether external forces are taken into account
+  bool mWithExternalForces;
+
+  /// Whether damping forces are taken into account
+  bool mWithDampingForces;
+
+  /// Whether spring forces are taken into account
+  bool mWithSpringForces;
+};
+
+} // namespace dynamics
+} // namespace dart
+
+#endif // DART_DYNAMICS_INVERSEDYNAMICS_HPP_
@@ -617,20 +617,7 @@ void Joint::notifyPositionUpdate()
 //==============================================================================
 void Joint::notifyPositionUpdated()
 {
-  if (mChildBodyNode)
-  {
-    mChildBodyNode->dirtyTransform();
-    mChildBodyNode->dirtyJacobian();
-    mChildBodyNode->dirtyJacobianDeriv();
-  }
-
-  mIsRelativeJacobianDirty = true;
-  mIsRelativeJacobianTimeDerivDirty = true;
-  mNeedPrimaryAccelerationUpdate = true;
-
-  mNeedTransformUpdate = true;
-  mNeedSpatialVelocityUpdate = true;
-  mNeedSpatialAccelerationUpdate = true;
+  dirtyPositionDependents();
 
   SkeletonPtr skel = getSkeleton();
   if (skel)
@@ -679,5 +666,53 @@ void Joint::notifyAccelerationUpdated()
   mNeedPrimaryAccelerationUpdate = true;
 }
 
+//==============================================================================
+bool Joint::copyPositionsFrom(const Eigen::VectorXd& values, std::size_t offset)
+{
+  for (std::size_t i = 0; i < getNumDofs(); ++i)
+    setPosition(i, values[static_cast<int>(offset + i)]);
+
+  return false;
+}
+
+//==============================================================================
+bool Joint::copyVelocitiesFrom(
+    const Eigen::VectorXd& values, std::size_t offset)
+{
+  for (std::size_t i = 0; i < getNumDofs(); ++i)
+    setVelocity(i, values[static_cast<int>(offset + i)]);
+
+  return false;
+}
+
+//==============================================================================
+bool Joint::copyAccelerationsFrom(
+    const Eigen::VectorXd& values, std::size_t offset)
+{
+  for (std::size_t i = 0; i < getNumDofs(); ++i)
+    setAcceleration(i, values[static_cast<int>(offset + i)]);
+
+  return false;
+}
+
+//==============================================================================
+void Joint::dirtyPositionDependents()
+{
+  if (mChildBodyNode)
+  {
+    mChildBodyNode->dirtyTransform();
+    mChildBodyNode->dirtyJacobian();
+    mChildBodyNode->dirtyJacobianDeriv();
+  }
+
+  mIsRelativeJacobianDirty = true;
+  mIsRelativeJacobianTimeDerivDirty = true;
+  mNeedPrimaryAccelerationUpdate = true;
+
+  mNeedTransformUpdate = true;
+  mNeedSpatialVelocityUpdate = true;
+  mNeedSpatialAccelerationUpdate = true;
+}
+
 } // namespace dynamics
 } // namespace dart
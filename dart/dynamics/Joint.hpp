@@ -783,6 +783,29 @@ protected:
   /// called with _renameDofs set to true.
   virtual void updateDegreeOfFreedomNames() = 0;
 
+  /// Copy the positions of this Joint from the entries of \c values that start
+  /// at \c offset, without notifying anything. Returns true if any position
+  /// has changed, in which case the caller is responsible for the
+  /// notifications. Used by Skeleton to batch whole-skeleton state writes.
+  ///
+  /// The default implementation falls back on setPosition(), which notifies
+  /// by itself, and therefore always returns false.
+  virtual bool copyPositionsFrom(
+      const Eigen::VectorXd& values, std::size_t offset);
+
+  /// Same as copyPositionsFrom(), but for the velocities
+  virtual bool copyVelocitiesFrom(
+      const Eigen::VectorXd& values, std::size_t offset);
+
+  /// Same as copyPositionsFrom(), but for the accelerations
+  virtual bool copyAccelerationsFrom(
+      const Eigen::VectorXd& values, std::size_t offset);
+
+  /// Dirty the caches of this Joint and of its child BodyNode subtree that
+  /// depend on the positions of this Joint. Unlike notifyPositionUpdated(),
+  /// the caches of the Skeleton are left untouched.
+  void dirtyPositionDependents();
+
   //----------------------------------------------------------------------------
   /// \{ \name Recursive dynamics routines
   //----------------------------------------------------------------------------
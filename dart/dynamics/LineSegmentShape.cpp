@@ -86,6 +86,12 @@ const std::string& LineSegmentShape::getStaticType()
   return type;
 }
 
+//==============================================================================
+Shape::TypeId LineSegmentShape::getTypeId() const
+{
+  return getStaticTypeId();
+}
+
 //==============================================================================
 void LineSegmentShape::setThickness(float _thickness)
 {
@@ -60,6 +60,15 @@ public:
   /// Returns shape type for this class
   static const std::string& getStaticType();
 
+  // Documentation inherited.
+  TypeId getTypeId() const override;
+
+  /// Returns shape type ID for this class
+  static constexpr TypeId getStaticTypeId()
+  {
+    return TypeId::LINE_SEGMENT;
+  }
+
   /// Set the line thickness/width for rendering
   void setThickness(float _thickness);
 
@@ -161,6 +161,12 @@ const std::string& MeshShape::getStaticType()
   return type;
 }
 
+//==============================================================================
+Shape::TypeId MeshShape::getTypeId() const
+{
+  return getStaticTypeId();
+}
+
 //==============================================================================
 const aiScene* MeshShape::getMesh() const
 {
@@ -92,6 +92,15 @@ public:
   /// Returns shape type for this class
   static const std::string& getStaticType();
 
+  // Documentation inherited.
+  TypeId getTypeId() const override;
+
+  /// Returns shape type ID for this class
+  static constexpr TypeId getStaticTypeId()
+  {
+    return TypeId::MESH;
+  }
+
   const aiScene* getMesh() const;
 
   /// Updates positions of the vertices or the elements. By default, this does
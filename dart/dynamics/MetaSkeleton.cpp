@@ -34,6 +34,7 @@
 
 #include <algorithm>
 #include "dart/common/Console.hpp"
+#include "dart/dynamics/BodyNode.hpp"
 #include "dart/dynamics/DegreeOfFreedom.hpp"
 #include "dart/dynamics/JacobianNode.hpp"
 
@@ -1094,6 +1095,21 @@ math::Jacobian MetaSkeleton::getJacobianSpatialDeriv(
   return math::AdRJac(_node->getTransform(_inCoordinatesOf), result);
 }
 
+//==============================================================================
+Eigen::Vector6d MetaSkeleton::getCentroidalMomentum() const
+{
+  return getCentroidalMomentumMatrix() * getVelocities();
+}
+
+//==============================================================================
+Eigen::Isometry3d MetaSkeleton::getCentroidalTransform(
+    const BodyNode* _bodyNode, const Eigen::Vector3d& _com)
+{
+  Eigen::Isometry3d T = _bodyNode->getWorldTransform();
+  T.translation() -= _com;
+  return T;
+}
+
 //==============================================================================
 double MetaSkeleton::computeLagrangian() const
 {
@@ -268,7 +268,7 @@ public:
   double getPosition(std::size_t _index) const;
 
   /// Set the positions for all generalized coordinates
-  void setPositions(const Eigen::VectorXd& _positions);
+  virtual void setPositions(const Eigen::VectorXd& _positions);
 
   /// Set the positions for a subset of the generalized coordinates
   void setPositions(
@@ -339,7 +339,7 @@ public:
   double getVelocity(std::size_t _index) const;
 
   /// Set the velocities of all generalized coordinates
-  void setVelocities(const Eigen::VectorXd& _velocities);
+  virtual void setVelocities(const Eigen::VectorXd& _velocities);
 
   /// Set the velocities of a subset of the generalized coordinates
   void setVelocities(
@@ -414,7 +414,7 @@ public:
   double getAcceleration(std::size_t _index) const;
 
   /// Set the accelerations of all generalized coordinates
-  void setAccelerations(const Eigen::VectorXd& _accelerations);
+  virtual void setAccelerations(const Eigen::VectorXd& _accelerations);
 
   /// Set the accelerations of a subset of the generalized coordinates
   void setAccelerations(
@@ -580,7 +580,7 @@ public:
   /// Get the spatial Jacobian targeting the origin of a BodyNode relative to
   /// another BodyNode in the same Skeleton. You can specify a coordinate Frame
   /// to express the Jacobian in.
-  math::Jacobian getJacobian(
+  virtual math::Jacobian getJacobian(
       const JacobianNode* _node,
       const JacobianNode* _relativeTo,
       const Frame* _inCoordinatesOf) const;
@@ -603,7 +603,7 @@ public:
   /// another BodyNode in the same Skeleton. The _offset is expected in
   /// coordinates of the BodyNode Frame. You can specify a coordinate Frame to
   /// express the Jacobian in.
-  math::Jacobian getJacobian(
+  virtual math::Jacobian getJacobian(
       const JacobianNode* _node,
       const Eigen::Vector3d& _localOffset,
       const JacobianNode* _relativeTo,
@@ -636,7 +636,7 @@ public:
   /// Get the linear Jacobian targeting the origin of a BodyNode relative to
   /// another BodyNode in the same Skeleton. You can specify a coordinate Frame
   /// to express the Jacobian in.
-  math::LinearJacobian getLinearJacobian(
+  virtual math::LinearJacobian getLinearJacobian(
       const JacobianNode* _node,
       const JacobianNode* _relativeTo,
       const Frame* _inCoordinatesOf = Frame::World()) const;
@@ -645,7 +645,7 @@ public:
   /// another BodyNode in the same Skeleton. The _offset is expected in
   /// coordinates of the BodyNode Frame. You can specify a coordinate Frame to
   /// express the Jacobian in.
-  math::LinearJacobian getLinearJacobian(
+  virtual math::LinearJacobian getLinearJacobian(
       const JacobianNode* _node,
       const Eigen::Vector3d& _localOffset,
       const JacobianNode* _relativeTo,
@@ -666,7 +666,7 @@ public:
   /// Get the angular Jacobian of a BodyNode relative to another BodyNode in the
   /// same Skeleton. You can specify a coordinate Frame to express the Jacobian
   /// in.
-  math::AngularJacobian getAngularJacobian(
+  virtual math::AngularJacobian getAngularJacobian(
       const JacobianNode* _node,
       const JacobianNode* _relativeTo,
       const Frame* _inCoordinatesOf = Frame::World()) const;
@@ -886,10 +886,45 @@ public:
 
   /// \}
 
+  //----------------------------------------------------------------------------
+  /// \{ \name Centroidal Dynamics
+  //----------------------------------------------------------------------------
+
+  /// Get the centroidal momentum matrix of this MetaSkeleton, which maps the
+  /// generalized velocities of this MetaSkeleton to its spatial momentum about
+  /// its COM. The momentum stacks the angular momentum on top of the linear
+  /// momentum and is expressed in a frame located at the COM and aligned with
+  /// the World Frame.
+  virtual math::Jacobian getCentroidalMomentumMatrix() const = 0;
+
+  /// Get the rate of change of the centroidal momentum when all generalized
+  /// accelerations are zero, i.e., the time derivative of the centroidal
+  /// momentum matrix times the generalized velocities. The rate of change of
+  /// the centroidal momentum is getCentroidalMomentumMatrix() * ddq plus this
+  /// vector.
+  virtual Eigen::Vector6d getCentroidalMomentumBias() const = 0;
+
+  /// Get the spatial inertia of this MetaSkeleton about its COM as if all of
+  /// its BodyNodes were welded together in the current configuration,
+  /// expressed in the same frame as the centroidal momentum
+  virtual Eigen::Matrix6d getCentroidalInertia() const = 0;
+
+  /// Get the centroidal momentum due to the generalized velocities of this
+  /// MetaSkeleton
+  Eigen::Vector6d getCentroidalMomentum() const;
+
+  /// \}
+
 protected:
   /// Default constructor
   MetaSkeleton();
 
+  /// Get the transform of _bodyNode relative to the frame that is located at
+  /// _com and aligned with the World Frame, which is the frame that the
+  /// centroidal quantities are expressed in
+  static Eigen::Isometry3d getCentroidalTransform(
+      const BodyNode* _bodyNode, const Eigen::Vector3d& _com);
+
   //--------------------------------------------------------------------------
   // Signals
   //--------------------------------------------------------------------------
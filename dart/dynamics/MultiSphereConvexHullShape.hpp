@@ -60,6 +60,15 @@ public:
   /// Returns shape type for this class
   static const std::string& getStaticType();
 
+  // Documentation inherited.
+  TypeId getTypeId() const override;
+
+  /// Returns shape type ID for this class
+  static constexpr TypeId getStaticTypeId()
+  {
+    return TypeId::MULTISPHERE_CONVEX_HULL;
+  }
+
   /// Add a list of spheres
   void addSpheres(const Spheres& spheres);
 
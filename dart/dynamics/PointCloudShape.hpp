@@ -83,6 +83,15 @@ public:
   /// Returns shape type for this class
   static const std::string& getStaticType();
 
+  // Documentation inherited.
+  TypeId getTypeId() const override;
+
+  /// Returns shape type ID for this class
+  static constexpr TypeId getStaticTypeId()
+  {
+    return TypeId::POINT_CLOUD;
+  }
+
   /// Reserves the point list by \c size.
   void reserve(std::size_t size);
 
@@ -152,15 +152,8 @@ PointMass::PointMass(SoftBodyNode* _softBodyNode)
     mX(Eigen::Vector3d::Zero()),
     mV(Eigen::Vector3d::Zero()),
     mEta(Eigen::Vector3d::Zero()),
-    mAlpha(Eigen::Vector3d::Zero()),
-    mBeta(Eigen::Vector3d::Zero()),
     mA(Eigen::Vector3d::Zero()),
     mF(Eigen::Vector3d::Zero()),
-    mPsi(0.0),
-    mImplicitPsi(0.0),
-    mPi(0.0),
-    mImplicitPi(0.0),
-    mB(Eigen::Vector3d::Zero()),
     mFext(Eigen::Vector3d::Zero()),
     mIsColliding(false),
     mDelV(Eigen::Vector3d::Zero()),
@@ -221,28 +214,28 @@ double PointMass::getMass() const
 double PointMass::getPsi() const
 {
   mParentSoftBodyNode->checkArticulatedInertiaUpdate();
-  return mPsi;
+  return mParentSoftBodyNode->mPointMassBuffers.mPsi[mIndex];
 }
 
 //==============================================================================
 double PointMass::getImplicitPsi() const
 {
   mParentSoftBodyNode->checkArticulatedInertiaUpdate();
-  return mImplicitPsi;
+  return mParentSoftBodyNode->mPointMassBuffers.mImplicitPsi[mIndex];
 }
 
 //==============================================================================
 double PointMass::getPi() const
 {
   mParentSoftBodyNode->checkArticulatedInertiaUpdate();
-  return mPi;
+  return mParentSoftBodyNode->mPointMassBuffers.mPi[mIndex];
 }
 
 //==============================================================================
 double PointMass::getImplicitPi() const
 {
   mParentSoftBodyNode->checkArticulatedInertiaUpdate();
-  return mImplicitPi;
+  return mParentSoftBodyNode->mPointMassBuffers.mImplicitPi[mIndex];
 }
 
 //==============================================================================
@@ -783,31 +776,6 @@ void PointMass::updateTransmittedForceID(
   assert(!math::isNan(mF));
 }
 
-//==============================================================================
-void PointMass::updateArtInertiaFD(double _timeStep) const
-{
-  // Articulated inertia
-  // - Do nothing
-
-  // Cache data: PsiK and Psi
-  mPsi = 1.0 / getMass();
-  mImplicitPsi
-      = 1.0
-        / (getMass() + _timeStep * mParentSoftBodyNode->getDampingCoefficient()
-           + _timeStep * _timeStep
-                 * mParentSoftBodyNode->getVertexSpringStiffness());
-  assert(!math::isNan(mImplicitPsi));
-
-  // Cache data: AI_S_Psi
-  // - Do nothing
-
-  // Cache data: Pi
-  mPi = getMass() - getMass() * getMass() * mPsi;
-  mImplicitPi = getMass() - getMass() * getMass() * mImplicitPsi;
-  assert(!math::isNan(mPi));
-  assert(!math::isNan(mImplicitPi));
-}
-
 //==============================================================================
 void PointMass::updateJointForceID(
     double /*_timeStep*/,
@@ -819,72 +787,12 @@ void PointMass::updateJointForceID(
   // TODO: need to add spring and damping forces
 }
 
-//==============================================================================
-void PointMass::updateBiasForceFD(double _dt, const Eigen::Vector3d& _gravity)
-{
-  // B = w(parent) x m*v - fext - fgravity
-  // - w(parent) x m*v - fext
-  mB = mParentSoftBodyNode->getSpatialVelocity().head<3>().cross(
-           getMass() * getBodyVelocity())
-       - mFext;
-  // - fgravity
-  if (mParentSoftBodyNode->getGravityMode() == true)
-  {
-    mB -= getMass()
-          * (mParentSoftBodyNode->getWorldTransform().linear().transpose()
-             * _gravity);
-  }
-  assert(!math::isNan(mB));
-
-  const State& state = getState();
-
-  // Cache data: alpha
-  double kv = mParentSoftBodyNode->getVertexSpringStiffness();
-  double ke = mParentSoftBodyNode->getEdgeSpringStiffness();
-  double kd = mParentSoftBodyNode->getDampingCoefficient();
-  std::size_t nN = getNumConnectedPointMasses();
-  mAlpha = state.mForces - (kv + nN * ke) * getPositions()
-           - (_dt * (kv + nN * ke) + kd) * getVelocities()
-           - getMass() * getPartialAccelerations() - mB;
-  for (std::size_t i = 0; i < getNumConnectedPointMasses(); ++i)
-  {
-    const State& i_state = getConnectedPointMass(i)->getState();
-    mAlpha += ke * (i_state.mPositions + _dt * i_state.mVelocities);
-  }
-  assert(!math::isNan(mAlpha));
-
-  // Cache data: beta
-  mBeta = mB;
-  mBeta.noalias()
-      += getMass() * (getPartialAccelerations() + getImplicitPsi() * mAlpha);
-  assert(!math::isNan(mBeta));
-}
-
-//==============================================================================
-void PointMass::updateAccelerationFD()
-{
-  // ddq = imp_psi*(alpha - m*(dw(parent) x mX + dv(parent))
-  const Eigen::Vector3d& X = getLocalPosition();
-  const Eigen::Vector6d& a_parent
-      = mParentSoftBodyNode->getSpatialAcceleration();
-  Eigen::Vector3d ddq
-      = getImplicitPsi()
-        * (mAlpha
-           - getMass() * (a_parent.head<3>().cross(X) + a_parent.tail<3>()));
-  setAccelerations(ddq);
-  assert(!math::isNan(ddq));
-
-  // dv = dw(parent) x mX + dv(parent) + eata + ddq
-  mA = a_parent.head<3>().cross(X) + a_parent.tail<3>()
-       + getPartialAccelerations() + getAccelerations();
-  assert(!math::isNan(mA));
-}
-
 //==============================================================================
 void PointMass::updateTransmittedForce()
 {
   // f = m*dv + B
-  mF = mB;
+  mF = mParentSoftBodyNode->mPointMassBuffers.mBiasForces.row(mIndex)
+           .transpose();
   mF.noalias() += getMass() * getBodyAcceleration();
   assert(!math::isNan(mF));
 }
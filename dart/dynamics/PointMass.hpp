@@ -431,16 +431,6 @@ protected:
   /// \brief Update partial body acceleration due to parent joint's velocity.
   void updatePartialAcceleration() const;
 
-  /// \brief Update articulated body inertia. Forward dynamics routine.
-  /// \param[in] _timeStep Rquired for implicit joint stiffness and damping.
-  void updateArtInertiaFD(double _timeStep) const;
-
-  /// \brief Update bias force associated with the articulated body inertia.
-  /// Forward dynamics routine.
-  /// \param[in] _dt Required for implicit joint stiffness and damping.
-  /// \param[in] _gravity Vector of gravitational acceleration
-  void updateBiasForceFD(double _dt, const Eigen::Vector3d& _gravity);
-
   /// \brief Update bias impulse associated with the articulated body inertia.
   /// Impulse-based forward dynamics routine.
   void updateBiasImpulseFD();
@@ -448,9 +438,6 @@ protected:
   /// \brief Update body acceleration with the partial body acceleration.
   void updateAccelerationID() const;
 
-  /// \brief Update body acceleration. Forward dynamics routine.
-  void updateAccelerationFD();
-
   /// \brief Update body velocity change. Impluse-based forward dynamics
   /// routine.
   void updateVelocityChangeFD();
@@ -607,33 +594,12 @@ protected:
   /// Partial Acceleration of this PointMass
   mutable Eigen::Vector3d mEta;
 
-  ///
-  Eigen::Vector3d mAlpha;
-
-  ///
-  Eigen::Vector3d mBeta;
-
   /// Current acceleration viewed in parent body node frame.
   mutable Eigen::Vector3d mA;
 
   ///
   Eigen::Vector3d mF;
 
-  ///
-  mutable double mPsi;
-
-  ///
-  mutable double mImplicitPsi;
-
-  ///
-  mutable double mPi;
-
-  ///
-  mutable double mImplicitPi;
-
-  /// Bias force
-  Eigen::Vector3d mB;
-
   /// External force.
   Eigen::Vector3d mFext;
 
@@ -66,6 +66,12 @@ const std::string& PyramidShape::getStaticType()
   return type;
 }
 
+//==============================================================================
+Shape::TypeId PyramidShape::getTypeId() const
+{
+  return getStaticTypeId();
+}
+
 //==============================================================================
 double PyramidShape::getBaseWidth() const
 {
@@ -64,6 +64,15 @@ public:
   /// Returns shape type string for this shape.
   static const std::string& getStaticType();
 
+  // Documentation inherited.
+  TypeId getTypeId() const override;
+
+  /// Returns shape type ID for this class
+  static constexpr TypeId getStaticTypeId()
+  {
+    return TypeId::PYRAMID;
+  }
+
   /// Returns the lateral length (algon X-axis) of the base.
   double getBaseWidth() const;
 
@@ -1154,6 +1154,76 @@ math::LinearJacobian ReferentialSkeleton::getCOMLinearJacobianDeriv(
       this, _inCoordinatesOf);
 }
 
+//==============================================================================
+math::Jacobian ReferentialSkeleton::getCentroidalMomentumMatrix() const
+{
+  math::Jacobian A = math::Jacobian::Zero(6, getNumDofs());
+  if (mBodyNodes.empty() || getMass() == 0.0)
+    return A;
+
+  const Eigen::Vector3d com = getCOM();
+  for (const BodyNode* bn : mBodyNodes)
+  {
+    const Eigen::Isometry3d T = getCentroidalTransform(bn, com);
+    const math::Jacobian momenta = bn->getSpatialInertia() * bn->getJacobian();
+
+    const std::vector<const DegreeOfFreedom*>& dofs = bn->getDependentDofs();
+    for (std::size_t i = 0; i < dofs.size(); ++i)
+    {
+      const std::size_t index = getIndexOf(dofs[i], false);
+      if (INVALID_INDEX == index)
+        continue;
+
+      A.col(index) += math::dAdInvT(T, momenta.col(i));
+    }
+  }
+
+  return A;
+}
+
+//==============================================================================
+Eigen::Vector6d ReferentialSkeleton::getCentroidalMomentumBias() const
+{
+  Eigen::Vector6d bias = Eigen::Vector6d::Zero();
+  if (mBodyNodes.empty() || getMass() == 0.0)
+    return bias;
+
+  const Eigen::Vector3d com = getCOM();
+  for (const BodyNode* bn : mBodyNodes)
+  {
+    const std::vector<const DegreeOfFreedom*>& dofs = bn->getDependentDofs();
+    Eigen::VectorXd dq(dofs.size());
+    for (std::size_t i = 0; i < dofs.size(); ++i)
+      dq[i] = dofs[i]->getVelocity();
+
+    const Eigen::Matrix6d& I = bn->getSpatialInertia();
+    const Eigen::Vector6d& V = bn->getSpatialVelocity();
+    const Eigen::Vector6d F
+        = I * (bn->getJacobianSpatialDeriv() * dq) - math::dad(V, I * V);
+
+    bias += math::dAdInvT(getCentroidalTransform(bn, com), F);
+  }
+
+  return bias;
+}
+
+//==============================================================================
+Eigen::Matrix6d ReferentialSkeleton::getCentroidalInertia() const
+{
+  Eigen::Matrix6d inertia = Eigen::Matrix6d::Zero();
+  if (mBodyNodes.empty() || getMass() == 0.0)
+    return inertia;
+
+  const Eigen::Vector3d com = getCOM();
+  for (const BodyNode* bn : mBodyNodes)
+  {
+    inertia += math::transformInertia(
+        getCentroidalTransform(bn, com).inverse(), bn->getSpatialInertia());
+  }
+
+  return inertia;
+}
+
 //==============================================================================
 void ReferentialSkeleton::registerComponent(BodyNode* _bn)
 {
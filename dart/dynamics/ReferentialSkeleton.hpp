@@ -401,6 +401,23 @@ public:
 
   /// \}
 
+  //----------------------------------------------------------------------------
+  /// \{ \name Centroidal Dynamics
+  //----------------------------------------------------------------------------
+
+  // Documentation inherited
+  math::Jacobian getCentroidalMomentumMatrix() const override;
+
+  /// Get the centroidal momentum bias. The accelerations of the
+  /// DegreesOfFreedom that are not part of this ReferentialSkeleton are taken
+  /// as zero as well.
+  Eigen::Vector6d getCentroidalMomentumBias() const override;
+
+  // Documentation inherited
+  Eigen::Matrix6d getCentroidalInertia() const override;
+
+  /// \}
+
 protected:
   /// Default constructor. Protected to avoid blank and useless instantiations
   /// of ReferentialSkeleton.
@@ -0,0 +1,413 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/dynamics/SdfShape.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+#include <assimp/scene.h>
+
+#include "dart/common/Console.hpp"
+#include "dart/common/ThreadPool.hpp"
+#include "dart/dynamics/BoxShape.hpp"
+#include "dart/dynamics/MeshShape.hpp"
+#include "dart/math/Constants.hpp"
+
+namespace dart {
+namespace dynamics {
+
+namespace {
+
+using Triangle = std::array<Eigen::Vector3d, 3>;
+
+//==============================================================================
+std::vector<Triangle> getTriangles(const MeshShape& mesh)
+{
+  std::vector<Triangle> triangles;
+
+  const aiScene* scene = mesh.getMesh();
+  if (!scene)
+    return triangles;
+
+  const Eigen::Vector3d& scale = mesh.getScale();
+  const auto vertex = [&](const aiMesh* subMesh, unsigned int index) {
+    const aiVector3D& v = subMesh->mVertices[index];
+    return Eigen::Vector3d(v.x * scale.x(), v.y * scale.y(), v.z * scale.z());
+  };
+
+  for (unsigned int i = 0u; i < scene->mNumMeshes; ++i)
+  {
+    const aiMesh* subMesh = scene->mMeshes[i];
+    for (unsigned int j = 0u; j < subMesh->mNumFaces; ++j)
+    {
+      const aiFace& face = subMesh->mFaces[j];
+      if (face.mNumIndices != 3u)
+        continue;
+
+      triangles.push_back({{vertex(subMesh, face.mIndices[0]),
+                            vertex(subMesh, face.mIndices[1]),
+                            vertex(subMesh, face.mIndices[2])}});
+    }
+  }
+
+  return triangles;
+}
+
+//==============================================================================
+/// Returns the squared distance between a point and a triangle (see Ericson,
+/// Real-Time Collision Detection, 5.1.5)
+double computeSquaredDistance(const Eigen::Vector3d& p, const Triangle& tri)
+{
+  const Eigen::Vector3d& a = tri[0];
+  const Eigen::Vector3d& b = tri[1];
+  const Eigen::Vector3d& c = tri[2];
+
+  const Eigen::Vector3d ab = b - a;
+  const Eigen::Vector3d ac = c - a;
+  const Eigen::Vector3d ap = p - a;
+  const double d1 = ab.dot(ap);
+  const double d2 = ac.dot(ap);
+  if (d1 <= 0.0 && d2 <= 0.0)
+    return ap.squaredNorm();
+
+  const Eigen::Vector3d bp = p - b;
+  const double d3 = ab.dot(bp);
+  const double d4 = ac.dot(bp);
+  if (d3 >= 0.0 && d4 <= d3)
+    return bp.squaredNorm();
+
+  const double vc = d1 * d4 - d3 * d2;
+  if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0)
+    return (ap - (d1 / (d1 - d3)) * ab).squaredNorm();
+
+  const Eigen::Vector3d cp = p - c;
+  const double d5 = ab.dot(cp);
+  const double d6 = ac.dot(cp);
+  if (d6 >= 0.0 && d5 <= d6)
+    return cp.squaredNorm();
+
+  const double vb = d5 * d2 - d1 * d6;
+  if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0)
+    return (ap - (d2 / (d2 - d6)) * ac).squaredNorm();
+
+  const double va = d3 * d6 - d5 * d4;
+  if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0)
+  {
+    const double w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+    return (bp - w * (c - b)).squaredNorm();
+  }
+
+  const double denominator = va + vb + vc;
+  if (denominator <= 0.0)
+  {
+    // Degenerate triangle
+    return std::min({ap.squaredNorm(), bp.squaredNorm(), cp.squaredNorm()});
+  }
+
+  const double v = vb / denominator;
+  const double w = vc / denominator;
+  return (ap - v * ab - w * ac).squaredNorm();
+}
+
+//==============================================================================
+/// Returns the solid angle subtended by a triangle at a point, signed by the
+/// winding of the triangle (Van Oosterom and Strackee)
+double computeSolidAngle(const Eigen::Vector3d& p, const Triangle& tri)
+{
+  const Eigen::Vector3d a = tri[0] - p;
+  const Eigen::Vector3d b = tri[1] - p;
+  const Eigen::Vector3d c = tri[2] - p;
+
+  const double la = a.norm();
+  const double lb = b.norm();
+  const double lc = c.norm();
+
+  const double numerator = a.dot(b.cross(c));
+  const double denominator
+      = la * lb * lc + a.dot(b) * lc + b.dot(c) * la + c.dot(a) * lb;
+
+  return 2.0 * std::atan2(numerator, denominator);
+}
+
+} // namespace
+
+//==============================================================================
+SdfShape::SdfShape(
+    const Eigen::Vector3d& origin,
+    double voxelSize,
+    const Eigen::Vector3i& dimensions,
+    std::vector<double> values)
+  : Shape(),
+    mOrigin(origin),
+    mVoxelSize(voxelSize),
+    mDimensions(dimensions),
+    mValues(std::move(values))
+{
+  assert(voxelSize > 0.0);
+  assert((dimensions.array() >= 2).all());
+  assert(mValues.size() == static_cast<std::size_t>(dimensions.prod()));
+}
+
+//==============================================================================
+SdfShape::SdfShape(const MeshShape& mesh, double voxelSize, double padding)
+  : Shape(),
+    mOrigin(Eigen::Vector3d::Zero()),
+    mVoxelSize(voxelSize),
+    mDimensions(Eigen::Vector3i::Constant(2))
+{
+  assert(voxelSize > 0.0);
+  assert(padding >= 0.0);
+
+  const std::vector<Triangle> triangles = getTriangles(mesh);
+  if (triangles.empty())
+  {
+    dtwarn << "[SdfShape] The mesh has no triangle. Creating an empty signed "
+           << "distance field.\n";
+    mValues.assign(8u, std::numeric_limits<double>::max());
+    return;
+  }
+
+  Eigen::Vector3d min = triangles.front()[0];
+  Eigen::Vector3d max = min;
+  for (const auto& triangle : triangles)
+  {
+    for (const auto& vertex : triangle)
+    {
+      min = min.cwiseMin(vertex);
+      max = max.cwiseMax(vertex);
+    }
+  }
+  min.array() -= padding;
+  max.array() += padding;
+
+  // Center the grid on the padded bounding box of the mesh
+  for (int i = 0; i < 3; ++i)
+  {
+    const double extent = max[i] - min[i];
+    mDimensions[i]
+        = std::max(2, static_cast<int>(std::ceil(extent / voxelSize)) + 1);
+    mOrigin[i] = 0.5 * (min[i] + max[i] - (mDimensions[i] - 1) * voxelSize);
+  }
+
+  mValues.resize(static_cast<std::size_t>(mDimensions.prod()));
+
+  // Brute force over the triangles. The sign comes from the generalized
+  // winding number so that small gaps in the mesh do not flip whole regions.
+  const auto computeSlice = [&](std::size_t z) {
+    for (int y = 0; y < mDimensions.y(); ++y)
+    {
+      for (int x = 0; x < mDimensions.x(); ++x)
+      {
+        const Eigen::Vector3d point
+            = mOrigin
+              + mVoxelSize * Eigen::Vector3d(x, y, static_cast<double>(z));
+
+        double squaredDistance = std::numeric_limits<double>::max();
+        double solidAngle = 0.0;
+        for (const auto& triangle : triangles)
+        {
+          squaredDistance = std::min(
+              squaredDistance, computeSquaredDistance(point, triangle));
+          solidAngle += computeSolidAngle(point, triangle);
+        }
+
+        const bool inside = std::abs(solidAngle) > 2.0 * math::constantsd::pi();
+        const double distance = std::sqrt(squaredDistance);
+        mValues[x + mDimensions.x() * (y + mDimensions.y() * z)]
+            = inside ? -distance : distance;
+      }
+    }
+  };
+
+  common::ThreadPool::getDefault()->parallelFor(
+      static_cast<std::size_t>(mDimensions.z()), computeSlice);
+}
+
+//==============================================================================
+const std::string& SdfShape::getType() const
+{
+  return getStaticType();
+}
+
+//==============================================================================
+const std::string& SdfShape::getStaticType()
+{
+  static const std::string type("SdfShape");
+  return type;
+}
+
+//==============================================================================
+Shape::TypeId SdfShape::getTypeId() const
+{
+  return getStaticTypeId();
+}
+
+//==============================================================================
+const Eigen::Vector3d& SdfShape::getOrigin() const
+{
+  return mOrigin;
+}
+
+//==============================================================================
+double SdfShape::getVoxelSize() const
+{
+  return mVoxelSize;
+}
+
+//==============================================================================
+const Eigen::Vector3i& SdfShape::getDimensions() const
+{
+  return mDimensions;
+}
+
+//==============================================================================
+const std::vector<double>& SdfShape::getValues() const
+{
+  return mValues;
+}
+
+//==============================================================================
+double SdfShape::getSignedDistance(
+    const Eigen::Vector3d& point, Eigen::Vector3d* gradient) const
+{
+  // Grid coordinates of the point, clamped to the grid
+  const Eigen::Vector3d maxCoords = (mDimensions.array() - 1).cast<double>();
+  const Eigen::Vector3d coords = (point - mOrigin) / mVoxelSize;
+  const Eigen::Vector3d clamped
+      = coords.cwiseMax(Eigen::Vector3d::Zero()).cwiseMin(maxCoords);
+
+  Eigen::Vector3i cell;
+  Eigen::Vector3d t;
+  for (int i = 0; i < 3; ++i)
+  {
+    cell[i] = std::min(
+        static_cast<int>(std::floor(clamped[i])), mDimensions[i] - 2);
+    t[i] = clamped[i] - cell[i];
+  }
+
+  // Trilinear interpolation of the eight corners of the cell
+  double c[2][2][2];
+  for (int dz = 0; dz < 2; ++dz)
+  {
+    for (int dy = 0; dy < 2; ++dy)
+    {
+      for (int dx = 0; dx < 2; ++dx)
+        c[dx][dy][dz] = getValue(cell.x() + dx, cell.y() + dy, cell.z() + dz);
+    }
+  }
+
+  const double c00 = c[0][0][0] * (1.0 - t.x()) + c[1][0][0] * t.x();
+  const double c10 = c[0][1][0] * (1.0 - t.x()) + c[1][1][0] * t.x();
+  const double c01 = c[0][0][1] * (1.0 - t.x()) + c[1][0][1] * t.x();
+  const double c11 = c[0][1][1] * (1.0 - t.x()) + c[1][1][1] * t.x();
+  const double c0 = c00 * (1.0 - t.y()) + c10 * t.y();
+  const double c1 = c01 * (1.0 - t.y()) + c11 * t.y();
+  double distance = c0 * (1.0 - t.z()) + c1 * t.z();
+
+  const Eigen::Vector3d outside = (coords - clamped) * mVoxelSize;
+  const double outsideDistance = outside.norm();
+  distance += outsideDistance;
+
+  if (gradient)
+  {
+    if (outsideDistance > 0.0)
+    {
+      // Far from the grid, the field grows away from the grid box
+      *gradient = outside / outsideDistance;
+    }
+    else
+    {
+      const auto lerp = [](double a, double b, double s) {
+        return a * (1.0 - s) + b * s;
+      };
+
+      Eigen::Vector3d g;
+      g.x() = lerp(
+          lerp(c[1][0][0] - c[0][0][0], c[1][1][0] - c[0][1][0], t.y()),
+          lerp(c[1][0][1] - c[0][0][1], c[1][1][1] - c[0][1][1], t.y()),
+          t.z());
+      g.y() = lerp(
+          lerp(c[0][1][0] - c[0][0][0], c[1][1][0] - c[1][0][0], t.x()),
+          lerp(c[0][1][1] - c[0][0][1], c[1][1][1] - c[1][0][1], t.x()),
+          t.z());
+      g.z() = c1 - c0;
+
+      const double norm = g.norm();
+      if (norm > 0.0)
+        *gradient = g / norm;
+      else
+        *gradient = Eigen::Vector3d::UnitZ();
+    }
+  }
+
+  return distance;
+}
+
+//==============================================================================
+Eigen::Matrix3d SdfShape::computeInertia(double mass) const
+{
+  // Use bounding box to represent the solid
+  return BoxShape::computeInertia(getBoundingBox().computeFullExtents(), mass);
+}
+
+//==============================================================================
+void SdfShape::updateBoundingBox() const
+{
+  mBoundingBox.setMin(mOrigin);
+  mBoundingBox.setMax(
+      mOrigin + mVoxelSize * (mDimensions.array() - 1).cast<double>().matrix());
+  mIsBoundingBoxDirty = false;
+}
+
+//==============================================================================
+void SdfShape::updateVolume() const
+{
+  // Every grid node inside the solid stands for one voxel
+  const auto numInside
+      = std::count_if(mValues.begin(), mValues.end(), [](double value) {
+          return value < 0.0;
+        });
+  mVolume = static_cast<double>(numInside) * std::pow(mVoxelSize, 3);
+  mIsVolumeDirty = false;
+}
+
+//==============================================================================
+double SdfShape::getValue(int x, int y, int z) const
+{
+  return mValues[x + mDimensions.x() * (y + mDimensions.y() * z)];
+}
+
+} // namespace dynamics
+} // namespace dart
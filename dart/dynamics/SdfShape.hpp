@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_DYNAMICS_SDFSHAPE_HPP_
+#define DART_DYNAMICS_SDFSHAPE_HPP_
+
+#include <vector>
+
+#include "dart/dynamics/Shape.hpp"
+
+namespace dart {
+namespace dynamics {
+
+class MeshShape;
+
+/// SdfShape represents a solid by a signed distance field sampled on a regular
+/// grid. The distance is negative inside the solid and positive outside, and
+/// it is interpolated trilinearly between the grid nodes.
+///
+/// The field is usually built once from a closed MeshShape and shared between
+/// ShapeNodes. A contact query against it only evaluates the field at sample
+/// points of the other shape, so its cost does not depend on the number of
+/// triangles of the original mesh.
+class SdfShape : public Shape
+{
+public:
+  /// Constructor.
+  /// \param[in] origin Position of the first grid node in the shape frame.
+  /// \param[in] voxelSize Distance between two neighboring grid nodes.
+  /// \param[in] dimensions Number of grid nodes along each axis; at least two.
+  /// \param[in] values Signed distances at the grid nodes, with the x index
+  /// running fastest.
+  SdfShape(
+      const Eigen::Vector3d& origin,
+      double voxelSize,
+      const Eigen::Vector3i& dimensions,
+      std::vector<double> values);
+
+  /// Constructs the signed distance field of a closed triangle mesh.
+  /// \param[in] mesh Mesh whose (scaled) triangles bound the solid.
+  /// \param[in] voxelSize Distance between two neighboring grid nodes.
+  /// \param[in] padding Margin added around the bounding box of the mesh.
+  SdfShape(const MeshShape& mesh, double voxelSize, double padding = 0.0);
+
+  /// Destructor.
+  ~SdfShape() override = default;
+
+  // Documentation inherited.
+  const std::string& getType() const override;
+
+  /// Returns shape type for this class
+  static const std::string& getStaticType();
+
+  // Documentation inherited.
+  TypeId getTypeId() const override;
+
+  /// Returns shape type ID for this class
+  static constexpr TypeId getStaticTypeId()
+  {
+    return TypeId::SDF;
+  }
+
+  /// Returns the position of the first grid node.
+  const Eigen::Vector3d& getOrigin() const;
+
+  /// Returns the distance between two neighboring grid nodes.
+  double getVoxelSize() const;
+
+  /// Returns the number of grid nodes along each axis.
+  const Eigen::Vector3i& getDimensions() const;
+
+  /// Returns the signed distances at the grid nodes.
+  const std::vector<double>& getValues() const;
+
+  /// Returns the signed distance of a point given in the shape frame.
+  ///
+  /// Outside the grid, the distance to the grid box is added to the value at
+  /// the closest point of the grid.
+  /// \param[in] point Query point in the shape frame.
+  /// \param[out] gradient If not null, the unit gradient of the field at the
+  /// point, i.e., the outward normal of the closest surface.
+  double getSignedDistance(
+      const Eigen::Vector3d& point, Eigen::Vector3d* gradient = nullptr) const;
+
+  // Documentation inherited.
+  Eigen::Matrix3d computeInertia(double mass) const override;
+
+protected:
+  // Documentation inherited.
+  void updateBoundingBox() const override;
+
+  // Documentation inherited.
+  void updateVolume() const override;
+
+  /// Returns the value at the grid node (x, y, z).
+  double getValue(int x, int y, int z) const;
+
+private:
+  /// Position of the first grid node
+  Eigen::Vector3d mOrigin;
+
+  /// Distance between two neighboring grid nodes
+  double mVoxelSize;
+
+  /// Number of grid nodes along each axis
+  Eigen::Vector3i mDimensions;
+
+  /// Signed distances at the grid nodes
+  std::vector<double> mValues;
+};
+
+} // namespace dynamics
+} // namespace dart
+
+#endif // DART_DYNAMICS_SDFSHAPE_HPP_
@@ -54,15 +54,9 @@ Shape::Shape(ShapeType type)
 }
 
 //==============================================================================
-Shape::Shape()
-  : mBoundingBox(),
-    mVolume(0.0),
-    mID(mCounter++),
-    mVariance(STATIC),
-    mType(UNSUPPORTED),
-    onVersionChanged(mVersionChangedSignal)
+Shape::Shape() : Shape(UNSUPPORTED)
 {
-  mVersion = 1;
+  // Do nothing
 }
 
 //==============================================================================
@@ -71,6 +65,12 @@ Shape::~Shape()
   // Do nothing
 }
 
+//==============================================================================
+Shape::TypeId Shape::getTypeId() const
+{
+  return TypeId::OTHER;
+}
+
 //==============================================================================
 const math::BoundingBox& Shape::getBoundingBox() const
 {
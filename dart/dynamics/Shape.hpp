@@ -74,6 +74,32 @@ public:
     UNSUPPORTED
   };
 
+  /// Compact identifier of the built-in shape types. Unlike the strings
+  /// returned by getType(), these are cheap to compare and can be used to index
+  /// dispatch tables, e.g., for choosing a narrowphase routine per shape pair.
+  enum class TypeId : unsigned char
+  {
+    SPHERE = 0,
+    BOX,
+    ELLIPSOID,
+    CYLINDER,
+    CAPSULE,
+    CONE,
+    PYRAMID,
+    PLANE,
+    MULTISPHERE_CONVEX_HULL,
+    MESH,
+    SOFT_MESH,
+    LINE_SEGMENT,
+    HEIGHTMAP_FLOAT,
+    HEIGHTMAP_DOUBLE,
+    POINT_CLOUD,
+    VOXEL_GRID,
+    SDF,
+    OTHER, ///< Any shape that is not built into DART
+    NUM_TYPE_IDS
+  };
+
   /// DataVariance can be used by renderers to determine whether it should
   /// expect data for this shape to change during each update.
   enum DataVariance
@@ -110,6 +136,12 @@ public:
   /// \sa is()
   virtual const std::string& getType() const = 0;
 
+  /// Returns the type ID of this shape. Shapes that are not built into DART
+  /// return TypeId::OTHER, in which case getType() is the only way to tell
+  /// them apart.
+  /// \sa getType()
+  virtual TypeId getTypeId() const;
+
   /// Get true if the types of this Shape and the template parameter (a shape
   /// class) are identical. This function is a syntactic sugar, which is
   /// identical to: (getType() == ShapeType::getStaticType()).
@@ -46,8 +46,9 @@ VisualAspectProperties::VisualAspectProperties(
 }
 
 //==============================================================================
-CollisionAspectProperties::CollisionAspectProperties(const bool collidable)
-  : mCollidable(collidable)
+CollisionAspectProperties::CollisionAspectProperties(
+    const bool collidable, const bool continuous)
+  : mCollidable(collidable), mContinuous(continuous)
 {
   // Do nothing
 }
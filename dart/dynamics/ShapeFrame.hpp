@@ -125,6 +125,10 @@ public:
 
   /// Return true if this body can collide with others bodies
   bool isCollidable() const;
+
+  DART_COMMON_SET_GET_ASPECT_PROPERTY(bool, Continuous)
+  // void setContinuous(const bool& value);
+  // const bool& getContinuous() const;
 };
 
 //==============================================================================
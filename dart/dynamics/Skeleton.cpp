@@ -33,6 +33,7 @@
 #include "dart/dynamics/Skeleton.hpp"
 
 #include <algorithm>
+#include <iterator>
 #include <queue>
 #include <string>
 #include <vector>
@@ -40,9 +41,11 @@
 #include "dart/common/Console.hpp"
 #include "dart/common/Deprecated.hpp"
 #include "dart/common/StlHelpers.hpp"
+#include "dart/common/ThreadPool.hpp"
 #include "dart/dynamics/BodyNode.hpp"
 #include "dart/dynamics/DegreeOfFreedom.hpp"
 #include "dart/dynamics/EndEffector.hpp"
+#include "dart/dynamics/InverseDynamics.hpp"
 #include "dart/dynamics/InverseKinematics.hpp"
 #include "dart/dynamics/Joint.hpp"
 #include "dart/dynamics/Marker.hpp"
@@ -609,6 +612,96 @@ Skeleton::Configuration Skeleton::getConfiguration(
   return config;
 }
 
+//==============================================================================
+static bool checkStateVectorSize(
+    const Skeleton* skel,
+    const Eigen::VectorXd& values,
+    const std::string& fname,
+    const std::string& vname)
+{
+  if (values.size() != static_cast<int>(skel->getNumDofs()))
+  {
+    dterr << "[Skeleton::" << fname << "] Invalid number of entries ("
+          << values.size() << ") in " << vname << " for Skeleton named ["
+          << skel->getName() << "] (" << skel << "). Must be equal to ("
+          << skel->getNumDofs() << "). Nothing will be set!\n";
+    assert(false);
+    return false;
+  }
+
+  return true;
+}
+
+//==============================================================================
+void Skeleton::setPositions(const Eigen::VectorXd& positions)
+{
+  if (!checkStateVectorSize(this, positions, "setPositions", "positions"))
+    return;
+
+  for (std::size_t tree = 0; tree < mTreeCache.size(); ++tree)
+  {
+    bool changed = false;
+
+    // BodyNodes are stored parent-first, so only the first changed Joint of a
+    // branch walks its subtree; the others find it already dirty.
+    for (BodyNode* bodyNode : mTreeCache[tree].mBodyNodes)
+    {
+      Joint* joint = bodyNode->getParentJoint();
+      if (joint->getNumDofs() == 0)
+        continue;
+
+      if (joint->copyPositionsFrom(positions, joint->getIndexInSkeleton(0)))
+      {
+        joint->dirtyPositionDependents();
+        changed = true;
+      }
+    }
+
+    if (changed)
+    {
+      dirtyArticulatedInertia(tree);
+      mTreeCache[tree].mDirty.mExternalForces = true;
+      mSkelCache.mDirty.mExternalForces = true;
+    }
+  }
+}
+
+//==============================================================================
+void Skeleton::setVelocities(const Eigen::VectorXd& velocities)
+{
+  if (!checkStateVectorSize(this, velocities, "setVelocities", "velocities"))
+    return;
+
+  for (BodyNode* bodyNode : mSkelCache.mBodyNodes)
+  {
+    Joint* joint = bodyNode->getParentJoint();
+    if (joint->getNumDofs() == 0)
+      continue;
+
+    if (joint->copyVelocitiesFrom(velocities, joint->getIndexInSkeleton(0)))
+      joint->notifyVelocityUpdated();
+  }
+}
+
+//==============================================================================
+void Skeleton::setAccelerations(const Eigen::VectorXd& accelerations)
+{
+  if (!checkStateVectorSize(
+          this, accelerations, "setAccelerations", "accelerations"))
+    return;
+
+  for (BodyNode* bodyNode : mSkelCache.mBodyNodes)
+  {
+    Joint* joint = bodyNode->getParentJoint();
+    if (joint->getNumDofs() == 0)
+      continue;
+
+    if (joint->copyAccelerationsFrom(
+            accelerations, joint->getIndexInSkeleton(0)))
+      joint->notifyAccelerationUpdated();
+  }
+}
+
 //==============================================================================
 void Skeleton::setState(const State& state)
 {
@@ -1723,6 +1816,142 @@ math::Jacobian Skeleton::getJacobian(
   return variadicGetJacobian(this, _node, _localOffset, _inCoordinatesOf);
 }
 
+//==============================================================================
+math::Jacobian Skeleton::getJacobian(
+    const JacobianNode* _node,
+    const JacobianNode* _relativeTo,
+    const Frame* _inCoordinatesOf) const
+{
+  return getCompactJacobian(_node, _relativeTo, _inCoordinatesOf).toDense();
+}
+
+//==============================================================================
+math::Jacobian Skeleton::getJacobian(
+    const JacobianNode* _node,
+    const Eigen::Vector3d& _localOffset,
+    const JacobianNode* _relativeTo,
+    const Frame* _inCoordinatesOf) const
+{
+  return getCompactJacobian(_node, _localOffset, _relativeTo, _inCoordinatesOf)
+      .toDense();
+}
+
+//==============================================================================
+template <typename... Args>
+CompactJacobian variadicGetCompactJacobian(
+    const Skeleton* _skel, const JacobianNode* _node, Args... args)
+{
+  if (!isValidBodyNode(_skel, _node, "getCompactJacobian"))
+    return CompactJacobian(_skel->getNumDofs());
+
+  return CompactJacobian(
+      _skel->getNumDofs(),
+      _node->getDependentGenCoordIndices(),
+      _node->getJacobian(args...));
+}
+
+//==============================================================================
+CompactJacobian Skeleton::getCompactJacobian(const JacobianNode* _node) const
+{
+  return variadicGetCompactJacobian(this, _node);
+}
+
+//==============================================================================
+CompactJacobian Skeleton::getCompactJacobian(
+    const JacobianNode* _node, const Frame* _inCoordinatesOf) const
+{
+  return variadicGetCompactJacobian(this, _node, _inCoordinatesOf);
+}
+
+//==============================================================================
+CompactJacobian Skeleton::getCompactJacobian(
+    const JacobianNode* _node,
+    const Eigen::Vector3d& _localOffset,
+    const Frame* _inCoordinatesOf) const
+{
+  return variadicGetCompactJacobian(
+      this, _node, _localOffset, _inCoordinatesOf);
+}
+
+//==============================================================================
+static CompactJacobian getRelativeCompactJacobian(
+    const Skeleton* _skel,
+    const JacobianNode* _node,
+    const Eigen::Vector3d* _localOffset,
+    const JacobianNode* _relativeTo,
+    const Frame* _inCoordinatesOf)
+{
+  const std::size_t numDofs = _skel->getNumDofs();
+
+  if (!isValidBodyNode(_skel, _node, "getCompactJacobian")
+      || !isValidBodyNode(_skel, _relativeTo, "getCompactJacobian"))
+    return CompactJacobian(numDofs);
+
+  if (_node == _relativeTo)
+    return CompactJacobian(numDofs);
+
+  // Both index lists are sorted, so their union is a single merge. Each column
+  // of the two BodyNode Jacobians is accumulated into its column in the union.
+  const std::vector<std::size_t>& nodeIndices
+      = _node->getDependentGenCoordIndices();
+  const std::vector<std::size_t>& relIndices
+      = _relativeTo->getDependentGenCoordIndices();
+
+  std::vector<std::size_t> indices;
+  indices.reserve(nodeIndices.size() + relIndices.size());
+  std::set_union(
+      nodeIndices.begin(),
+      nodeIndices.end(),
+      relIndices.begin(),
+      relIndices.end(),
+      std::back_inserter(indices));
+
+  const math::Jacobian& J = _node->getJacobian();
+  const math::Jacobian JRelTo = math::AdTJac(
+      _relativeTo->getTransform(_node), _relativeTo->getJacobian());
+
+  math::Jacobian block = math::Jacobian::Zero(6, indices.size());
+  std::size_t nodeCol = 0u;
+  std::size_t relCol = 0u;
+  for (std::size_t i = 0u; i < indices.size(); ++i)
+  {
+    if (nodeCol < nodeIndices.size() && nodeIndices[nodeCol] == indices[i])
+      block.col(i) += J.col(nodeCol++);
+
+    if (relCol < relIndices.size() && relIndices[relCol] == indices[i])
+      block.col(i) -= JRelTo.col(relCol++);
+  }
+
+  if (_localOffset)
+    block.bottomRows<3>() += block.topRows<3>().colwise().cross(*_localOffset);
+
+  if (_node != _inCoordinatesOf)
+    block = math::AdRJac(_node->getTransform(_inCoordinatesOf), block);
+
+  return CompactJacobian(numDofs, indices, block);
+}
+
+//==============================================================================
+CompactJacobian Skeleton::getCompactJacobian(
+    const JacobianNode* _node,
+    const JacobianNode* _relativeTo,
+    const Frame* _inCoordinatesOf) const
+{
+  return getRelativeCompactJacobian(
+      this, _node, nullptr, _relativeTo, _inCoordinatesOf);
+}
+
+//==============================================================================
+CompactJacobian Skeleton::getCompactJacobian(
+    const JacobianNode* _node,
+    const Eigen::Vector3d& _localOffset,
+    const JacobianNode* _relativeTo,
+    const Frame* _inCoordinatesOf) const
+{
+  return getRelativeCompactJacobian(
+      this, _node, &_localOffset, _relativeTo, _inCoordinatesOf);
+}
+
 //==============================================================================
 template <typename... Args>
 math::Jacobian variadicGetWorldJacobian(
@@ -1786,6 +2015,47 @@ math::LinearJacobian Skeleton::getLinearJacobian(
   return variadicGetLinearJacobian(this, _node, _localOffset, _inCoordinatesOf);
 }
 
+//==============================================================================
+/// Scatter _rows of the stored block of a CompactJacobian into a zero
+/// Jacobian with one column per coordinate of the Skeleton
+template <typename JacobianType, typename RowsType>
+JacobianType scatterCompactJacobian(
+    const CompactJacobian& _compact, const RowsType& _rows)
+{
+  JacobianType J = JacobianType::Zero(_rows.rows(), _compact.getNumDofs());
+
+  const std::vector<std::size_t>& indices = _compact.getIndices();
+  for (std::size_t k = 0u; k < indices.size(); ++k)
+    J.col(indices[k]) = _rows.col(k);
+
+  return J;
+}
+
+//==============================================================================
+math::LinearJacobian Skeleton::getLinearJacobian(
+    const JacobianNode* _node,
+    const JacobianNode* _relativeTo,
+    const Frame* _inCoordinatesOf) const
+{
+  const CompactJacobian J
+      = getCompactJacobian(_node, _relativeTo, _inCoordinatesOf);
+  return scatterCompactJacobian<math::LinearJacobian>(
+      J, J.getBlock().bottomRows<3>());
+}
+
+//==============================================================================
+math::LinearJacobian Skeleton::getLinearJacobian(
+    const JacobianNode* _node,
+    const Eigen::Vector3d& _localOffset,
+    const JacobianNode* _relativeTo,
+    const Frame* _inCoordinatesOf) const
+{
+  const CompactJacobian J = getCompactJacobian(
+      _node, _localOffset, _relativeTo, _inCoordinatesOf);
+  return scatterCompactJacobian<math::LinearJacobian>(
+      J, J.getBlock().bottomRows<3>());
+}
+
 //==============================================================================
 template <typename... Args>
 math::AngularJacobian variadicGetAngularJacobian(
@@ -1810,6 +2080,18 @@ math::AngularJacobian Skeleton::getAngularJacobian(
   return variadicGetAngularJacobian(this, _node, _inCoordinatesOf);
 }
 
+//==============================================================================
+math::AngularJacobian Skeleton::getAngularJacobian(
+    const JacobianNode* _node,
+    const JacobianNode* _relativeTo,
+    const Frame* _inCoordinatesOf) const
+{
+  const CompactJacobian J
+      = getCompactJacobian(_node, _relativeTo, _inCoordinatesOf);
+  return scatterCompactJacobian<math::AngularJacobian>(
+      J, J.getBlock().topRows<3>());
+}
+
 //==============================================================================
 template <typename... Args>
 math::Jacobian variadicGetJacobianSpatialDeriv(
@@ -2130,7 +2412,9 @@ const Eigen::VectorXd& Skeleton::getConstraintForces() const
 
 //==============================================================================
 Skeleton::Skeleton(const AspectPropertiesData& properties)
-  : mTotalMass(0.0), mIsImpulseApplied(false), mUnionSize(1)
+  : mTotalMass(0.0),
+    mIsImpulseApplied(false),
+    mUnionSize(1)
 {
   createAspect<Aspect>(properties);
   createAspect<detail::BodyNodeVectorProxyAspect>();
@@ -3229,6 +3513,108 @@ void Skeleton::updateInvAugMassMatrix() const
   mSkelCache.mDirty.mInvAugMassMatrix = false;
 }
 
+//==============================================================================
+void Skeleton::updateCentroidalMomentumMatrix() const
+{
+  DataCache& cache = mSkelCache;
+  const std::size_t numBodies = cache.mBodyNodes.size();
+
+  cache.mCentroidalMomentumMatrix.setZero(6, getNumDofs());
+  cache.mCentroidalInertia.setZero();
+  cache.mDirty.mCentroidalMomentumMatrix = false;
+
+  if (numBodies == 0u || mTotalMass == 0.0)
+    return;
+
+  const Eigen::Vector3d com = getCOM();
+
+  // Composite rigid body inertias in the BodyNode frames. Parents are indexed
+  // before their children, so a backward sweep accumulates whole subtrees.
+  common::aligned_vector<Eigen::Matrix6d> inertias(numBodies);
+  for (std::size_t i = 0u; i < numBodies; ++i)
+    inertias[i] = cache.mBodyNodes[i]->getSpatialInertia();
+
+  for (std::size_t i = numBodies; i-- > 0u;)
+  {
+    const BodyNode* bodyNode = cache.mBodyNodes[i];
+    const BodyNode* parent = bodyNode->getParentBodyNode();
+    if (parent)
+    {
+      inertias[parent->getIndexInSkeleton()] += math::transformInertia(
+          bodyNode->getParentJoint()->getRelativeTransform().inverse(),
+          inertias[i]);
+    }
+  }
+
+  // A motion of the parent Joint of a BodyNode moves its whole subtree
+  // rigidly, so the columns of that Joint are the momentum of the composite
+  // rigid body, transformed to the centroidal frame
+  for (std::size_t i = 0u; i < numBodies; ++i)
+  {
+    const BodyNode* bodyNode = cache.mBodyNodes[i];
+    const Joint* joint = bodyNode->getParentJoint();
+    const Eigen::Isometry3d T = getCentroidalTransform(bodyNode, com);
+
+    const std::size_t numDofs = joint->getNumDofs();
+    if (numDofs > 0u)
+    {
+      const math::Jacobian momenta
+          = inertias[i] * joint->getRelativeJacobian();
+      const std::size_t start = joint->getIndexInSkeleton(0u);
+      for (std::size_t k = 0u; k < numDofs; ++k)
+      {
+        cache.mCentroidalMomentumMatrix.col(start + k)
+            = math::dAdInvT(T, momenta.col(k));
+      }
+    }
+
+    if (!bodyNode->getParentBodyNode())
+    {
+      cache.mCentroidalInertia
+          += math::transformInertia(T.inverse(), inertias[i]);
+    }
+  }
+}
+
+//==============================================================================
+void Skeleton::updateCentroidalMomentumBias() const
+{
+  DataCache& cache = mSkelCache;
+  const std::size_t numBodies = cache.mBodyNodes.size();
+
+  cache.mCentroidalMomentumBias.setZero();
+  cache.mDirty.mCentroidalMomentumBias = false;
+
+  if (numBodies == 0u || mTotalMass == 0.0)
+    return;
+
+  const Eigen::Vector3d com = getCOM();
+
+  // Sum the rates of change of the momenta of the BodyNodes when all the
+  // generalized accelerations are zero
+  common::aligned_vector<Eigen::Vector6d> accelerations(numBodies);
+  for (std::size_t i = 0u; i < numBodies; ++i)
+  {
+    const BodyNode* bodyNode = cache.mBodyNodes[i];
+    const BodyNode* parent = bodyNode->getParentBodyNode();
+
+    accelerations[i] = bodyNode->getPartialAcceleration();
+    if (parent)
+    {
+      accelerations[i] += math::AdInvT(
+          bodyNode->getParentJoint()->getRelativeTransform(),
+          accelerations[parent->getIndexInSkeleton()]);
+    }
+
+    const Eigen::Matrix6d& I = bodyNode->getSpatialInertia();
+    const Eigen::Vector6d& V = bodyNode->getSpatialVelocity();
+    const Eigen::Vector6d F = I * accelerations[i] - math::dad(V, I * V);
+
+    cache.mCentroidalMomentumBias
+        += math::dAdInvT(getCentroidalTransform(bodyNode, com), F);
+  }
+}
+
 //==============================================================================
 void Skeleton::updateCoriolisForces(std::size_t _treeIdx) const
 {
@@ -3730,19 +4116,21 @@ void Skeleton::computeForwardDynamics()
   // Note: Articulated Inertias will be updated automatically when
   // getArtInertiaImplicit() is called in BodyNode::updateBiasForce()
 
-  for (auto it = mSkelCache.mBodyNodes.rbegin();
-       it != mSkelCache.mBodyNodes.rend();
-       ++it)
-    (*it)->updateBiasForce(
-        mAspectProperties.mGravity, mAspectProperties.mTimeStep);
+  forEachTree([this](std::size_t tree) {
+    const std::vector<BodyNode*>& bodyNodes = mTreeCache[tree].mBodyNodes;
 
-  // Forward recursion
-  for (auto& bodyNode : mSkelCache.mBodyNodes)
-  {
-    bodyNode->updateAccelerationFD();
-    bodyNode->updateTransmittedForceFD();
-    bodyNode->updateJointForceFD(mAspectProperties.mTimeStep, true, true);
-  }
+    for (auto it = bodyNodes.rbegin(); it != bodyNodes.rend(); ++it)
+      (*it)->updateBiasForce(
+          mAspectProperties.mGravity, mAspectProperties.mTimeStep);
+
+    // Forward recursion
+    for (auto& bodyNode : bodyNodes)
+    {
+      bodyNode->updateAccelerationFD();
+      bodyNode->updateTransmittedForceFD();
+      bodyNode->updateJointForceFD(mAspectProperties.mTimeStep, true, true);
+    }
+  });
 }
 
 //==============================================================================
@@ -3765,6 +4153,95 @@ void Skeleton::computeInverseDynamics(
   }
 }
 
+//==============================================================================
+Eigen::MatrixXd Skeleton::computeInverseDynamics(
+    const Eigen::MatrixXd& _positions,
+    const Eigen::MatrixXd& _velocities,
+    const Eigen::MatrixXd& _accelerations,
+    bool _withExternalForces,
+    bool _withDampingForces,
+    bool _withSpringForces) const
+{
+  const Eigen::Index numDofs = static_cast<Eigen::Index>(getNumDofs());
+  const Eigen::Index numSamples = _positions.cols();
+  if (_positions.rows() != numDofs || _velocities.rows() != numDofs
+      || _accelerations.rows() != numDofs || _velocities.cols() != numSamples
+      || _accelerations.cols() != numSamples)
+  {
+    dterr << "[Skeleton::computeInverseDynamics] Mismatching trajectory "
+          << "sizes: positions (" << _positions.rows() << " x "
+          << _positions.cols() << "), velocities (" << _velocities.rows()
+          << " x " << _velocities.cols() << "), accelerations ("
+          << _accelerations.rows() << " x " << _accelerations.cols()
+          << "), but the Skeleton [" << getName() << "] has " << numDofs
+          << " DOFs.\n";
+    assert(false);
+    return Eigen::MatrixXd::Zero(numDofs, numSamples);
+  }
+
+  Eigen::MatrixXd forces(numDofs, numSamples);
+  if (numDofs == 0 || numSamples == 0)
+    return forces;
+
+  const std::shared_ptr<common::ThreadPool> pool = getThreadPool();
+
+  if (InverseDynamics::isSupported(*this))
+  {
+    const InverseDynamics inverseDynamics(
+        *this, _withExternalForces, _withDampingForces, _withSpringForces);
+    inverseDynamics.compute(
+        _positions, _velocities, _accelerations, forces, pool.get());
+    return forces;
+  }
+
+  // Each task sets the samples of its range on its own clone, which keeps the
+  // external forces and the Joint properties of this Skeleton. The clones are
+  // made up front because cloning reads the lazily updated caches of this
+  // Skeleton.
+  const std::size_t numThreads = pool ? pool->getNumThreads() : 1u;
+  const std::size_t numTasks
+      = std::min(static_cast<std::size_t>(numSamples), numThreads);
+  const std::size_t samplesPerTask
+      = (static_cast<std::size_t>(numSamples) + numTasks - 1u) / numTasks;
+
+  std::vector<SkeletonPtr> clones(numTasks);
+  for (auto& clone : clones)
+  {
+    clone = cloneSkeleton();
+    clone->setThreadPool(nullptr);
+  }
+
+  const auto task = [&](std::size_t _taskIndex) {
+    const std::size_t begin = _taskIndex * samplesPerTask;
+    const std::size_t end = std::min(
+        begin + samplesPerTask, static_cast<std::size_t>(numSamples));
+
+    const SkeletonPtr& clone = clones[_taskIndex];
+    for (std::size_t i = begin; i < end; ++i)
+    {
+      const Eigen::Index col = static_cast<Eigen::Index>(i);
+      clone->setPositions(_positions.col(col));
+      clone->setVelocities(_velocities.col(col));
+      clone->setAccelerations(_accelerations.col(col));
+      clone->computeInverseDynamics(
+          _withExternalForces, _withDampingForces, _withSpringForces);
+      forces.col(col) = clone->getForces();
+    }
+  };
+
+  if (pool && numTasks > 1u)
+  {
+    pool->parallelFor(numTasks, task);
+  }
+  else
+  {
+    for (std::size_t i = 0u; i < numTasks; ++i)
+      task(i);
+  }
+
+  return forces;
+}
+
 //==============================================================================
 void Skeleton::clearExternalForces()
 {
@@ -3796,6 +4273,8 @@ void Skeleton::dirtyArticulatedInertia(std::size_t _treeIdx)
   SET_FLAG(_treeIdx, mCoriolisForces);
   SET_FLAG(_treeIdx, mGravityForces);
   SET_FLAG(_treeIdx, mCoriolisAndGravityForces);
+  SET_FLAG(_treeIdx, mCentroidalMomentumMatrix);
+  SET_FLAG(_treeIdx, mCentroidalMomentumBias);
 }
 
 //==============================================================================
@@ -4010,19 +4489,99 @@ void Skeleton::computeImpulseForwardDynamics()
   // be updated when BodyNode::updateBiasImpulse() calls
   // BodyNode::getArticulatedInertia()
 
-  // Backward recursion
-  for (auto it = mSkelCache.mBodyNodes.rbegin();
-       it != mSkelCache.mBodyNodes.rend();
-       ++it)
-    (*it)->updateBiasImpulse();
+  forEachTree([this](std::size_t tree) {
+    const std::vector<BodyNode*>& bodyNodes = mTreeCache[tree].mBodyNodes;
 
-  // Forward recursion
+    // Backward recursion
+    for (auto it = bodyNodes.rbegin(); it != bodyNodes.rend(); ++it)
+      (*it)->updateBiasImpulse();
+
+    // Forward recursion
+    for (auto& bodyNode : bodyNodes)
+    {
+      bodyNode->updateVelocityChangeFD();
+      bodyNode->updateTransmittedImpulse();
+      bodyNode->updateJointImpulseFD();
+    }
+  });
+
+  // Applying the velocity changes dirties the velocity-dependent caches of the
+  // Skeleton, which are shared by all the trees, so it is done serially. None
+  // of the passes above depend on the joint velocities.
   for (auto& bodyNode : mSkelCache.mBodyNodes)
-  {
-    bodyNode->updateVelocityChangeFD();
-    bodyNode->updateTransmittedImpulse();
-    bodyNode->updateJointImpulseFD();
     bodyNode->updateConstrainedTerms(mAspectProperties.mTimeStep);
+}
+
+//==============================================================================
+void Skeleton::setThreadPool(const std::shared_ptr<common::ThreadPool>& pool)
+{
+  mThreadPool = pool;
+}
+
+//==============================================================================
+std::shared_ptr<common::ThreadPool> Skeleton::getThreadPool() const
+{
+  return mThreadPool;
+}
+
+//==============================================================================
+static bool hasConnectedUpdateSignals(Entity* _entity)
+{
+  if (_entity->hasConnectedUpdateSignals())
+    return true;
+
+  Frame* frame = dynamic_cast<Frame*>(_entity);
+  if (!frame)
+    return false;
+
+  // The child BodyNodes are visited by the caller
+  for (Entity* child : frame->getChildEntities())
+  {
+    if (!dynamic_cast<BodyNode*>(child)
+        && hasConnectedUpdateSignals(child))
+      return true;
+  }
+
+  return false;
+}
+
+//==============================================================================
+void Skeleton::forEachTree(const std::function<void(std::size_t)>& _function)
+{
+  // Below this size, waking up the workers costs more than the passes saved
+  static constexpr std::size_t minBodyNodesForThreads = 16u;
+
+  const std::size_t numTrees = mTreeCache.size();
+  if (numTrees < 2u || mSkelCache.mBodyNodes.size() < minBodyNodesForThreads)
+  {
+    for (std::size_t tree = 0u; tree < numTrees; ++tree)
+      _function(tree);
+    return;
+  }
+
+  // The passes dirty the Frames of the trees they process, so the slots
+  // connected to those Frames would be called from the worker threads
+  bool hasSignals = false;
+  if (mThreadPool)
+  {
+    for (BodyNode* bodyNode : mSkelCache.mBodyNodes)
+    {
+      if (hasConnectedUpdateSignals(bodyNode))
+      {
+        hasSignals = true;
+        break;
+      }
+    }
+  }
+
+  if (mThreadPool && !hasSignals)
+  {
+    mThreadPool->parallelFor(numTrees, _function);
+  }
+  else
+  {
+    for (std::size_t tree = 0u; tree < numTrees; ++tree)
+      _function(tree);
   }
 }
 
@@ -4227,6 +4786,33 @@ math::LinearJacobian Skeleton::getCOMLinearJacobianDeriv(
       this, _inCoordinatesOf);
 }
 
+//==============================================================================
+math::Jacobian Skeleton::getCentroidalMomentumMatrix() const
+{
+  if (mSkelCache.mDirty.mCentroidalMomentumMatrix)
+    updateCentroidalMomentumMatrix();
+
+  return mSkelCache.mCentroidalMomentumMatrix;
+}
+
+//==============================================================================
+Eigen::Vector6d Skeleton::getCentroidalMomentumBias() const
+{
+  if (mSkelCache.mDirty.mCentroidalMomentumBias)
+    updateCentroidalMomentumBias();
+
+  return mSkelCache.mCentroidalMomentumBias;
+}
+
+//==============================================================================
+Eigen::Matrix6d Skeleton::getCentroidalInertia() const
+{
+  if (mSkelCache.mDirty.mCentroidalMomentumMatrix)
+    updateCentroidalMomentumMatrix();
+
+  return mSkelCache.mCentroidalInertia;
+}
+
 //==============================================================================
 Skeleton::DirtyFlags::DirtyFlags()
   : mArticulatedInertia(true),
@@ -4239,6 +4825,8 @@ Skeleton::DirtyFlags::DirtyFlags()
     mCoriolisAndGravityForces(true),
     mExternalForces(true),
     mDampingForces(true),
+    mCentroidalMomentumMatrix(true),
+    mCentroidalMomentumBias(true),
     mSupport(true),
     mSupportVersion(0)
 {
@@ -33,9 +33,11 @@
 #ifndef DART_DYNAMICS_SKELETON_HPP_
 #define DART_DYNAMICS_SKELETON_HPP_
 
+#include <functional>
 #include <mutex>
 #include "dart/common/NameManager.hpp"
 #include "dart/common/VersionCounter.hpp"
+#include "dart/dynamics/CompactJacobian.hpp"
 #include "dart/dynamics/EndEffector.hpp"
 #include "dart/dynamics/HierarchicalIK.hpp"
 #include "dart/dynamics/Joint.hpp"
@@ -48,6 +50,10 @@
 #include "dart/dynamics/detail/SkeletonAspect.hpp"
 
 namespace dart {
+namespace common {
+class ThreadPool;
+} // namespace common
+
 namespace dynamics {
 
 /// class Skeleton
@@ -218,6 +224,23 @@ public:
   /// \{ \name State
   //----------------------------------------------------------------------------
 
+  using MetaSkeleton::setAccelerations;
+  using MetaSkeleton::setPositions;
+  using MetaSkeleton::setVelocities;
+
+  /// Set the positions of all the generalized coordinates. The values are
+  /// written Joint by Joint, and each tree whose state has changed is
+  /// invalidated once instead of once per DegreeOfFreedom.
+  void setPositions(const Eigen::VectorXd& positions) override;
+
+  /// Set the velocities of all the generalized coordinates. See
+  /// setPositions(const Eigen::VectorXd&).
+  void setVelocities(const Eigen::VectorXd& velocities) override;
+
+  /// Set the accelerations of all the generalized coordinates. See
+  /// setPositions(const Eigen::VectorXd&).
+  void setAccelerations(const Eigen::VectorXd& accelerations) override;
+
   /// Set the State of this Skeleton [alias for setCompositeState(~)]
   void setState(const State& state);
 
@@ -643,7 +666,9 @@ public:
   // Dynamics algorithms
   //----------------------------------------------------------------------------
 
-  /// Compute forward dynamics
+  /// Compute forward dynamics. The trees of this Skeleton are independent of
+  /// each other, so when there are several of them they are processed
+  /// concurrently on the thread pool of this Skeleton (see setThreadPool()).
   void computeForwardDynamics();
 
   /// Computes inverse dynamics.
@@ -677,6 +702,27 @@ public:
       bool _withDampingForces = false,
       bool _withSpringForces = false);
 
+  /// Computes inverse dynamics for every sample of a trajectory without
+  /// changing the state of this Skeleton.
+  ///
+  /// Each column of _positions, _velocities and _accelerations is one sample,
+  /// and the matching column of the returned matrix holds its joint forces.
+  /// The flags, the external forces, gravity and time step are the same as in
+  /// computeInverseDynamics() and are taken from the current state of this
+  /// Skeleton. The samples are distributed over the thread pool of this
+  /// Skeleton (see setThreadPool()).
+  ///
+  /// Skeletons supported by InverseDynamics run the recursion over a
+  /// flattened copy of their model. The others are computed on clones of this
+  /// Skeleton, one per task.
+  Eigen::MatrixXd computeInverseDynamics(
+      const Eigen::MatrixXd& _positions,
+      const Eigen::MatrixXd& _velocities,
+      const Eigen::MatrixXd& _accelerations,
+      bool _withExternalForces = false,
+      bool _withDampingForces = false,
+      bool _withSpringForces = false) const;
+
   //----------------------------------------------------------------------------
   // Impulse-based dynamics algorithms
   //----------------------------------------------------------------------------
@@ -723,9 +769,24 @@ public:
   /// Get whether this skeleton is constrained
   bool isImpulseApplied() const;
 
-  /// Compute impulse-based forward dynamics
+  /// Compute impulse-based forward dynamics. Like computeForwardDynamics(),
+  /// the trees are processed concurrently when possible.
   void computeImpulseForwardDynamics();
 
+  /// Set the thread pool used to process the trees of this Skeleton
+  /// concurrently, e.g., common::ThreadPool::getDefault(). Pass nullptr to
+  /// process them serially, which is the default.
+  ///
+  /// The trees are still processed serially while a slot is connected to the
+  /// transform, velocity or acceleration signal of one of the Frames of this
+  /// Skeleton, so that the signals are always raised on the calling thread.
+  /// An exception thrown by a pass is rethrown on the calling thread.
+  void setThreadPool(const std::shared_ptr<common::ThreadPool>& pool);
+
+  /// Get the thread pool used to process the trees of this Skeleton
+  /// concurrently. Returns nullptr if they are processed serially.
+  std::shared_ptr<common::ThreadPool> getThreadPool() const;
+
   //----------------------------------------------------------------------------
   /// \{ \name Jacobians
   //----------------------------------------------------------------------------
@@ -748,6 +809,56 @@ public:
       const Eigen::Vector3d& _localOffset,
       const Frame* _inCoordinatesOf) const override;
 
+  /// Computed from the columns of the dependent coordinates only, through
+  /// getCompactJacobian()
+  math::Jacobian getJacobian(
+      const JacobianNode* _node,
+      const JacobianNode* _relativeTo,
+      const Frame* _inCoordinatesOf) const override;
+
+  /// Computed from the columns of the dependent coordinates only, through
+  /// getCompactJacobian()
+  math::Jacobian getJacobian(
+      const JacobianNode* _node,
+      const Eigen::Vector3d& _localOffset,
+      const JacobianNode* _relativeTo,
+      const Frame* _inCoordinatesOf) const override;
+
+  /// Get the spatial Jacobian targeting the origin of a BodyNode, keeping
+  /// only the columns of the coordinates that the BodyNode depends on. The
+  /// Jacobian is expressed in the Frame of the BodyNode.
+  CompactJacobian getCompactJacobian(const JacobianNode* _node) const;
+
+  /// Same as getCompactJacobian(const JacobianNode*), but expressed in
+  /// _inCoordinatesOf
+  CompactJacobian getCompactJacobian(
+      const JacobianNode* _node, const Frame* _inCoordinatesOf) const;
+
+  /// Same as getCompactJacobian(const JacobianNode*, const Frame*), but
+  /// targeting an offset in the BodyNode, given in coordinates of the
+  /// BodyNode Frame
+  CompactJacobian getCompactJacobian(
+      const JacobianNode* _node,
+      const Eigen::Vector3d& _localOffset,
+      const Frame* _inCoordinatesOf) const;
+
+  /// Get the compact spatial Jacobian of a BodyNode relative to another
+  /// BodyNode in this Skeleton. The columns are the union of the coordinates
+  /// that either BodyNode depends on.
+  CompactJacobian getCompactJacobian(
+      const JacobianNode* _node,
+      const JacobianNode* _relativeTo,
+      const Frame* _inCoordinatesOf) const;
+
+  /// Same as getCompactJacobian(const JacobianNode*, const JacobianNode*,
+  /// const Frame*), but targeting an offset in the BodyNode, given in
+  /// coordinates of the BodyNode Frame
+  CompactJacobian getCompactJacobian(
+      const JacobianNode* _node,
+      const Eigen::Vector3d& _localOffset,
+      const JacobianNode* _relativeTo,
+      const Frame* _inCoordinatesOf) const;
+
   // Documentation inherited
   math::Jacobian getWorldJacobian(const JacobianNode* _node) const override;
 
@@ -767,11 +878,33 @@ public:
       const Eigen::Vector3d& _localOffset,
       const Frame* _inCoordinatesOf = Frame::World()) const override;
 
+  /// Computed from the columns of the dependent coordinates only, through
+  /// getCompactJacobian()
+  math::LinearJacobian getLinearJacobian(
+      const JacobianNode* _node,
+      const JacobianNode* _relativeTo,
+      const Frame* _inCoordinatesOf = Frame::World()) const override;
+
+  /// Computed from the columns of the dependent coordinates only, through
+  /// getCompactJacobian()
+  math::LinearJacobian getLinearJacobian(
+      const JacobianNode* _node,
+      const Eigen::Vector3d& _localOffset,
+      const JacobianNode* _relativeTo,
+      const Frame* _inCoordinatesOf = Frame::World()) const override;
+
   // Documentation inherited
   math::AngularJacobian getAngularJacobian(
       const JacobianNode* _node,
       const Frame* _inCoordinatesOf = Frame::World()) const override;
 
+  /// Computed from the columns of the dependent coordinates only, through
+  /// getCompactJacobian()
+  math::AngularJacobian getAngularJacobian(
+      const JacobianNode* _node,
+      const JacobianNode* _relativeTo,
+      const Frame* _inCoordinatesOf = Frame::World()) const override;
+
   // Documentation inherited
   math::Jacobian getJacobianSpatialDeriv(
       const JacobianNode* _node) const override;
@@ -986,6 +1119,25 @@ public:
 
   /// \}
 
+  //----------------------------------------------------------------------------
+  /// \{ \name Centroidal Dynamics
+  //----------------------------------------------------------------------------
+
+  /// Get the centroidal momentum matrix. It is computed in O(n) from the
+  /// composite rigid body inertias and cached until the positions or the
+  /// inertias of this Skeleton change. SoftBodyNodes only contribute their
+  /// rigid body inertia.
+  math::Jacobian getCentroidalMomentumMatrix() const override;
+
+  /// Get the centroidal momentum bias. It is computed in O(n) and cached until
+  /// the positions or the velocities of this Skeleton change.
+  Eigen::Vector6d getCentroidalMomentumBias() const override;
+
+  // Documentation inherited
+  Eigen::Matrix6d getCentroidalInertia() const override;
+
+  /// \}
+
   //----------------------------------------------------------------------------
   // Friendship
   //----------------------------------------------------------------------------
@@ -1103,6 +1255,11 @@ protected:
   /// Update the articulated inertias of the skeleton
   void updateArticulatedInertia() const;
 
+  /// Call _function(tree) for every tree of this Skeleton. The calls are made
+  /// concurrently when the Skeleton has a thread pool, is large enough for it
+  /// to pay off and none of its Frames has a connected update signal.
+  void forEachTree(const std::function<void(std::size_t)>& _function);
+
   /// Update the mass matrix of a tree
   void updateMassMatrix(std::size_t _treeIdx) const;
 
@@ -1126,6 +1283,13 @@ protected:
   /// Update inverse of augmented mass matrix of the skeleton.
   void updateInvAugMassMatrix() const;
 
+  /// Update the centroidal momentum matrix and the centroidal inertia of the
+  /// skeleton
+  void updateCentroidalMomentumMatrix() const;
+
+  /// Update the centroidal momentum bias of the skeleton
+  void updateCentroidalMomentumBias() const;
+
   /// Update Coriolis force vector for a tree in the Skeleton
   void updateCoriolisForces(std::size_t _treeIdx) const;
 
@@ -1226,6 +1390,13 @@ protected:
     /// Dirty flag for the damping force vector.
     bool mDampingForces;
 
+    /// Dirty flag for the centroidal momentum matrix and the centroidal
+    /// inertia
+    bool mCentroidalMomentumMatrix;
+
+    /// Dirty flag for the centroidal momentum bias
+    bool mCentroidalMomentumBias;
+
     /// Dirty flag for the support polygon
     bool mSupport;
 
@@ -1278,6 +1449,15 @@ protected:
     /// Constraint force vector.
     Eigen::VectorXd mFc;
 
+    /// Centroidal momentum matrix
+    math::Jacobian mCentroidalMomentumMatrix;
+
+    /// Centroidal composite rigid body inertia
+    Eigen::Matrix6d mCentroidalInertia;
+
+    /// Centroidal momentum bias
+    Eigen::Vector6d mCentroidalMomentumBias;
+
     /// Support polygon
     math::SupportPolygon mSupportPolygon;
 
@@ -1315,6 +1495,10 @@ protected:
   /// Flag for status of impulse testing.
   bool mIsImpulseApplied;
 
+  /// Thread pool used by forEachTree(), nullptr unless setThreadPool() was
+  /// called
+  std::shared_ptr<common::ThreadPool> mThreadPool;
+
   mutable std::mutex mMutex;
 
 public:
@@ -32,6 +32,7 @@
 
 #include "dart/dynamics/SoftBodyNode.hpp"
 
+#include <algorithm>
 #include <map>
 #include <string>
 #include <vector>
@@ -56,10 +57,12 @@ SoftBodyNodeUniqueProperties::SoftBodyNodeUniqueProperties(
     double _Ke,
     double _DampCoeff,
     const std::vector<PointMass::Properties>& _points,
-    const std::vector<Eigen::Vector3i>& _faces)
+    const std::vector<Eigen::Vector3i>& _faces,
+    bool _implicitEdgeSprings)
   : mKv(_Kv),
     mKe(_Ke),
     mDampCoeff(_DampCoeff),
+    mImplicitEdgeSprings(_implicitEdgeSprings),
     mPointProps(_points),
     mFaces(_faces)
 {
@@ -127,6 +130,59 @@ SoftBodyNodeProperties::SoftBodyNodeProperties(
 
 } // namespace detail
 
+namespace {
+
+//==============================================================================
+/// Return the matrix whose i-th row is w x vectors.row(i)
+Eigen::MatrixX3d crossRows(
+    const Eigen::Vector3d& w, const Eigen::Ref<const Eigen::MatrixX3d>& vectors)
+{
+  Eigen::MatrixX3d result(vectors.rows(), 3);
+  result.col(0) = w[1] * vectors.col(2) - w[2] * vectors.col(1);
+  result.col(1) = w[2] * vectors.col(0) - w[0] * vectors.col(2);
+  result.col(2) = w[0] * vectors.col(1) - w[1] * vectors.col(0);
+
+  return result;
+}
+
+//==============================================================================
+/// Return the sum of x.row(i) x f.row(i) over all the rows
+Eigen::Vector3d sumCrossRows(
+    const Eigen::Ref<const Eigen::MatrixX3d>& x,
+    const Eigen::Ref<const Eigen::MatrixX3d>& f)
+{
+  return Eigen::Vector3d(
+      x.col(1).dot(f.col(2)) - x.col(2).dot(f.col(1)),
+      x.col(2).dot(f.col(0)) - x.col(0).dot(f.col(2)),
+      x.col(0).dot(f.col(1)) - x.col(1).dot(f.col(0)));
+}
+
+//==============================================================================
+/// Add the spatial inertia of point masses with the given weights, located at
+/// the rows of x, to the spatial inertia. Only the zeroth, first, and second
+/// moments of the points are needed, so the cost per point is a few
+/// multiply-adds.
+void addPointMassInertia(
+    Eigen::Matrix6d& inertia,
+    const Eigen::MatrixX3d& x,
+    const Eigen::VectorXd& weights)
+{
+  const double mass = weights.sum();
+  const Eigen::Vector3d firstMoment = x.transpose() * weights;
+  const Eigen::Matrix3d secondMoment
+      = x.transpose() * weights.asDiagonal() * x;
+  const Eigen::Matrix3d skew = math::makeSkewSymmetric(firstMoment);
+
+  // sum(-w * [x] * [x]) = sum(w * (x^T * x * I - x * x^T))
+  inertia.topLeftCorner<3, 3>() -= secondMoment;
+  inertia.topLeftCorner<3, 3>().diagonal().array() += secondMoment.trace();
+  inertia.topRightCorner<3, 3>() += skew;
+  inertia.bottomLeftCorner<3, 3>() -= skew;
+  inertia.bottomRightCorner<3, 3>().diagonal().array() += mass;
+}
+
+} // namespace
+
 //==============================================================================
 SoftBodyNode::~SoftBodyNode()
 {
@@ -179,6 +235,7 @@ void SoftBodyNode::setAspectProperties(const AspectProperties& properties)
   setVertexSpringStiffness(properties.mKv);
   setEdgeSpringStiffness(properties.mKe);
   setDampingCoefficient(properties.mDampCoeff);
+  setImplicitEdgeSprings(properties.mImplicitEdgeSprings);
 
   if (properties.mPointProps != mAspectProperties.mPointProps
       || properties.mFaces != mAspectProperties.mFaces)
@@ -472,6 +529,23 @@ double SoftBodyNode::getDampingCoefficient() const
   return mAspectProperties.mDampCoeff;
 }
 
+//==============================================================================
+void SoftBodyNode::setImplicitEdgeSprings(bool _implicit)
+{
+  if (_implicit == mAspectProperties.mImplicitEdgeSprings)
+    return;
+
+  mAspectProperties.mImplicitEdgeSprings = _implicit;
+  dirtyArticulatedInertia();
+  incrementVersion();
+}
+
+//==============================================================================
+bool SoftBodyNode::areEdgeSpringsImplicit() const
+{
+  return mAspectProperties.mImplicitEdgeSprings;
+}
+
 //==============================================================================
 void SoftBodyNode::removeAllPointMasses()
 {
@@ -667,8 +741,8 @@ void SoftBodyNode::updateArtInertia(double _timeStep) const
 {
   const Eigen::Matrix6d& mI
       = BodyNode::mAspectProperties.mInertia.getSpatialTensor();
-  for (auto& pointMass : mPointMasses)
-    pointMass->updateArtInertiaFD(_timeStep);
+  updatePointMassBuffers(_timeStep);
+  const PointMassBuffers& buffers = mPointMassBuffers;
 
   assert(mParentJoint != nullptr);
 
@@ -687,11 +761,31 @@ void SoftBodyNode::updateArtInertia(double _timeStep) const
   }
 
   //
-  for (const auto& pointMass : mPointMasses)
+  addPointMassInertia(mArtInertia, buffers.mLocalPositions, buffers.mPi);
+
+  if (areEdgeSpringsImplicit())
+  {
+    updateImplicitSystem(_timeStep);
+
+    // Add J^T * m * (J - X) for each PointMass, where J maps the spatial
+    // acceleration of this body to the PointMass and X is the corresponding
+    // row of the implicit response.
+    addPointMassInertia(
+        mArtInertiaImplicit, buffers.mLocalPositions, buffers.mMasses);
+
+    for (int i = 0; i < 6; ++i)
+    {
+      const Eigen::MatrixX3d momentum
+          = buffers.mMasses.asDiagonal() * mImplicitResponse.middleCols<3>(3 * i);
+      mArtInertiaImplicit.col(i).head<3>()
+          -= sumCrossRows(buffers.mLocalPositions, momentum);
+      mArtInertiaImplicit.col(i).tail<3>() -= momentum.colwise().sum();
+    }
+  }
+  else
   {
-    _addPiToArtInertia(pointMass->getLocalPosition(), pointMass->mPi);
-    _addPiToArtInertiaImplicit(
-        pointMass->getLocalPosition(), pointMass->mImplicitPi);
+    addPointMassInertia(
+        mArtInertiaImplicit, buffers.mLocalPositions, buffers.mImplicitPi);
   }
 
   // Verification
@@ -713,16 +807,84 @@ void SoftBodyNode::updateBiasForce(
 {
   const Eigen::Matrix6d& mI
       = BodyNode::mAspectProperties.mInertia.getSpatialTensor();
+
+  // The local positions and the inertia terms of the PointMasses are gathered
+  // by the articulated inertia update
+  checkArticulatedInertiaUpdate();
+  PointMassBuffers& buffers = mPointMassBuffers;
+
+  const std::size_t numPointMasses = mPointMasses.size();
+  buffers.mPositions.resize(numPointMasses, 3);
+  buffers.mVelocities.resize(numPointMasses, 3);
+  buffers.mPartialAccelerations.resize(numPointMasses, 3);
+  Eigen::MatrixX3d externalForces(numPointMasses, 3);
   for (PointMass* pointMass : mPointMasses)
   {
     // Reset internal forces of point masses before used.
     //
     // Once control force for point mass is introduced, assign it to the
-    // internal force instead of always resetting the internal forces to zero.
+    // internal force instead of always resetting the internal forces to zero,
+    // and add it to alpha below.
     pointMass->resetForces();
 
-    pointMass->updateBiasForceFD(_timeStep, _gravity);
+    const std::size_t index = pointMass->mIndex;
+    buffers.mPositions.row(index) = pointMass->getPositions().transpose();
+    buffers.mVelocities.row(index) = pointMass->getVelocities().transpose();
+    buffers.mPartialAccelerations.row(index)
+        = pointMass->getPartialAccelerations().transpose();
+    externalForces.row(index) = pointMass->mFext.transpose();
+  }
+
+  const Eigen::Vector6d& V = getSpatialVelocity();
+  const Eigen::Vector3d w = V.head<3>();
+  const Eigen::VectorXd& masses = buffers.mMasses;
+
+  // B = w(parent) x m*v - fext - fgravity, where
+  // v = w(parent) x X + v(parent) + dq
+  Eigen::MatrixX3d momentum
+      = crossRows(w, buffers.mLocalPositions) + buffers.mVelocities;
+  momentum.rowwise() += V.tail<3>().transpose();
+  momentum = masses.asDiagonal() * momentum;
+  buffers.mBiasForces = crossRows(w, momentum) - externalForces;
+  if (BodyNode::mAspectProperties.mGravityMode == true)
+  {
+    const Eigen::Vector3d localGravity
+        = getWorldTransform().linear().transpose() * _gravity;
+    buffers.mBiasForces.noalias() -= masses * localGravity.transpose();
+  }
+  assert(!math::isNan(buffers.mBiasForces));
+
+  // Cache data: alpha
+  const double kv = getVertexSpringStiffness();
+  const double ke = getEdgeSpringStiffness();
+  const double kd = getDampingCoefficient();
+  const Eigen::ArrayXd stiffness = kv + ke * buffers.mNumConnected.array();
+  const Eigen::MatrixX3d predictedPositions
+      = buffers.mPositions + _timeStep * buffers.mVelocities;
+  buffers.mAlpha
+      = -(stiffness.matrix().asDiagonal() * predictedPositions)
+        - kd * buffers.mVelocities
+        - masses.asDiagonal() * buffers.mPartialAccelerations
+        - buffers.mBiasForces;
+  buffers.mAlpha.noalias() += ke * (buffers.mAdjacency * predictedPositions);
+  assert(!math::isNan(buffers.mAlpha));
+
+  // Cache data: beta
+  if (areEdgeSpringsImplicit() && numPointMasses > 0u)
+  {
+    // Solve the coupled system for the PointMass accelerations that would
+    // result from zero spatial acceleration of this body
+    mImplicitAccelerations = mImplicitSolver.solve(buffers.mAlpha);
+    buffers.mBeta = buffers.mPartialAccelerations + mImplicitAccelerations;
   }
+  else
+  {
+    buffers.mBeta = buffers.mPartialAccelerations
+                    + buffers.mImplicitPsi.asDiagonal() * buffers.mAlpha;
+  }
+  buffers.mBeta = masses.asDiagonal() * buffers.mBeta;
+  buffers.mBeta += buffers.mBiasForces;
+  assert(!math::isNan(buffers.mBeta));
 
   // Gravity force
   if (BodyNode::mAspectProperties.mGravityMode == true)
@@ -732,7 +894,6 @@ void SoftBodyNode::updateBiasForce(
     mFgravity.setZero();
 
   // Set bias force
-  const Eigen::Vector6d& V = getSpatialVelocity();
   mBiasForce = -math::dad(V, mI * V) - BodyNode::mAspectState.mFext - mFgravity;
 
   // Verifycation
@@ -751,12 +912,9 @@ void SoftBodyNode::updateBiasForce(
   }
 
   //
-  for (const auto& pointMass : mPointMasses)
-  {
-    mBiasForce.head<3>()
-        += pointMass->getLocalPosition().cross(pointMass->mBeta);
-    mBiasForce.tail<3>() += pointMass->mBeta;
-  }
+  mBiasForce.head<3>()
+      += sumCrossRows(buffers.mLocalPositions, buffers.mBeta);
+  mBiasForce.tail<3>() += buffers.mBeta.colwise().sum().transpose();
 
   // Verifycation
   assert(!math::isNan(mBiasForce));
@@ -773,8 +931,41 @@ void SoftBodyNode::updateAccelerationFD()
 {
   BodyNode::updateAccelerationFD();
 
+  PointMassBuffers& buffers = mPointMassBuffers;
+
+  // Acceleration of the PointMass origins: dw(parent) x X + dv(parent)
+  const Eigen::Vector6d& a = getSpatialAcceleration();
+  buffers.mParentAccelerations
+      = crossRows(a.head<3>(), buffers.mLocalPositions);
+  buffers.mParentAccelerations.rowwise() += a.tail<3>().transpose();
+
+  Eigen::MatrixX3d ddq;
+  if (areEdgeSpringsImplicit() && !mPointMasses.empty())
+  {
+    // ddq = ddq(a(parent) = 0) - X * a(parent), from the coupled system
+    ddq = mImplicitAccelerations;
+    for (int i = 0; i < 6; ++i)
+      ddq.noalias() -= a[i] * mImplicitResponse.middleCols<3>(3 * i);
+  }
+  else
+  {
+    // ddq = imp_psi*(alpha - m*(dw(parent) x X + dv(parent))
+    ddq = buffers.mImplicitPsi.asDiagonal()
+          * (buffers.mAlpha
+             - buffers.mMasses.asDiagonal() * buffers.mParentAccelerations);
+  }
+  assert(!math::isNan(ddq));
+
+  // dv = dw(parent) x X + dv(parent) + eta + ddq
   for (auto& pointMass : mPointMasses)
-    pointMass->updateAccelerationFD();
+  {
+    const std::size_t index = pointMass->mIndex;
+    pointMass->getState().mAccelerations = ddq.row(index).transpose();
+    pointMass->mA = (buffers.mParentAccelerations.row(index)
+                     + buffers.mPartialAccelerations.row(index)
+                     + ddq.row(index))
+                        .transpose();
+  }
 
   mNotifier->clearAccelerationNotice();
 }
@@ -1257,33 +1448,149 @@ void SoftBodyNode::clearInternalForces()
 }
 
 //==============================================================================
-void SoftBodyNode::_addPiToArtInertia(
-    const Eigen::Vector3d& _p, double _Pi) const
+void SoftBodyNode::updateImplicitSystem(double _timeStep) const
 {
-  Eigen::Matrix3d tmp = math::makeSkewSymmetric(_p);
+  const std::size_t numPointMasses = mPointMasses.size();
+  if (numPointMasses == 0u)
+  {
+    mImplicitResponse.resize(0, 18);
+    return;
+  }
+
+  const double kv = getVertexSpringStiffness();
+  const double ke = getEdgeSpringStiffness();
+  const double kd = getDampingCoefficient();
+  const double dt2 = _timeStep * _timeStep;
+
+  // (m + dt*kd + dt^2*(kv + n*ke)) * ddq_i - dt^2*ke * sum_j(ddq_j) = alpha_i
+  std::vector<Eigen::Triplet<double>> triplets;
+  triplets.reserve(numPointMasses * 7u);
+  for (const auto& pointMass : mPointMasses)
+  {
+    const std::size_t numConnected = pointMass->getNumConnectedPointMasses();
+    const int index = static_cast<int>(pointMass->mIndex);
+
+    triplets.emplace_back(
+        index,
+        index,
+        pointMass->getMass() + _timeStep * kd
+            + dt2 * (kv + numConnected * ke));
+
+    for (std::size_t j = 0u; j < numConnected; ++j)
+    {
+      triplets.emplace_back(
+          index,
+          static_cast<int>(pointMass->getConnectedPointMass(j)->mIndex),
+          -dt2 * ke);
+    }
+  }
+
+  Eigen::SparseMatrix<double> system(numPointMasses, numPointMasses);
+  system.setFromTriplets(triplets.begin(), triplets.end());
+
+  // Only refactorize when the coefficients changed, and only redo the symbolic
+  // analysis when the connectivity changed
+  const bool samePattern
+      = system.rows() == mImplicitSystem.rows()
+        && system.nonZeros() == mImplicitSystem.nonZeros()
+        && std::equal(
+            system.outerIndexPtr(),
+            system.outerIndexPtr() + system.outerSize() + 1,
+            mImplicitSystem.outerIndexPtr())
+        && std::equal(
+            system.innerIndexPtr(),
+            system.innerIndexPtr() + system.nonZeros(),
+            mImplicitSystem.innerIndexPtr());
+
+  if (!samePattern
+      || !std::equal(
+          system.valuePtr(),
+          system.valuePtr() + system.nonZeros(),
+          mImplicitSystem.valuePtr()))
+  {
+    if (!samePattern)
+      mImplicitSolver.analyzePattern(system);
+
+    mImplicitSolver.factorize(system);
+    mImplicitSystem = std::move(system);
+
+    if (mImplicitSolver.info() != Eigen::Success)
+    {
+      dterr << "[SoftBodyNode::updateImplicitSystem] Failed to factorize the "
+            << "PointMass system of SoftBodyNode [" << getName() << "].\n";
+      assert(false);
+    }
+  }
 
-  mArtInertia.topLeftCorner<3, 3>() -= _Pi * tmp * tmp;
-  mArtInertia.topRightCorner<3, 3>() += _Pi * tmp;
-  mArtInertia.bottomLeftCorner<3, 3>() -= _Pi * tmp;
+  // Right-hand side: m_i * J_i, where the i-th column of J maps the i-th
+  // component of the spatial acceleration of this body to the PointMass
+  const PointMassBuffers& buffers = mPointMassBuffers;
+  Eigen::MatrixXd massJacobian = Eigen::MatrixXd::Zero(numPointMasses, 18);
+  for (int i = 0; i < 3; ++i)
+  {
+    massJacobian.middleCols<3>(3 * i)
+        = buffers.mMasses.asDiagonal()
+          * crossRows(Eigen::Vector3d::Unit(i), buffers.mLocalPositions);
+    massJacobian.col(3 * (i + 3) + i) = buffers.mMasses;
+  }
 
-  mArtInertia(3, 3) += _Pi;
-  mArtInertia(4, 4) += _Pi;
-  mArtInertia(5, 5) += _Pi;
+  mImplicitResponse = mImplicitSolver.solve(massJacobian);
 }
 
 //==============================================================================
-void SoftBodyNode::_addPiToArtInertiaImplicit(
-    const Eigen::Vector3d& _p, double _ImplicitPi) const
+void SoftBodyNode::updatePointMassBuffers(double _timeStep) const
 {
-  Eigen::Matrix3d tmp = math::makeSkewSymmetric(_p);
+  PointMassBuffers& buffers = mPointMassBuffers;
+  const std::size_t numPointMasses = mPointMasses.size();
 
-  mArtInertiaImplicit.topLeftCorner<3, 3>() -= _ImplicitPi * tmp * tmp;
-  mArtInertiaImplicit.topRightCorner<3, 3>() += _ImplicitPi * tmp;
-  mArtInertiaImplicit.bottomLeftCorner<3, 3>() -= _ImplicitPi * tmp;
+  if (buffers.mVersion != getVersion()
+      || static_cast<std::size_t>(buffers.mMasses.size()) != numPointMasses)
+  {
+    buffers.mMasses.resize(numPointMasses);
+    buffers.mNumConnected.resize(numPointMasses);
 
-  mArtInertiaImplicit(3, 3) += _ImplicitPi;
-  mArtInertiaImplicit(4, 4) += _ImplicitPi;
-  mArtInertiaImplicit(5, 5) += _ImplicitPi;
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(numPointMasses * 6u);
+    for (const auto& pointMass : mPointMasses)
+    {
+      const std::size_t index = pointMass->mIndex;
+      const std::size_t numConnected = pointMass->getNumConnectedPointMasses();
+      buffers.mMasses[index] = pointMass->getMass();
+      buffers.mNumConnected[index] = static_cast<double>(numConnected);
+
+      for (std::size_t j = 0u; j < numConnected; ++j)
+      {
+        triplets.emplace_back(
+            static_cast<int>(index),
+            static_cast<int>(pointMass->getConnectedPointMass(j)->mIndex),
+            1.0);
+      }
+    }
+
+    buffers.mAdjacency.resize(numPointMasses, numPointMasses);
+    buffers.mAdjacency.setFromTriplets(triplets.begin(), triplets.end());
+    buffers.mVersion = getVersion();
+  }
+
+  buffers.mLocalPositions.resize(numPointMasses, 3);
+  for (const auto& pointMass : mPointMasses)
+  {
+    buffers.mLocalPositions.row(pointMass->mIndex)
+        = pointMass->getLocalPosition().transpose();
+  }
+  assert(!math::isNan(buffers.mLocalPositions));
+
+  // Cache data: Psi, ImplicitPsi, Pi, and ImplicitPi
+  const Eigen::ArrayXd masses = buffers.mMasses.array();
+  const double implicitTerms
+      = _timeStep * getDampingCoefficient()
+        + _timeStep * _timeStep * getVertexSpringStiffness();
+  buffers.mPsi = masses.inverse().matrix();
+  buffers.mImplicitPsi = (masses + implicitTerms).inverse().matrix();
+  buffers.mPi = (masses - masses.square() * buffers.mPsi.array()).matrix();
+  buffers.mImplicitPi
+      = (masses - masses.square() * buffers.mImplicitPsi.array()).matrix();
+  assert(!math::isNan(buffers.mImplicitPsi));
 }
 
 //==============================================================================
@@ -33,6 +33,8 @@
 #ifndef DART_DYNAMICS_SOFTBODYNODE_HPP_
 #define DART_DYNAMICS_SOFTBODYNODE_HPP_
 
+#include <Eigen/Sparse>
+
 #include "dart/dynamics/detail/SoftBodyNodeAspect.hpp"
 
 namespace dart {
@@ -117,6 +119,22 @@ public:
   /// \brief
   double getDampingCoefficient() const;
 
+  /// Set whether the edge springs between the PointMasses are integrated
+  /// implicitly.
+  ///
+  /// By default only the vertex springs and the damping are treated
+  /// implicitly, which decouples the PointMasses from each other but requires
+  /// small time steps for stiff edge springs. When enabled, the forward
+  /// dynamics solves the backward Euler equations of all the PointMasses of
+  /// this SoftBodyNode at once, using the springs linearized at the end of the
+  /// time step. The resulting sparse system is factorized once and reused for
+  /// as long as the time step, the masses, the stiffnesses, and the
+  /// connectivity stay the same.
+  void setImplicitEdgeSprings(bool _implicit);
+
+  /// Return true if the edge springs are integrated implicitly
+  bool areEdgeSpringsImplicit() const;
+
   /// \brief
   void removeAllPointMasses();
 
@@ -319,13 +337,90 @@ protected:
   ///
   math::Inertia mArtInertiaImplicit2;
 
+  /// Structure-of-arrays copies of the PointMass quantities used by the
+  /// forward dynamics passes. Row i belongs to the i-th PointMass, and each
+  /// column is contiguous so that the passes vectorize across PointMasses.
+  /// PointMass reads its per-vertex values back from these buffers.
+  struct PointMassBuffers
+  {
+    /// Version of this SoftBodyNode when the masses and the connectivity were
+    /// last gathered
+    std::size_t mVersion{0u};
+
+    /// Masses
+    Eigen::VectorXd mMasses;
+
+    /// Number of edge springs attached to each PointMass
+    Eigen::VectorXd mNumConnected;
+
+    /// Sums the rows of the connected PointMasses
+    Eigen::SparseMatrix<double, Eigen::RowMajor> mAdjacency;
+
+    /// Inverse masses
+    Eigen::VectorXd mPsi;
+
+    /// Inverse masses augmented by the implicit vertex springs and damping
+    Eigen::VectorXd mImplicitPsi;
+
+    /// Articulated inertia contributions
+    Eigen::VectorXd mPi;
+
+    /// Implicit articulated inertia contributions
+    Eigen::VectorXd mImplicitPi;
+
+    /// Positions viewed in this SoftBodyNode frame
+    Eigen::MatrixX3d mLocalPositions;
+
+    /// Generalized positions
+    Eigen::MatrixX3d mPositions;
+
+    /// Generalized velocities
+    Eigen::MatrixX3d mVelocities;
+
+    /// Partial accelerations
+    Eigen::MatrixX3d mPartialAccelerations;
+
+    /// Accelerations of the PointMass origins due to the spatial acceleration
+    /// of this SoftBodyNode
+    Eigen::MatrixX3d mParentAccelerations;
+
+    /// Bias forces
+    Eigen::MatrixX3d mBiasForces;
+
+    /// Cache data for the bias forces
+    Eigen::MatrixX3d mAlpha;
+
+    /// Cache data for the bias forces
+    Eigen::MatrixX3d mBeta;
+  };
+
+  /// PointMass data of the forward dynamics passes
+  mutable PointMassBuffers mPointMassBuffers;
+
+  /// Backward Euler system matrix of the PointMasses, used when the edge
+  /// springs are implicit. The same matrix applies to each coordinate.
+  mutable Eigen::SparseMatrix<double> mImplicitSystem;
+
+  /// Factorization of mImplicitSystem
+  mutable Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> mImplicitSolver;
+
+  /// Change of the PointMass accelerations for a unit spatial acceleration of
+  /// this SoftBodyNode. Row i holds the 3x6 response of the i-th PointMass,
+  /// stored column by column.
+  mutable Eigen::MatrixXd mImplicitResponse;
+
+  /// PointMass accelerations for zero spatial acceleration of this
+  /// SoftBodyNode. Row i belongs to the i-th PointMass.
+  Eigen::MatrixXd mImplicitAccelerations;
+
 private:
-  /// \brief
-  void _addPiToArtInertia(const Eigen::Vector3d& _p, double _Pi) const;
+  /// Refactorize the implicit PointMass system if any of its coefficients
+  /// changed, and update mImplicitResponse
+  void updateImplicitSystem(double _timeStep) const;
 
-  /// \brief
-  void _addPiToArtInertiaImplicit(
-      const Eigen::Vector3d& _p, double _ImplicitPi) const;
+  /// Gather the masses, the connectivity, and the local positions of the
+  /// PointMasses into mPointMassBuffers, and update their inertia terms
+  void updatePointMassBuffers(double _timeStep) const;
 
   ///
   void updateInertiaWithPointMass();
@@ -68,6 +68,12 @@ const std::string& SoftMeshShape::getStaticType()
   return type;
 }
 
+//==============================================================================
+Shape::TypeId SoftMeshShape::getTypeId() const
+{
+  return getStaticTypeId();
+}
+
 const aiMesh* SoftMeshShape::getAssimpMesh() const
 {
   return mAssimpMesh.get();
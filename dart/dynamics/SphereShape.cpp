@@ -62,6 +62,12 @@ const std::string& SphereShape::getStaticType()
   return type;
 }
 
+//==============================================================================
+Shape::TypeId SphereShape::getTypeId() const
+{
+  return getStaticTypeId();
+}
+
 //==============================================================================
 void SphereShape::setRadius(double radius)
 {
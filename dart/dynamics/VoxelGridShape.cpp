@@ -111,6 +111,12 @@ const std::string& VoxelGridShape::getStaticType()
   return type;
 }
 
+//==============================================================================
+Shape::TypeId VoxelGridShape::getTypeId() const
+{
+  return getStaticTypeId();
+}
+
 //==============================================================================
 void VoxelGridShape::setOctree(fcl_shared_ptr<octomap::OcTree> octree)
 {
@@ -66,6 +66,15 @@ public:
   /// Returns shape type for this class
   static const std::string& getStaticType();
 
+  // Documentation inherited.
+  TypeId getTypeId() const override;
+
+  /// Returns shape type ID for this class
+  static constexpr TypeId getStaticTypeId()
+  {
+    return TypeId::VOXEL_GRID;
+  }
+
   /// Sets octree.
   void setOctree(fcl_shared_ptr<octomap::OcTree> octree);
 
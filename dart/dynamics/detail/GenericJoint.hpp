@@ -1642,6 +1642,53 @@ void GenericJoint<ConfigSpaceT>::registerDofs()
   }
 }
 
+//==============================================================================
+template <class ConfigSpaceT>
+bool GenericJoint<ConfigSpaceT>::copyPositionsFrom(
+    const Eigen::VectorXd& values, std::size_t offset)
+{
+  const auto positions = values.template segment<NumDofs>(offset);
+  if (this->mAspectState.mPositions == positions)
+    return false;
+
+  this->mAspectState.mPositions = positions;
+  return true;
+}
+
+//==============================================================================
+template <class ConfigSpaceT>
+bool GenericJoint<ConfigSpaceT>::copyVelocitiesFrom(
+    const Eigen::VectorXd& values, std::size_t offset)
+{
+  const auto velocities = values.template segment<NumDofs>(offset);
+  if (this->mAspectState.mVelocities == velocities)
+    return false;
+
+  this->mAspectState.mVelocities = velocities;
+
+  if (Joint::mAspectProperties.mActuatorType == Joint::VELOCITY)
+    this->mAspectState.mCommands = this->getVelocitiesStatic();
+
+  return true;
+}
+
+//==============================================================================
+template <class ConfigSpaceT>
+bool GenericJoint<ConfigSpaceT>::copyAccelerationsFrom(
+    const Eigen::VectorXd& values, std::size_t offset)
+{
+  const auto accelerations = values.template segment<NumDofs>(offset);
+  if (this->mAspectState.mAccelerations == accelerations)
+    return false;
+
+  this->mAspectState.mAccelerations = accelerations;
+
+  if (Joint::mAspectProperties.mActuatorType == Joint::ACCELERATION)
+    this->mAspectState.mCommands = this->getAccelerationsStatic();
+
+  return true;
+}
+
 //==============================================================================
 template <class ConfigSpaceT>
 Eigen::Vector6d GenericJoint<ConfigSpaceT>::getBodyConstraintWrench() const
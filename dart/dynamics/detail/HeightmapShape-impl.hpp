@@ -43,7 +43,8 @@ namespace dynamics {
 
 //==============================================================================
 template <typename S>
-HeightmapShape<S>::HeightmapShape() : Shape(HEIGHTMAP), mScale(1, 1, 1)
+HeightmapShape<S>::HeightmapShape()
+  : Shape(HEIGHTMAP), mScale(1, 1, 1), mIsPyramidDirty(false)
 {
   static_assert(
       std::is_same<S, float>::value || std::is_same<S, double>::value,
@@ -66,6 +67,13 @@ const std::string& HeightmapShape<S>::getStaticType()
   return type;
 }
 
+//==============================================================================
+template <typename S>
+Shape::TypeId HeightmapShape<S>::getTypeId() const
+{
+  return getStaticTypeId();
+}
+
 //==============================================================================
 template <typename S>
 void HeightmapShape<S>::setScale(const Vector3& scale)
@@ -118,9 +126,7 @@ template <typename S>
 void HeightmapShape<S>::setHeightField(const HeightField& heights)
 {
   mHeights = heights;
-
-  mMinHeight = heights.minCoeff();
-  mMaxHeight = heights.maxCoeff();
+  updatePyramid();
 
   mIsBoundingBoxDirty = true;
   mIsVolumeDirty = true;
@@ -139,6 +145,14 @@ auto HeightmapShape<S>::getHeightField() const -> const HeightField&
 template <typename S>
 auto HeightmapShape<S>::getHeightFieldModifiable() const -> HeightField&
 {
+  // The caller may change any height, so everything derived from them is
+  // computed again on the next query, and the collision engines that keep a
+  // copy of the heights recreate it
+  mIsPyramidDirty = true;
+  mIsBoundingBoxDirty = true;
+  mIsVolumeDirty = true;
+  const_cast<HeightmapShape*>(this)->incrementVersion();
+
   return mHeights;
 }
 
@@ -147,12 +161,16 @@ template <typename S>
 void HeightmapShape<S>::flipY() const
 {
   mHeights = mHeights.colwise().reverse().eval();
+  updatePyramid();
 }
 
 //==============================================================================
 template <typename S>
 auto HeightmapShape<S>::getMaxHeight() const -> S
 {
+  if (mIsPyramidDirty)
+    updatePyramid();
+
   return mMaxHeight;
 }
 
@@ -160,6 +178,9 @@ auto HeightmapShape<S>::getMaxHeight() const -> S
 template <typename S>
 auto HeightmapShape<S>::getMinHeight() const -> S
 {
+  if (mIsPyramidDirty)
+    updatePyramid();
+
   return mMinHeight;
 }
 
@@ -177,6 +198,40 @@ std::size_t HeightmapShape<S>::getDepth() const
   return mHeights.rows();
 }
 
+//==============================================================================
+template <typename S>
+std::size_t HeightmapShape<S>::getNumPyramidLevels() const
+{
+  if (mIsPyramidDirty)
+    updatePyramid();
+
+  return mPyramidMinHeights.size();
+}
+
+//==============================================================================
+template <typename S>
+auto HeightmapShape<S>::getPyramidMinHeights(std::size_t level) const
+    -> const HeightField&
+{
+  if (mIsPyramidDirty)
+    updatePyramid();
+
+  assert(level < mPyramidMinHeights.size());
+  return mPyramidMinHeights[level];
+}
+
+//==============================================================================
+template <typename S>
+auto HeightmapShape<S>::getPyramidMaxHeights(std::size_t level) const
+    -> const HeightField&
+{
+  if (mIsPyramidDirty)
+    updatePyramid();
+
+  assert(level < mPyramidMaxHeights.size());
+  return mPyramidMaxHeights[level];
+}
+
 //==============================================================================
 template <typename S>
 void HeightmapShape<S>::notifyColorUpdated(const Eigen::Vector4d& /*color*/)
@@ -202,11 +257,87 @@ void HeightmapShape<S>::computeBoundingBox(
 {
   const double dimX = getWidth() * mScale.x();
   const double dimY = getDepth() * mScale.y();
-  const double dimZ = (mMaxHeight - mMinHeight) * mScale.z();
-  min = Eigen::Vector3d(-dimX * 0.5, -dimY * 0.5, mMinHeight * mScale.z());
+  const double dimZ = (getMaxHeight() - getMinHeight()) * mScale.z();
+  min = Eigen::Vector3d(-dimX * 0.5, -dimY * 0.5, getMinHeight() * mScale.z());
   max = min + Eigen::Vector3d(dimX, dimY, dimZ);
 }
 
+//==============================================================================
+template <typename S>
+void HeightmapShape<S>::updatePyramid() const
+{
+  mIsPyramidDirty = false;
+  mPyramidMinHeights.clear();
+  mPyramidMaxHeights.clear();
+
+  if (mHeights.size() > 0)
+  {
+    mMinHeight = mHeights.minCoeff();
+    mMaxHeight = mHeights.maxCoeff();
+  }
+
+  const Eigen::Index numRows = mHeights.rows() - 1;
+  const Eigen::Index numCols = mHeights.cols() - 1;
+  if (numRows < 1 || numCols < 1)
+    return;
+
+  // Finest level: tiles of getPyramidTileSize() x getPyramidTileSize() cells,
+  // with the vertices on their borders
+  const auto tileSize = static_cast<Eigen::Index>(getPyramidTileSize());
+  Eigen::Index rows = (numRows + tileSize - 1) / tileSize;
+  Eigen::Index cols = (numCols + tileSize - 1) / tileSize;
+
+  HeightField minHeights(rows, cols);
+  HeightField maxHeights(rows, cols);
+  for (Eigen::Index r = 0; r < rows; ++r)
+  {
+    const Eigen::Index r0 = r * tileSize;
+    const Eigen::Index numBlockRows = std::min(tileSize, numRows - r0) + 1;
+    for (Eigen::Index c = 0; c < cols; ++c)
+    {
+      const Eigen::Index c0 = c * tileSize;
+      const Eigen::Index numBlockCols = std::min(tileSize, numCols - c0) + 1;
+      const auto block = mHeights.block(r0, c0, numBlockRows, numBlockCols);
+      minHeights(r, c) = block.minCoeff();
+      maxHeights(r, c) = block.maxCoeff();
+    }
+  }
+  mPyramidMinHeights.push_back(std::move(minHeights));
+  mPyramidMaxHeights.push_back(std::move(maxHeights));
+
+  // Coarser levels merge 2 x 2 tiles of the previous one
+  while (rows > 1 || cols > 1)
+  {
+    const HeightField& fineMin = mPyramidMinHeights.back();
+    const HeightField& fineMax = mPyramidMaxHeights.back();
+    const Eigen::Index fineRows = rows;
+    const Eigen::Index fineCols = cols;
+    rows = (rows + 1) / 2;
+    cols = (cols + 1) / 2;
+
+    HeightField coarseMin(rows, cols);
+    HeightField coarseMax(rows, cols);
+    for (Eigen::Index r = 0; r < rows; ++r)
+    {
+      const Eigen::Index numBlockRows
+          = std::min<Eigen::Index>(2, fineRows - 2 * r);
+      for (Eigen::Index c = 0; c < cols; ++c)
+      {
+        const Eigen::Index numBlockCols
+            = std::min<Eigen::Index>(2, fineCols - 2 * c);
+        coarseMin(r, c)
+            = fineMin.block(2 * r, 2 * c, numBlockRows, numBlockCols)
+                  .minCoeff();
+        coarseMax(r, c)
+            = fineMax.block(2 * r, 2 * c, numBlockRows, numBlockCols)
+                  .maxCoeff();
+      }
+    }
+    mPyramidMinHeights.push_back(std::move(coarseMin));
+    mPyramidMaxHeights.push_back(std::move(coarseMax));
+  }
+}
+
 //==============================================================================
 template <typename S>
 void HeightmapShape<S>::updateBoundingBox() const
@@ -79,8 +79,14 @@ struct CollisionAspectProperties
   /// This object is collidable if true
   bool mCollidable;
 
+  /// If true, the constraint solver also looks for the contacts this object is
+  /// about to make within the next time step, so that it cannot pass through
+  /// thin objects when it moves fast.
+  bool mContinuous;
+
   /// Constructor
-  CollisionAspectProperties(const bool collidable = true);
+  CollisionAspectProperties(
+      const bool collidable = true, const bool continuous = false);
 
   /// Destructor
   virtual ~CollisionAspectProperties() = default;
@@ -75,6 +75,11 @@ struct SoftBodyNodeUniqueProperties
   /// Damping coefficient
   double mDampCoeff;
 
+  /// Whether the edge springs are integrated implicitly together with the
+  /// vertex springs and the damping. See
+  /// SoftBodyNode::setImplicitEdgeSprings().
+  bool mImplicitEdgeSprings;
+
   /// Array of Properties for PointMasses
   std::vector<PointMass::Properties> mPointProps;
 
@@ -89,7 +94,8 @@ struct SoftBodyNodeUniqueProperties
       const std::vector<PointMass::Properties>& _points
       = std::vector<PointMass::Properties>(),
       const std::vector<Eigen::Vector3i>& _faces
-      = std::vector<Eigen::Vector3i>());
+      = std::vector<Eigen::Vector3i>(),
+      bool _implicitEdgeSprings = false);
 
   virtual ~SoftBodyNodeUniqueProperties() = default;
 
@@ -45,6 +45,12 @@ EulerIntegrator::~EulerIntegrator()
 {
 }
 
+//==============================================================================
+std::shared_ptr<Integrator> EulerIntegrator::clone() const
+{
+  return std::make_shared<EulerIntegrator>(*this);
+}
+
 //==============================================================================
 void EulerIntegrator::integrate(IntegrableSystem* _system, double _dt)
 {
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "dart/integration/ImplicitMidpointIntegrator.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+#include "dart/common/Console.hpp"
+
+namespace dart {
+namespace integration {
+
+//==============================================================================
+ImplicitMidpointIntegrator::ImplicitMidpointIntegrator(
+    std::size_t _maxIterations, double _tolerance)
+  : Integrator(),
+    mMaxIterations(_maxIterations),
+    mTolerance(_tolerance),
+    mLastNumIterations(0u),
+    mConverged(true)
+{
+  assert(_maxIterations > 0u);
+}
+
+//==============================================================================
+ImplicitMidpointIntegrator::~ImplicitMidpointIntegrator()
+{
+}
+
+//==============================================================================
+std::shared_ptr<Integrator> ImplicitMidpointIntegrator::clone() const
+{
+  return std::make_shared<ImplicitMidpointIntegrator>(*this);
+}
+
+//==============================================================================
+void ImplicitMidpointIntegrator::setMaxIterations(std::size_t _maxIterations)
+{
+  assert(_maxIterations > 0u);
+  mMaxIterations = _maxIterations;
+}
+
+//==============================================================================
+std::size_t ImplicitMidpointIntegrator::getMaxIterations() const
+{
+  return mMaxIterations;
+}
+
+//==============================================================================
+void ImplicitMidpointIntegrator::setTolerance(double _tolerance)
+{
+  mTolerance = _tolerance;
+}
+
+//==============================================================================
+double ImplicitMidpointIntegrator::getTolerance() const
+{
+  return mTolerance;
+}
+
+//==============================================================================
+std::size_t ImplicitMidpointIntegrator::getLastNumIterations() const
+{
+  return mLastNumIterations;
+}
+
+//==============================================================================
+bool ImplicitMidpointIntegrator::hasConverged() const
+{
+  return mConverged;
+}
+
+//==============================================================================
+void ImplicitMidpointIntegrator::integrate(
+    IntegrableSystem* _system, double _dt)
+{
+  integrateVel(_system, _dt);
+  integratePos(_system, _dt);
+}
+
+//==============================================================================
+void ImplicitMidpointIntegrator::integratePos(
+    IntegrableSystem* _system, double _dt)
+{
+  // q1 = q0 + (dq_mid + dq - dqFree) * dt
+  //   where dq - dqFree is the change of the velocities since integrateVel()
+  _system->integrateConfigs(
+      mMidGenVels + _system->getGenVels() - mFreeGenVels, _dt);
+}
+
+//==============================================================================
+void ImplicitMidpointIntegrator::integrateVel(
+    IntegrableSystem* _system, double _dt)
+{
+  mConfigs = _system->getConfigs();
+  mGenVels = _system->getGenVels();
+
+  // Initial guess from an explicit Euler step
+  mFreeGenVels = mGenVels + _dt * _system->evalGenAccs();
+
+  mConverged = false;
+  double error = 0.0;
+  for (mLastNumIterations = 1u; mLastNumIterations <= mMaxIterations;
+       ++mLastNumIterations)
+  {
+    // Evaluate the accelerations at the midpoint
+    mMidGenVels = 0.5 * (mGenVels + mFreeGenVels);
+    _system->setConfigs(mConfigs);
+    _system->integrateConfigs(mMidGenVels, 0.5 * _dt);
+    _system->setGenVels(mMidGenVels);
+
+    const Eigen::VectorXd genVels = mGenVels + _dt * _system->evalGenAccs();
+    error = (genVels - mFreeGenVels).norm();
+    mFreeGenVels = genVels;
+
+    if (error <= mTolerance * (1.0 + mFreeGenVels.norm()))
+    {
+      mConverged = true;
+      break;
+    }
+  }
+  mLastNumIterations = std::min(mLastNumIterations, mMaxIterations);
+
+  if (!mConverged)
+  {
+    dtwarn << "[ImplicitMidpointIntegrator::integrateVel] The fixed-point "
+           << "iteration did not converge in " << mMaxIterations
+           << " iterations (last change of the velocities: " << error
+           << "). The time step is likely too large for this system.\n";
+  }
+  mMidGenVels = 0.5 * (mGenVels + mFreeGenVels);
+
+  _system->setConfigs(mConfigs);
+  _system->setGenVels(mFreeGenVels);
+}
+
+} // namespace integration
+} // namespace dart
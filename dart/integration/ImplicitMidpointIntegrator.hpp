@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef DART_INTEGRATION_IMPLICITMIDPOINTINTEGRATOR_HPP_
+#define DART_INTEGRATION_IMPLICITMIDPOINTINTEGRATOR_HPP_
+
+#include "dart/integration/Integrator.hpp"
+
+namespace dart {
+namespace integration {
+
+/// ImplicitMidpointIntegrator advances the system with the implicit midpoint
+/// rule
+///
+///   dq_mid = (dq0 + dq1) / 2
+///   dq1 = dq0 + dt * ddq(q0 + dt / 2 * dq_mid, dq_mid)
+///   q1 = q0 + dt * dq_mid
+///
+/// The rule is symplectic. For mechanical systems it is the variational
+/// integrator of the midpoint discrete Lagrangian, so the energy of a
+/// conservative system stays bounded instead of drifting, even with time
+/// steps several times larger than the ones semi-implicit Euler needs.
+///
+/// The implicit equation is solved by fixed-point iteration, which evaluates
+/// the accelerations once per iteration and converges when the time step is
+/// small compared to the time scales of the system. When the iteration does
+/// not reach the tolerance within the maximum number of iterations, the last
+/// iterate is used, a warning is printed, and hasConverged() returns false
+/// until the next step.
+class ImplicitMidpointIntegrator : public Integrator
+{
+public:
+  /// Constructor
+  explicit ImplicitMidpointIntegrator(
+      std::size_t _maxIterations = 10u, double _tolerance = 1e-10);
+
+  /// Destructor
+  virtual ~ImplicitMidpointIntegrator();
+
+  // Documentation inherited
+  std::shared_ptr<Integrator> clone() const override;
+
+  /// Set the maximum number of fixed-point iterations per step
+  void setMaxIterations(std::size_t _maxIterations);
+
+  /// Get the maximum number of fixed-point iterations per step
+  std::size_t getMaxIterations() const;
+
+  /// Set the tolerance of the fixed-point iteration, relative to the norm of
+  /// the generalized velocities
+  void setTolerance(double _tolerance);
+
+  /// Get the tolerance of the fixed-point iteration
+  double getTolerance() const;
+
+  /// Get the number of fixed-point iterations used by the last step
+  std::size_t getLastNumIterations() const;
+
+  /// Return true if the fixed-point iteration of the last step reached the
+  /// tolerance
+  bool hasConverged() const;
+
+  // Documentation inherited
+  void integrate(IntegrableSystem* _system, double _dt) override;
+
+  // Documentation inherited
+  void integratePos(IntegrableSystem* _system, double _dt) override;
+
+  // Documentation inherited
+  void integrateVel(IntegrableSystem* _system, double _dt) override;
+
+private:
+  /// Maximum number of fixed-point iterations per step
+  std::size_t mMaxIterations;
+
+  /// Tolerance of the fixed-point iteration
+  double mTolerance;
+
+  /// Number of fixed-point iterations used by the last step
+  std::size_t mLastNumIterations;
+
+  /// Whether the fixed-point iteration of the last step converged
+  bool mConverged;
+
+  /// Initial configurations
+  Eigen::VectorXd mConfigs;
+
+  /// Initial generalized velocities
+  Eigen::VectorXd mGenVels;
+
+  /// Generalized velocities computed by integrateVel()
+  Eigen::VectorXd mFreeGenVels;
+
+  /// Midpoint generalized velocities
+  Eigen::VectorXd mMidGenVels;
+};
+
+} // namespace integration
+} // namespace dart
+
+#endif // DART_INTEGRATION_IMPLICITMIDPOINTINTEGRATOR_HPP_
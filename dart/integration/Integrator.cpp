@@ -55,5 +55,11 @@ Integrator::~Integrator()
 {
 }
 
+//==============================================================================
+std::shared_ptr<Integrator> Integrator::clone() const
+{
+  return nullptr;
+}
+
 } // namespace integration
 } // namespace dart
@@ -33,6 +33,7 @@
 #ifndef DART_INTEGRATION_INTEGRATOR_HPP_
 #define DART_INTEGRATION_INTEGRATOR_HPP_
 
+#include <memory>
 #include <vector>
 
 #include <Eigen/Dense>
@@ -87,14 +88,27 @@ public:
   /// \brief Destructor
   virtual ~Integrator();
 
+  /// \brief Create a copy of this Integrator, including the state it keeps
+  /// between calls. World::clone() uses it so that the original World and its
+  /// clone never share an Integrator. Returns nullptr by default; Integrators
+  /// that can be copied should override it.
+  virtual std::shared_ptr<Integrator> clone() const;
+
 public:
   /// \brief Integrate the system with time step dt
   virtual void integrate(IntegrableSystem* _system, double _dt) = 0;
 
-  /// \brief Integrate velocity of the system with time step dt
+  /// \brief Integrate position of the system with time step dt
+  ///
+  /// Calling integrateVel() and then integratePos() performs one step of
+  /// integrate(). The velocities of the system may be changed in between,
+  /// e.g., by constraint impulses, and integratePos() takes that change into
+  /// account.
   virtual void integratePos(IntegrableSystem* _system, double _dt) = 0;
 
   /// \brief Integrate velocity of the system with time step dt
+  ///
+  /// The configurations of the system are left unchanged. See integratePos().
   virtual void integrateVel(IntegrableSystem* _system, double _dt) = 0;
 };
 
@@ -45,6 +45,12 @@ RK4Integrator::~RK4Integrator()
 {
 }
 
+//==============================================================================
+std::shared_ptr<Integrator> RK4Integrator::clone() const
+{
+  return std::make_shared<RK4Integrator>(*this);
+}
+
 //==============================================================================
 void RK4Integrator::integrate(IntegrableSystem* _system, double _dt)
 {
@@ -80,6 +86,7 @@ void RK4Integrator::integrate(IntegrableSystem* _system, double _dt)
 
   //----------------------------------------------------------------------------
   // q4 = q1 + dq3 * _dt
+  _system->setConfigs(q1);
   _system->integrateConfigs(dq3, _dt);
 
   // dq4 = dq1 + ddq3 * _dt
@@ -104,5 +111,26 @@ void RK4Integrator::integrate(IntegrableSystem* _system, double _dt)
       1.0 / 6.0 * (ddq1 + (2.0 * ddq2) + (2.0 * ddq3) + ddq4), _dt);
 }
 
+//==============================================================================
+void RK4Integrator::integratePos(IntegrableSystem* _system, double _dt)
+{
+  // q = q1 + (dq5 + dq - dqFree) * _dt
+  //   where dq - dqFree is the change of the velocities since integrateVel()
+  _system->integrateConfigs(
+      1.0 / 6.0 * (dq1 + (2.0 * dq2) + (2.0 * dq3) + dq4)
+          + _system->getGenVels() - dqFree,
+      _dt);
+}
+
+//==============================================================================
+void RK4Integrator::integrateVel(IntegrableSystem* _system, double _dt)
+{
+  // Take a full step, and then restore the initial configurations. The
+  // velocities dq1, ..., dq4 are kept for integratePos().
+  integrate(_system, _dt);
+  _system->setConfigs(q1);
+  dqFree = _system->getGenVels();
+}
+
 } // namespace integration
 } // namespace dart
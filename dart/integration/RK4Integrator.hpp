@@ -48,9 +48,18 @@ public:
   /// \brief Destructor
   virtual ~RK4Integrator();
 
+  // Documentation inherited
+  std::shared_ptr<Integrator> clone() const override;
+
   // Documentation inherited
   void integrate(IntegrableSystem* _system, double _dt) override;
 
+  // Documentation inherited
+  void integratePos(IntegrableSystem* _system, double _dt) override;
+
+  // Documentation inherited
+  void integrateVel(IntegrableSystem* _system, double _dt) override;
+
 private:
   /// \brief Initial configurations
   Eigen::VectorXd q1;
@@ -60,6 +69,9 @@ private:
 
   /// \brief Chache data for generalized accelerations
   Eigen::VectorXd ddq1, ddq2, ddq3, ddq4;
+
+  /// \brief Generalized velocities computed by integrateVel()
+  Eigen::VectorXd dqFree;
 };
 
 } // namespace integration
@@ -45,6 +45,12 @@ SemiImplicitEulerIntegrator::~SemiImplicitEulerIntegrator()
 {
 }
 
+//==============================================================================
+std::shared_ptr<Integrator> SemiImplicitEulerIntegrator::clone() const
+{
+  return std::make_shared<SemiImplicitEulerIntegrator>(*this);
+}
+
 //==============================================================================
 void SemiImplicitEulerIntegrator::integrate(
     IntegrableSystem* _system, double _dt)
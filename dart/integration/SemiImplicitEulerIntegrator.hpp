@@ -48,6 +48,9 @@ public:
   /// \brief Destructor
   virtual ~SemiImplicitEulerIntegrator();
 
+  // Documentation inherited
+  std::shared_ptr<Integrator> clone() const override;
+
   // Documentation inherited
   void integrate(IntegrableSystem* _system, double _dt) override;
 
@@ -681,41 +681,18 @@ Eigen::Vector6d logMap(const Eigen::Isometry3d& _T)
 // res = T * s * Inv(T)
 Eigen::Vector6d AdT(const Eigen::Isometry3d& _T, const Eigen::Vector6d& _V)
 {
-  //--------------------------------------------------------------------------
-  // w' = R*w
-  // v' = p x R*w + R*v
-  //--------------------------------------------------------------------------
-  Eigen::Vector6d res;
-  res.head<3>().noalias() = _T.linear() * _V.head<3>();
-  res.tail<3>().noalias()
-      = _T.linear() * _V.tail<3>() + _T.translation().cross(res.head<3>());
-  return res;
+  return AdT<double>(_T, _V);
 }
 
 //==============================================================================
 Eigen::Matrix6d getAdTMatrix(const Eigen::Isometry3d& T)
 {
-  Eigen::Matrix6d AdT;
-
-  AdT.topLeftCorner<3, 3>() = T.linear();
-  AdT.topRightCorner<3, 3>().setZero();
-  AdT.bottomLeftCorner<3, 3>()
-      = makeSkewSymmetric(T.translation()) * T.linear();
-  AdT.bottomRightCorner<3, 3>() = T.linear();
-
-  return AdT;
+  return getAdTMatrix<double>(T);
 }
 
 Eigen::Vector6d AdR(const Eigen::Isometry3d& _T, const Eigen::Vector6d& _V)
 {
-  //--------------------------------------------------------------------------
-  // w' = R*w
-  // v' = R*v
-  //--------------------------------------------------------------------------
-  Eigen::Vector6d res;
-  res.head<3>().noalias() = _T.linear() * _V.head<3>();
-  res.tail<3>().noalias() = _T.linear() * _V.tail<3>();
-  return res;
+  return AdR<double>(_T, _V);
 }
 
 Eigen::Vector6d AdTAngular(
@@ -775,12 +752,7 @@ Eigen::Vector6d AdTLinear(
 // re = Inv(T)*s*T
 Eigen::Vector6d AdInvT(const Eigen::Isometry3d& _T, const Eigen::Vector6d& _V)
 {
-  Eigen::Vector6d res;
-  res.head<3>().noalias() = _T.linear().transpose() * _V.head<3>();
-  res.tail<3>().noalias()
-      = _T.linear().transpose()
-        * (_V.tail<3>() + _V.head<3>().cross(_T.translation()));
-  return res;
+  return AdInvT<double>(_T, _V);
 }
 
 // se3 AdInvR(const SE3& T, const se3& s)
@@ -800,35 +772,17 @@ Eigen::Vector6d AdInvT(const Eigen::Isometry3d& _T, const Eigen::Vector6d& _V)
 Eigen::Vector6d AdInvRLinear(
     const Eigen::Isometry3d& _T, const Eigen::Vector3d& _v)
 {
-  Eigen::Vector6d res = Eigen::Vector6d::Zero();
-  res.tail<3>().noalias() = _T.linear().transpose() * _v;
-  return res;
+  return AdInvRLinear<double>(_T, _v);
 }
 
 Eigen::Vector6d ad(const Eigen::Vector6d& _X, const Eigen::Vector6d& _Y)
 {
-  //--------------------------------------------------------------------------
-  // ad(s1, s2) = | [w1]    0 | | w2 |
-  //              | [v1] [w1] | | v2 |
-  //
-  //            = |          [w1]w2 |
-  //              | [v1]w2 + [w1]v2 |
-  //--------------------------------------------------------------------------
-  Eigen::Vector6d res;
-  res.head<3>() = _X.head<3>().cross(_Y.head<3>());
-  res.tail<3>()
-      = _X.head<3>().cross(_Y.tail<3>()) + _X.tail<3>().cross(_Y.head<3>());
-  return res;
+  return ad<double>(_X, _Y);
 }
 
 Eigen::Vector6d dAdT(const Eigen::Isometry3d& _T, const Eigen::Vector6d& _F)
 {
-  Eigen::Vector6d res;
-  res.head<3>().noalias()
-      = _T.linear().transpose()
-        * (_F.head<3>() + _F.tail<3>().cross(_T.translation()));
-  res.tail<3>().noalias() = _T.linear().transpose() * _F.tail<3>();
-  return res;
+  return dAdT<double>(_T, _F);
 }
 
 // dse3 dAdTLinear(const SE3& T, const Vec3& v)
@@ -849,11 +803,7 @@ Eigen::Vector6d dAdT(const Eigen::Isometry3d& _T, const Eigen::Vector6d& _F)
 
 Eigen::Vector6d dAdInvT(const Eigen::Isometry3d& _T, const Eigen::Vector6d& _F)
 {
-  Eigen::Vector6d res;
-  res.tail<3>().noalias() = _T.linear() * _F.tail<3>();
-  res.head<3>().noalias() = _T.linear() * _F.head<3>();
-  res.head<3>() += _T.translation().cross(res.tail<3>());
-  return res;
+  return dAdInvT<double>(_T, _F);
 }
 
 Eigen::Vector6d dAdInvR(const Eigen::Isometry3d& _T, const Eigen::Vector6d& _F)
@@ -1404,95 +1354,12 @@ Eigen::Isometry3d expAngular(const Eigen::Vector3d& _s)
 
 Eigen::Vector6d dad(const Eigen::Vector6d& _s, const Eigen::Vector6d& _t)
 {
-  Eigen::Vector6d res;
-  res.head<3>()
-      = _t.head<3>().cross(_s.head<3>()) + _t.tail<3>().cross(_s.tail<3>());
-  res.tail<3>() = _t.tail<3>().cross(_s.head<3>());
-  return res;
+  return dad<double>(_s, _t);
 }
 
 Inertia transformInertia(const Eigen::Isometry3d& _T, const Inertia& _I)
 {
-  // operation count: multiplication = 186, addition = 117, subtract = 21
-
-  Inertia ret = Inertia::Identity();
-
-  double d0 = _I(0, 3) + _T(2, 3) * _I(3, 4) - _T(1, 3) * _I(3, 5);
-  double d1 = _I(1, 3) - _T(2, 3) * _I(3, 3) + _T(0, 3) * _I(3, 5);
-  double d2 = _I(2, 3) + _T(1, 3) * _I(3, 3) - _T(0, 3) * _I(3, 4);
-  double d3 = _I(0, 4) + _T(2, 3) * _I(4, 4) - _T(1, 3) * _I(4, 5);
-  double d4 = _I(1, 4) - _T(2, 3) * _I(3, 4) + _T(0, 3) * _I(4, 5);
-  double d5 = _I(2, 4) + _T(1, 3) * _I(3, 4) - _T(0, 3) * _I(4, 4);
-  double d6 = _I(0, 5) + _T(2, 3) * _I(4, 5) - _T(1, 3) * _I(5, 5);
-  double d7 = _I(1, 5) - _T(2, 3) * _I(3, 5) + _T(0, 3) * _I(5, 5);
-  double d8 = _I(2, 5) + _T(1, 3) * _I(3, 5) - _T(0, 3) * _I(4, 5);
-  double e0 = _I(0, 0) + _T(2, 3) * _I(0, 4) - _T(1, 3) * _I(0, 5)
-              + d3 * _T(2, 3) - d6 * _T(1, 3);
-  double e3 = _I(0, 1) + _T(2, 3) * _I(1, 4) - _T(1, 3) * _I(1, 5)
-              - d0 * _T(2, 3) + d6 * _T(0, 3);
-  double e4 = _I(1, 1) - _T(2, 3) * _I(1, 3) + _T(0, 3) * _I(1, 5)
-              - d1 * _T(2, 3) + d7 * _T(0, 3);
-  double e6 = _I(0, 2) + _T(2, 3) * _I(2, 4) - _T(1, 3) * _I(2, 5)
-              + d0 * _T(1, 3) - d3 * _T(0, 3);
-  double e7 = _I(1, 2) - _T(2, 3) * _I(2, 3) + _T(0, 3) * _I(2, 5)
-              + d1 * _T(1, 3) - d4 * _T(0, 3);
-  double e8 = _I(2, 2) + _T(1, 3) * _I(2, 3) - _T(0, 3) * _I(2, 4)
-              + d2 * _T(1, 3) - d5 * _T(0, 3);
-  double f0 = _T(0, 0) * e0 + _T(1, 0) * e3 + _T(2, 0) * e6;
-  double f1 = _T(0, 0) * e3 + _T(1, 0) * e4 + _T(2, 0) * e7;
-  double f2 = _T(0, 0) * e6 + _T(1, 0) * e7 + _T(2, 0) * e8;
-  double f3 = _T(0, 0) * d0 + _T(1, 0) * d1 + _T(2, 0) * d2;
-  double f4 = _T(0, 0) * d3 + _T(1, 0) * d4 + _T(2, 0) * d5;
-  double f5 = _T(0, 0) * d6 + _T(1, 0) * d7 + _T(2, 0) * d8;
-  double f6 = _T(0, 1) * e0 + _T(1, 1) * e3 + _T(2, 1) * e6;
-  double f7 = _T(0, 1) * e3 + _T(1, 1) * e4 + _T(2, 1) * e7;
-  double f8 = _T(0, 1) * e6 + _T(1, 1) * e7 + _T(2, 1) * e8;
-  double g0 = _T(0, 1) * d0 + _T(1, 1) * d1 + _T(2, 1) * d2;
-  double g1 = _T(0, 1) * d3 + _T(1, 1) * d4 + _T(2, 1) * d5;
-  double g2 = _T(0, 1) * d6 + _T(1, 1) * d7 + _T(2, 1) * d8;
-  double g3 = _T(0, 2) * d0 + _T(1, 2) * d1 + _T(2, 2) * d2;
-  double g4 = _T(0, 2) * d3 + _T(1, 2) * d4 + _T(2, 2) * d5;
-  double g5 = _T(0, 2) * d6 + _T(1, 2) * d7 + _T(2, 2) * d8;
-  double h0 = _T(0, 0) * _I(3, 3) + _T(1, 0) * _I(3, 4) + _T(2, 0) * _I(3, 5);
-  double h1 = _T(0, 0) * _I(3, 4) + _T(1, 0) * _I(4, 4) + _T(2, 0) * _I(4, 5);
-  double h2 = _T(0, 0) * _I(3, 5) + _T(1, 0) * _I(4, 5) + _T(2, 0) * _I(5, 5);
-  double h3 = _T(0, 1) * _I(3, 3) + _T(1, 1) * _I(3, 4) + _T(2, 1) * _I(3, 5);
-  double h4 = _T(0, 1) * _I(3, 4) + _T(1, 1) * _I(4, 4) + _T(2, 1) * _I(4, 5);
-  double h5 = _T(0, 1) * _I(3, 5) + _T(1, 1) * _I(4, 5) + _T(2, 1) * _I(5, 5);
-
-  ret(0, 0) = f0 * _T(0, 0) + f1 * _T(1, 0) + f2 * _T(2, 0);
-  ret(0, 1) = f0 * _T(0, 1) + f1 * _T(1, 1) + f2 * _T(2, 1);
-  ret(0, 2) = f0 * _T(0, 2) + f1 * _T(1, 2) + f2 * _T(2, 2);
-  ret(0, 3) = f3 * _T(0, 0) + f4 * _T(1, 0) + f5 * _T(2, 0);
-  ret(0, 4) = f3 * _T(0, 1) + f4 * _T(1, 1) + f5 * _T(2, 1);
-  ret(0, 5) = f3 * _T(0, 2) + f4 * _T(1, 2) + f5 * _T(2, 2);
-  ret(1, 1) = f6 * _T(0, 1) + f7 * _T(1, 1) + f8 * _T(2, 1);
-  ret(1, 2) = f6 * _T(0, 2) + f7 * _T(1, 2) + f8 * _T(2, 2);
-  ret(1, 3) = g0 * _T(0, 0) + g1 * _T(1, 0) + g2 * _T(2, 0);
-  ret(1, 4) = g0 * _T(0, 1) + g1 * _T(1, 1) + g2 * _T(2, 1);
-  ret(1, 5) = g0 * _T(0, 2) + g1 * _T(1, 2) + g2 * _T(2, 2);
-  ret(2, 2) = (_T(0, 2) * e0 + _T(1, 2) * e3 + _T(2, 2) * e6) * _T(0, 2)
-              + (_T(0, 2) * e3 + _T(1, 2) * e4 + _T(2, 2) * e7) * _T(1, 2)
-              + (_T(0, 2) * e6 + _T(1, 2) * e7 + _T(2, 2) * e8) * _T(2, 2);
-  ret(2, 3) = g3 * _T(0, 0) + g4 * _T(1, 0) + g5 * _T(2, 0);
-  ret(2, 4) = g3 * _T(0, 1) + g4 * _T(1, 1) + g5 * _T(2, 1);
-  ret(2, 5) = g3 * _T(0, 2) + g4 * _T(1, 2) + g5 * _T(2, 2);
-  ret(3, 3) = h0 * _T(0, 0) + h1 * _T(1, 0) + h2 * _T(2, 0);
-  ret(3, 4) = h0 * _T(0, 1) + h1 * _T(1, 1) + h2 * _T(2, 1);
-  ret(3, 5) = h0 * _T(0, 2) + h1 * _T(1, 2) + h2 * _T(2, 2);
-  ret(4, 4) = h3 * _T(0, 1) + h4 * _T(1, 1) + h5 * _T(2, 1);
-  ret(4, 5) = h3 * _T(0, 2) + h4 * _T(1, 2) + h5 * _T(2, 2);
-  ret(5, 5)
-      = (_T(0, 2) * _I(3, 3) + _T(1, 2) * _I(3, 4) + _T(2, 2) * _I(3, 5))
-            * _T(0, 2)
-        + (_T(0, 2) * _I(3, 4) + _T(1, 2) * _I(4, 4) + _T(2, 2) * _I(4, 5))
-              * _T(1, 2)
-        + (_T(0, 2) * _I(3, 5) + _T(1, 2) * _I(4, 5) + _T(2, 2) * _I(5, 5))
-              * _T(2, 2);
-
-  ret.triangularView<Eigen::StrictlyLower>() = ret.transpose();
-
-  return ret;
+  return transformInertia<double>(_T, _I);
 }
 
 Eigen::Matrix3d parallelAxisTheorem(
@@ -424,6 +424,54 @@ Eigen::Vector6d dad(const Eigen::Vector6d& _s, const Eigen::Vector6d& _t);
 /// \brief
 Inertia transformInertia(const Eigen::Isometry3d& _T, const Inertia& _AI);
 
+//------------------------------------------------------------------------------
+// Spatial algebra for an arbitrary scalar type, e.g., float. The double
+// overloads above are implemented with these.
+//------------------------------------------------------------------------------
+
+/// \brief adjoint mapping for an arbitrary scalar type
+template <typename S>
+Vector6<S> AdT(const Isometry3<S>& T, const Vector6<S>& V);
+
+/// \brief Get linear transformation matrix of Adjoint mapping for an
+/// arbitrary scalar type
+template <typename S>
+Matrix6<S> getAdTMatrix(const Isometry3<S>& T);
+
+/// \brief fast version of Ad([R 0; 0 1], V) for an arbitrary scalar type
+template <typename S>
+Vector6<S> AdR(const Isometry3<S>& T, const Vector6<S>& V);
+
+/// \brief fast version of Ad(Inv(T), V) for an arbitrary scalar type
+template <typename S>
+Vector6<S> AdInvT(const Isometry3<S>& T, const Vector6<S>& V);
+
+/// \brief fast version of Ad(Inv([R 0; 0 1]), se3(0, v)) for an arbitrary
+/// scalar type
+template <typename S>
+Vector6<S> AdInvRLinear(
+    const Isometry3<S>& T, const Eigen::Matrix<S, 3, 1>& v);
+
+/// \brief dual adjoint mapping for an arbitrary scalar type
+template <typename S>
+Vector6<S> dAdT(const Isometry3<S>& T, const Vector6<S>& F);
+
+/// \brief fast version of dAd(Inv(T), F) for an arbitrary scalar type
+template <typename S>
+Vector6<S> dAdInvT(const Isometry3<S>& T, const Vector6<S>& F);
+
+/// \brief adjoint mapping for an arbitrary scalar type
+template <typename S>
+Vector6<S> ad(const Vector6<S>& X, const Vector6<S>& Y);
+
+/// \brief dual adjoint mapping for an arbitrary scalar type
+template <typename S>
+Vector6<S> dad(const Vector6<S>& s, const Vector6<S>& t);
+
+/// \brief transformInertia() for an arbitrary scalar type
+template <typename S>
+Matrix6<S> transformInertia(const Isometry3<S>& T, const Matrix6<S>& AI);
+
 /// Use the Parallel Axis Theorem to compute the moment of inertia of a body
 /// whose center of mass has been shifted from the origin
 Eigen::Matrix3d parallelAxisTheorem(
@@ -638,4 +686,6 @@ protected:
 } // namespace math
 } // namespace dart
 
+#include "dart/math/detail/Geometry-impl.hpp"
+
 #endif // DART_MATH_GEOMETRY_HPP_
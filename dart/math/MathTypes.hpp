@@ -113,6 +113,14 @@ using LinearJacobian = Eigen::Matrix<double, 3, Eigen::Dynamic>;
 using AngularJacobian = Eigen::Matrix<double, 3, Eigen::Dynamic>;
 using Jacobian = Eigen::Matrix<double, 6, Eigen::Dynamic>;
 
+// Spatial types for an arbitrary scalar type, e.g., float
+template <typename S>
+using Vector6 = Eigen::Matrix<S, 6, 1>;
+template <typename S>
+using Matrix6 = Eigen::Matrix<S, 6, 6>;
+template <typename S>
+using Isometry3 = Eigen::Transform<S, 3, Eigen::Isometry>;
+
 } // namespace math
 } // namespace dart
 
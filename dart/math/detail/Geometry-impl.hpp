@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef DART_MATH_DETAIL_GEOMETRY_IMPL_HPP_
+#define DART_MATH_DETAIL_GEOMETRY_IMPL_HPP_
+
+#include "dart/math/Geometry.hpp"
+
+namespace dart {
+namespace math {
+
+//==============================================================================
+template <typename S>
+Vector6<S> AdT(const Isometry3<S>& T, const Vector6<S>& V)
+{
+  // w' = R*w
+  // v' = p x R*w + R*v
+  Vector6<S> res;
+  res.template head<3>().noalias() = T.linear() * V.template head<3>();
+  res.template tail<3>().noalias()
+      = T.linear() * V.template tail<3>()
+        + T.translation().cross(res.template head<3>());
+  return res;
+}
+
+//==============================================================================
+template <typename S>
+Matrix6<S> getAdTMatrix(const Isometry3<S>& T)
+{
+  const Eigen::Matrix<S, 3, 1>& p = T.translation();
+  Eigen::Matrix<S, 3, 3> skew;
+  skew << S(0), -p[2], p[1], p[2], S(0), -p[0], -p[1], p[0], S(0);
+
+  Matrix6<S> AdT;
+  AdT.template topLeftCorner<3, 3>() = T.linear();
+  AdT.template topRightCorner<3, 3>().setZero();
+  AdT.template bottomLeftCorner<3, 3>().noalias() = skew * T.linear();
+  AdT.template bottomRightCorner<3, 3>() = T.linear();
+
+  return AdT;
+}
+
+//==============================================================================
+template <typename S>
+Vector6<S> AdR(const Isometry3<S>& T, const Vector6<S>& V)
+{
+  // w' = R*w
+  // v' = R*v
+  Vector6<S> res;
+  res.template head<3>().noalias() = T.linear() * V.template head<3>();
+  res.template tail<3>().noalias() = T.linear() * V.template tail<3>();
+  return res;
+}
+
+//==============================================================================
+template <typename S>
+Vector6<S> AdInvT(const Isometry3<S>& T, const Vector6<S>& V)
+{
+  Vector6<S> res;
+  res.template head<3>().noalias()
+      = T.linear().transpose() * V.template head<3>();
+  res.template tail<3>().noalias()
+      = T.linear().transpose()
+        * (V.template tail<3>()
+           + V.template head<3>().cross(T.translation()));
+  return res;
+}
+
+//==============================================================================
+template <typename S>
+Vector6<S> AdInvRLinear(const Isometry3<S>& T, const Eigen::Matrix<S, 3, 1>& v)
+{
+  Vector6<S> res = Vector6<S>::Zero();
+  res.template tail<3>().noalias() = T.linear().transpose() * v;
+  return res;
+}
+
+//==============================================================================
+template <typename S>
+Vector6<S> dAdT(const Isometry3<S>& T, const Vector6<S>& F)
+{
+  Vector6<S> res;
+  res.template head<3>().noalias()
+      = T.linear().transpose()
+        * (F.template head<3>()
+           + F.template tail<3>().cross(T.translation()));
+  res.template tail<3>().noalias()
+      = T.linear().transpose() * F.template tail<3>();
+  return res;
+}
+
+//==============================================================================
+template <typename S>
+Vector6<S> dAdInvT(const Isometry3<S>& T, const Vector6<S>& F)
+{
+  Vector6<S> res;
+  res.template tail<3>().noalias() = T.linear() * F.template tail<3>();
+  res.template head<3>().noalias() = T.linear() * F.template head<3>();
+  res.template head<3>() += T.translation().cross(res.template tail<3>());
+  return res;
+}
+
+//==============================================================================
+template <typename S>
+Vector6<S> ad(const Vector6<S>& X, const Vector6<S>& Y)
+{
+  Vector6<S> res;
+  res.template head<3>() = X.template head<3>().cross(Y.template head<3>());
+  res.template tail<3>() = X.template head<3>().cross(Y.template tail<3>())
+                           + X.template tail<3>().cross(Y.template head<3>());
+  return res;
+}
+
+//==============================================================================
+template <typename S>
+Vector6<S> dad(const Vector6<S>& s, const Vector6<S>& t)
+{
+  Vector6<S> res;
+  res.template head<3>() = t.template head<3>().cross(s.template head<3>())
+                           + t.template tail<3>().cross(s.template tail<3>());
+  res.template tail<3>() = t.template tail<3>().cross(s.template head<3>());
+  return res;
+}
+
+//==============================================================================
+template <typename S>
+Matrix6<S> transformInertia(const Isometry3<S>& _T, const Matrix6<S>& _I)
+{
+  // operation count: multiplication = 186, addition = 117, subtract = 21
+
+  Matrix6<S> ret = Matrix6<S>::Identity();
+
+  S d0 = _I(0, 3) + _T(2, 3) * _I(3, 4) - _T(1, 3) * _I(3, 5);
+  S d1 = _I(1, 3) - _T(2, 3) * _I(3, 3) + _T(0, 3) * _I(3, 5);
+  S d2 = _I(2, 3) + _T(1, 3) * _I(3, 3) - _T(0, 3) * _I(3, 4);
+  S d3 = _I(0, 4) + _T(2, 3) * _I(4, 4) - _T(1, 3) * _I(4, 5);
+  S d4 = _I(1, 4) - _T(2, 3) * _I(3, 4) + _T(0, 3) * _I(4, 5);
+  S d5 = _I(2, 4) + _T(1, 3) * _I(3, 4) - _T(0, 3) * _I(4, 4);
+  S d6 = _I(0, 5) + _T(2, 3) * _I(4, 5) - _T(1, 3) * _I(5, 5);
+  S d7 = _I(1, 5) - _T(2, 3) * _I(3, 5) + _T(0, 3) * _I(5, 5);
+  S d8 = _I(2, 5) + _T(1, 3) * _I(3, 5) - _T(0, 3) * _I(4, 5);
+  S e0 = _I(0, 0) + _T(2, 3) * _I(0, 4) - _T(1, 3) * _I(0, 5)
+         + d3 * _T(2, 3) - d6 * _T(1, 3);
+  S e3 = _I(0, 1) + _T(2, 3) * _I(1, 4) - _T(1, 3) * _I(1, 5)
+         - d0 * _T(2, 3) + d6 * _T(0, 3);
+  S e4 = _I(1, 1) - _T(2, 3) * _I(1, 3) + _T(0, 3) * _I(1, 5)
+         - d1 * _T(2, 3) + d7 * _T(0, 3);
+  S e6 = _I(0, 2) + _T(2, 3) * _I(2, 4) - _T(1, 3) * _I(2, 5)
+         + d0 * _T(1, 3) - d3 * _T(0, 3);
+  S e7 = _I(1, 2) - _T(2, 3) * _I(2, 3) + _T(0, 3) * _I(2, 5)
+         + d1 * _T(1, 3) - d4 * _T(0, 3);
+  S e8 = _I(2, 2) + _T(1, 3) * _I(2, 3) - _T(0, 3) * _I(2, 4)
+         + d2 * _T(1, 3) - d5 * _T(0, 3);
+  S f0 = _T(0, 0) * e0 + _T(1, 0) * e3 + _T(2, 0) * e6;
+  S f1 = _T(0, 0) * e3 + _T(1, 0) * e4 + _T(2, 0) * e7;
+  S f2 = _T(0, 0) * e6 + _T(1, 0) * e7 + _T(2, 0) * e8;
+  S f3 = _T(0, 0) * d0 + _T(1, 0) * d1 + _T(2, 0) * d2;
+  S f4 = _T(0, 0) * d3 + _T(1, 0) * d4 + _T(2, 0) * d5;
+  S f5 = _T(0, 0) * d6 + _T(1, 0) * d7 + _T(2, 0) * d8;
+  S f6 = _T(0, 1) * e0 + _T(1, 1) * e3 + _T(2, 1) * e6;
+  S f7 = _T(0, 1) * e3 + _T(1, 1) * e4 + _T(2, 1) * e7;
+  S f8 = _T(0, 1) * e6 + _T(1, 1) * e7 + _T(2, 1) * e8;
+  S g0 = _T(0, 1) * d0 + _T(1, 1) * d1 + _T(2, 1) * d2;
+  S g1 = _T(0, 1) * d3 + _T(1, 1) * d4 + _T(2, 1) * d5;
+  S g2 = _T(0, 1) * d6 + _T(1, 1) * d7 + _T(2, 1) * d8;
+  S g3 = _T(0, 2) * d0 + _T(1, 2) * d1 + _T(2, 2) * d2;
+  S g4 = _T(0, 2) * d3 + _T(1, 2) * d4 + _T(2, 2) * d5;
+  S g5 = _T(0, 2) * d6 + _T(1, 2) * d7 + _T(2, 2) * d8;
+  S h0 = _T(0, 0) * _I(3, 3) + _T(1, 0) * _I(3, 4) + _T(2, 0) * _I(3, 5);
+  S h1 = _T(0, 0) * _I(3, 4) + _T(1, 0) * _I(4, 4) + _T(2, 0) * _I(4, 5);
+  S h2 = _T(0, 0) * _I(3, 5) + _T(1, 0) * _I(4, 5) + _T(2, 0) * _I(5, 5);
+  S h3 = _T(0, 1) * _I(3, 3) + _T(1, 1) * _I(3, 4) + _T(2, 1) * _I(3, 5);
+  S h4 = _T(0, 1) * _I(3, 4) + _T(1, 1) * _I(4, 4) + _T(2, 1) * _I(4, 5);
+  S h5 = _T(0, 1) * _I(3, 5) + _T(1, 1) * _I(4, 5) + _T(2, 1) * _I(5, 5);
+
+  ret(0, 0) = f0 * _T(0, 0) + f1 * _T(1, 0) + f2 * _T(2, 0);
+  ret(0, 1) = f0 * _T(0, 1) + f1 * _T(1, 1) + f2 * _T(2, 1);
+  ret(0, 2) = f0 * _T(0, 2) + f1 * _T(1, 2) + f2 * _T(2, 2);
+  ret(0, 3) = f3 * _T(0, 0) + f4 * _T(1, 0) + f5 * _T(2, 0);
+  ret(0, 4) = f3 * _T(0, 1) + f4 * _T(1, 1) + f5 * _T(2, 1);
+  ret(0, 5) = f3 * _T(0, 2) + f4 * _T(1, 2) + f5 * _T(2, 2);
+  ret(1, 1) = f6 * _T(0, 1) + f7 * _T(1, 1) + f8 * _T(2, 1);
+  ret(1, 2) = f6 * _T(0, 2) + f7 * _T(1, 2) + f8 * _T(2, 2);
+  ret(1, 3) = g0 * _T(0, 0) + g1 * _T(1, 0) + g2 * _T(2, 0);
+  ret(1, 4) = g0 * _T(0, 1) + g1 * _T(1, 1) + g2 * _T(2, 1);
+  ret(1, 5) = g0 * _T(0, 2) + g1 * _T(1, 2) + g2 * _T(2, 2);
+  ret(2, 2) = (_T(0, 2) * e0 + _T(1, 2) * e3 + _T(2, 2) * e6) * _T(0, 2)
+              + (_T(0, 2) * e3 + _T(1, 2) * e4 + _T(2, 2) * e7) * _T(1, 2)
+              + (_T(0, 2) * e6 + _T(1, 2) * e7 + _T(2, 2) * e8) * _T(2, 2);
+  ret(2, 3) = g3 * _T(0, 0) + g4 * _T(1, 0) + g5 * _T(2, 0);
+  ret(2, 4) = g3 * _T(0, 1) + g4 * _T(1, 1) + g5 * _T(2, 1);
+  ret(2, 5) = g3 * _T(0, 2) + g4 * _T(1, 2) + g5 * _T(2, 2);
+  ret(3, 3) = h0 * _T(0, 0) + h1 * _T(1, 0) + h2 * _T(2, 0);
+  ret(3, 4) = h0 * _T(0, 1) + h1 * _T(1, 1) + h2 * _T(2, 1);
+  ret(3, 5) = h0 * _T(0, 2) + h1 * _T(1, 2) + h2 * _T(2, 2);
+  ret(4, 4) = h3 * _T(0, 1) + h4 * _T(1, 1) + h5 * _T(2, 1);
+  ret(4, 5) = h3 * _T(0, 2) + h4 * _T(1, 2) + h5 * _T(2, 2);
+  ret(5, 5)
+      = (_T(0, 2) * _I(3, 3) + _T(1, 2) * _I(3, 4) + _T(2, 2) * _I(3, 5))
+            * _T(0, 2)
+        + (_T(0, 2) * _I(3, 4) + _T(1, 2) * _I(4, 4) + _T(2, 2) * _I(4, 5))
+              * _T(1, 2)
+        + (_T(0, 2) * _I(3, 5) + _T(1, 2) * _I(4, 5) + _T(2, 2) * _I(5, 5))
+              * _T(2, 2);
+
+  ret.template triangularView<Eigen::StrictlyLower>() = ret.transpose();
+
+  return ret;
+}
+
+} // namespace math
+} // namespace dart
+
+#endif // DART_MATH_DETAIL_GEOMETRY_IMPL_HPP_
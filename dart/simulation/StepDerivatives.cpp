@@ -0,0 +1,968 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/simulation/StepDerivatives.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "dart/common/Console.hpp"
+#include "dart/common/Memory.hpp"
+#include "dart/constraint/BoxedLcpConstraintSolver.hpp"
+#include "dart/dynamics/BallJoint.hpp"
+#include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/DegreeOfFreedom.hpp"
+#include "dart/dynamics/EulerJoint.hpp"
+#include "dart/dynamics/FreeJoint.hpp"
+#include "dart/dynamics/PlanarJoint.hpp"
+#include "dart/dynamics/PrismaticJoint.hpp"
+#include "dart/dynamics/RevoluteJoint.hpp"
+#include "dart/dynamics/ScrewJoint.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+#include "dart/dynamics/TranslationalJoint.hpp"
+#include "dart/dynamics/TranslationalJoint2D.hpp"
+#include "dart/dynamics/UniversalJoint.hpp"
+#include "dart/math/Geometry.hpp"
+
+namespace dart {
+namespace simulation {
+
+namespace {
+
+//==============================================================================
+/// Nominal quantities of a BodyNode for the tangent pass of the inverse
+/// dynamics, all expressed in the frame of the BodyNode
+struct BodyLinearization
+{
+  /// Index of the parent BodyNode, or -1 for a root
+  int mParent;
+
+  /// Index of the first generalized coordinate of the parent Joint
+  int mDofOffset;
+
+  /// Number of generalized coordinates of the parent Joint
+  int mNumDofs;
+
+  /// Transform of the parent Joint
+  Eigen::Isometry3d mTransform;
+
+  /// Relative Jacobian of the parent Joint
+  math::Jacobian mJacobian;
+
+  /// Derivative of mJacobian with respect to each position of the parent
+  /// Joint, or empty if mJacobian does not depend on the positions
+  std::vector<math::Jacobian> mJacobianDerivs;
+
+  /// Velocities of the parent Joint
+  Eigen::VectorXd mJointVelocities;
+
+  /// Accelerations of the parent Joint
+  Eigen::VectorXd mJointAccelerations;
+
+  /// Twists by which the transform of the parent Joint moves per unit change
+  /// of its positions
+  math::Jacobian mPositionTangents;
+
+  /// Spatial inertia
+  Eigen::Matrix6d mInertia;
+
+  /// Spatial velocity
+  Eigen::Vector6d mVelocity;
+
+  /// Spatial velocity relative to the parent BodyNode
+  Eigen::Vector6d mRelativeVelocity;
+
+  /// Spatial velocity of the parent BodyNode
+  Eigen::Vector6d mParentVelocity;
+
+  /// Spatial acceleration of the parent BodyNode
+  Eigen::Vector6d mParentAcceleration;
+
+  /// Gravitational acceleration, or zero if the BodyNode ignores gravity
+  Eigen::Vector6d mGravity;
+
+  /// Force transmitted through the parent Joint by the inverse dynamics
+  Eigen::Vector6d mForce;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+//==============================================================================
+/// Right Jacobian J of the exponential map of rotations, with
+///   expMapRot(_q + dq) = expMapRot(_q) * expMapRot(J * dq)
+/// to first order. math::expMapJac() is the left Jacobian.
+Eigen::Matrix3d computeRightJacobian(const Eigen::Vector3d& _q)
+{
+  return math::expMapJac(_q).transpose();
+}
+
+//==============================================================================
+/// Map from the changes of the positions of _joint to the changes of its
+/// velocity coordinates that move its transform the same way
+Eigen::MatrixXd computePositionTangents(const dynamics::Joint* _joint)
+{
+  const Eigen::VectorXd positions = _joint->getPositions();
+
+  if (dynamic_cast<const dynamics::BallJoint*>(_joint))
+    return computeRightJacobian(positions);
+
+  if (dynamic_cast<const dynamics::FreeJoint*>(_joint))
+  {
+    // The velocities of a FreeJoint are the twist of its transform in its
+    // child frame, while its last three positions are the translation in its
+    // parent frame
+    Eigen::MatrixXd tangents = Eigen::MatrixXd::Zero(6, 6);
+    tangents.topLeftCorner<3, 3>() = computeRightJacobian(positions.head<3>());
+    tangents.bottomRightCorner<3, 3>()
+        = math::expMapRot(positions.head<3>()).transpose();
+    return tangents;
+  }
+
+  return Eigen::MatrixXd::Identity(
+      static_cast<int>(_joint->getNumDofs()),
+      static_cast<int>(_joint->getNumDofs()));
+}
+
+//==============================================================================
+/// Return whether the transform of _joint is a product of exponentials
+///   T(q) = T_parent * exp(S_0 q_0) * ... * exp(S_m-1 q_m-1) * T_child^-1
+/// whose relative Jacobian depends on the positions
+bool hasProductOfExponentials(const dynamics::Joint* _joint)
+{
+  return dynamic_cast<const dynamics::UniversalJoint*>(_joint)
+         || dynamic_cast<const dynamics::EulerJoint*>(_joint)
+         || dynamic_cast<const dynamics::PlanarJoint*>(_joint);
+}
+
+//==============================================================================
+/// Return whether the derivatives model the relative Jacobian of _joint
+bool isSupportedJoint(const dynamics::Joint* _joint)
+{
+  return hasProductOfExponentials(_joint)
+         || dynamic_cast<const dynamics::BallJoint*>(_joint)
+         || dynamic_cast<const dynamics::FreeJoint*>(_joint)
+         || dynamic_cast<const dynamics::PrismaticJoint*>(_joint)
+         || dynamic_cast<const dynamics::RevoluteJoint*>(_joint)
+         || dynamic_cast<const dynamics::ScrewJoint*>(_joint)
+         || dynamic_cast<const dynamics::TranslationalJoint*>(_joint)
+         || dynamic_cast<const dynamics::TranslationalJoint2D*>(_joint)
+         || _joint->getNumDofs() == 0u;
+}
+
+//==============================================================================
+/// Derivatives of the relative Jacobian _jacobian of a product of
+/// exponentials with respect to each position. The body twist of the factor
+/// k moves column i < k by
+///   dS_i/dq_k = -ad(S_k, S_i)
+/// and leaves the other columns.
+std::vector<math::Jacobian> computeJacobianDerivs(
+    const math::Jacobian& _jacobian)
+{
+  const int numDofs = static_cast<int>(_jacobian.cols());
+
+  std::vector<math::Jacobian> derivs(
+      static_cast<std::size_t>(numDofs), math::Jacobian::Zero(6, numDofs));
+  for (int k = 0; k < numDofs; ++k)
+  {
+    for (int i = 0; i < k; ++i)
+    {
+      derivs[static_cast<std::size_t>(k)].col(i)
+          = -math::ad(_jacobian.col(k), _jacobian.col(i));
+    }
+  }
+
+  return derivs;
+}
+
+//==============================================================================
+/// Differentiate the inverse dynamics of _skel at its current positions,
+/// velocities, and accelerations with respect to the positions and the
+/// velocities by a tangent pass of the recursive Newton-Euler algorithm
+void differentiateInverseDynamics(
+    const dynamics::Skeleton* _skel,
+    Eigen::MatrixXd& _wrtPositions,
+    Eigen::MatrixXd& _wrtVelocities)
+{
+  const int numBodies = static_cast<int>(_skel->getNumBodyNodes());
+  const int numDofs = static_cast<int>(_skel->getNumDofs());
+  const Eigen::Vector3d& gravity = _skel->getGravity();
+
+  // Nominal pass. The BodyNodes of a Skeleton are ordered from the roots to
+  // the leaves.
+  common::aligned_vector<BodyLinearization> bodies(
+      static_cast<std::size_t>(numBodies));
+  for (int i = 0; i < numBodies; ++i)
+  {
+    const dynamics::BodyNode* bodyNode = _skel->getBodyNode(i);
+    const dynamics::Joint* joint = bodyNode->getParentJoint();
+    const dynamics::BodyNode* parent = bodyNode->getParentBodyNode();
+    BodyLinearization& body = bodies[static_cast<std::size_t>(i)];
+
+    body.mParent
+        = parent ? static_cast<int>(parent->getIndexInSkeleton()) : -1;
+    body.mNumDofs = static_cast<int>(joint->getNumDofs());
+    body.mDofOffset
+        = body.mNumDofs > 0
+              ? static_cast<int>(joint->getIndexInSkeleton(0u))
+              : 0;
+    body.mTransform = joint->getRelativeTransform();
+    body.mJacobian = joint->getRelativeJacobian();
+    if (hasProductOfExponentials(joint))
+      body.mJacobianDerivs = computeJacobianDerivs(body.mJacobian);
+    body.mJointVelocities = joint->getVelocities();
+    body.mJointAccelerations = joint->getAccelerations();
+    body.mPositionTangents
+        = body.mJacobian * computePositionTangents(joint);
+    body.mInertia = bodyNode->getSpatialInertia();
+    body.mVelocity = bodyNode->getSpatialVelocity();
+    body.mRelativeVelocity = body.mJacobian * body.mJointVelocities;
+
+    if (parent)
+    {
+      body.mParentVelocity
+          = math::AdInvT(body.mTransform, parent->getSpatialVelocity());
+      body.mParentAcceleration
+          = math::AdInvT(body.mTransform, parent->getSpatialAcceleration());
+    }
+    else
+    {
+      body.mParentVelocity.setZero();
+      body.mParentAcceleration.setZero();
+    }
+
+    if (bodyNode->getGravityMode())
+    {
+      body.mGravity
+          = math::AdInvRLinear(bodyNode->getWorldTransform(), gravity);
+    }
+    else
+    {
+      body.mGravity.setZero();
+    }
+
+    body.mForce = body.mInertia * bodyNode->getSpatialAcceleration()
+                  - body.mInertia * body.mGravity
+                  - bodyNode->getExternalForceLocal()
+                  - math::dad(body.mVelocity, body.mInertia * body.mVelocity);
+  }
+  for (int i = numBodies - 1; i >= 0; --i)
+  {
+    const BodyLinearization& body = bodies[static_cast<std::size_t>(i)];
+    if (body.mParent >= 0)
+    {
+      bodies[static_cast<std::size_t>(body.mParent)].mForce
+          += math::dAdInvT(body.mTransform, body.mForce);
+    }
+  }
+
+  _wrtPositions.setZero(numDofs, numDofs);
+  _wrtVelocities.setZero(numDofs, numDofs);
+
+  // Changes of the velocity, the acceleration, the world transform, and the
+  // transmitted force of each BodyNode along one direction
+  common::aligned_vector<Eigen::Vector6d> velocityChanges(
+      static_cast<std::size_t>(numBodies));
+  common::aligned_vector<Eigen::Vector6d> accelerationChanges(
+      static_cast<std::size_t>(numBodies));
+  common::aligned_vector<Eigen::Vector6d> transformChanges(
+      static_cast<std::size_t>(numBodies));
+  common::aligned_vector<Eigen::Vector6d> forceChanges(
+      static_cast<std::size_t>(numBodies));
+
+  // Propagate the changes of the transform (_twist), the relative velocity,
+  // the relative acceleration, and the relative Jacobian (or nullptr if it
+  // doesn't change) of the parent Joint of the BodyNode _index into the
+  // column _column of the generalized forces
+  const auto propagate = [&](int _index,
+                             const Eigen::Vector6d& _twist,
+                             const Eigen::Vector6d& _relativeVelocity,
+                             const Eigen::Vector6d& _relativeAcceleration,
+                             const math::Jacobian* _jacobianChange,
+                             Eigen::Ref<Eigen::VectorXd> _column) {
+    // Only the BodyNodes from _index on can be descendants
+    for (int i = 0; i < _index; ++i)
+    {
+      velocityChanges[static_cast<std::size_t>(i)].setZero();
+      accelerationChanges[static_cast<std::size_t>(i)].setZero();
+      transformChanges[static_cast<std::size_t>(i)].setZero();
+    }
+
+    for (int i = _index; i < numBodies; ++i)
+    {
+      const std::size_t k = static_cast<std::size_t>(i);
+      const BodyLinearization& body = bodies[k];
+      Eigen::Vector6d& dV = velocityChanges[k];
+      Eigen::Vector6d& dA = accelerationChanges[k];
+      Eigen::Vector6d& dW = transformChanges[k];
+
+      if (body.mParent >= 0)
+      {
+        const std::size_t p = static_cast<std::size_t>(body.mParent);
+        dV = math::AdInvT(body.mTransform, velocityChanges[p]);
+        dA = math::AdInvT(body.mTransform, accelerationChanges[p]);
+        dW = math::AdInvT(body.mTransform, transformChanges[p]);
+      }
+      else
+      {
+        dV.setZero();
+        dA.setZero();
+        dW.setZero();
+      }
+
+      if (i == _index)
+      {
+        dW += _twist;
+        dV += _relativeVelocity - math::ad(_twist, body.mParentVelocity);
+        dA += _relativeAcceleration
+              + math::ad(body.mVelocity, _relativeVelocity)
+              - math::ad(_twist, body.mParentAcceleration);
+      }
+
+      dA += math::ad(dV, body.mRelativeVelocity);
+    }
+
+    for (auto& forceChange : forceChanges)
+      forceChange.setZero();
+
+    for (int i = numBodies - 1; i >= 0; --i)
+    {
+      const std::size_t k = static_cast<std::size_t>(i);
+      const BodyLinearization& body = bodies[k];
+      Eigen::Vector6d& dF = forceChanges[k];
+
+      if (i >= _index)
+      {
+        const Eigen::Vector6d& dV = velocityChanges[k];
+        dF += body.mInertia * accelerationChanges[k]
+              + body.mInertia * math::ad(transformChanges[k], body.mGravity)
+              - math::dad(dV, body.mInertia * body.mVelocity)
+              - math::dad(body.mVelocity, body.mInertia * dV);
+      }
+
+      if (body.mNumDofs > 0)
+      {
+        _column.segment(body.mDofOffset, body.mNumDofs)
+            = body.mJacobian.transpose() * dF;
+        if (i == _index && _jacobianChange)
+        {
+          _column.segment(body.mDofOffset, body.mNumDofs)
+              += _jacobianChange->transpose() * body.mForce;
+        }
+      }
+
+      if (body.mParent >= 0)
+      {
+        const Eigen::Vector6d transmitted
+            = i == _index ? Eigen::Vector6d(dF - math::dad(_twist, body.mForce))
+                          : dF;
+        forceChanges[static_cast<std::size_t>(body.mParent)]
+            += math::dAdInvT(body.mTransform, transmitted);
+      }
+    }
+  };
+
+  const Eigen::Vector6d zero = Eigen::Vector6d::Zero();
+  for (int i = 0; i < numBodies; ++i)
+  {
+    const BodyLinearization& body = bodies[static_cast<std::size_t>(i)];
+    if (body.mJacobianDerivs.empty())
+    {
+      for (int j = 0; j < body.mNumDofs; ++j)
+      {
+        const int dof = body.mDofOffset + j;
+        propagate(
+            i,
+            body.mPositionTangents.col(j),
+            zero,
+            zero,
+            nullptr,
+            _wrtPositions.col(dof));
+        propagate(
+            i,
+            zero,
+            body.mJacobian.col(j),
+            zero,
+            nullptr,
+            _wrtVelocities.col(dof));
+      }
+      continue;
+    }
+
+    // The relative acceleration holds S ddq + dS/dt dq, with
+    //   dS/dt = sum_l dq_l dS/dq_l
+    const std::vector<math::Jacobian>& derivs = body.mJacobianDerivs;
+    const Eigen::VectorXd& dq = body.mJointVelocities;
+    math::Jacobian jacobianDeriv = math::Jacobian::Zero(6, body.mNumDofs);
+    for (int l = 0; l < body.mNumDofs; ++l)
+      jacobianDeriv += dq[l] * derivs[static_cast<std::size_t>(l)];
+
+    for (int j = 0; j < body.mNumDofs; ++j)
+    {
+      const int dof = body.mDofOffset + j;
+      const math::Jacobian& deriv = derivs[static_cast<std::size_t>(j)];
+
+      // Second derivatives d^2S_i/(dq_l dq_j) for l > i, contracted with dq
+      // over l to differentiate dS/dt with respect to q_j
+      math::Jacobian jacobianDerivChange
+          = math::Jacobian::Zero(6, body.mNumDofs);
+      for (int l = 0; l < body.mNumDofs; ++l)
+      {
+        for (int m = 0; m < l; ++m)
+        {
+          jacobianDerivChange.col(m)
+              -= dq[l]
+                 * (math::ad(deriv.col(l), body.mJacobian.col(m))
+                    + math::ad(body.mJacobian.col(l), deriv.col(m)));
+        }
+      }
+
+      propagate(
+          i,
+          body.mPositionTangents.col(j),
+          deriv * dq,
+          deriv * body.mJointAccelerations + jacobianDerivChange * dq,
+          &deriv,
+          _wrtPositions.col(dof));
+      propagate(
+          i,
+          zero,
+          body.mJacobian.col(j),
+          deriv * dq + jacobianDeriv.col(j),
+          nullptr,
+          _wrtVelocities.col(dof));
+    }
+  }
+}
+
+//==============================================================================
+/// Differentiate the exponential coordinates
+///   log(expMapRot(_positions) * expMapRot(_timeStep * _velocities))
+/// that BallJoint and FreeJoint integrate their rotations to
+void differentiateRotationIntegration(
+    const Eigen::Vector3d& _positions,
+    const Eigen::Vector3d& _velocities,
+    double _timeStep,
+    Eigen::Ref<Eigen::MatrixXd> _wrtPositions,
+    Eigen::Ref<Eigen::MatrixXd> _wrtVelocities)
+{
+  const Eigen::Vector3d step = _timeStep * _velocities;
+  const Eigen::Matrix3d stepRotation = math::expMapRot(step);
+  const Eigen::Vector3d next
+      = math::logMap(math::expMapRot(_positions) * stepRotation);
+  const Eigen::Matrix3d nextInverse = computeRightJacobian(next).inverse();
+
+  _wrtPositions = nextInverse * stepRotation.transpose()
+                  * computeRightJacobian(_positions);
+  _wrtVelocities = _timeStep * nextInverse * computeRightJacobian(step);
+}
+
+//==============================================================================
+/// Differentiate the positions that Joint::integratePositions() of _joint
+/// reaches from _positions with _velocities over _timeStep
+void differentiateIntegration(
+    const dynamics::Joint* _joint,
+    const Eigen::VectorXd& _positions,
+    const Eigen::VectorXd& _velocities,
+    double _timeStep,
+    Eigen::Ref<Eigen::MatrixXd> _wrtPositions,
+    Eigen::Ref<Eigen::MatrixXd> _wrtVelocities)
+{
+  if (dynamic_cast<const dynamics::BallJoint*>(_joint))
+  {
+    differentiateRotationIntegration(
+        _positions, _velocities, _timeStep, _wrtPositions, _wrtVelocities);
+    return;
+  }
+
+  if (dynamic_cast<const dynamics::FreeJoint*>(_joint))
+  {
+    // The translation moves by the rotation before the step times the linear
+    // velocity
+    const Eigen::Vector3d rotation = _positions.head<3>();
+    const Eigen::Matrix3d R = math::expMapRot(rotation);
+
+    _wrtPositions.setZero();
+    _wrtVelocities.setZero();
+    differentiateRotationIntegration(
+        rotation,
+        _velocities.head<3>(),
+        _timeStep,
+        _wrtPositions.topLeftCorner(3, 3),
+        _wrtVelocities.topLeftCorner(3, 3));
+    _wrtPositions.bottomLeftCorner(3, 3)
+        = -R * math::makeSkewSymmetric(_timeStep * _velocities.tail<3>())
+          * computeRightJacobian(rotation);
+    _wrtPositions.bottomRightCorner(3, 3).setIdentity();
+    _wrtVelocities.bottomRightCorner(3, 3) = _timeStep * R;
+    return;
+  }
+
+  _wrtPositions.setIdentity();
+  _wrtVelocities.setIdentity();
+  _wrtVelocities *= _timeStep;
+}
+
+} // namespace
+
+//==============================================================================
+StepDerivatives::StepDerivatives() : mNumDofs(0u), mTimeStep(0.0)
+{
+  // Do nothing
+}
+
+//==============================================================================
+const std::vector<dynamics::SkeletonPtr>& StepDerivatives::getSkeletons() const
+{
+  return mSkeletons;
+}
+
+//==============================================================================
+std::size_t StepDerivatives::getNumDofs() const
+{
+  return mNumDofs;
+}
+
+//==============================================================================
+std::size_t StepDerivatives::getNumActiveConstraints() const
+{
+  return static_cast<std::size_t>(mImpulseGains.rows());
+}
+
+//==============================================================================
+Eigen::MatrixXd StepDerivatives::getStateJacobian() const
+{
+  const int n = static_cast<int>(mNumDofs);
+
+  // Projection of the unconstrained velocities onto the constrained ones
+  const Eigen::MatrixXd projection
+      = Eigen::MatrixXd::Identity(n, n) - mImpulseResponses * mImpulseGains;
+  const Eigen::MatrixXd velocityWrtPositions
+      = projection * mVelocityWrtPositions;
+  const Eigen::MatrixXd velocityWrtVelocities
+      = projection * mVelocityWrtVelocities;
+
+  Eigen::MatrixXd jacobian(2 * n, 2 * n);
+  jacobian.topLeftCorner(n, n)
+      = mPositionWrtPositions + mPositionWrtVelocities * velocityWrtPositions;
+  jacobian.topRightCorner(n, n)
+      = mPositionWrtVelocities * velocityWrtVelocities;
+  jacobian.bottomLeftCorner(n, n) = velocityWrtPositions;
+  jacobian.bottomRightCorner(n, n) = velocityWrtVelocities;
+
+  return jacobian;
+}
+
+//==============================================================================
+Eigen::MatrixXd StepDerivatives::getControlJacobian() const
+{
+  const int n = static_cast<int>(mNumDofs);
+
+  const Eigen::MatrixXd velocityWrtForces
+      = mVelocityWrtForces
+        - mImpulseResponses * (mImpulseGains * mVelocityWrtForces);
+
+  Eigen::MatrixXd jacobian(2 * n, n);
+  jacobian.topRows(n) = mPositionWrtVelocities * velocityWrtForces;
+  jacobian.bottomRows(n) = velocityWrtForces;
+
+  return jacobian;
+}
+
+//==============================================================================
+Eigen::VectorXd StepDerivatives::computeJvp(
+    const Eigen::VectorXd& _dx, const Eigen::VectorXd& _du) const
+{
+  const int n = static_cast<int>(mNumDofs);
+  assert(_dx.size() == 2 * n);
+  assert(_du.size() == n);
+
+  const Eigen::VectorXd freeVelocities = mVelocityWrtPositions * _dx.head(n)
+                                         + mVelocityWrtVelocities * _dx.tail(n)
+                                         + mVelocityWrtForces * _du;
+
+  Eigen::VectorXd result(2 * n);
+  result.tail(n)
+      = freeVelocities - mImpulseResponses * (mImpulseGains * freeVelocities);
+  result.head(n) = mPositionWrtPositions * _dx.head(n)
+                   + mPositionWrtVelocities * result.tail(n);
+
+  return result;
+}
+
+//==============================================================================
+void StepDerivatives::computeVjp(
+    const Eigen::VectorXd& _gradient,
+    Eigen::VectorXd& _stateGradient,
+    Eigen::VectorXd& _controlGradient) const
+{
+  const int n = static_cast<int>(mNumDofs);
+  assert(_gradient.size() == 2 * n);
+
+  // Gradient with respect to the constrained velocities after the step
+  const Eigen::VectorXd velocityGradient
+      = _gradient.tail(n)
+        + mPositionWrtVelocities.transpose() * _gradient.head(n);
+
+  // Gradient with respect to the unconstrained velocities after the step
+  const Eigen::VectorXd freeVelocityGradient
+      = velocityGradient
+        - mImpulseGains.transpose()
+              * (mImpulseResponses.transpose() * velocityGradient);
+
+  _stateGradient.resize(2 * n);
+  _stateGradient.head(n)
+      = mPositionWrtPositions.transpose() * _gradient.head(n)
+        + mVelocityWrtPositions.transpose() * freeVelocityGradient;
+  _stateGradient.tail(n)
+      = mVelocityWrtVelocities.transpose() * freeVelocityGradient;
+
+  _controlGradient = mVelocityWrtForces.transpose() * freeVelocityGradient;
+}
+
+//==============================================================================
+void StepDerivatives::linearizeVelocities(
+    const std::vector<dynamics::SkeletonPtr>& _skeletons, double _timeStep)
+{
+  mTimeStep = _timeStep;
+
+  mSkeletons.clear();
+  mOffsets.clear();
+  mNumDofs = 0u;
+  for (const auto& skel : _skeletons)
+  {
+    if (!skel->isMobile() || skel->getNumDofs() == 0u)
+      continue;
+
+    mSkeletons.push_back(skel);
+    mOffsets.push_back(mNumDofs);
+    mNumDofs += skel->getNumDofs();
+  }
+
+  const int n = static_cast<int>(mNumDofs);
+  mPositions.resize(n);
+  mVelocityWrtPositions.setZero(n, n);
+  mVelocityWrtVelocities.setZero(n, n);
+  mVelocityWrtForces.setZero(n, n);
+
+  for (std::size_t k = 0u; k < mSkeletons.size(); ++k)
+  {
+    const dynamics::Skeleton* skel = mSkeletons[k].get();
+    const int offset = static_cast<int>(mOffsets[k]);
+    const int numDofs = static_cast<int>(skel->getNumDofs());
+
+    mPositions.segment(offset, numDofs) = skel->getPositions();
+
+    for (std::size_t i = 0u; i < skel->getNumJoints(); ++i)
+    {
+      const dynamics::Joint* joint = skel->getJoint(i);
+      if (!isSupportedJoint(joint))
+      {
+        dtwarn << "[StepDerivatives::linearizeVelocities] Joint ["
+               << joint->getName() << "] of type [" << joint->getType()
+               << "] is not one of the joints of DART. The derivatives take "
+               << "its relative Jacobian as independent of its positions.\n";
+      }
+    }
+
+    // The forward dynamics solves the residual
+    //   R = ID(q, dq, ddq) + D (dq + dt ddq) + K (q - q0 + dt dq + dt^2 ddq)
+    //       - u
+    // for the accelerations of the dynamic coordinates, where ID is the
+    // inverse dynamics and D and K are the joint dampings and stiffnesses, so
+    //   d(ddq) = -(M + dt D + dt^2 K)^-1 (dR/dq dq + dR/d(dq) d(dq) - du)
+    Eigen::MatrixXd residualWrtPositions;
+    Eigen::MatrixXd residualWrtVelocities;
+    differentiateInverseDynamics(
+        skel, residualWrtPositions, residualWrtVelocities);
+
+    // The kinematic coordinates follow their commands. VELOCITY joints reach
+    // the commanded velocities within the step, and LOCKED joints stop.
+    Eigen::VectorXd kinematicAccelerationWrtVelocities
+        = Eigen::VectorXd::Zero(numDofs);
+    Eigen::VectorXd carriedVelocities = Eigen::VectorXd::Ones(numDofs);
+    std::vector<int> dynamicDofs;
+    std::vector<int> forceDofs;
+    for (int i = 0; i < numDofs; ++i)
+    {
+      const dynamics::DegreeOfFreedom* dof = skel->getDof(i);
+      const dynamics::Joint* joint = dof->getJoint();
+      switch (joint->getActuatorType())
+      {
+        case dynamics::Joint::VELOCITY:
+          kinematicAccelerationWrtVelocities[i] = -1.0 / _timeStep;
+          break;
+        case dynamics::Joint::LOCKED:
+          // The forward dynamics zeroes the velocities of LOCKED joints
+          residualWrtVelocities.col(i).setZero();
+          carriedVelocities[i] = 0.0;
+          break;
+        case dynamics::Joint::ACCELERATION:
+          break;
+        default:
+          dynamicDofs.push_back(i);
+          if (joint->getActuatorType() == dynamics::Joint::FORCE)
+            forceDofs.push_back(i);
+          break;
+      }
+
+      const double stiffness = dof->getSpringStiffness();
+      const double damping = dof->getDampingCoefficient();
+      residualWrtPositions(i, i) += stiffness;
+      residualWrtVelocities(i, i) += damping + _timeStep * stiffness;
+    }
+
+    const Eigen::MatrixXd& augMass = skel->getAugMassMatrix();
+    for (int i = 0; i < numDofs; ++i)
+    {
+      if (kinematicAccelerationWrtVelocities[i] != 0.0)
+      {
+        residualWrtVelocities.col(i)
+            += kinematicAccelerationWrtVelocities[i] * augMass.col(i);
+      }
+    }
+
+    // One factorization of the augmented mass matrix of the dynamic
+    // coordinates gives all the derivatives of their accelerations
+    const int numDynamicDofs = static_cast<int>(dynamicDofs.size());
+    Eigen::MatrixXd dynamicMass(numDynamicDofs, numDynamicDofs);
+    Eigen::MatrixXd rhs = Eigen::MatrixXd::Zero(numDynamicDofs, 3 * numDofs);
+    for (int a = 0; a < numDynamicDofs; ++a)
+    {
+      const int i = dynamicDofs[static_cast<std::size_t>(a)];
+      for (int b = 0; b < numDynamicDofs; ++b)
+      {
+        dynamicMass(a, b)
+            = augMass(i, dynamicDofs[static_cast<std::size_t>(b)]);
+      }
+
+      rhs.block(a, 0, 1, numDofs) = -residualWrtPositions.row(i);
+      rhs.block(a, numDofs, 1, numDofs) = -residualWrtVelocities.row(i);
+    }
+    for (const int i : forceDofs)
+    {
+      const auto it = std::find(dynamicDofs.begin(), dynamicDofs.end(), i);
+      rhs(static_cast<int>(std::distance(dynamicDofs.begin(), it)),
+          2 * numDofs + i)
+          = 1.0;
+    }
+    const Eigen::MatrixXd accelerations = dynamicMass.llt().solve(rhs);
+
+    auto velocityWrtPositions
+        = mVelocityWrtPositions.block(offset, offset, numDofs, numDofs);
+    auto velocityWrtVelocities
+        = mVelocityWrtVelocities.block(offset, offset, numDofs, numDofs);
+    auto velocityWrtForces
+        = mVelocityWrtForces.block(offset, offset, numDofs, numDofs);
+    for (int a = 0; a < numDynamicDofs; ++a)
+    {
+      const int i = dynamicDofs[static_cast<std::size_t>(a)];
+      velocityWrtPositions.row(i)
+          = _timeStep * accelerations.block(a, 0, 1, numDofs);
+      velocityWrtVelocities.row(i)
+          = _timeStep * accelerations.block(a, numDofs, 1, numDofs);
+      velocityWrtForces.row(i)
+          = _timeStep * accelerations.block(a, 2 * numDofs, 1, numDofs);
+    }
+    velocityWrtVelocities.diagonal()
+        += carriedVelocities
+           + _timeStep * kinematicAccelerationWrtVelocities;
+  }
+
+  // Without constraint impulses until linearizeImpulses() says otherwise
+  mImpulseResponses.resize(n, 0);
+  mImpulseGains.resize(0, n);
+}
+
+//==============================================================================
+void StepDerivatives::linearizeImpulses(
+    const constraint::BoxedLcpConstraintSolver* _solver)
+{
+  const int n = static_cast<int>(mNumDofs);
+
+  mImpulseResponses.resize(n, 0);
+  mImpulseGains.resize(0, n);
+
+  if (!_solver)
+    return;
+
+  std::vector<Eigen::MatrixXd> responses;
+  std::vector<Eigen::MatrixXd> gains;
+  int numActive = 0;
+
+  for (const auto& record : _solver->getLcpRecords())
+  {
+    const int m = static_cast<int>(record.mX.size());
+    const Eigen::VectorXd& x = record.mX;
+
+    // Velocity changes per unit impulse, D = M^-1 J^T, and the constraint
+    // Jacobian, J = (M D)^T, in the coordinates of x
+    Eigen::MatrixXd impulseResponses = Eigen::MatrixXd::Zero(n, m);
+    Eigen::MatrixXd constraintJacobian = Eigen::MatrixXd::Zero(m, n);
+    for (std::size_t k = 0u; k < record.mSkeletons.size(); ++k)
+    {
+      const auto it = std::find(
+          mSkeletons.begin(), mSkeletons.end(), record.mSkeletons[k]);
+      if (it == mSkeletons.end())
+        continue;
+
+      const dynamics::SkeletonPtr& skel = *it;
+      const int offset
+          = static_cast<int>(mOffsets[std::distance(mSkeletons.begin(), it)]);
+      const int numDofs = static_cast<int>(skel->getNumDofs());
+
+      impulseResponses.middleRows(offset, numDofs)
+          = record.mImpulseResponses[k];
+      constraintJacobian.middleCols(offset, numDofs)
+          = (skel->getMassMatrix() * record.mImpulseResponses[k]).transpose();
+    }
+
+    // Sort the rows into the active set. Friction rows are bounded by the
+    // impulse of their normal row.
+    std::vector<int> activeIndices(static_cast<std::size_t>(m), -1);
+    std::vector<int> activeRows;
+    for (int i = 0; i < m; ++i)
+    {
+      double lo = record.mLo[i];
+      double hi = record.mHi[i];
+      const int normal = record.mFIndex[i];
+      if (normal >= 0)
+      {
+        hi = std::abs(record.mHi[i] * x[normal]);
+        lo = -hi;
+      }
+
+      const double tolerance = 1e-9 * (1.0 + std::abs(x[i]));
+      if (x[i] > lo + tolerance && x[i] < hi - tolerance)
+      {
+        activeIndices[static_cast<std::size_t>(i)]
+            = static_cast<int>(activeRows.size());
+        activeRows.push_back(i);
+      }
+    }
+
+    const int c = static_cast<int>(activeRows.size());
+    if (c == 0)
+      continue;
+
+    // With lambda_B = E * lambda_C for the friction rows at their bound,
+    //   Dc = D_C + D_B * E
+    //   K  = A_CC + A_CB * E
+    Eigen::MatrixXd activeResponses(n, c);
+    Eigen::MatrixXd activeMatrix(c, c);
+    Eigen::MatrixXd activeJacobian(c, n);
+    for (int a = 0; a < c; ++a)
+    {
+      const int i = activeRows[static_cast<std::size_t>(a)];
+      activeResponses.col(a) = impulseResponses.col(i);
+      activeJacobian.row(a) = constraintJacobian.row(i);
+      for (int b = 0; b < c; ++b)
+      {
+        activeMatrix(b, a)
+            = record.mA(activeRows[static_cast<std::size_t>(b)], i);
+      }
+    }
+
+    for (int i = 0; i < m; ++i)
+    {
+      const int normal = record.mFIndex[i];
+      if (activeIndices[static_cast<std::size_t>(i)] >= 0 || normal < 0)
+        continue;
+
+      const int a = activeIndices[static_cast<std::size_t>(normal)];
+      if (a < 0 || x[normal] <= 0.0)
+        continue;
+
+      const double ratio = x[i] / x[normal];
+      activeResponses.col(a) += ratio * impulseResponses.col(i);
+      for (int b = 0; b < c; ++b)
+      {
+        activeMatrix(b, a)
+            += ratio * record.mA(activeRows[static_cast<std::size_t>(b)], i);
+      }
+    }
+
+    // Rows whose constraint Jacobian vanishes, like the out-of-plane row of a
+    // ball joint constraint on a planar chain, make the matrix singular, so
+    // take the minimum norm solution
+    responses.push_back(activeResponses);
+    gains.push_back(
+        activeMatrix.completeOrthogonalDecomposition().solve(activeJacobian));
+    numActive += c;
+  }
+
+  mImpulseResponses.resize(n, numActive);
+  mImpulseGains.resize(numActive, n);
+  int index = 0;
+  for (std::size_t g = 0u; g < responses.size(); ++g)
+  {
+    const int c = static_cast<int>(responses[g].cols());
+    mImpulseResponses.middleCols(index, c) = responses[g];
+    mImpulseGains.middleRows(index, c) = gains[g];
+    index += c;
+  }
+}
+
+//==============================================================================
+void StepDerivatives::linearizePositions()
+{
+  const int n = static_cast<int>(mNumDofs);
+  mPositionWrtPositions.setZero(n, n);
+  mPositionWrtVelocities.setZero(n, n);
+
+  for (std::size_t k = 0u; k < mSkeletons.size(); ++k)
+  {
+    const dynamics::Skeleton* skel = mSkeletons[k].get();
+    const int offset = static_cast<int>(mOffsets[k]);
+
+    for (std::size_t i = 0u; i < skel->getNumJoints(); ++i)
+    {
+      const dynamics::Joint* joint = skel->getJoint(i);
+      const int numDofs = static_cast<int>(joint->getNumDofs());
+      if (numDofs == 0)
+        continue;
+
+      const int index
+          = offset + static_cast<int>(joint->getIndexInSkeleton(0u));
+      differentiateIntegration(
+          joint,
+          mPositions.segment(index, numDofs),
+          joint->getVelocities(),
+          mTimeStep,
+          mPositionWrtPositions.block(index, index, numDofs, numDofs),
+          mPositionWrtVelocities.block(index, index, numDofs, numDofs));
+    }
+  }
+}
+
+} // namespace simulation
+} // namespace dart
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_SIMULATION_STEPDERIVATIVES_HPP_
+#define DART_SIMULATION_STEPDERIVATIVES_HPP_
+
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include "dart/dynamics/SmartPointer.hpp"
+
+namespace dart {
+
+namespace constraint {
+class BoxedLcpConstraintSolver;
+} // namespace constraint
+
+namespace simulation {
+
+class World;
+
+/// StepDerivatives linearizes the last World::step() around the state before
+/// the step. Let x = [q; dq] stack the positions and the velocities of the
+/// mobile Skeletons, and u stack their generalized forces. A perturbation of
+/// the state and the forces before the step changes the state after the step
+/// by
+///
+///   dx' = getStateJacobian() * dx + getControlJacobian() * du
+///
+/// The constraint impulses are differentiated through the active set of the
+/// boxed LCP that the step solved. Constraint rows whose impulse lies strictly
+/// between its bounds are treated as equality constraints on the constraint
+/// velocity, friction rows at their bound follow the impulse of their normal
+/// row, and the impulses of the other rows are held. The constraint Jacobians
+/// and the error reduction terms of the LCP are held at their values of the
+/// step, so the derivatives neglect how the contact geometry moves with q.
+///
+/// The derivatives of the unconstrained accelerations are analytic. A tangent
+/// pass of the recursive Newton-Euler inverse dynamics gives the derivatives
+/// of the generalized forces with respect to q and dq, which one factorization
+/// of the augmented mass matrix of Skeleton::getAugMassMatrix() turns into the
+/// derivatives of the accelerations. The columns of the inverse of that matrix
+/// are the derivatives with respect to u of the coordinates of FORCE joints.
+/// The relative Jacobians of UniversalJoint, EulerJoint, and PlanarJoint
+/// depend on q, and their derivatives follow from the product of exponentials
+/// that the transforms of these joints are made of.
+///
+/// Limitations:
+/// - The constraint Jacobians are held fixed, as described above, so the
+///   derivatives miss how the contact points and normals move with q, and
+///   they don't anticipate contacts that are made or broken.
+/// - Joint types defined outside of DART are taken to have relative
+///   Jacobians that don't depend on q, and a warning is printed for them.
+/// - SoftBodyNodes are treated as rigid.
+class StepDerivatives
+{
+public:
+  /// Constructor
+  StepDerivatives();
+
+  /// Get the Skeletons whose coordinates x and u stack, in order
+  const std::vector<dynamics::SkeletonPtr>& getSkeletons() const;
+
+  /// Get the number of generalized coordinates of the Skeletons, which is the
+  /// size of u and half the size of x
+  std::size_t getNumDofs() const;
+
+  /// Get the number of constraint rows treated as equality constraints
+  std::size_t getNumActiveConstraints() const;
+
+  /// Get the dense Jacobian of x' with respect to x
+  Eigen::MatrixXd getStateJacobian() const;
+
+  /// Get the dense Jacobian of x' with respect to u
+  Eigen::MatrixXd getControlJacobian() const;
+
+  /// Compute the change of x' for the changes _dx of x and _du of u without
+  /// forming the dense Jacobians
+  Eigen::VectorXd computeJvp(
+      const Eigen::VectorXd& _dx, const Eigen::VectorXd& _du) const;
+
+  /// Pull the gradient _gradient of a scalar with respect to x' back to the
+  /// gradients with respect to x and u without forming the dense Jacobians
+  void computeVjp(
+      const Eigen::VectorXd& _gradient,
+      Eigen::VectorXd& _stateGradient,
+      Eigen::VectorXd& _controlGradient) const;
+
+protected:
+  friend class World;
+
+  /// Linearize the unconstrained velocity update of the mobile Skeletons among
+  /// _skeletons at their current state. World::step() calls this after it
+  /// computes the forward dynamics and before it integrates the velocities.
+  void linearizeVelocities(
+      const std::vector<dynamics::SkeletonPtr>& _skeletons, double _timeStep);
+
+  /// Linearize the constraint impulses from the LCPs that _solver recorded.
+  /// World::step() calls this right after solving the constraints, while the
+  /// Skeletons are still at the positions before the step. A nullptr _solver
+  /// means that no constraint impulse is applied.
+  void linearizeImpulses(const constraint::BoxedLcpConstraintSolver* _solver);
+
+  /// Linearize the position update. World::step() calls this after
+  /// integrating the positions.
+  void linearizePositions();
+
+  /// Skeletons whose coordinates x and u stack
+  std::vector<dynamics::SkeletonPtr> mSkeletons;
+
+  /// Index of the first generalized coordinate of each Skeleton
+  std::vector<std::size_t> mOffsets;
+
+  /// Number of generalized coordinates
+  std::size_t mNumDofs;
+
+  /// Time step of the step
+  double mTimeStep;
+
+  /// Positions before the step
+  Eigen::VectorXd mPositions;
+
+  /// Derivative of the unconstrained velocities after the step with respect to
+  /// the positions before the step
+  Eigen::MatrixXd mVelocityWrtPositions;
+
+  /// Derivative of the unconstrained velocities after the step with respect to
+  /// the velocities before the step
+  Eigen::MatrixXd mVelocityWrtVelocities;
+
+  /// Derivative of the unconstrained velocities after the step with respect to
+  /// the generalized forces
+  Eigen::MatrixXd mVelocityWrtForces;
+
+  /// Velocity changes caused by a unit impulse of each active constraint row,
+  /// including the friction rows that follow it
+  Eigen::MatrixXd mImpulseResponses;
+
+  /// Derivative of the impulses of the active constraint rows with respect to
+  /// the negative unconstrained velocities. The constrained velocities are
+  ///   dq' = (I - mImpulseResponses * mImpulseGains) * dq*
+  Eigen::MatrixXd mImpulseGains;
+
+  /// Derivative of the positions after the step with respect to the positions
+  /// before the step
+  Eigen::MatrixXd mPositionWrtPositions;
+
+  /// Derivative of the positions after the step with respect to the velocities
+  /// after the step
+  Eigen::MatrixXd mPositionWrtVelocities;
+};
+
+} // namespace simulation
+} // namespace dart
+
+#endif // DART_SIMULATION_STEPDERIVATIVES_HPP_
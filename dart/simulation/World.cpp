@@ -38,20 +38,189 @@
 
 #include "dart/simulation/World.hpp"
 
+#include <algorithm>
 #include <iostream>
+#include <set>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
+#include "dart/collision/CollisionFilter.hpp"
 #include "dart/collision/CollisionGroup.hpp"
+#include "dart/collision/CollisionObject.hpp"
 #include "dart/common/Console.hpp"
 #include "dart/constraint/BoxedLcpConstraintSolver.hpp"
 #include "dart/constraint/ConstrainedGroup.hpp"
+#include "dart/dynamics/ShapeNode.hpp"
 #include "dart/dynamics/Skeleton.hpp"
-#include "dart/integration/SemiImplicitEulerIntegrator.hpp"
+#include "dart/integration/Integrator.hpp"
 
 namespace dart {
 namespace simulation {
 
+namespace {
+
+//==============================================================================
+/// The mobile Skeletons of a World as a single IntegrableSystem. The
+/// generalized coordinates of the Skeletons are stacked in order.
+class SkeletonsIntegrableSystem : public integration::IntegrableSystem
+{
+public:
+  /// Constructor
+  SkeletonsIntegrableSystem() : mNumDofs(0u)
+  {
+    // Do nothing
+  }
+
+  /// Collect the mobile Skeletons among _skeletons
+  void setSkeletons(const std::vector<dynamics::SkeletonPtr>& _skeletons)
+  {
+    mSkeletons.clear();
+    mOffsets.clear();
+    mNumDofs = 0u;
+
+    for (const auto& skel : _skeletons)
+    {
+      if (!skel->isMobile())
+        continue;
+
+      mSkeletons.push_back(skel.get());
+      mOffsets.push_back(mNumDofs);
+      mNumDofs += skel->getNumDofs();
+    }
+  }
+
+  // Documentation inherited
+  void setConfigs(const Eigen::VectorXd& _configs) override
+  {
+    for (std::size_t i = 0u; i < mSkeletons.size(); ++i)
+      mSkeletons[i]->setPositions(getSegment(_configs, i));
+  }
+
+  // Documentation inherited
+  void setGenVels(const Eigen::VectorXd& _genVels) override
+  {
+    for (std::size_t i = 0u; i < mSkeletons.size(); ++i)
+      mSkeletons[i]->setVelocities(getSegment(_genVels, i));
+  }
+
+  // Documentation inherited
+  Eigen::VectorXd getConfigs() const override
+  {
+    Eigen::VectorXd configs(mNumDofs);
+    for (std::size_t i = 0u; i < mSkeletons.size(); ++i)
+      getSegment(configs, i) = mSkeletons[i]->getPositions();
+
+    return configs;
+  }
+
+  // Documentation inherited
+  Eigen::VectorXd getGenVels() const override
+  {
+    Eigen::VectorXd genVels(mNumDofs);
+    for (std::size_t i = 0u; i < mSkeletons.size(); ++i)
+      getSegment(genVels, i) = mSkeletons[i]->getVelocities();
+
+    return genVels;
+  }
+
+  // Documentation inherited
+  Eigen::VectorXd evalGenAccs() override
+  {
+    Eigen::VectorXd genAccs(mNumDofs);
+    for (std::size_t i = 0u; i < mSkeletons.size(); ++i)
+    {
+      mSkeletons[i]->computeForwardDynamics();
+      getSegment(genAccs, i) = mSkeletons[i]->getAccelerations();
+    }
+
+    return genAccs;
+  }
+
+  // Documentation inherited
+  void integrateConfigs(const Eigen::VectorXd& _genVels, double _dt) override
+  {
+    // Skeleton::integratePositions() integrates the current velocities, so
+    // swap them temporarily
+    for (std::size_t i = 0u; i < mSkeletons.size(); ++i)
+    {
+      dynamics::Skeleton* skel = mSkeletons[i];
+      const Eigen::VectorXd genVels = skel->getVelocities();
+      skel->setVelocities(getSegment(_genVels, i));
+      skel->integratePositions(_dt);
+      skel->setVelocities(genVels);
+    }
+  }
+
+  // Documentation inherited
+  void integrateGenVels(const Eigen::VectorXd& _genAccs, double _dt) override
+  {
+    for (std::size_t i = 0u; i < mSkeletons.size(); ++i)
+    {
+      mSkeletons[i]->setAccelerations(getSegment(_genAccs, i));
+      mSkeletons[i]->integrateVelocities(_dt);
+    }
+  }
+
+protected:
+  /// Get the segment of _vector that belongs to the _index-th Skeleton
+  template <typename VectorT>
+  auto getSegment(VectorT& _vector, std::size_t _index) const
+      -> decltype(_vector.segment(0, 0))
+  {
+    return _vector.segment(
+        static_cast<int>(mOffsets[_index]),
+        static_cast<int>(mSkeletons[_index]->getNumDofs()));
+  }
+
+  /// Mobile Skeletons
+  std::vector<dynamics::Skeleton*> mSkeletons;
+
+  /// Index of the first generalized coordinate of each Skeleton
+  std::vector<std::size_t> mOffsets;
+
+  /// Total number of generalized coordinates
+  std::size_t mNumDofs;
+};
+
+//==============================================================================
+/// Ignores the pairs of CollisionObjects that don't involve one of a set of
+/// Skeletons
+class SkeletonSubsetCollisionFilter : public collision::CollisionFilter
+{
+public:
+  /// Add a Skeleton to the set
+  void addSkeleton(const dynamics::Skeleton* _skeleton)
+  {
+    mSkeletons.insert(_skeleton);
+  }
+
+  // Documentation inherited
+  bool ignoresCollision(
+      const collision::CollisionObject* _object1,
+      const collision::CollisionObject* _object2) const override
+  {
+    return !contains(_object1) && !contains(_object2);
+  }
+
+protected:
+  /// Return whether _object belongs to one of the Skeletons of the set
+  bool contains(const collision::CollisionObject* _object) const
+  {
+    const dynamics::ShapeNode* shapeNode
+        = _object->getShapeFrame()->asShapeNode();
+    if (!shapeNode)
+      return false;
+
+    return mSkeletons.count(shapeNode->getSkeleton().get()) > 0u;
+  }
+
+  /// Skeletons of the set
+  std::unordered_set<const dynamics::Skeleton*> mSkeletons;
+};
+
+} // namespace
+
 //==============================================================================
 std::shared_ptr<World> World::create(const std::string& name)
 {
@@ -67,6 +236,8 @@ World::World(const std::string& _name)
     mTimeStep(0.001),
     mTime(0.0),
     mFrame(0),
+    mIntegrableSystem(std::make_unique<SkeletonsIntegrableSystem>()),
+    mDifferentiable(false),
     mRecording(new Recording(mSkeletons)),
     onNameChanged(mNameChangedSignal)
 {
@@ -95,6 +266,19 @@ WorldPtr World::clone() const
 
   worldClone->setGravity(mGravity);
   worldClone->setTimeStep(mTimeStep);
+  if (mIntegrator)
+  {
+    std::shared_ptr<integration::Integrator> integratorClone
+        = mIntegrator->clone();
+    if (!integratorClone)
+    {
+      dtwarn << "[World::clone] The Integrator of World [" << mName
+             << "] does not implement clone(), so the clone shares it.\n";
+      integratorClone = mIntegrator;
+    }
+    worldClone->setIntegrator(std::move(integratorClone));
+  }
+  worldClone->setDifferentiable(mDifferentiable);
 
   auto cd = getConstraintSolver()->getCollisionDetector();
   worldClone->getConstraintSolver()->setCollisionDetector(
@@ -103,7 +287,9 @@ WorldPtr World::clone() const
   // Clone and add each Skeleton
   for (std::size_t i = 0; i < mSkeletons.size(); ++i)
   {
-    worldClone->addSkeleton(mSkeletons[i]->cloneSkeleton());
+    dynamics::SkeletonPtr skelClone = mSkeletons[i]->cloneSkeleton();
+    worldClone->addSkeleton(skelClone);
+    worldClone->setNumSubsteps(skelClone, getNumSubstepsAt(i));
   }
 
   // Clone and add each SimpleFrame
@@ -166,19 +352,57 @@ void World::reset()
 //==============================================================================
 void World::step(bool _resetCommand)
 {
+  constraint::BoxedLcpConstraintSolver* lcpSolver = nullptr;
+  const bool differentiate = mDifferentiable && !mIntegrator;
+  if (differentiate)
+  {
+    lcpSolver = dynamic_cast<constraint::BoxedLcpConstraintSolver*>(
+        mConstraintSolver.get());
+    if (lcpSolver)
+    {
+      lcpSolver->setLcpRecording(true);
+      lcpSolver->clearLcpRecords();
+    }
+  }
+
+  // Skeletons with substeps sit out this part of the step as boundaries
+  const bool multiRate = isMultiRate();
+  if (multiRate)
+    beginSubsteps();
+
   // Integrate velocity for unconstrained skeletons
-  for (auto& skel : mSkeletons)
+  if (mIntegrator)
   {
-    if (!skel->isMobile())
-      continue;
+    auto system = static_cast<SkeletonsIntegrableSystem*>(
+        mIntegrableSystem.get());
+    system->setSkeletons(mSkeletons);
+    mIntegrator->integrateVel(system, mTimeStep);
+  }
+  else
+  {
+    for (auto& skel : mSkeletons)
+    {
+      if (skel->isMobile())
+        skel->computeForwardDynamics();
+    }
 
-    skel->computeForwardDynamics();
-    skel->integrateVelocities(mTimeStep);
+    // The derivatives start from the accelerations of the forward dynamics
+    if (differentiate)
+      mStepDerivatives.linearizeVelocities(mSkeletons, mTimeStep);
+
+    for (auto& skel : mSkeletons)
+    {
+      if (skel->isMobile())
+        skel->integrateVelocities(mTimeStep);
+    }
   }
 
   // Detect activated constraints and compute constraint impulses
   mConstraintSolver->solve();
 
+  if (differentiate)
+    mStepDerivatives.linearizeImpulses(lcpSolver);
+
   // Compute velocity changes given constraint impulses
   for (auto& skel : mSkeletons)
   {
@@ -191,10 +415,26 @@ void World::step(bool _resetCommand)
       skel->setImpulseApplied(false);
     }
 
-    skel->integratePositions(mTimeStep);
+    if (!mIntegrator)
+      skel->integratePositions(mTimeStep);
+  }
+
+  if (mIntegrator)
+    mIntegrator->integratePos(mIntegrableSystem.get(), mTimeStep);
 
-    if (_resetCommand)
+  if (differentiate)
+    mStepDerivatives.linearizePositions();
+
+  if (multiRate)
+    stepSubsteps();
+
+  if (_resetCommand)
+  {
+    for (auto& skel : mSkeletons)
     {
+      if (!skel->isMobile())
+        continue;
+
       skel->clearInternalForces();
       skel->clearExternalForces();
       skel->resetCommands();
@@ -205,6 +445,239 @@ void World::step(bool _resetCommand)
   mFrame++;
 }
 
+//==============================================================================
+void World::setNumSubsteps(
+    const dynamics::SkeletonPtr& _skeleton, std::size_t _numSubsteps)
+{
+  if (_numSubsteps == 0u)
+  {
+    dtwarn << "[World::setNumSubsteps] Attempting to set zero substeps. "
+           << "Ignoring this request.\n";
+    return;
+  }
+
+  if (!hasSkeleton(_skeleton))
+  {
+    dtwarn << "[World::setNumSubsteps] Skeleton ["
+           << (_skeleton ? _skeleton->getName() : "nullptr")
+           << "] is not in the world.\n";
+    return;
+  }
+
+  if (_numSubsteps > 1u)
+    mNumSubsteps[_skeleton.get()] = _numSubsteps;
+  else
+    mNumSubsteps.erase(_skeleton.get());
+}
+
+//==============================================================================
+std::size_t World::getNumSubsteps(
+    const dynamics::ConstSkeletonPtr& _skeleton) const
+{
+  if (!hasSkeleton(_skeleton))
+    return 0u;
+
+  const auto it = mNumSubsteps.find(_skeleton.get());
+  return it == mNumSubsteps.end() ? 1u : it->second;
+}
+
+//==============================================================================
+bool World::isMultiRate() const
+{
+  if (mIntegrator || mDifferentiable)
+    return false;
+
+  return !mNumSubsteps.empty();
+}
+
+//==============================================================================
+std::size_t World::getNumSubstepsAt(std::size_t _index) const
+{
+  const auto it = mNumSubsteps.find(mSkeletons[_index].get());
+  return it == mNumSubsteps.end() ? 1u : it->second;
+}
+
+//==============================================================================
+void World::beginSubsteps()
+{
+  mSubstepStartPositions.resize(mSkeletons.size());
+  for (std::size_t i = 0u; i < mSkeletons.size(); ++i)
+  {
+    dynamics::Skeleton* skel = mSkeletons[i].get();
+    if (!skel->isMobile() || skel->getNumDofs() == 0u)
+    {
+      mSubstepStartPositions[i].resize(0);
+      continue;
+    }
+
+    mSubstepStartPositions[i] = skel->getPositions();
+    if (getNumSubstepsAt(i) > 1u)
+      skel->setMobile(false);
+  }
+}
+
+//==============================================================================
+void World::stepSubsteps()
+{
+  // Groups of Skeletons that have the same number of substeps
+  std::set<std::size_t> groups;
+  for (std::size_t i = 0u; i < mSkeletons.size(); ++i)
+  {
+    if (mSubstepStartPositions[i].size() > 0 && getNumSubstepsAt(i) > 1u)
+      groups.insert(getNumSubstepsAt(i));
+  }
+
+  collision::CollisionOption& option = mConstraintSolver->getCollisionOption();
+  const std::shared_ptr<collision::CollisionFilter> filter
+      = option.collisionFilter;
+
+  std::vector<dynamics::Skeleton*> stepped;
+  std::vector<dynamics::Skeleton*> moving;
+  std::vector<Eigen::VectorXd> endPositions;
+  std::vector<Eigen::VectorXd> endVelocities;
+
+  for (std::size_t numSubsteps : groups)
+  {
+    const double timeStep = mTimeStep / static_cast<double>(numSubsteps);
+
+    stepped.clear();
+    moving.clear();
+    endPositions.clear();
+    endVelocities.clear();
+
+    SkeletonSubsetCollisionFilter subsetFilter;
+    for (std::size_t i = 0u; i < mSkeletons.size(); ++i)
+    {
+      const Eigen::VectorXd& startPositions = mSubstepStartPositions[i];
+      if (startPositions.size() == 0)
+        continue;
+
+      dynamics::Skeleton* skel = mSkeletons[i].get();
+      if (getNumSubstepsAt(i) == numSubsteps)
+      {
+        skel->setMobile(true);
+        skel->setTimeStep(timeStep);
+        subsetFilter.addSkeleton(skel);
+        stepped.push_back(skel);
+        continue;
+      }
+
+      skel->setMobile(false);
+      if (getNumSubstepsAt(i) > numSubsteps)
+        continue;
+
+      // This Skeleton has been advanced already, so rewind it and let it move
+      // along its step at constant velocity
+      moving.push_back(skel);
+      endPositions.push_back(skel->getPositions());
+      endVelocities.push_back(skel->getVelocities());
+      skel->setVelocities(
+          skel->getPositionDifferences(endPositions.back(), startPositions)
+          / mTimeStep);
+      skel->setPositions(startPositions);
+    }
+
+    auto compositeFilter
+        = std::make_shared<collision::CompositeCollisionFilter>();
+    if (filter)
+      compositeFilter->addCollisionFilter(filter.get());
+    compositeFilter->addCollisionFilter(&subsetFilter);
+    option.collisionFilter = compositeFilter;
+    mConstraintSolver->setTimeStep(timeStep);
+
+    for (std::size_t k = 0u; k < numSubsteps; ++k)
+    {
+      for (dynamics::Skeleton* skel : stepped)
+      {
+        skel->computeForwardDynamics();
+        skel->integrateVelocities(timeStep);
+      }
+
+      mConstraintSolver->solve();
+
+      for (dynamics::Skeleton* skel : stepped)
+      {
+        if (skel->isImpulseApplied())
+        {
+          skel->computeImpulseForwardDynamics();
+          skel->setImpulseApplied(false);
+        }
+
+        skel->integratePositions(timeStep);
+      }
+
+      for (dynamics::Skeleton* skel : moving)
+        skel->integratePositions(timeStep);
+    }
+
+    for (std::size_t i = 0u; i < moving.size(); ++i)
+    {
+      moving[i]->setPositions(endPositions[i]);
+      moving[i]->setVelocities(endVelocities[i]);
+    }
+
+    for (dynamics::Skeleton* skel : stepped)
+      skel->setTimeStep(mTimeStep);
+  }
+
+  option.collisionFilter = filter;
+  mConstraintSolver->setTimeStep(mTimeStep);
+
+  for (std::size_t i = 0u; i < mSkeletons.size(); ++i)
+  {
+    if (mSubstepStartPositions[i].size() > 0)
+      mSkeletons[i]->setMobile(true);
+  }
+}
+
+//==============================================================================
+void World::setIntegrator(std::shared_ptr<integration::Integrator> _integrator)
+{
+  mIntegrator = std::move(_integrator);
+}
+
+//==============================================================================
+const std::shared_ptr<integration::Integrator>& World::getIntegrator() const
+{
+  return mIntegrator;
+}
+
+//==============================================================================
+void World::setDifferentiable(bool _differentiable)
+{
+  mDifferentiable = _differentiable;
+
+  if (mDifferentiable && mIntegrator)
+  {
+    dtwarn << "[World::setDifferentiable] World [" << getName() << "] uses "
+           << "an integrator, so its steps won't be linearized until the "
+           << "integrator is reset to nullptr.\n";
+  }
+
+  auto lcpSolver = dynamic_cast<constraint::BoxedLcpConstraintSolver*>(
+      mConstraintSolver.get());
+  if (!mDifferentiable && lcpSolver)
+    lcpSolver->setLcpRecording(false);
+}
+
+//==============================================================================
+bool World::isDifferentiable() const
+{
+  return mDifferentiable;
+}
+
+//==============================================================================
+const StepDerivatives& World::getStepDerivatives() const
+{
+  return mStepDerivatives;
+}
+
+//==============================================================================
+StepDerivatives& World::getStepDerivatives()
+{
+  return mStepDerivatives;
+}
+
 //==============================================================================
 void World::setTime(double _time)
 {
@@ -295,35 +768,79 @@ std::string World::addSkeleton(const dynamics::SkeletonPtr& _skeleton)
     return "";
   }
 
-  // If mSkeletons already has _skeleton, then we do nothing.
-  if (find(mSkeletons.begin(), mSkeletons.end(), _skeleton) != mSkeletons.end())
+  if (addSkeletonEntry(_skeleton))
+  {
+    mConstraintSolver->addSkeleton(_skeleton);
+
+    // Update recording
+    mRecording->updateNumGenCoords(mSkeletons);
+  }
+
+  return _skeleton->getName();
+}
+
+//==============================================================================
+std::vector<std::string> World::addSkeletons(
+    const std::vector<dynamics::SkeletonPtr>& skeletons)
+{
+  std::vector<std::string> names;
+  names.reserve(skeletons.size());
+
+  std::vector<dynamics::SkeletonPtr> added;
+  added.reserve(skeletons.size());
+
+  for (const auto& skeleton : skeletons)
+  {
+    if (nullptr == skeleton)
+    {
+      dtwarn << "[World::addSkeletons] Attempting to add a nullptr Skeleton to "
+             << "the world!\n";
+      names.emplace_back();
+      continue;
+    }
+
+    if (addSkeletonEntry(skeleton))
+      added.push_back(skeleton);
+
+    names.push_back(skeleton->getName());
+  }
+
+  mConstraintSolver->addSkeletons(added);
+
+  // Update recording
+  mRecording->updateNumGenCoords(mSkeletons);
+
+  return names;
+}
+
+//==============================================================================
+bool World::addSkeletonEntry(const dynamics::SkeletonPtr& skeleton)
+{
+  // If mSkeletons already has the skeleton, then we do nothing.
+  if (mMapForSkeletons.find(skeleton) != mMapForSkeletons.end())
   {
-    dtwarn << "[World::addSkeleton] Skeleton named [" << _skeleton->getName()
+    dtwarn << "[World::addSkeleton] Skeleton named [" << skeleton->getName()
            << "] is already in the world." << std::endl;
-    return _skeleton->getName();
+    return false;
   }
 
-  mSkeletons.push_back(_skeleton);
-  mMapForSkeletons[_skeleton] = _skeleton;
+  mSkeletons.push_back(skeleton);
+  mMapForSkeletons[skeleton] = skeleton;
 
-  mNameConnectionsForSkeletons.push_back(_skeleton->onNameChanged.connect(
+  mNameConnectionsForSkeletons.push_back(skeleton->onNameChanged.connect(
       [=](dynamics::ConstMetaSkeletonPtr skel,
           const std::string&,
           const std::string&) { this->handleSkeletonNameChange(skel); }));
 
-  _skeleton->setName(
-      mNameMgrForSkeletons.issueNewNameAndAdd(_skeleton->getName(), _skeleton));
-
-  _skeleton->setTimeStep(mTimeStep);
-  _skeleton->setGravity(mGravity);
+  skeleton->setName(
+      mNameMgrForSkeletons.issueNewNameAndAdd(skeleton->getName(), skeleton));
 
-  mIndices.push_back(mIndices.back() + _skeleton->getNumDofs());
-  mConstraintSolver->addSkeleton(_skeleton);
+  skeleton->setTimeStep(mTimeStep);
+  skeleton->setGravity(mGravity);
 
-  // Update recording
-  mRecording->updateNumGenCoords(mSkeletons);
+  mIndices.push_back(mIndices.back() + skeleton->getNumDofs());
 
-  return _skeleton->getName();
+  return true;
 }
 
 //==============================================================================
@@ -333,70 +850,87 @@ void World::removeSkeleton(const dynamics::SkeletonPtr& _skeleton)
       _skeleton != nullptr
       && "Attempted to remove nullptr Skeleton from world");
 
-  if (nullptr == _skeleton)
-  {
-    dtwarn << "[World::removeSkeleton] Attempting to remove a nullptr Skeleton "
-           << "from the world!\n";
-    return;
-  }
+  removeSkeletons({_skeleton});
+}
 
-  // Find index of _skeleton in mSkeleton.
-  std::size_t index = 0;
-  for (; index < mSkeletons.size(); ++index)
+//==============================================================================
+void World::removeSkeletons(const std::vector<dynamics::SkeletonPtr>& skeletons)
+{
+  std::unordered_set<const dynamics::Skeleton*> toRemove;
+  std::vector<dynamics::SkeletonPtr> removed;
+  removed.reserve(skeletons.size());
+
+  for (const auto& skeleton : skeletons)
   {
-    if (mSkeletons[index] == _skeleton)
-      break;
+    if (nullptr == skeleton)
+    {
+      dtwarn << "[World::removeSkeleton] Attempting to remove a nullptr "
+             << "Skeleton from the world!\n";
+      continue;
+    }
+
+    // If the skeleton is not in mSkeletons, we do nothing.
+    if (mMapForSkeletons.find(skeleton) == mMapForSkeletons.end())
+    {
+      dtwarn << "[World::removeSkeleton] Skeleton [" << skeleton->getName()
+             << "] is not in the world.\n";
+      continue;
+    }
+
+    if (toRemove.insert(skeleton.get()).second)
+      removed.push_back(skeleton);
   }
 
-  // If i is equal to the number of skeletons, then _skeleton is not in
-  // mSkeleton. We do nothing.
-  if (index == mSkeletons.size())
-  {
-    dtwarn << "[World::removeSkeleton] Skeleton [" << _skeleton->getName()
-           << "] is not in the world.\n";
+  if (removed.empty())
     return;
-  }
 
-  // Update mIndices.
-  for (std::size_t i = index + 1; i < mSkeletons.size() - 1; ++i)
-    mIndices[i] = mIndices[i + 1] - _skeleton->getNumDofs();
-  mIndices.pop_back();
+  // Remove the skeletons from constraint handler.
+  mConstraintSolver->removeSkeletons(removed);
 
-  // Remove _skeleton from constraint handler.
-  mConstraintSolver->removeSkeleton(_skeleton);
+  // Compact the containers that run parallel to mSkeletons, and rebuild
+  // mIndices from the remaining skeletons.
+  mIndices.resize(1u);
+  std::size_t numKept = 0u;
+  for (std::size_t i = 0u; i < mSkeletons.size(); ++i)
+  {
+    const dynamics::SkeletonPtr& skeleton = mSkeletons[i];
+    if (toRemove.count(skeleton.get()) > 0u)
+    {
+      // Disconnect the name change monitor
+      mNameConnectionsForSkeletons[i].disconnect();
 
-  // Remove _skeleton from mSkeletons
-  mSkeletons.erase(
-      remove(mSkeletons.begin(), mSkeletons.end(), _skeleton),
-      mSkeletons.end());
+      // Remove from NameManager
+      mNameMgrForSkeletons.removeName(skeleton->getName());
 
-  // Disconnect the name change monitor
-  mNameConnectionsForSkeletons[index].disconnect();
-  mNameConnectionsForSkeletons.erase(
-      mNameConnectionsForSkeletons.begin() + index);
+      // Remove from the pointer map
+      mMapForSkeletons.erase(skeleton);
+      mNumSubsteps.erase(skeleton.get());
+      continue;
+    }
 
-  // Update recording
-  mRecording->updateNumGenCoords(mSkeletons);
+    mIndices.push_back(mIndices.back() + skeleton->getNumDofs());
+    if (numKept != i)
+    {
+      mSkeletons[numKept] = std::move(mSkeletons[i]);
+      mNameConnectionsForSkeletons[numKept]
+          = std::move(mNameConnectionsForSkeletons[i]);
+    }
+    ++numKept;
+  }
 
-  // Remove from NameManager
-  mNameMgrForSkeletons.removeName(_skeleton->getName());
+  mSkeletons.resize(numKept);
+  mNameConnectionsForSkeletons.resize(numKept);
 
-  // Remove from the pointer map
-  mMapForSkeletons.erase(_skeleton);
+  // Update recording
+  mRecording->updateNumGenCoords(mSkeletons);
 }
 
 //==============================================================================
 std::set<dynamics::SkeletonPtr> World::removeAllSkeletons()
 {
-  std::set<dynamics::SkeletonPtr> ptrs;
-  for (std::vector<dynamics::SkeletonPtr>::iterator it = mSkeletons.begin(),
-                                                    end = mSkeletons.end();
-       it != end;
-       ++it)
-    ptrs.insert(*it);
+  std::set<dynamics::SkeletonPtr> ptrs(mSkeletons.begin(), mSkeletons.end());
 
-  while (getNumSkeletons() > 0)
-    removeSkeleton(getSkeleton(0));
+  removeSkeletons(std::vector<dynamics::SkeletonPtr>(mSkeletons));
 
   return ptrs;
 }
@@ -404,8 +938,7 @@ std::set<dynamics::SkeletonPtr> World::removeAllSkeletons()
 //==============================================================================
 bool World::hasSkeleton(const dynamics::ConstSkeletonPtr& skeleton) const
 {
-  return std::find(mSkeletons.begin(), mSkeletons.end(), skeleton)
-         != mSkeletons.end();
+  return mMapForSkeletons.find(skeleton) != mMapForSkeletons.end();
 }
 
 //==============================================================================
@@ -41,6 +41,7 @@
 
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <Eigen/Dense>
@@ -55,10 +56,12 @@
 #include "dart/dynamics/Skeleton.hpp"
 #include "dart/simulation/Recording.hpp"
 #include "dart/simulation/SmartPointer.hpp"
+#include "dart/simulation/StepDerivatives.hpp"
 
 namespace dart {
 
 namespace integration {
+class IntegrableSystem;
 class Integrator;
 } // namespace integration
 
@@ -146,9 +149,20 @@ public:
   /// Add a skeleton to this world
   std::string addSkeleton(const dynamics::SkeletonPtr& _skeleton);
 
+  /// Add several skeletons to this world. This is equivalent to calling
+  /// addSkeleton() on each of them, but the constraint solver and its
+  /// collision group register them as one batch. Returns the names that the
+  /// skeletons were given, or an empty string for nullptr entries.
+  std::vector<std::string> addSkeletons(
+      const std::vector<dynamics::SkeletonPtr>& skeletons);
+
   /// Remove a skeleton from this world
   void removeSkeleton(const dynamics::SkeletonPtr& _skeleton);
 
+  /// Remove several skeletons from this world in a single pass over the
+  /// skeletons of this world
+  void removeSkeletons(const std::vector<dynamics::SkeletonPtr>& skeletons);
+
   /// Remove all the skeletons in this world, and return a set of shared
   /// pointers to them, in case you want to recycle them
   std::set<dynamics::SkeletonPtr> removeAllSkeletons();
@@ -217,6 +231,71 @@ public:
   /// command after simulation step.
   void step(bool _resetCommand = true);
 
+  /// Set the number of substeps that _skeleton takes within each step(). A
+  /// Skeleton with more than one substep sits out the World step as an
+  /// immobile boundary and is then advanced on its own, together with the
+  /// other Skeletons that have the same number of substeps, at
+  /// getTimeStep() / _numSubsteps. Groups are advanced in increasing order of
+  /// substeps. During the substeps of a group, the mobile Skeletons that have
+  /// already been advanced move from their start to their end positions of
+  /// the step at constant velocity, and the others keep their state. Only the
+  /// contacts that involve the advanced group are checked, so
+  /// getLastCollisionResult() holds the contacts of the last substep.
+  ///
+  /// Contacts between Skeletons of different groups are not solved as
+  /// contacts between two moving bodies. Each group sees the Skeletons of the
+  /// other groups as immobile boundaries or as bodies that follow a
+  /// prescribed motion, both of infinite mass, so momentum is not conserved
+  /// across groups. Skeletons that push each other should take the same
+  /// number of substeps.
+  ///
+  /// Substeps are not used while an integrator is set by setIntegrator() or
+  /// while this World is differentiable.
+  void setNumSubsteps(
+      const dynamics::SkeletonPtr& _skeleton, std::size_t _numSubsteps);
+
+  /// Get the number of substeps that _skeleton takes within each step(), or 0
+  /// if _skeleton is not in this World
+  std::size_t getNumSubsteps(const dynamics::ConstSkeletonPtr& _skeleton) const;
+
+  /// Set the integrator used by step(), or nullptr to use the default
+  /// semi-implicit Euler scheme of Skeleton::integrateVelocities() and
+  /// Skeleton::integratePositions().
+  ///
+  /// step() treats all the mobile Skeletons as one system: it calls
+  /// Integrator::integrateVel(), applies the constraint impulses to the
+  /// resulting velocities, and then calls Integrator::integratePos().
+  ///
+  /// clone() gives the cloned World a copy made by Integrator::clone(), since
+  /// integrators keep data between integrateVel() and integratePos().
+  void setIntegrator(std::shared_ptr<integration::Integrator> _integrator);
+
+  /// Get the integrator used by step(), or nullptr for the default scheme
+  const std::shared_ptr<integration::Integrator>& getIntegrator() const;
+
+  /// Set whether step() linearizes itself into getStepDerivatives(). The
+  /// constraint impulses are differentiated when the constraint solver is a
+  /// constraint::BoxedLcpConstraintSolver, which then records its LCPs.
+  /// Steps taken with an integrator set by setIntegrator() are not
+  /// linearized, and Skeletons advanced in substeps by setNumSubsteps() are
+  /// left out of the derivatives.
+  ///
+  /// The derivatives hold the contact Jacobians fixed, so they miss how
+  /// contact points and normals move with the positions, and they treat
+  /// SoftBodyNodes as rigid. See StepDerivatives for the details.
+  void setDifferentiable(bool _differentiable);
+
+  /// Return whether step() linearizes itself into getStepDerivatives()
+  bool isDifferentiable() const;
+
+  /// Get the derivatives of the last step() taken while this World was
+  /// differentiable
+  const StepDerivatives& getStepDerivatives() const;
+
+  /// Get the derivatives of the last step() taken while this World was
+  /// differentiable
+  StepDerivatives& getStepDerivatives();
+
   /// Set current time
   void setTime(double _time);
 
@@ -259,6 +338,25 @@ protected:
   /// Register when a SimpleFrame's name is changed
   void handleSimpleFrameNameChange(const dynamics::Entity* _entity);
 
+  /// Return whether step() advances some Skeletons with substeps
+  bool isMultiRate() const;
+
+  /// Get the number of substeps of the Skeleton at _index in mSkeletons
+  std::size_t getNumSubstepsAt(std::size_t _index) const;
+
+  /// Record the positions of the mobile Skeletons at the start of step(), and
+  /// make the ones that have substeps immobile for the World step
+  void beginSubsteps();
+
+  /// Advance the Skeletons that have substeps after the World step, and make
+  /// them mobile again
+  void stepSubsteps();
+
+  /// Add a Skeleton to the containers of this World, except the constraint
+  /// solver and the recording. Returns false if the Skeleton was already in
+  /// this World.
+  bool addSkeletonEntry(const dynamics::SkeletonPtr& skeleton);
+
   /// Name of this World
   std::string mName;
 
@@ -295,6 +393,14 @@ protected:
   /// 6, 1 and 2 then the mIndices goes like this: [0 6 7].
   std::vector<int> mIndices;
 
+  /// Number of substeps within a step of each skeleton that takes more than
+  /// one
+  std::unordered_map<const dynamics::Skeleton*, std::size_t> mNumSubsteps;
+
+  /// Positions of each skeleton at the start of a multi-rate step, or an empty
+  /// vector if the skeleton doesn't move during the step
+  std::vector<Eigen::VectorXd> mSubstepStartPositions;
+
   /// Gravity
   Eigen::Vector3d mGravity;
 
@@ -307,6 +413,18 @@ protected:
   /// Current simulation frame number
   int mFrame;
 
+  /// Integrator used by step(), or nullptr for the default scheme
+  std::shared_ptr<integration::Integrator> mIntegrator;
+
+  /// The mobile Skeletons as a system for mIntegrator
+  std::unique_ptr<integration::IntegrableSystem> mIntegrableSystem;
+
+  /// Whether step() linearizes itself into mStepDerivatives
+  bool mDifferentiable;
+
+  /// Derivatives of the last differentiable step
+  StepDerivatives mStepDerivatives;
+
   /// Constraint solver
   std::unique_ptr<constraint::ConstraintSolver> mConstraintSolver;
 
@@ -685,6 +685,61 @@ void Shape(py::module& m)
             return dart::dynamics::PlaneShape::getStaticType();
           },
           ::py::return_value_policy::reference_internal);
+
+  ::py::class_<
+      dart::dynamics::SdfShape,
+      dart::dynamics::Shape,
+      std::shared_ptr<dart::dynamics::SdfShape>>(m, "SdfShape")
+      .def(
+          ::py::init<
+              const Eigen::Vector3d&,
+              double,
+              const Eigen::Vector3i&,
+              std::vector<double>>(),
+          ::py::arg("origin"),
+          ::py::arg("voxelSize"),
+          ::py::arg("dimensions"),
+          ::py::arg("values"))
+      .def(
+          ::py::init<const dart::dynamics::MeshShape&, double, double>(),
+          ::py::arg("mesh"),
+          ::py::arg("voxelSize"),
+          ::py::arg("padding") = 0.0)
+      .def(
+          "getType",
+          +[](const dart::dynamics::SdfShape* self) -> const std::string& {
+            return self->getType();
+          },
+          ::py::return_value_policy::reference_internal)
+      .def(
+          "getOrigin",
+          +[](const dart::dynamics::SdfShape* self) -> Eigen::Vector3d {
+            return self->getOrigin();
+          })
+      .def(
+          "getVoxelSize",
+          +[](const dart::dynamics::SdfShape* self) -> double {
+            return self->getVoxelSize();
+          })
+      .def(
+          "getDimensions",
+          +[](const dart::dynamics::SdfShape* self) -> Eigen::Vector3i {
+            return self->getDimensions();
+          })
+      .def(
+          "getSignedDistance",
+          +[](const dart::dynamics::SdfShape* self,
+              const Eigen::Vector3d& point) -> double {
+            return self->getSignedDistance(point);
+          },
+          ::py::arg("point"))
+      .def_static(
+          "getStaticType",
+          +[]() -> const std::string& {
+            return dart::dynamics::SdfShape::getStaticType();
+          },
+          ::py::return_value_policy::reference_internal);
+
   ::py::class_<
       dart::dynamics::PointCloudShape,
       dart::dynamics::Shape,
@@ -267,6 +267,17 @@ void ShapeFrame(py::module& m)
           "isCollidable",
           +[](const dart::dynamics::CollisionAspect* self) -> bool {
             return self->isCollidable();
+          })
+      .def(
+          "setContinuous",
+          +[](dart::dynamics::CollisionAspect* self, const bool& value) {
+            self->setContinuous(value);
+          },
+          ::py::arg("value"))
+      .def(
+          "getContinuous",
+          +[](const dart::dynamics::CollisionAspect* self) -> bool {
+            return self->getContinuous();
           });
 
   ::py::class_<dart::dynamics::DynamicsAspect>(m, "DynamicsAspect")
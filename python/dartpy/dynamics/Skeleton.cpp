@@ -718,6 +718,29 @@ void Skeleton(py::module& m)
           ::py::arg("withExternalForces"),
           ::py::arg("withDampingForces"),
           ::py::arg("withSpringForces"))
+      .def(
+          "computeInverseDynamics",
+          +[](const dart::dynamics::Skeleton* self,
+              const Eigen::MatrixXd& positions,
+              const Eigen::MatrixXd& velocities,
+              const Eigen::MatrixXd& accelerations,
+              bool withExternalForces,
+              bool withDampingForces,
+              bool withSpringForces) -> Eigen::MatrixXd {
+            return self->computeInverseDynamics(
+                positions,
+                velocities,
+                accelerations,
+                withExternalForces,
+                withDampingForces,
+                withSpringForces);
+          },
+          ::py::arg("positions"),
+          ::py::arg("velocities"),
+          ::py::arg("accelerations"),
+          ::py::arg("withExternalForces") = false,
+          ::py::arg("withDampingForces") = false,
+          ::py::arg("withSpringForces") = false)
       .def(
           "clearConstraintImpulses",
           +[](dart::dynamics::Skeleton* self) -> void {
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <dart/dart.hpp>
+#include <dart/simulation/StepDerivatives.hpp>
+
+#include <pybind11/eigen.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+namespace dart {
+namespace python {
+
+void StepDerivatives(py::module& m)
+{
+  ::py::class_<dart::simulation::StepDerivatives>(m, "StepDerivatives")
+      .def(
+          "getSkeletons",
+          +[](const dart::simulation::StepDerivatives* self)
+              -> std::vector<dart::dynamics::SkeletonPtr> {
+            return self->getSkeletons();
+          })
+      .def(
+          "getNumDofs",
+          +[](const dart::simulation::StepDerivatives* self) -> std::size_t {
+            return self->getNumDofs();
+          })
+      .def(
+          "getNumActiveConstraints",
+          +[](const dart::simulation::StepDerivatives* self) -> std::size_t {
+            return self->getNumActiveConstraints();
+          })
+      .def(
+          "getStateJacobian",
+          +[](const dart::simulation::StepDerivatives* self)
+              -> Eigen::MatrixXd { return self->getStateJacobian(); })
+      .def(
+          "getControlJacobian",
+          +[](const dart::simulation::StepDerivatives* self)
+              -> Eigen::MatrixXd { return self->getControlJacobian(); })
+      .def(
+          "computeJvp",
+          +[](const dart::simulation::StepDerivatives* self,
+              const Eigen::VectorXd& dx,
+              const Eigen::VectorXd& du) -> Eigen::VectorXd {
+            return self->computeJvp(dx, du);
+          },
+          ::py::arg("dx"),
+          ::py::arg("du"))
+      .def(
+          "computeVjp",
+          +[](const dart::simulation::StepDerivatives* self,
+              const Eigen::VectorXd& gradient) -> ::py::tuple {
+            Eigen::VectorXd stateGradient;
+            Eigen::VectorXd controlGradient;
+            self->computeVjp(gradient, stateGradient, controlGradient);
+            return ::py::make_tuple(stateGradient, controlGradient);
+          },
+          ::py::arg("gradient"));
+}
+
+} // namespace python
+} // namespace dart
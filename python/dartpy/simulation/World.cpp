@@ -227,6 +227,24 @@ void World(py::module& m)
             return self->step(_resetCommand);
           },
           ::py::arg("resetCommand"))
+      .def(
+          "setDifferentiable",
+          +[](dart::simulation::World* self, bool differentiable) -> void {
+            self->setDifferentiable(differentiable);
+          },
+          ::py::arg("differentiable"))
+      .def(
+          "isDifferentiable",
+          +[](const dart::simulation::World* self) -> bool {
+            return self->isDifferentiable();
+          })
+      .def(
+          "getStepDerivatives",
+          +[](dart::simulation::World* self)
+              -> dart::simulation::StepDerivatives& {
+            return self->getStepDerivatives();
+          },
+          ::py::return_value_policy::reference_internal)
       .def(
           "setTime",
           +[](dart::simulation::World* self, double _time) -> void {
@@ -37,12 +37,14 @@ namespace py = pybind11;
 namespace dart {
 namespace python {
 
+void StepDerivatives(py::module& sm);
 void World(py::module& sm);
 
 void dart_simulation(py::module& m)
 {
   auto sm = m.def_submodule("simulation");
 
+  StepDerivatives(sm);
   World(sm);
 }
 
@@ -18,5 +18,26 @@ def test_basic():
     assert skel.getBodyNodes()[0].getName() == body1.getName()
 
 
+def test_trajectory_inverse_dynamics():
+    skel = dart.dynamics.Skeleton()
+    _, body0 = skel.createRevoluteJointAndBodyNodePair()
+    skel.createBallJointAndBodyNodePair(body0)
+    dofs = skel.getNumDofs()
+
+    num_samples = 5
+    q = np.random.uniform(-1.0, 1.0, (dofs, num_samples))
+    dq = np.random.uniform(-1.0, 1.0, (dofs, num_samples))
+    ddq = np.random.uniform(-1.0, 1.0, (dofs, num_samples))
+    forces = skel.computeInverseDynamics(q, dq, ddq)
+    assert forces.shape == (dofs, num_samples)
+
+    for i in range(num_samples):
+        skel.setPositions(q[:, i])
+        skel.setVelocities(dq[:, i])
+        skel.setAccelerations(ddq[:, i])
+        skel.computeInverseDynamics()
+        assert np.allclose(skel.getForces(), forces[:, i])
+
+
 if __name__ == "__main__":
     pytest.main()
@@ -1,5 +1,6 @@
 import platform
 import pytest
+import numpy as np
 import dartpy as dart
 
 
@@ -28,5 +29,34 @@ def test_collision_detector_change():
         assert solver.getCollisionDetector().getType() == dart.collision.OdeCollisionDetector().getStaticType()
 
 
+def test_step_derivatives():
+    world = dart.simulation.World('world')
+    skel = dart.dynamics.Skeleton()
+    _, body0 = skel.createRevoluteJointAndBodyNodePair()
+    skel.createRevoluteJointAndBodyNodePair(body0)
+    world.addSkeleton(skel)
+
+    assert not world.isDifferentiable()
+    world.setDifferentiable(True)
+    assert world.isDifferentiable()
+    world.step()
+
+    derivatives = world.getStepDerivatives()
+    assert derivatives.getNumDofs() == 2
+    A = derivatives.getStateJacobian()
+    B = derivatives.getControlJacobian()
+    assert A.shape == (4, 4)
+    assert B.shape == (4, 2)
+
+    dx = np.array([0.1, -0.2, 0.3, 0.4])
+    du = np.array([1.0, -1.0])
+    assert np.allclose(derivatives.computeJvp(dx, du), A.dot(dx) + B.dot(du))
+
+    g = np.array([1.0, 2.0, 3.0, 4.0])
+    stateGradient, controlGradient = derivatives.computeVjp(g)
+    assert np.allclose(stateGradient, A.T.dot(g))
+    assert np.allclose(controlGradient, B.T.dot(g))
+
+
 if __name__ == "__main__":
     pytest.main()
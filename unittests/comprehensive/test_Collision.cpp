@@ -796,8 +796,8 @@ TEST_F(Collision, testCylinderCylinder)
   testCylinderCylinder(bullet);
 #endif
 
-  // auto dart = DARTCollisionDetector::create();
-  // testCylinderCylinder(dart);
+  auto dart = DARTCollisionDetector::create();
+  testCylinderCylinder(dart);
 }
 
 //==============================================================================
@@ -867,8 +867,8 @@ TEST_F(Collision, testConeCone)
   testCylinderCylinder(bullet);
 #endif
 
-  // auto dart = DARTCollisionDetector::create();
-  // testCylinderCylinder(dart);
+  auto dart = DARTCollisionDetector::create();
+  testConeCone(dart);
 }
 
 //==============================================================================
@@ -938,8 +938,8 @@ TEST_F(Collision, testCapsuleCapsule)
   testCapsuleCapsule(bullet);
 #endif
 
-  // auto dart = DARTCollisionDetector::create();
-  // testCapsuleCapsule(dart);
+  auto dart = DARTCollisionDetector::create();
+  testCapsuleCapsule(dart);
 }
 
 //==============================================================================
@@ -985,6 +985,9 @@ TEST_F(Collision, testPlane)
   auto ode = OdeCollisionDetector::create();
   testPlane(ode);
 #endif
+
+  auto dart = DARTCollisionDetector::create();
+  testPlane(dart);
 }
 
 //==============================================================================
@@ -1167,6 +1170,10 @@ void testHeightmapBox(
 //==============================================================================
 TEST_F(Collision, testHeightmapBox)
 {
+  auto dart = DARTCollisionDetector::create();
+  testHeightmapBox<float>(dart.get(), true, false);
+  testHeightmapBox<double>(dart.get(), true, false);
+
 #if HAVE_ODE
   auto ode = OdeCollisionDetector::create();
   // TODO take this message out as soon as testing is done
@@ -1272,6 +1279,103 @@ TEST_F(Collision, testHeightmapFlipY)
   EXPECT_EQ(shape->getHeightField().data()[0], heights8[0]);
 }
 
+//==============================================================================
+TEST_F(Collision, DARTHeightmap)
+{
+  // Large flat terrain with a single spike, 0.1 apart in x and y
+  const std::size_t size = 201u;
+  std::vector<float> heights(size * size, 0.0f);
+  heights[50 * size + 150] = 2.0f;
+  auto terrain = std::make_shared<HeightmapShapef>();
+  terrain->setHeightField(size, size, heights);
+  terrain->setScale(Eigen::Vector3f(0.1f, 0.1f, 1.0f));
+
+  // 200 x 200 cells make 25 x 25 tiles of 8 x 8 cells at the finest level
+  ASSERT_EQ(terrain->getNumPyramidLevels(), 6u);
+  EXPECT_EQ(terrain->getPyramidMaxHeights(0).rows(), 25);
+  EXPECT_EQ(terrain->getPyramidMaxHeights(5).size(), 1);
+  EXPECT_EQ(terrain->getPyramidMaxHeights(5)(0, 0), 2.0f);
+  EXPECT_EQ(terrain->getPyramidMinHeights(5)(0, 0), 0.0f);
+  EXPECT_EQ(terrain->getPyramidMaxHeights(0)(6, 18), 2.0f);
+  EXPECT_EQ(terrain->getPyramidMaxHeights(0)(18, 6), 0.0f);
+  terrain->flipY();
+  EXPECT_EQ(terrain->getPyramidMaxHeights(0)(6, 18), 0.0f);
+  EXPECT_EQ(terrain->getPyramidMaxHeights(0)(18, 18), 2.0f);
+  terrain->flipY();
+
+  auto cd = DARTCollisionDetector::create();
+  collision::CollisionOption option;
+  option.maxNumContacts = 100u;
+  collision::CollisionResult result;
+
+  auto terrainFrame = SimpleFrame::createShared(Frame::World());
+  terrainFrame->setShape(terrain);
+  auto frame = SimpleFrame::createShared(Frame::World());
+  frame->setShape(std::make_shared<SphereShape>(0.25));
+  auto group = cd->createCollisionGroup(terrainFrame.get(), frame.get());
+
+  const auto expectUpwardNormals = [&]() {
+    for (const auto& contact : result.getContacts())
+    {
+      const double sign
+          = contact.collisionObject1->getShapeFrame() == terrainFrame.get()
+                ? -1.0
+                : 1.0;
+      EXPECT_TRUE(
+          contact.normal.isApprox(sign * Eigen::Vector3d::UnitZ(), 1e-6));
+    }
+  };
+
+  // Sphere resting on the flat part, over a vertex and inside of a cell
+  for (const double x : {-3.0, -3.05})
+  {
+    frame->setTranslation(Eigen::Vector3d(x, -2.0, 0.24));
+    result.clear();
+    EXPECT_TRUE(group->collide(option, &result));
+    ASSERT_GE(result.getNumContacts(), 1u);
+    expectUpwardNormals();
+    for (const auto& contact : result.getContacts())
+      EXPECT_NEAR(contact.penetrationDepth, 0.01, 1e-6);
+  }
+
+  frame->setTranslation(Eigen::Vector3d(-3.0, -2.0, 0.26));
+  result.clear();
+  EXPECT_FALSE(group->collide(option, &result));
+
+  // A box resting on the flat part gets a manifold of four points
+  frame->setShape(std::make_shared<BoxShape>(Eigen::Vector3d(0.5, 0.3, 0.2)));
+  frame->setTranslation(Eigen::Vector3d(3.03, 2.02, 0.09));
+  result.clear();
+  EXPECT_TRUE(group->collide(option, &result));
+  EXPECT_EQ(result.getNumContacts(), 4u);
+  expectUpwardNormals();
+  for (const auto& contact : result.getContacts())
+    EXPECT_NEAR(contact.penetrationDepth, 0.01, 1e-6);
+
+  // The spike at (5, 5) pokes into a box above the flat part
+  frame->setTranslation(Eigen::Vector3d(5.0, 5.0, 1.95));
+  result.clear();
+  EXPECT_TRUE(group->collide(option, &result));
+  frame->setTranslation(Eigen::Vector3d(5.0, 5.0, 2.15));
+  result.clear();
+  EXPECT_FALSE(group->collide(option, &result));
+
+  // Raising the spike in place refreshes the heights used for culling
+  terrain->getHeightFieldModifiable()(50, 150) = 3.0f;
+  EXPECT_EQ(terrain->getMaxHeight(), 3.0f);
+  EXPECT_EQ(terrain->getPyramidMaxHeights(5)(0, 0), 3.0f);
+  EXPECT_EQ(terrain->getPyramidMaxHeights(0)(6, 18), 3.0f);
+  result.clear();
+  EXPECT_TRUE(group->collide(option, &result));
+  terrain->getHeightFieldModifiable()(50, 150) = 2.0f;
+  EXPECT_EQ(terrain->getMaxHeight(), 2.0f);
+
+  // Outside of the terrain
+  frame->setTranslation(Eigen::Vector3d(11.0, 0.0, 0.0));
+  result.clear();
+  EXPECT_FALSE(group->collide(option, &result));
+}
+
 //==============================================================================
 TEST_F(Collision, Options)
 {
@@ -1590,6 +1694,1085 @@ TEST_F(Collision, CollisionOfPrescribedJoints)
   }
 }
 
+//==============================================================================
+TEST_F(Collision, DARTBroadPhase)
+{
+  // Spheres of various radii on a jittered lattice, and a rotated long box
+  // cutting through them. The pairs reported by DARTCollisionDetector have to
+  // match the analytic answer exactly, so the broadphase must not cull any
+  // colliding pair.
+  auto cd = DARTCollisionDetector::create();
+
+  std::vector<SimpleFramePtr> spheres;
+  std::vector<double> radii;
+  for (int i = 0; i < 200; ++i)
+  {
+    const double radius = 0.35 + 0.15 * std::sin(1.3 * i);
+    const Eigen::Vector3d position
+        = 0.9 * Eigen::Vector3d(i % 8, (i / 8) % 5, i / 40)
+          + 0.2 * Eigen::Vector3d(std::sin(i), std::cos(2.0 * i), 0.0);
+
+    auto frame = SimpleFrame::createShared(Frame::World());
+    frame->setShape(std::make_shared<SphereShape>(radius));
+    frame->setTranslation(position);
+    spheres.push_back(frame);
+    radii.push_back(radius);
+  }
+
+  const Eigen::Vector3d boxSize(8.0, 0.2, 0.2);
+  Eigen::Isometry3d boxTf = Eigen::Isometry3d::Identity();
+  boxTf.linear() = eulerXYZToMatrix(Eigen::Vector3d(0.3, 0.2, 0.5));
+  boxTf.translation() = Eigen::Vector3d(3.0, 1.8, 1.5);
+  auto box = SimpleFrame::createShared(Frame::World());
+  box->setShape(std::make_shared<BoxShape>(boxSize));
+  box->setTransform(boxTf);
+
+  using FramePair = std::pair<const ShapeFrame*, const ShapeFrame*>;
+  const auto makePair = [](const ShapeFrame* a, const ShapeFrame* b) {
+    return a < b ? FramePair(a, b) : FramePair(b, a);
+  };
+
+  std::set<FramePair> expected;
+  for (std::size_t i = 0u; i < spheres.size(); ++i)
+  {
+    const Eigen::Vector3d pi = spheres[i]->getWorldTransform().translation();
+    for (std::size_t j = i + 1u; j < spheres.size(); ++j)
+    {
+      const Eigen::Vector3d pj = spheres[j]->getWorldTransform().translation();
+      if ((pi - pj).norm() < radii[i] + radii[j])
+        expected.insert(makePair(spheres[i].get(), spheres[j].get()));
+    }
+
+    const Eigen::Vector3d local = boxTf.inverse() * pi;
+    const Eigen::Vector3d closest
+        = local.cwiseMax(-0.5 * boxSize).cwiseMin(0.5 * boxSize);
+    if ((local - closest).norm() < radii[i])
+      expected.insert(makePair(spheres[i].get(), box.get()));
+  }
+  ASSERT_FALSE(expected.empty());
+
+  CollisionOption option;
+  option.maxNumContacts = 100000u;
+
+  const auto collectPairs = [&](const CollisionResult& result) {
+    std::set<FramePair> pairs;
+    for (const auto& contact : result.getContacts())
+    {
+      pairs.insert(makePair(
+          contact.collisionObject1->getShapeFrame(),
+          contact.collisionObject2->getShapeFrame()));
+    }
+    return pairs;
+  };
+
+  auto group = cd->createCollisionGroup();
+  for (const auto& sphere : spheres)
+    group->addShapeFrame(sphere.get());
+  group->addShapeFrame(box.get());
+
+  CollisionResult result;
+  EXPECT_TRUE(group->collide(option, &result));
+  EXPECT_EQ(collectPairs(result), expected);
+
+  // Moving the objects reuses the sort order of the previous query
+  for (auto& sphere : spheres)
+    sphere->setTranslation(
+        sphere->getWorldTransform().translation() + Eigen::Vector3d::UnitX());
+  boxTf.translation() += Eigen::Vector3d::UnitX();
+  box->setTransform(boxTf);
+
+  result.clear();
+  EXPECT_TRUE(group->collide(option, &result));
+  EXPECT_EQ(collectPairs(result), expected);
+
+  // Two groups: the even spheres and the box against the odd spheres
+  auto group1 = cd->createCollisionGroup();
+  auto group2 = cd->createCollisionGroup();
+  for (std::size_t i = 0u; i < spheres.size(); ++i)
+    (i % 2u == 0u ? group1 : group2)->addShapeFrame(spheres[i].get());
+  group1->addShapeFrame(box.get());
+
+  std::set<FramePair> expectedBetween;
+  for (const auto& pair : expected)
+  {
+    if (group1->hasShapeFrame(pair.first) != group1->hasShapeFrame(pair.second))
+      expectedBetween.insert(pair);
+  }
+
+  result.clear();
+  EXPECT_TRUE(group1->collide(group2.get(), option, &result));
+  EXPECT_EQ(collectPairs(result), expectedBetween);
+}
+
+//==============================================================================
+TEST_F(Collision, DARTBroadPhasePlane)
+{
+  // PlaneShape(normal, point) goes through the default Shape constructor. Its
+  // bounding box must still be reported as unbounded, or the broadphase culls
+  // every object that is away from the origin.
+  auto cd = DARTCollisionDetector::create();
+
+  auto plane = SimpleFrame::createShared(Frame::World());
+  plane->setShape(std::make_shared<PlaneShape>(
+      Eigen::Vector3d::UnitZ(), Eigen::Vector3d(0.0, 0.0, -1.0)));
+  EXPECT_FALSE(plane->getShape()->getBoundingBox().getMin().allFinite());
+
+  auto sphere = SimpleFrame::createShared(Frame::World());
+  sphere->setShape(std::make_shared<SphereShape>(0.5));
+  sphere->setTranslation(Eigen::Vector3d(20.0, -30.0, -0.6));
+
+  auto group = cd->createCollisionGroup(plane.get(), sphere.get());
+  CollisionResult result;
+  EXPECT_TRUE(group->collide(CollisionOption(), &result));
+  ASSERT_EQ(result.getNumContacts(), 1u);
+  EXPECT_NEAR(result.getContact(0).penetrationDepth, 0.1, 1e-9);
+
+  sphere->setTranslation(Eigen::Vector3d(20.0, -30.0, -0.4));
+  result.clear();
+  EXPECT_FALSE(group->collide(CollisionOption(), &result));
+}
+
+//==============================================================================
+TEST_F(Collision, ShapeTypeIds)
+{
+  using TypeId = Shape::TypeId;
+
+  const std::vector<std::pair<ShapePtr, TypeId>> shapes = {
+      {std::make_shared<SphereShape>(0.5), TypeId::SPHERE},
+      {std::make_shared<BoxShape>(Eigen::Vector3d::Ones()), TypeId::BOX},
+      {std::make_shared<EllipsoidShape>(Eigen::Vector3d::Ones()),
+       TypeId::ELLIPSOID},
+      {std::make_shared<CylinderShape>(0.5, 1.0), TypeId::CYLINDER},
+      {std::make_shared<CapsuleShape>(0.5, 1.0), TypeId::CAPSULE},
+      {std::make_shared<ConeShape>(0.5, 1.0), TypeId::CONE},
+      {std::make_shared<PlaneShape>(Eigen::Vector3d::UnitZ(), 0.0),
+       TypeId::PLANE},
+      {std::make_shared<HeightmapShapef>(), TypeId::HEIGHTMAP_FLOAT},
+      {std::make_shared<HeightmapShaped>(), TypeId::HEIGHTMAP_DOUBLE}};
+
+  for (const auto& entry : shapes)
+    EXPECT_EQ(entry.first->getTypeId(), entry.second);
+
+  EXPECT_EQ(SphereShape::getStaticTypeId(), TypeId::SPHERE);
+  EXPECT_EQ(HeightmapShapef::getStaticTypeId(), TypeId::HEIGHTMAP_FLOAT);
+
+  // The DART narrowphase dispatches on the type IDs, including the mixed
+  // sphere/ellipsoid/box pairs
+  auto cd = DARTCollisionDetector::create();
+  auto frame1 = SimpleFrame::createShared(Frame::World());
+  auto frame2 = SimpleFrame::createShared(Frame::World());
+  frame2->setTranslation(Eigen::Vector3d(0.9, 0.0, 0.0));
+
+  const std::vector<ShapePtr> supported
+      = {std::make_shared<SphereShape>(0.5),
+         std::make_shared<EllipsoidShape>(Eigen::Vector3d::Ones()),
+         std::make_shared<BoxShape>(Eigen::Vector3d::Ones())};
+  frame1->setShape(supported[0]);
+  frame2->setShape(supported[0]);
+  auto group = cd->createCollisionGroup(frame1.get(), frame2.get());
+
+  for (const auto& shape1 : supported)
+  {
+    for (const auto& shape2 : supported)
+    {
+      frame1->setShape(shape1);
+      frame2->setShape(shape2);
+      EXPECT_TRUE(group->collide());
+    }
+  }
+}
+
+//==============================================================================
+void testDARTConvexManifolds(const std::shared_ptr<DARTCollisionDetector>& cd)
+{
+  collision::CollisionOption option;
+  option.enableContact = true;
+  option.maxNumContacts = 100u;
+
+  const auto collideShapes = [&](const ShapePtr& shape1,
+                                 const Eigen::Isometry3d& tf1,
+                                 const ShapePtr& shape2,
+                                 const Eigen::Isometry3d& tf2,
+                                 collision::CollisionResult& result) {
+    auto frame1 = SimpleFrame::createShared(Frame::World(), "frame1", tf1);
+    auto frame2 = SimpleFrame::createShared(Frame::World(), "frame2", tf2);
+    frame1->setShape(shape1);
+    frame2->setShape(shape2);
+    auto group = cd->createCollisionGroup(frame1.get(), frame2.get());
+    result.clear();
+    const bool collision = group->collide(option, &result);
+
+    // The normals point from the second object to the first one
+    for (const auto& contact : result.getContacts())
+    {
+      const Eigen::Vector3d center1 = contact.collisionObject1->getShapeFrame()
+                                          ->getWorldTransform()
+                                          .translation();
+      const Eigen::Vector3d center2 = contact.collisionObject2->getShapeFrame()
+                                          ->getWorldTransform()
+                                          .translation();
+      EXPECT_GT((center1 - center2).dot(contact.normal), 0.0);
+    }
+
+    return collision;
+  };
+
+  Eigen::Isometry3d tf1 = Eigen::Isometry3d::Identity();
+  Eigen::Isometry3d tf2 = Eigen::Isometry3d::Identity();
+  collision::CollisionResult result;
+
+  // Cylinder standing on another cylinder: the caps touch
+  auto cylinder = std::make_shared<CylinderShape>(0.5, 1.0);
+  tf2.translation() = Eigen::Vector3d(0.0, 0.0, 0.99);
+  EXPECT_TRUE(collideShapes(cylinder, tf1, cylinder, tf2, result));
+  EXPECT_EQ(result.getNumContacts(), 4u);
+  for (const auto& contact : result.getContacts())
+  {
+    EXPECT_NEAR(std::abs(contact.normal.z()), 1.0, 1e-6);
+    EXPECT_NEAR(contact.penetrationDepth, 0.01, 1e-6);
+    EXPECT_NEAR(contact.point.z(), 0.495, 1e-6);
+  }
+
+  tf2.translation() = Eigen::Vector3d(0.0, 0.0, 1.01);
+  EXPECT_FALSE(collideShapes(cylinder, tf1, cylinder, tf2, result));
+  EXPECT_EQ(result.getNumContacts(), 0u);
+
+  // Capsule lying on a box: the contact line gives two points
+  auto box = std::make_shared<BoxShape>(Eigen::Vector3d(2.0, 2.0, 1.0));
+  auto capsule = std::make_shared<CapsuleShape>(0.2, 1.0);
+  tf2 = Eigen::Isometry3d::Identity();
+  tf2.linear()
+      = Eigen::AngleAxisd(0.5 * constantsd::pi(), Eigen::Vector3d::UnitY())
+            .toRotationMatrix();
+  tf2.translation() = Eigen::Vector3d(0.1, 0.0, 0.69);
+  EXPECT_TRUE(collideShapes(box, tf1, capsule, tf2, result));
+  ASSERT_EQ(result.getNumContacts(), 2u);
+  EXPECT_NEAR(
+      std::abs(result.getContact(0).point.x() - result.getContact(1).point.x()),
+      1.0,
+      1e-6);
+  for (const auto& contact : result.getContacts())
+    EXPECT_NEAR(contact.penetrationDepth, 0.01, 1e-6);
+
+  // Crossing capsules touch at a single point
+  tf1.linear()
+      = Eigen::AngleAxisd(0.5 * constantsd::pi(), Eigen::Vector3d::UnitX())
+            .toRotationMatrix();
+  tf1.translation() = Eigen::Vector3d(0.1, 0.0, 0.3);
+  EXPECT_TRUE(collideShapes(capsule, tf1, capsule, tf2, result));
+  ASSERT_EQ(result.getNumContacts(), 1u);
+  EXPECT_NEAR(result.getContact(0).penetrationDepth, 0.01, 1e-4);
+  EXPECT_TRUE(result.getContact(0).point.isApprox(
+      Eigen::Vector3d(0.1, 0.0, 0.495), 1e-3));
+
+  // Hull of two spheres resting on a box
+  auto spheres = std::make_shared<MultiSphereConvexHullShape>(
+      MultiSphereConvexHullShape::Spheres{
+          {0.2, Eigen::Vector3d(-0.5, 0.0, 0.0)},
+          {0.2, Eigen::Vector3d(0.5, 0.0, 0.0)}});
+  tf1 = Eigen::Isometry3d::Identity();
+  tf2 = Eigen::Isometry3d::Identity();
+  tf2.translation() = Eigen::Vector3d(0.0, 0.3, 0.69);
+  EXPECT_TRUE(collideShapes(box, tf1, spheres, tf2, result));
+  EXPECT_EQ(result.getNumContacts(), 2u);
+  for (const auto& contact : result.getContacts())
+    EXPECT_NEAR(contact.penetrationDepth, 0.01, 1e-6);
+
+  // Cone resting on a plane with its base
+  auto plane = std::make_shared<PlaneShape>(Eigen::Vector3d::UnitZ(), 0.0);
+  auto cone = std::make_shared<ConeShape>(0.5, 1.0);
+  tf2.translation() = Eigen::Vector3d(0.3, 0.2, 0.49);
+  EXPECT_TRUE(collideShapes(plane, tf1, cone, tf2, result));
+  EXPECT_EQ(result.getNumContacts(), 4u);
+  for (const auto& contact : result.getContacts())
+  {
+    EXPECT_NEAR(contact.penetrationDepth, 0.01, 1e-9);
+    EXPECT_NEAR(contact.normal.z(), -1.0, 1e-9);
+  }
+
+  // Cone standing on its apex
+  tf2.linear() = Eigen::AngleAxisd(constantsd::pi(), Eigen::Vector3d::UnitX())
+                     .toRotationMatrix();
+  EXPECT_TRUE(collideShapes(cone, tf2, plane, tf1, result));
+  ASSERT_EQ(result.getNumContacts(), 1u);
+  EXPECT_NEAR(result.getContact(0).penetrationDepth, 0.01, 1e-9);
+  EXPECT_NEAR(result.getContact(0).normal.z(), 1.0, 1e-9);
+}
+
+//==============================================================================
+TEST_F(Collision, DARTConvexManifolds)
+{
+  auto cd = DARTCollisionDetector::create();
+  EXPECT_EQ(cd->getConvexCollisionAlgorithm(), DARTCollisionDetector::GJK_EPA);
+  testDARTConvexManifolds(cd);
+
+  cd->setConvexCollisionAlgorithm(DARTCollisionDetector::MPR);
+  testDARTConvexManifolds(cd);
+}
+
+//==============================================================================
+TEST_F(Collision, DARTConvexDeepPenetration)
+{
+  // Unit sphere against a capsule that degenerates to a unit sphere. EPA runs
+  // out of vertices on such curved shapes, after which it must still report
+  // a depth that doesn't exceed the exact one.
+  auto sphereFrame = SimpleFrame::createShared(Frame::World());
+  auto capsuleFrame = SimpleFrame::createShared(Frame::World());
+  sphereFrame->setShape(
+      std::make_shared<EllipsoidShape>(Eigen::Vector3d::Constant(2.0)));
+  capsuleFrame->setShape(std::make_shared<CapsuleShape>(1.0, 1e-9));
+
+  auto cd = DARTCollisionDetector::create();
+  auto group = cd->createCollisionGroup(sphereFrame.get(), capsuleFrame.get());
+
+  collision::CollisionOption option;
+  for (const auto algorithm :
+       {DARTCollisionDetector::GJK_EPA, DARTCollisionDetector::MPR})
+  {
+    cd->setConvexCollisionAlgorithm(algorithm);
+
+    for (const double offset : {1.5, 1.0, 0.5, 0.2, 0.05})
+    {
+      const Eigen::Vector3d translation(offset, 0.3 * offset, 0.1);
+      capsuleFrame->setTranslation(translation);
+      const double depth = 2.0 - translation.norm();
+
+      collision::CollisionResult result;
+      EXPECT_TRUE(group->collide(option, &result));
+      ASSERT_EQ(result.getNumContacts(), 1u);
+      EXPECT_LE(result.getContact(0).penetrationDepth, depth + 1e-6);
+      EXPECT_GE(result.getContact(0).penetrationDepth, 0.9 * depth);
+    }
+  }
+}
+
+//==============================================================================
+void expectSameContacts(
+    const CollisionResult& expected, const CollisionResult& actual)
+{
+  ASSERT_EQ(expected.getNumContacts(), actual.getNumContacts());
+  for (std::size_t i = 0u; i < expected.getNumContacts(); ++i)
+  {
+    const auto& contact1 = expected.getContact(i);
+    const auto& contact2 = actual.getContact(i);
+    EXPECT_EQ(contact1.collisionObject1, contact2.collisionObject1);
+    EXPECT_EQ(contact1.collisionObject2, contact2.collisionObject2);
+    EXPECT_TRUE(contact1.point.isApprox(contact2.point));
+    EXPECT_TRUE(contact1.normal.isApprox(contact2.normal));
+  }
+}
+
+//==============================================================================
+void testParallelNarrowPhase(const std::shared_ptr<CollisionDetector>& cd)
+{
+  // A loose pile of overlapping boxes gives many candidate pairs. Checking the
+  // pairs on a pool of several threads has to report the same contacts, in the
+  // same order, as checking them on a single thread.
+  std::vector<SimpleFramePtr> frames;
+  for (int i = 0; i < 60; ++i)
+  {
+    auto frame = SimpleFrame::createShared(Frame::World());
+    frame->setShape(std::make_shared<BoxShape>(Eigen::Vector3d::Constant(0.6)));
+    Eigen::Isometry3d tf = Eigen::Isometry3d::Identity();
+    tf.linear() = eulerXYZToMatrix(
+        Eigen::Vector3d(0.3 * i, 0.7 * std::sin(i), 0.2 * std::cos(i)));
+    tf.translation()
+        = 0.5 * Eigen::Vector3d(i % 5, (i / 5) % 4, i / 20)
+          + 0.1 * Eigen::Vector3d(std::sin(3.0 * i), std::cos(i), 0.0);
+    frame->setTransform(tf);
+    frames.push_back(frame);
+  }
+
+  auto group = cd->createCollisionGroup();
+  auto group1 = cd->createCollisionGroup();
+  auto group2 = cd->createCollisionGroup();
+  for (std::size_t i = 0u; i < frames.size(); ++i)
+  {
+    group->addShapeFrame(frames[i].get());
+    if (i % 2u == 0u)
+      group1->addShapeFrame(frames[i].get());
+    else
+      group2->addShapeFrame(frames[i].get());
+  }
+
+  const auto onePool = std::make_shared<common::ThreadPool>(1u);
+  const auto manyPool = std::make_shared<common::ThreadPool>(4u);
+
+  for (const std::size_t maxNumContacts : {1u, 5u, 100000u})
+  {
+    CollisionOption option;
+    option.maxNumContacts = maxNumContacts;
+
+    CollisionResult oneResult;
+    CollisionResult oneResult12;
+    cd->setThreadPool(onePool);
+    EXPECT_TRUE(group->collide(option, &oneResult));
+    EXPECT_TRUE(group->collide(option));
+    EXPECT_TRUE(group1->collide(group2.get(), option, &oneResult12));
+
+    CollisionResult manyResult;
+    CollisionResult manyResult12;
+    cd->setThreadPool(manyPool);
+    EXPECT_TRUE(group->collide(option, &manyResult));
+    EXPECT_TRUE(group->collide(option));
+    EXPECT_TRUE(group1->collide(group2.get(), option, &manyResult12));
+
+    CollisionResult serialResult;
+    cd->setThreadPool(nullptr);
+    EXPECT_TRUE(group->collide(option, &serialResult));
+
+    EXPECT_LE(oneResult.getNumContacts(), maxNumContacts);
+    expectSameContacts(oneResult, manyResult);
+    expectSameContacts(oneResult12, manyResult12);
+    expectSameContacts(oneResult, serialResult);
+  }
+
+  // Binary queries are answered by the first colliding pair, with or without
+  // a thread pool
+  for (const auto& threadPool :
+       {std::shared_ptr<common::ThreadPool>(), onePool, manyPool})
+  {
+    cd->setThreadPool(threadPool);
+
+    CollisionResult result;
+    EXPECT_TRUE(group->collide(CollisionOption(false, 1u), &result));
+    EXPECT_TRUE(group->collide(CollisionOption(false, 1u)));
+    EXPECT_TRUE(group->collide(CollisionOption(true, 1u), &result));
+    EXPECT_EQ(result.getNumContacts(), 1u);
+  }
+}
+
+//==============================================================================
+TEST_F(Collision, ParallelNarrowPhase)
+{
+  auto fcl = FCLCollisionDetector::create();
+  testParallelNarrowPhase(fcl);
+
+#if HAVE_BULLET
+  auto bullet = BulletCollisionDetector::create();
+  testParallelNarrowPhase(bullet);
+#endif
+
+  auto dart = DARTCollisionDetector::create();
+  testParallelNarrowPhase(dart);
+}
+
+//==============================================================================
+void testIncrementalUpdate(const std::shared_ptr<CollisionDetector>& cd)
+{
+  // Only the frames that moved are pushed to the engine between two checks,
+  // so moving one frame among many static ones, or changing its shape, has to
+  // be noticed all the same.
+  auto group = cd->createCollisionGroup();
+
+  std::vector<SimpleFramePtr> statics;
+  for (int i = 0; i < 50; ++i)
+  {
+    auto frame = SimpleFrame::createShared(Frame::World());
+    frame->setShape(std::make_shared<SphereShape>(0.1));
+    frame->setTranslation(Eigen::Vector3d(i % 10, i / 10, 0.0));
+    group->addShapeFrame(frame.get());
+    statics.push_back(frame);
+  }
+
+  auto mover = SimpleFrame::createShared(Frame::World());
+  mover->setShape(std::make_shared<SphereShape>(0.1));
+  mover->setTranslation(Eigen::Vector3d(0.5, 0.5, 0.0));
+  group->addShapeFrame(mover.get());
+
+  auto parent = SimpleFrame::createShared(Frame::World());
+  auto child = SimpleFrame::createShared(parent.get());
+  child->setShape(std::make_shared<SphereShape>(0.1));
+  child->setTranslation(Eigen::Vector3d(0.0, 0.0, 2.0));
+  group->addShapeFrame(child.get());
+
+  CollisionOption option;
+  CollisionResult result;
+  EXPECT_FALSE(group->collide(option, &result));
+
+  mover->setTranslation(Eigen::Vector3d(3.05, 2.0, 0.0));
+  EXPECT_TRUE(group->collide(option, &result));
+  EXPECT_TRUE(result.inCollision(mover.get()));
+  EXPECT_TRUE(result.inCollision(statics[23].get()));
+
+  mover->setTranslation(Eigen::Vector3d(3.5, 2.5, 0.0));
+  EXPECT_FALSE(group->collide(option, &result));
+
+  // Moving the parent moves the child too
+  parent->setTranslation(Eigen::Vector3d(7.0, 4.0, -1.95));
+  EXPECT_TRUE(group->collide(option, &result));
+  EXPECT_TRUE(result.inCollision(child.get()));
+  EXPECT_TRUE(result.inCollision(statics[47].get()));
+
+  parent->setTranslation(Eigen::Vector3d::Zero());
+  EXPECT_FALSE(group->collide(option, &result));
+
+  // A new shape is pushed to the engine even though the frame did not move
+  mover->setShape(std::make_shared<SphereShape>(0.8));
+  group->removeShapeFrame(mover.get());
+  group->addShapeFrame(mover.get());
+  EXPECT_TRUE(group->collide(option, &result));
+  EXPECT_TRUE(result.inCollision(mover.get()));
+}
+
+//==============================================================================
+TEST_F(Collision, IncrementalUpdate)
+{
+  auto fcl_mesh_dart = FCLCollisionDetector::create();
+  fcl_mesh_dart->setPrimitiveShapeType(FCLCollisionDetector::MESH);
+  fcl_mesh_dart->setContactPointComputationMethod(FCLCollisionDetector::DART);
+  testIncrementalUpdate(fcl_mesh_dart);
+
+  auto fcl_prim_fcl = FCLCollisionDetector::create();
+  fcl_prim_fcl->setPrimitiveShapeType(FCLCollisionDetector::PRIMITIVE);
+  fcl_prim_fcl->setContactPointComputationMethod(FCLCollisionDetector::FCL);
+  testIncrementalUpdate(fcl_prim_fcl);
+
+#if HAVE_BULLET
+  auto bullet = BulletCollisionDetector::create();
+  testIncrementalUpdate(bullet);
+#endif
+
+  auto dart = DARTCollisionDetector::create();
+  testIncrementalUpdate(dart);
+}
+
+//==============================================================================
+void testContactCache(const std::shared_ptr<CollisionDetector>& cd)
+{
+  auto cache = std::make_shared<ContactCache>(1e-3, 1e-3);
+  cd->setContactCache(cache);
+
+  auto group = cd->createCollisionGroup();
+
+  auto ground = SimpleFrame::createShared(Frame::World());
+  auto groundShape = std::make_shared<BoxShape>(Eigen::Vector3d(4.0, 4.0, 0.2));
+  ground->setShape(groundShape);
+  ground->setTranslation(Eigen::Vector3d(0.0, 0.0, -0.1));
+  group->addShapeFrame(ground.get());
+
+  auto box = SimpleFrame::createShared(Frame::World());
+  box->setShape(std::make_shared<BoxShape>(Eigen::Vector3d::Ones()));
+  box->setTranslation(Eigen::Vector3d(0.0, 0.0, 0.49));
+  group->addShapeFrame(box.get());
+
+  CollisionOption option;
+  CollisionResult expected;
+  EXPECT_TRUE(group->collide(option, &expected));
+  EXPECT_EQ(cache->getNumHits(), 0u);
+  EXPECT_EQ(cache->getNumPairs(), 1u);
+
+  // The box has not moved, so its contacts are reused
+  CollisionResult result;
+  EXPECT_TRUE(group->collide(option, &result));
+  EXPECT_EQ(cache->getNumHits(), 1u);
+  ASSERT_EQ(result.getNumContacts(), expected.getNumContacts());
+  for (auto i = 0u; i < result.getNumContacts(); ++i)
+  {
+    const auto& contact = result.getContact(i);
+    EXPECT_TRUE(equals(contact.point, expected.getContact(i).point));
+    EXPECT_TRUE(equals(contact.normal, expected.getContact(i).normal));
+    EXPECT_DOUBLE_EQ(
+        contact.penetrationDepth, expected.getContact(i).penetrationDepth);
+  }
+
+  // Binary checks do not use the cache
+  EXPECT_TRUE(group->collide(option));
+  EXPECT_EQ(cache->getNumHits(), 1u);
+
+  // Moving both objects together keeps the contacts valid, and they move
+  // along with the objects
+  const Eigen::Vector3d offset(0.5, 0.0, 0.0);
+  ground->setTranslation(Eigen::Vector3d(0.0, 0.0, -0.1) + offset);
+  box->setTranslation(Eigen::Vector3d(0.0, 0.0, 0.49) + offset);
+  EXPECT_TRUE(group->collide(option, &result));
+  EXPECT_EQ(cache->getNumHits(), 2u);
+  ASSERT_EQ(result.getNumContacts(), expected.getNumContacts());
+  for (auto i = 0u; i < result.getNumContacts(); ++i)
+  {
+    EXPECT_TRUE(equals(
+        result.getContact(i).point,
+        Eigen::Vector3d(expected.getContact(i).point + offset)));
+  }
+
+  // Moving the box relative to the ground beyond the threshold invalidates
+  // the pair
+  box->setTranslation(Eigen::Vector3d(0.0, 0.0, 0.45) + offset);
+  EXPECT_TRUE(group->collide(option, &result));
+  EXPECT_EQ(cache->getNumHits(), 2u);
+
+  EXPECT_TRUE(group->collide(option, &result));
+  EXPECT_EQ(cache->getNumHits(), 3u);
+
+  // So does changing a shape
+  groundShape->setSize(Eigen::Vector3d(4.0, 4.0, 0.3));
+  EXPECT_TRUE(group->collide(option, &result));
+  EXPECT_EQ(cache->getNumHits(), 3u);
+
+  // Pairs that are no longer checked are dropped eventually
+  box->setTranslation(Eigen::Vector3d(0.0, 0.0, 5.0));
+  for (int i = 0; i < 10; ++i)
+    EXPECT_FALSE(group->collide(option, &result));
+  EXPECT_EQ(cache->getNumPairs(), 0u);
+
+  cd->setContactCache(nullptr);
+}
+
+//==============================================================================
+TEST_F(Collision, ContactCache)
+{
+  auto dart = DARTCollisionDetector::create();
+  testContactCache(dart);
+}
+
+//==============================================================================
+void testCachedRestingStack(const std::shared_ptr<CollisionDetector>& cd)
+{
+  // A stack of boxes resting on the ground is carried along as a whole, so the
+  // relative poses of the boxes do not change. The contacts reported with a
+  // cache have to be the ones reported without it.
+  std::vector<SimpleFramePtr> frames;
+  std::vector<Eigen::Isometry3d> poses;
+
+  auto ground = SimpleFrame::createShared(Frame::World());
+  ground->setShape(std::make_shared<BoxShape>(Eigen::Vector3d(4.0, 4.0, 0.2)));
+  frames.push_back(ground);
+  poses.push_back(Eigen::Isometry3d(Eigen::Translation3d(0.0, 0.0, -0.1)));
+
+  for (int i = 0; i < 4; ++i)
+  {
+    auto box = SimpleFrame::createShared(Frame::World());
+    box->setShape(std::make_shared<BoxShape>(Eigen::Vector3d::Constant(0.5)));
+    frames.push_back(box);
+
+    Eigen::Isometry3d pose = Eigen::Isometry3d::Identity();
+    pose.translation() = Eigen::Vector3d(0.02 * i, 0.0, 0.249 + 0.499 * i);
+    pose.linear() = Eigen::AngleAxisd(0.2 * i, Eigen::Vector3d::UnitZ())
+                        .toRotationMatrix();
+    poses.push_back(pose);
+  }
+
+  auto cachedCd = cd->cloneWithoutCollisionObjects();
+  auto cache = std::make_shared<ContactCache>();
+  cachedCd->setContactCache(cache);
+
+  auto group = cd->createCollisionGroup();
+  auto cachedGroup = cachedCd->createCollisionGroup();
+  for (const auto& frame : frames)
+  {
+    group->addShapeFrame(frame.get());
+    cachedGroup->addShapeFrame(frame.get());
+  }
+
+  for (int step = 0; step < 5; ++step)
+  {
+    const Eigen::Isometry3d carrier
+        = Eigen::Translation3d(0.1 * step, -0.05 * step, 0.0)
+          * Eigen::AngleAxisd(0.3 * step, Eigen::Vector3d::UnitZ());
+    for (std::size_t i = 0u; i < frames.size(); ++i)
+      frames[i]->setTransform(carrier * poses[i]);
+
+    CollisionOption option;
+    CollisionResult expected;
+    CollisionResult result;
+    EXPECT_TRUE(group->collide(option, &expected));
+    EXPECT_TRUE(cachedGroup->collide(option, &result));
+
+    ASSERT_EQ(result.getNumContacts(), expected.getNumContacts());
+    for (auto i = 0u; i < result.getNumContacts(); ++i)
+    {
+      const auto& contact = result.getContact(i);
+      const auto& expectedContact = expected.getContact(i);
+      EXPECT_EQ(
+          contact.collisionObject1->getShapeFrame(),
+          expectedContact.collisionObject1->getShapeFrame());
+      EXPECT_EQ(
+          contact.collisionObject2->getShapeFrame(),
+          expectedContact.collisionObject2->getShapeFrame());
+      EXPECT_TRUE(equals(contact.point, expectedContact.point, 1e-9));
+      EXPECT_TRUE(equals(contact.normal, expectedContact.normal, 1e-9));
+      EXPECT_NEAR(
+          contact.penetrationDepth, expectedContact.penetrationDepth, 1e-9);
+    }
+  }
+
+  // All but the first check reuse the contacts of the four resting pairs
+  if (cachedCd->getType() == DARTCollisionDetector::getStaticType())
+    EXPECT_EQ(cache->getNumHits(), 16u);
+}
+
+//==============================================================================
+TEST_F(Collision, CachedRestingStack)
+{
+  auto fcl_mesh_dart = FCLCollisionDetector::create();
+  fcl_mesh_dart->setPrimitiveShapeType(FCLCollisionDetector::MESH);
+  fcl_mesh_dart->setContactPointComputationMethod(FCLCollisionDetector::DART);
+  testCachedRestingStack(fcl_mesh_dart);
+
+  auto fcl_prim_fcl = FCLCollisionDetector::create();
+  fcl_prim_fcl->setPrimitiveShapeType(FCLCollisionDetector::PRIMITIVE);
+  fcl_prim_fcl->setContactPointComputationMethod(FCLCollisionDetector::FCL);
+  testCachedRestingStack(fcl_prim_fcl);
+
+#if HAVE_BULLET
+  auto bullet = BulletCollisionDetector::create();
+  testCachedRestingStack(bullet);
+#endif
+
+  auto dart = DARTCollisionDetector::create();
+  testCachedRestingStack(dart);
+}
+
+//==============================================================================
+double shootSphereAtWall(bool continuous)
+{
+  auto world = World::create();
+  world->setGravity(Eigen::Vector3d::Zero());
+  world->setTimeStep(1e-3);
+
+  auto wall
+      = createBox(Eigen::Vector3d(0.02, 1.0, 1.0), Eigen::Vector3d::UnitX());
+  wall->setMobile(false);
+  world->addSkeleton(wall);
+
+  auto sphere = createSphere(0.05, Eigen::Vector3d(0.07, 0.0, 0.0));
+  sphere->getBodyNode(0)->getShapeNode(0)->getCollisionAspect()->setContinuous(
+      continuous);
+  sphere->getJoint(0)->setVelocity(3, 200.0);
+  world->addSkeleton(sphere);
+
+  for (int i = 0; i < 20; ++i)
+    world->step();
+
+  return sphere->getBodyNode(0)->getWorldTransform().translation().x();
+}
+
+//==============================================================================
+TEST_F(Collision, ContinuousCollision)
+{
+  // The sphere moves 0.2 per step, which is more than the sphere and the wall
+  // are thick together, and it is never in contact with the wall at the end of
+  // a step.
+  EXPECT_GT(shootSphereAtWall(false), 1.0);
+
+  // The speculative contact stops it at the wall instead
+  const double x = shootSphereAtWall(true);
+  EXPECT_LT(x, 1.0);
+  EXPECT_NEAR(x, 1.0 - 0.01 - 0.05, 1e-3);
+}
+
+//==============================================================================
+TEST_F(Collision, ContinuousCollisionSweepsShape)
+{
+  auto cd = DARTCollisionDetector::create();
+  collision::CollisionOption option;
+  collision::CollisionResult result;
+
+  auto sphereFrame = SimpleFrame::createShared(Frame::World());
+  sphereFrame->setShape(std::make_shared<SphereShape>(0.1));
+  sphereFrame->createCollisionAspect();
+  sphereFrame->setClassicDerivatives(Eigen::Vector3d(100.0, 0.0, 0.0));
+
+  // Thin wall ahead of the sphere that the path of the sphere center misses
+  auto wallFrame = SimpleFrame::createShared(Frame::World());
+  wallFrame->setShape(
+      std::make_shared<BoxShape>(Eigen::Vector3d(0.02, 0.2, 1.0)));
+  wallFrame->setTranslation(Eigen::Vector3d(0.5, 0.17, 0.0));
+
+  auto group = cd->createCollisionGroup(sphereFrame.get(), wallFrame.get());
+
+  // Nothing is swept unless the frame is continuous
+  EXPECT_FALSE(group->collideContinuous(0.01, option, &result));
+  EXPECT_EQ(result.getNumContacts(), 0u);
+
+  // The sphere hits the lower front edge of the wall at (0.49, 0.07) when its
+  // center is reach away from the edge along x. The normal of the ray cast is
+  // that of a simplex face, which approximates the curved sphere.
+  sphereFrame->getCollisionAspect()->setContinuous(true);
+  EXPECT_TRUE(group->collideContinuous(0.01, option, &result));
+  ASSERT_EQ(result.getNumContacts(), 1u);
+  auto contact = result.getContact(0);
+  const double reach = std::sqrt(0.1 * 0.1 - 0.07 * 0.07);
+  const Eigen::Vector3d normal = Eigen::Vector3d(-reach, -0.07, 0.0) / 0.1;
+  EXPECT_EQ(contact.collisionObject1->getShapeFrame(), sphereFrame.get());
+  EXPECT_TRUE(contact.normal.isApprox(normal, 1e-2));
+  EXPECT_NEAR(contact.penetrationDepth, -(0.49 - reach) * reach / 0.1, 1e-2);
+  EXPECT_NEAR(contact.point.x(), 0.49, 1e-4);
+  EXPECT_NEAR(contact.point.y(), 0.07, 1e-4);
+
+  // The pair is not added twice
+  EXPECT_FALSE(group->collideContinuous(0.01, option, &result));
+  EXPECT_EQ(result.getNumContacts(), 1u);
+
+  // The wall is not reached within a shorter time step
+  result.clear();
+  EXPECT_FALSE(group->collideContinuous(0.003, option, &result));
+
+  // Plane below the sphere that falls towards it
+  auto planeFrame = SimpleFrame::createShared(Frame::World());
+  planeFrame->setShape(
+      std::make_shared<PlaneShape>(Eigen::Vector3d::UnitZ(), -1.0));
+  auto planeGroup
+      = cd->createCollisionGroup(sphereFrame.get(), planeFrame.get());
+  sphereFrame->setClassicDerivatives(Eigen::Vector3d(0.0, 0.0, -100.0));
+
+  result.clear();
+  EXPECT_TRUE(planeGroup->collideContinuous(0.01, option, &result));
+  ASSERT_EQ(result.getNumContacts(), 1u);
+  contact = result.getContact(0);
+  EXPECT_EQ(contact.collisionObject1->getShapeFrame(), sphereFrame.get());
+  EXPECT_TRUE(contact.normal.isApprox(Eigen::Vector3d::UnitZ(), 1e-6));
+  EXPECT_NEAR(contact.penetrationDepth, -0.9, 1e-6);
+  EXPECT_NEAR(contact.point.z(), -1.0, 1e-6);
+}
+
+//==============================================================================
+TEST_F(Collision, ContinuousCollisionSweepsRotation)
+{
+  auto cd = DARTCollisionDetector::create();
+  collision::CollisionOption option;
+  collision::CollisionResult result;
+
+  // Rod along x that spins about z around its fixed center
+  auto rodFrame = SimpleFrame::createShared(Frame::World());
+  rodFrame->setShape(
+      std::make_shared<BoxShape>(Eigen::Vector3d(1.0, 0.02, 0.02)));
+  rodFrame->createCollisionAspect();
+  rodFrame->getCollisionAspect()->setContinuous(true);
+
+  // Thin wall above the rod that the tip sweeps through within 1 radian
+  auto wallFrame = SimpleFrame::createShared(Frame::World());
+  wallFrame->setShape(
+      std::make_shared<BoxShape>(Eigen::Vector3d(0.2, 0.02, 1.0)));
+  wallFrame->setTranslation(Eigen::Vector3d(0.3, 0.35, 0.0));
+
+  auto group = cd->createCollisionGroup(rodFrame.get(), wallFrame.get());
+
+  // The wall is not reached within 0.1 radian
+  rodFrame->setClassicDerivatives(
+      Eigen::Vector3d::Zero(), Eigen::Vector3d(0.0, 0.0, 10.0));
+  EXPECT_FALSE(group->collideContinuous(0.01, option, &result));
+  EXPECT_EQ(result.getNumContacts(), 0u);
+
+  // The center doesn't move, so only the rotation brings the rod to the wall
+  rodFrame->setClassicDerivatives(
+      Eigen::Vector3d::Zero(), Eigen::Vector3d(0.0, 0.0, 100.0));
+  EXPECT_TRUE(group->collideContinuous(0.01, option, &result));
+  ASSERT_EQ(result.getNumContacts(), 1u);
+  const auto& contact = result.getContact(0);
+  EXPECT_EQ(contact.collisionObject1->getShapeFrame(), rodFrame.get());
+  EXPECT_TRUE(contact.normal.isApprox(-Eigen::Vector3d::UnitY(), 1e-6));
+  EXPECT_NEAR(contact.penetrationDepth, -0.33, 1e-6);
+  EXPECT_NEAR(contact.point.y(), 0.34, 1e-6);
+}
+
+//==============================================================================
+TEST_F(Collision, SdfShape)
+{
+  // Unit cube centered at the origin
+  const std::string meshUri = "dart://sample/obj/BoxSmall.obj";
+  const auto aiscene
+      = MeshShape::loadMesh(meshUri, DartResourceRetriever::create());
+  ASSERT_TRUE(aiscene);
+  const auto cube
+      = std::make_shared<MeshShape>(25.0 * Eigen::Vector3d::Ones(), aiscene);
+
+  const auto sdf = std::make_shared<SdfShape>(*cube, 0.05, 0.2);
+  EXPECT_EQ(sdf->getTypeId(), Shape::TypeId::SDF);
+  EXPECT_NEAR(sdf->getVolume(), 1.0, 0.2);
+  EXPECT_TRUE(sdf->getBoundingBox().getMin().isApprox(
+      Eigen::Vector3d::Constant(-0.7), 0.05));
+
+  Eigen::Vector3d gradient;
+  EXPECT_NEAR(sdf->getSignedDistance(Eigen::Vector3d::Zero()), -0.5, 0.05);
+  EXPECT_NEAR(
+      sdf->getSignedDistance(Eigen::Vector3d(0.6, 0.0, 0.0), &gradient),
+      0.1,
+      1e-3);
+  EXPECT_TRUE(gradient.isApprox(Eigen::Vector3d::UnitX(), 1e-3));
+  EXPECT_NEAR(
+      sdf->getSignedDistance(Eigen::Vector3d(0.0, -0.3, 0.0), &gradient),
+      -0.2,
+      1e-3);
+  EXPECT_TRUE(gradient.isApprox(-Eigen::Vector3d::UnitY(), 1e-3));
+  EXPECT_NEAR(
+      sdf->getSignedDistance(Eigen::Vector3d(2.0, 0.0, 0.0)), 1.5, 1e-3);
+
+  auto cd = DARTCollisionDetector::create();
+  collision::CollisionOption option;
+  option.maxNumContacts = 100u;
+  collision::CollisionResult result;
+
+  auto sdfFrame = SimpleFrame::createShared(Frame::World());
+  sdfFrame->setShape(sdf);
+  auto otherFrame = SimpleFrame::createShared(Frame::World());
+  otherFrame->setTranslation(Eigen::Vector3d(0.0, 0.0, 0.55));
+
+  // Sphere on top of the cube
+  otherFrame->setShape(std::make_shared<SphereShape>(0.1));
+  auto group = cd->createCollisionGroup(sdfFrame.get(), otherFrame.get());
+  EXPECT_TRUE(group->collide(option, &result));
+  ASSERT_EQ(result.getNumContacts(), 1u);
+  auto contact = result.getContact(0);
+  EXPECT_NEAR(contact.penetrationDepth, 0.05, 1e-3);
+  if (contact.collisionObject1->getShapeFrame() == sdfFrame.get())
+    EXPECT_TRUE(contact.normal.isApprox(-Eigen::Vector3d::UnitZ(), 1e-3));
+  else
+    EXPECT_TRUE(contact.normal.isApprox(Eigen::Vector3d::UnitZ(), 1e-3));
+  EXPECT_NEAR(contact.point.z(), 0.475, 1e-3);
+
+  // Both orders of the shapes give the same contact
+  auto swappedGroup
+      = cd->createCollisionGroup(otherFrame.get(), sdfFrame.get());
+  collision::CollisionResult swappedResult;
+  EXPECT_TRUE(swappedGroup->collide(option, &swappedResult));
+  ASSERT_EQ(swappedResult.getNumContacts(), 1u);
+  EXPECT_NEAR(swappedResult.getContact(0).penetrationDepth, 0.05, 1e-3);
+
+  otherFrame->setTranslation(Eigen::Vector3d(0.0, 0.0, 0.7));
+  result.clear();
+  EXPECT_FALSE(group->collide(option, &result));
+
+  // Small cube resting on a face: its four bottom vertices are below the face
+  otherFrame->setShape(
+      std::make_shared<MeshShape>(5.0 * Eigen::Vector3d::Ones(), aiscene));
+  otherFrame->setTranslation(Eigen::Vector3d(0.2, 0.0, 0.55));
+  result.clear();
+  EXPECT_TRUE(group->collide(option, &result));
+  EXPECT_EQ(result.getNumContacts(), 4u);
+  for (const auto& contact : result.getContacts())
+    EXPECT_NEAR(contact.penetrationDepth, 0.05, 1e-3);
+
+  // Box and capsule in the same pose
+  otherFrame->setShape(
+      std::make_shared<BoxShape>(Eigen::Vector3d::Constant(0.2)));
+  result.clear();
+  EXPECT_TRUE(group->collide(option, &result));
+  EXPECT_EQ(result.getNumContacts(), 8u);
+  for (const auto& contact : result.getContacts())
+    EXPECT_NEAR(contact.penetrationDepth, 0.05, 1e-3);
+
+  otherFrame->setShape(std::make_shared<CapsuleShape>(0.1, 0.2));
+  otherFrame->setTranslation(Eigen::Vector3d(0.0, 0.0, 0.65));
+  result.clear();
+  EXPECT_TRUE(group->collide(option, &result));
+  ASSERT_EQ(result.getNumContacts(), 1u);
+  EXPECT_NEAR(result.getContact(0).penetrationDepth, 0.05, 1e-3);
+
+  // The other detectors approximate the field by the box of its grid
+  std::vector<collision::CollisionDetectorPtr> approximatingDetectors;
+  approximatingDetectors.push_back(FCLCollisionDetector::create());
+#if HAVE_BULLET
+  approximatingDetectors.push_back(BulletCollisionDetector::create());
+#endif
+  otherFrame->setShape(std::make_shared<SphereShape>(0.1));
+  for (const auto& detector : approximatingDetectors)
+  {
+    auto approximatedGroup
+        = detector->createCollisionGroup(sdfFrame.get(), otherFrame.get());
+
+    otherFrame->setTranslation(Eigen::Vector3d(0.0, 0.0, 0.75));
+    EXPECT_TRUE(approximatedGroup->collide());
+
+    otherFrame->setTranslation(Eigen::Vector3d(0.0, 0.0, 0.85));
+    EXPECT_FALSE(approximatedGroup->collide());
+  }
+}
+
+//==============================================================================
+TEST_F(Collision, SdfShapeApproximation)
+{
+  // Field of a ball of radius 0.4 sampled on the grid box [-0.6, 0.6]^3
+  const double voxelSize = 0.05;
+  const Eigen::Vector3i dimensions = Eigen::Vector3i::Constant(25);
+  const Eigen::Vector3d origin = Eigen::Vector3d::Constant(-0.6);
+  std::vector<double> values;
+  for (int k = 0; k < dimensions.z(); ++k)
+  {
+    for (int j = 0; j < dimensions.y(); ++j)
+    {
+      for (int i = 0; i < dimensions.x(); ++i)
+      {
+        const Eigen::Vector3d node
+            = origin + voxelSize * Eigen::Vector3d(i, j, k);
+        values.push_back(node.norm() - 0.4);
+      }
+    }
+  }
+  const auto sdf = std::make_shared<SdfShape>(
+      origin, voxelSize, dimensions, std::move(values));
+  const math::BoundingBox& gridBox = sdf->getBoundingBox();
+
+  auto sdfFrame = SimpleFrame::createShared(Frame::World());
+  sdfFrame->setShape(sdf);
+  auto sphereFrame = SimpleFrame::createShared(Frame::World());
+  sphereFrame->setShape(std::make_shared<SphereShape>(0.1));
+
+  auto cd = DARTCollisionDetector::create();
+  auto exactGroup = cd->createCollisionGroup(sdfFrame.get(), sphereFrame.get());
+
+  // The detectors that approximate the field by its grid box
+  std::vector<collision::CollisionDetectorPtr> approximatingDetectors;
+  auto fcl_mesh = FCLCollisionDetector::create();
+  fcl_mesh->setPrimitiveShapeType(FCLCollisionDetector::MESH);
+  approximatingDetectors.push_back(fcl_mesh);
+  auto fcl_prim = FCLCollisionDetector::create();
+  fcl_prim->setPrimitiveShapeType(FCLCollisionDetector::PRIMITIVE);
+  approximatingDetectors.push_back(fcl_prim);
+#if HAVE_BULLET
+  approximatingDetectors.push_back(BulletCollisionDetector::create());
+#endif
+  std::vector<collision::CollisionGroupPtr> approximatedGroups;
+  for (const auto& detector : approximatingDetectors)
+  {
+    approximatedGroups.push_back(
+        detector->createCollisionGroup(sdfFrame.get(), sphereFrame.get()));
+  }
+
+  // Move the sphere through the ball, the empty corners of the grid box and
+  // the space around it. Wherever the exact query finds contacts, they lie in
+  // the grid box and the approximating detectors collide as well.
+  collision::CollisionOption option;
+  option.maxNumContacts = 100u;
+  std::size_t numExactHits = 0u;
+  std::size_t numApproximateOnlyHits = 0u;
+  for (int i = 0; i <= 16; ++i)
+  {
+    for (int k = 0; k <= 16; ++k)
+    {
+      const Eigen::Vector3d position(0.05 * i, 0.02, 0.05 * k);
+      sphereFrame->setTranslation(position);
+
+      collision::CollisionResult exactResult;
+      const bool exactHit = exactGroup->collide(option, &exactResult);
+      if (exactHit)
+      {
+        ++numExactHits;
+        for (const auto& contact : exactResult.getContacts())
+        {
+          EXPECT_TRUE(
+              (contact.point.array() >= gridBox.getMin().array() - 1e-6).all()
+              && (contact.point.array() <= gridBox.getMax().array() + 1e-6)
+                     .all());
+        }
+      }
+
+      for (const auto& approximatedGroup : approximatedGroups)
+      {
+        const bool approximateHit = approximatedGroup->collide();
+        if (exactHit)
+          EXPECT_TRUE(approximateHit) << "Sphere at " << position.transpose();
+        else if (approximateHit)
+          ++numApproximateOnlyHits;
+      }
+    }
+  }
+
+  // Both the ball and the empty corners of the grid box were visited
+  EXPECT_GT(numExactHits, 0u);
+  EXPECT_GT(numApproximateOnlyHits, 0u);
+}
+
 //==============================================================================
 TEST_F(Collision, Factory)
 {
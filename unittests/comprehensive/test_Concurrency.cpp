@@ -30,11 +30,15 @@
  *   POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <atomic>
 #include <chrono>
 #include <future>
+#include <stdexcept>
+#include <thread>
 
 #include <gtest/gtest.h>
 
+#include "dart/common/ThreadPool.hpp"
 #include "dart/simulation/World.hpp"
 
 #include "TestHelpers.hpp"
@@ -78,3 +82,149 @@ TEST(Concurrency, FrameDeletion)
   EXPECT_EQ(Frame::World()->getNumChildEntities(), 0);
   EXPECT_EQ(Frame::World()->getNumChildFrames(), 0);
 }
+
+//==============================================================================
+TEST(Concurrency, ThreadPool)
+{
+  common::ThreadPool pool(4u);
+  EXPECT_EQ(pool.getNumThreads(), 4u);
+
+  for (std::size_t count : {0u, 1u, 7u, 1000u})
+  {
+    std::vector<std::atomic<int>> calls(count);
+    for (auto& numCalls : calls)
+      numCalls = 0;
+
+    pool.parallelFor(count, [&](std::size_t i) {
+      ++calls[i];
+
+      // Nested loops fall back on serial execution
+      std::atomic<int> nested{0};
+      pool.parallelFor(3u, [&](std::size_t) { ++nested; });
+      EXPECT_EQ(nested, 3);
+    });
+
+    for (const auto& numCalls : calls)
+      EXPECT_EQ(numCalls, 1);
+  }
+
+  // Exceptions are rethrown on the calling thread, and the pool stays usable
+  for (std::size_t thrower : {0u, 5u, 999u})
+  {
+    EXPECT_THROW(
+        pool.parallelFor(
+            1000u,
+            [&](std::size_t i) {
+              if (i == thrower)
+                throw std::runtime_error("task failed");
+            }),
+        std::runtime_error);
+
+    std::atomic<int> numCalls{0};
+    pool.parallelFor(10u, [&](std::size_t) { ++numCalls; });
+    EXPECT_EQ(numCalls, 10);
+  }
+}
+
+//==============================================================================
+SkeletonPtr createMultiTreeSkeleton(std::size_t numTrees, std::size_t length)
+{
+  SkeletonPtr skel = Skeleton::create();
+
+  for (std::size_t tree = 0u; tree < numTrees; ++tree)
+  {
+    BodyNode* bn = skel->createJointAndBodyNodePair<FreeJoint>().second;
+    for (std::size_t i = 1u; i < length; ++i)
+    {
+      RevoluteJoint::Properties joint;
+      joint.mT_ParentBodyToJoint.translation() = Eigen::Vector3d::Random();
+      joint.mAxis = Eigen::Vector3d::Random().normalized();
+      bn = skel->createJointAndBodyNodePair<RevoluteJoint>(bn, joint).second;
+      bn->setMass(1.0 + static_cast<double>(i));
+    }
+  }
+
+  return skel;
+}
+
+//==============================================================================
+TEST(Concurrency, ParallelTreeDynamics)
+{
+  SkeletonPtr skel = createMultiTreeSkeleton(8u, 5u);
+  ASSERT_EQ(skel->getNumTrees(), 8u);
+
+  // Skeletons only use a thread pool on request
+  EXPECT_EQ(skel->getThreadPool(), nullptr);
+
+  const auto pool = std::make_shared<common::ThreadPool>(4u);
+  const std::size_t numDofs = skel->getNumDofs();
+
+  for (std::size_t i = 0u; i < 10u; ++i)
+  {
+    skel->setPositions(Eigen::VectorXd::Random(numDofs));
+    skel->setVelocities(Eigen::VectorXd::Random(numDofs));
+    skel->setForces(Eigen::VectorXd::Random(numDofs));
+
+    // The trees are processed in the same way, so the results are exact
+    skel->setThreadPool(nullptr);
+    EXPECT_EQ(skel->getThreadPool(), nullptr);
+    skel->computeForwardDynamics();
+    const Eigen::VectorXd serialAccelerations = skel->getAccelerations();
+
+    skel->setThreadPool(pool);
+    skel->computeForwardDynamics();
+    EXPECT_EQ(skel->getAccelerations(), serialAccelerations);
+
+    for (std::size_t j = 0u; j < skel->getNumBodyNodes(); ++j)
+      skel->getBodyNode(j)->setConstraintImpulse(Eigen::Vector6d::Random());
+
+    const Skeleton::Configuration config = skel->getConfiguration();
+
+    skel->setThreadPool(nullptr);
+    skel->computeImpulseForwardDynamics();
+    const Skeleton::Configuration serialResult = skel->getConfiguration();
+
+    skel->setConfiguration(config);
+    skel->setThreadPool(pool);
+    skel->computeImpulseForwardDynamics();
+    EXPECT_TRUE(skel->getConfiguration() == serialResult);
+  }
+}
+
+//==============================================================================
+TEST(Concurrency, ParallelTreeDynamicsSignals)
+{
+  SkeletonPtr skel = createMultiTreeSkeleton(8u, 5u);
+  skel->setThreadPool(std::make_shared<common::ThreadPool>(4u));
+
+  // The slots connected to the Frames of the Skeleton are called on the
+  // calling thread, which makes the trees be processed serially. The slots
+  // are slow so that the workers would pick up the other trees otherwise.
+  const std::thread::id callerId = std::this_thread::get_id();
+  std::atomic<int> numCalls{0};
+  std::atomic<int> numForeignCalls{0};
+  std::vector<SimpleFramePtr> frames;
+  std::vector<common::Connection> connections;
+  for (std::size_t tree = 0u; tree < skel->getNumTrees(); ++tree)
+  {
+    frames.push_back(
+        SimpleFrame::createShared(skel->getTreeBodyNodes(tree).back()));
+    connections.push_back(
+        frames.back()->onAccelerationChanged.connect([&](const Entity*) {
+          ++numCalls;
+          if (std::this_thread::get_id() != callerId)
+            ++numForeignCalls;
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }));
+  }
+
+  skel->setForces(Eigen::VectorXd::Random(skel->getNumDofs()));
+  for (const auto& frame : frames)
+    frame->getSpatialAcceleration();
+  skel->computeForwardDynamics();
+  EXPECT_GT(numCalls, 0);
+  EXPECT_EQ(numForeignCalls, 0);
+
+  for (auto& connection : connections)
+    connection.disconnect();
+}
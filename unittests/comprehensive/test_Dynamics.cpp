@@ -39,6 +39,8 @@
 
 #include "dart/common/Console.hpp"
 #include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/Group.hpp"
+#include "dart/dynamics/InverseDynamics.hpp"
 #include "dart/dynamics/SimpleFrame.hpp"
 #include "dart/dynamics/Skeleton.hpp"
 #include "dart/math/Geometry.hpp"
@@ -99,12 +101,20 @@ public:
   // force vector.
   void compareEquationsOfMotion(const common::Uri& uri);
 
+  // Compare the inverse dynamics computed for a whole trajectory with the one
+  // computed sample by sample.
+  void compareTrajectoryInverseDynamics(const common::Uri& uri);
+
   // Test skeleton's COM and its related quantities.
   void testCenterOfMass(const common::Uri& uri);
 
   // Test if the com acceleration is equal to the gravity
   void testCenterOfMassFreeFall(const common::Uri& uri);
 
+  // Compare the centroidal momentum quantities with the momenta of the
+  // BodyNodes.
+  void testCentroidalDynamics(const common::Uri& uri);
+
   //
   void testConstraintImpulse(const common::Uri& uri);
 
@@ -1902,6 +1912,96 @@ void compareCOMJacobianToFk(
         comLinearAccJac);
 }
 
+//==============================================================================
+void DynamicsTest::compareTrajectoryInverseDynamics(const common::Uri& uri)
+{
+  using namespace dart;
+  using namespace math;
+  using namespace dynamics;
+
+  //---------------------------- Settings --------------------------------------
+  // Number of samples of the trajectory for each skeletons
+#ifndef NDEBUG // Debug mode
+  const int numSamples = 4;
+#else
+  const int numSamples = 100;
+#endif
+
+  // Lower and upper bound of configuration for system
+  double lb = -1.0 * constantsd::pi();
+  double ub = 1.0 * constantsd::pi();
+
+  //----------------------------- Tests ----------------------------------------
+  simulation::WorldPtr myWorld = utils::SkelParser::readWorld(uri);
+  EXPECT_TRUE(myWorld != nullptr);
+
+  for (std::size_t i = 0; i < myWorld->getNumSkeletons(); ++i)
+  {
+    SkeletonPtr skel = myWorld->getSkeleton(i);
+    const int dof = static_cast<int>(skel->getNumDofs());
+    if (dof == 0)
+      continue;
+
+    // Random joint stiffness and damping coefficient, and external forces
+    for (std::size_t k = 0; k < skel->getNumJoints(); ++k)
+    {
+      Joint* joint = skel->getJoint(k);
+      for (std::size_t l = 0; l < joint->getNumDofs(); ++l)
+      {
+        joint->setDampingCoefficient(l, Random::uniform(0.0, 10.0));
+        joint->setSpringStiffness(l, Random::uniform(0.0, 10.0));
+      }
+    }
+    for (std::size_t k = 0; k < skel->getNumBodyNodes(); ++k)
+    {
+      skel->getBodyNode(k)->addExtForce(
+          Random::uniform<Eigen::Vector3d>(-1.0, 1.0),
+          Random::uniform<Eigen::Vector3d>(-0.1, 0.1),
+          true,
+          true);
+    }
+
+    Eigen::MatrixXd positions(dof, numSamples);
+    Eigen::MatrixXd velocities(dof, numSamples);
+    Eigen::MatrixXd accelerations(dof, numSamples);
+    for (int j = 0; j < numSamples; ++j)
+    {
+      positions.col(j) = Random::uniform<Eigen::VectorXd>(dof, lb, ub);
+      velocities.col(j) = Random::uniform<Eigen::VectorXd>(dof, lb, ub);
+      accelerations.col(j) = Random::uniform<Eigen::VectorXd>(dof, lb, ub);
+    }
+
+    const Eigen::VectorXd initialPositions = skel->getPositions();
+    const Eigen::MatrixXd forces = skel->computeInverseDynamics(
+        positions, velocities, accelerations, true, true, true);
+    ASSERT_EQ(forces.rows(), dof);
+    ASSERT_EQ(forces.cols(), numSamples);
+    EXPECT_TRUE(equals(skel->getPositions(), initialPositions));
+
+    // A serial flattened model gives the same forces
+    if (InverseDynamics::isSupported(*skel))
+    {
+      const InverseDynamics inverseDynamics(*skel, true, true, true);
+      Eigen::MatrixXd serialForces;
+      inverseDynamics.compute(
+          positions, velocities, accelerations, serialForces);
+      EXPECT_TRUE(equals(serialForces, forces));
+    }
+
+    for (int j = 0; j < numSamples; ++j)
+    {
+      skel->setPositions(positions.col(j));
+      skel->setVelocities(velocities.col(j));
+      skel->setAccelerations(accelerations.col(j));
+      skel->computeInverseDynamics(true, true, true);
+
+      const Eigen::VectorXd tau = skel->getForces();
+      EXPECT_LE(
+          (forces.col(j) - tau).norm(), 1e-9 * std::max(1.0, tau.norm()));
+    }
+  }
+}
+
 //==============================================================================
 void DynamicsTest::testCenterOfMass(const common::Uri& uri)
 {
@@ -2181,6 +2281,115 @@ void DynamicsTest::testCenterOfMassFreeFall(const common::Uri& uri)
   }
 }
 
+//==============================================================================
+void DynamicsTest::testCentroidalDynamics(const common::Uri& uri)
+{
+  using namespace dart;
+  using namespace math;
+  using namespace dynamics;
+
+  //---------------------------- Settings --------------------------------------
+  // Number of random state tests for each skeletons
+#ifndef NDEBUG // Debug mode
+  const std::size_t nRandomItr = 2;
+#else
+  const std::size_t nRandomItr = 20;
+#endif
+
+  // Lower and upper bound of configuration for system
+  const double lb = -1.5 * constantsd::pi();
+  const double ub = 1.5 * constantsd::pi();
+
+  const double tol = 1e-6;
+
+  //----------------------------- Tests ----------------------------------------
+  simulation::WorldPtr myWorld = utils::SkelParser::readWorld(uri);
+  EXPECT_TRUE(myWorld != nullptr);
+
+  for (std::size_t i = 0; i < myWorld->getNumSkeletons(); ++i)
+  {
+    SkeletonPtr skel = myWorld->getSkeleton(i);
+    const std::size_t dof = skel->getNumDofs();
+    if (dof == 0 || skel->getMass() == 0.0)
+      continue;
+
+    GroupPtr group = Group::create("group", skel->getBodyNodes());
+    ASSERT_EQ(group->getNumDofs(), dof);
+    ASSERT_EQ(group->getNumBodyNodes(), skel->getNumBodyNodes());
+
+    for (std::size_t j = 0; j < nRandomItr; ++j)
+    {
+      skel->setPositions(Random::uniform<Eigen::VectorXd>(dof, lb, ub));
+      skel->setVelocities(Random::uniform<Eigen::VectorXd>(dof, lb, ub));
+      skel->setAccelerations(Random::uniform<Eigen::VectorXd>(dof, lb, ub));
+
+      const Eigen::VectorXd dq = skel->getVelocities();
+      const Eigen::VectorXd ddq = skel->getAccelerations();
+      const Eigen::Vector3d com = skel->getCOM();
+
+      // Sum the momenta of the BodyNodes and their rates of change about the
+      // COM
+      Eigen::Vector6d momentum = Eigen::Vector6d::Zero();
+      Eigen::Vector6d momentumRate = Eigen::Vector6d::Zero();
+      for (std::size_t k = 0; k < skel->getNumBodyNodes(); ++k)
+      {
+        const BodyNode* bn = skel->getBodyNode(k);
+        Eigen::Isometry3d T = bn->getWorldTransform();
+        T.translation() -= com;
+
+        const Eigen::Matrix6d& I = bn->getSpatialInertia();
+        const Eigen::Vector6d& V = bn->getSpatialVelocity();
+        const Eigen::Vector6d& dV = bn->getSpatialAcceleration();
+        momentum += dAdInvT(T, I * V);
+        momentumRate += dAdInvT(T, I * dV - dad(V, I * V));
+      }
+
+      const Eigen::MatrixXd A = skel->getCentroidalMomentumMatrix();
+      const Eigen::Vector6d bias = skel->getCentroidalMomentumBias();
+      const Eigen::Matrix6d inertia = skel->getCentroidalInertia();
+      ASSERT_EQ(A.rows(), 6);
+      ASSERT_EQ(A.cols(), static_cast<int>(dof));
+
+      EXPECT_TRUE(equals(skel->getCentroidalMomentum(), momentum, tol));
+      EXPECT_TRUE(equals(
+          Eigen::Vector6d(A * ddq + bias), momentumRate, tol));
+
+      // The linear momentum is carried by the COM
+      EXPECT_TRUE(equals(
+          Eigen::Vector3d(momentum.tail<3>()),
+          Eigen::Vector3d(skel->getMass() * skel->getCOMLinearVelocity()),
+          tol));
+      EXPECT_TRUE(equals(
+          Eigen::Vector3d(momentumRate.tail<3>()),
+          Eigen::Vector3d(
+              skel->getMass() * skel->getCOMLinearAcceleration()),
+          tol));
+
+      // The centroidal inertia has no coupling between the angular and the
+      // linear parts
+      EXPECT_TRUE(equals(
+          Eigen::Matrix3d(inertia.bottomRightCorner<3, 3>()),
+          Eigen::Matrix3d(skel->getMass() * Eigen::Matrix3d::Identity()),
+          tol));
+      EXPECT_TRUE(inertia.topRightCorner(3, 3).isZero(tol));
+      EXPECT_TRUE(inertia.bottomLeftCorner(3, 3).isZero(tol));
+
+      // A Group of the whole Skeleton gives the same quantities
+      EXPECT_TRUE(equals(group->getCentroidalMomentumMatrix(), A, tol));
+      EXPECT_TRUE(equals(group->getCentroidalMomentumBias(), bias, tol));
+      EXPECT_TRUE(equals(group->getCentroidalInertia(), inertia, tol));
+
+      // The cached quantities follow velocity-only changes
+      skel->setVelocities(Random::uniform<Eigen::VectorXd>(dof, lb, ub));
+      EXPECT_TRUE(equals(skel->getCentroidalMomentumMatrix(), A, tol));
+      EXPECT_TRUE(equals(
+          skel->getCentroidalMomentumBias(),
+          group->getCentroidalMomentumBias(),
+          tol));
+    }
+  }
+}
+
 //==============================================================================
 void DynamicsTest::testConstraintImpulse(const common::Uri& uri)
 {
@@ -2449,6 +2658,18 @@ TEST_F(DynamicsTest, compareEquationsOfMotion)
   }
 }
 
+//==============================================================================
+TEST_F(DynamicsTest, compareTrajectoryInverseDynamics)
+{
+  for (std::size_t i = 0; i < getList().size(); ++i)
+  {
+#ifndef NDEBUG
+    dtdbg << getList()[i].toString() << std::endl;
+#endif
+    compareTrajectoryInverseDynamics(getList()[i]);
+  }
+}
+
 //==============================================================================
 TEST_F(DynamicsTest, testCenterOfMass)
 {
@@ -2473,6 +2694,18 @@ TEST_F(DynamicsTest, testCenterOfMassFreeFall)
   }
 }
 
+//==============================================================================
+TEST_F(DynamicsTest, testCentroidalDynamics)
+{
+  for (std::size_t i = 0; i < getList().size(); ++i)
+  {
+#ifndef NDEBUG
+    dtdbg << getList()[i].toString() << std::endl;
+#endif
+    testCentroidalDynamics(getList()[i]);
+  }
+}
+
 //==============================================================================
 TEST_F(DynamicsTest, testConstraintImpulse)
 {
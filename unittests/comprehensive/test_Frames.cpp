@@ -842,3 +842,29 @@ TEST(FRAMES, CHILDHOOD)
 
   EXPECT_TRUE(F1.getNumChildFrames() == 1);
 }
+
+TEST(FRAMES, WORLD_TRANSFORM_VERSION)
+{
+  SimpleFrame F1(Frame::World(), "F1");
+  SimpleFrame F2(&F1, "F2");
+
+  const std::size_t version1 = F1.getWorldTransformVersion();
+  const std::size_t version2 = F2.getWorldTransformVersion();
+
+  // Setting the same transform again does not count as a change
+  F1.setTranslation(Eigen::Vector3d::Zero());
+  EXPECT_EQ(F1.getWorldTransformVersion(), version1);
+  EXPECT_EQ(F2.getWorldTransformVersion(), version2);
+
+  // Moving a parent changes the world transforms of its children as well
+  F1.setTranslation(Eigen::Vector3d::UnitX());
+  EXPECT_NE(F1.getWorldTransformVersion(), version1);
+  EXPECT_NE(F2.getWorldTransformVersion(), version2);
+
+  // Moving a child does not affect its parent
+  const std::size_t version3 = F1.getWorldTransformVersion();
+  const std::size_t version4 = F2.getWorldTransformVersion();
+  F2.setTranslation(Eigen::Vector3d::UnitY());
+  EXPECT_EQ(F1.getWorldTransformVersion(), version3);
+  EXPECT_NE(F2.getWorldTransformVersion(), version4);
+}
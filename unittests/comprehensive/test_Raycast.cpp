@@ -239,3 +239,246 @@ TEST(Raycast, testOptions)
   auto dart = DARTCollisionDetector::create();
   testOptions(dart);
 }
+
+//==============================================================================
+void testRaycastBatch(const std::shared_ptr<CollisionDetector>& cd)
+{
+  auto sphereFrame = SimpleFrame::createShared(Frame::World());
+  sphereFrame->setShape(std::make_shared<SphereShape>(1.0));
+
+  auto boxFrame = SimpleFrame::createShared(Frame::World());
+  boxFrame->setShape(std::make_shared<BoxShape>(Eigen::Vector3d(2, 2, 2)));
+  boxFrame->setTranslation(Eigen::Vector3d(5, 0, 0));
+
+  auto cylinderFrame = SimpleFrame::createShared(Frame::World());
+  cylinderFrame->setShape(std::make_shared<CylinderShape>(0.5, 2.0));
+  cylinderFrame->setTranslation(Eigen::Vector3d(0, -5, 0));
+
+  auto capsuleFrame = SimpleFrame::createShared(Frame::World());
+  capsuleFrame->setShape(std::make_shared<CapsuleShape>(0.5, 1.0));
+  capsuleFrame->setTranslation(Eigen::Vector3d(5, 5, 0));
+
+  auto group = cd->createCollisionGroup(
+      sphereFrame.get(),
+      boxFrame.get(),
+      cylinderFrame.get(),
+      capsuleFrame.get());
+
+  const std::vector<Eigen::Vector3d> origins{Eigen::Vector3d(-3, 0, 0),
+                                             Eigen::Vector3d(2.5, 0, 0),
+                                             Eigen::Vector3d(0, 0, 5),
+                                             Eigen::Vector3d(0, 5, 0),
+                                             Eigen::Vector3d(-20, 0, 0),
+                                             Eigen::Vector3d(0, -5, 5),
+                                             Eigen::Vector3d(-3, -5, 0),
+                                             Eigen::Vector3d(5, 5, 5)};
+  const std::vector<Eigen::Vector3d> directions{Eigen::Vector3d::UnitX(),
+                                                Eigen::Vector3d::UnitX(),
+                                                -Eigen::Vector3d::UnitZ(),
+                                                Eigen::Vector3d::UnitY(),
+                                                Eigen::Vector3d::UnitX(),
+                                                -Eigen::Vector3d::UnitZ(),
+                                                Eigen::Vector3d::UnitX(),
+                                                -Eigen::Vector3d::UnitZ()};
+  const double inf = std::numeric_limits<double>::infinity();
+  const std::vector<double> expectedDistances{
+      2.0, 1.5, 4.0, inf, inf, 4.0, 2.5, 4.0};
+  const std::vector<Eigen::Vector3d> expectedNormals{-Eigen::Vector3d::UnitX(),
+                                                    -Eigen::Vector3d::UnitX(),
+                                                    Eigen::Vector3d::UnitZ(),
+                                                    Eigen::Vector3d::Zero(),
+                                                    Eigen::Vector3d::Zero(),
+                                                    Eigen::Vector3d::UnitZ(),
+                                                    -Eigen::Vector3d::UnitX(),
+                                                    Eigen::Vector3d::UnitZ()};
+  const std::vector<const dynamics::ShapeFrame*> expectedShapeFrames{
+      sphereFrame.get(),
+      boxFrame.get(),
+      sphereFrame.get(),
+      nullptr,
+      nullptr,
+      cylinderFrame.get(),
+      cylinderFrame.get(),
+      capsuleFrame.get()};
+
+  const std::size_t numRays = origins.size();
+  std::vector<double> distances(numRays);
+  std::vector<Eigen::Vector3d> normals(numRays);
+  std::vector<const dynamics::ShapeFrame*> shapeFrames(numRays);
+
+  EXPECT_EQ(
+      group->raycastBatch(
+          numRays,
+          origins.data(),
+          directions.data(),
+          10.0,
+          distances.data(),
+          normals.data(),
+          shapeFrames.data()),
+      6u);
+
+  for (std::size_t i = 0u; i < numRays; ++i)
+  {
+    if (expectedDistances[i] == inf)
+      EXPECT_EQ(distances[i], inf);
+    else
+      EXPECT_NEAR(distances[i], expectedDistances[i], 1e-3);
+    EXPECT_TRUE(equals(normals[i], expectedNormals[i], 1e-3));
+    EXPECT_EQ(shapeFrames[i], expectedShapeFrames[i]);
+  }
+
+  // The normals and the shape frames are optional
+  EXPECT_EQ(
+      group->raycastBatch(
+          numRays, origins.data(), directions.data(), 10.0, distances.data()),
+      6u);
+
+  // A fan of rays gives the same results with and without threads
+  const std::size_t numFanRays = 1000u;
+  std::vector<Eigen::Vector3d> fanOrigins(numFanRays, Eigen::Vector3d(2, 2, 0));
+  std::vector<Eigen::Vector3d> fanDirections(numFanRays);
+  for (std::size_t i = 0u; i < numFanRays; ++i)
+  {
+    const double angle = 2.0 * math::constantsd::pi() * i / numFanRays;
+    fanDirections[i] = Eigen::Vector3d(std::cos(angle), std::sin(angle), 0.0);
+  }
+
+  std::vector<double> serialDistances(numFanRays);
+  std::vector<const dynamics::ShapeFrame*> serialShapeFrames(numFanRays);
+  cd->setThreadPool(nullptr);
+  const auto numSerialHits = group->raycastBatch(
+      numFanRays,
+      fanOrigins.data(),
+      fanDirections.data(),
+      10.0,
+      serialDistances.data(),
+      nullptr,
+      serialShapeFrames.data());
+  EXPECT_LT(0u, numSerialHits);
+
+  std::vector<double> parallelDistances(numFanRays);
+  std::vector<const dynamics::ShapeFrame*> parallelShapeFrames(numFanRays);
+  cd->setThreadPool(std::make_shared<common::ThreadPool>(4u));
+  EXPECT_EQ(
+      group->raycastBatch(
+          numFanRays,
+          fanOrigins.data(),
+          fanDirections.data(),
+          10.0,
+          parallelDistances.data(),
+          nullptr,
+          parallelShapeFrames.data()),
+      numSerialHits);
+
+  EXPECT_EQ(parallelDistances, serialDistances);
+  EXPECT_EQ(parallelShapeFrames, serialShapeFrames);
+}
+
+//==============================================================================
+TEST(Raycast, RaycastBatch)
+{
+  auto fcl = FCLCollisionDetector::create();
+  testRaycastBatch(fcl);
+
+#if HAVE_BULLET
+  auto bullet = BulletCollisionDetector::create();
+  testRaycastBatch(bullet);
+#endif
+
+  auto dart = DARTCollisionDetector::create();
+  testRaycastBatch(dart);
+}
+
+//==============================================================================
+void testRaycastBatchCulling(const std::shared_ptr<CollisionDetector>& cd)
+{
+  // The rays cast through a field of shapes are culled by the broadphase of
+  // the group. Each ray has to hit what it hits when it is cast onto every
+  // shape on its own.
+  std::vector<SimpleFramePtr> frames;
+  std::vector<std::shared_ptr<CollisionGroup>> singleGroups;
+  auto group = cd->createCollisionGroup();
+  for (int i = 0; i < 64; ++i)
+  {
+    auto frame = SimpleFrame::createShared(Frame::World());
+    if (i % 2 == 0)
+      frame->setShape(std::make_shared<SphereShape>(0.3));
+    else
+      frame->setShape(
+          std::make_shared<BoxShape>(Eigen::Vector3d::Constant(0.5)));
+    frame->setTranslation(Eigen::Vector3d(i % 8, i / 8, 0.3 * std::sin(i)));
+    group->addShapeFrame(frame.get());
+    singleGroups.push_back(cd->createCollisionGroupAsSharedPtr(frame.get()));
+    frames.push_back(frame);
+  }
+
+  const std::size_t numRays = 400u;
+  std::vector<Eigen::Vector3d> origins(numRays);
+  std::vector<Eigen::Vector3d> directions(numRays);
+  for (std::size_t i = 0u; i < numRays; ++i)
+  {
+    const double angle = 2.0 * math::constantsd::pi() * i / numRays;
+    origins[i] = i % 2u == 0u ? Eigen::Vector3d(3.5, 3.5, 0.1)
+                              : Eigen::Vector3d(-2.0, 0.02 * i - 0.5, 0.0);
+    directions[i]
+        = Eigen::Vector3d(std::cos(angle), std::sin(angle), 0.1 * std::cos(i))
+              .normalized();
+  }
+
+  for (const double maxDistance :
+       {3.0, 20.0, std::numeric_limits<double>::infinity()})
+  {
+    std::vector<double> distances(numRays);
+    std::vector<const dynamics::ShapeFrame*> shapeFrames(numRays);
+    group->raycastBatch(
+        numRays,
+        origins.data(),
+        directions.data(),
+        maxDistance,
+        distances.data(),
+        nullptr,
+        shapeFrames.data());
+
+    for (std::size_t i = 0u; i < numRays; ++i)
+    {
+      double expectedDistance = std::numeric_limits<double>::infinity();
+      const dynamics::ShapeFrame* expectedShapeFrame = nullptr;
+      for (const auto& singleGroup : singleGroups)
+      {
+        double distance;
+        const dynamics::ShapeFrame* shapeFrame;
+        singleGroup->raycastBatch(
+            1u,
+            &origins[i],
+            &directions[i],
+            maxDistance,
+            &distance,
+            nullptr,
+            &shapeFrame);
+        if (distance < expectedDistance)
+        {
+          expectedDistance = distance;
+          expectedShapeFrame = shapeFrame;
+        }
+      }
+
+      EXPECT_EQ(distances[i], expectedDistance);
+      EXPECT_EQ(shapeFrames[i], expectedShapeFrame);
+    }
+  }
+}
+
+//==============================================================================
+TEST(Raycast, RaycastBatchCulling)
+{
+  auto fcl = FCLCollisionDetector::create();
+  testRaycastBatchCulling(fcl);
+
+#if HAVE_BULLET
+  auto bullet = BulletCollisionDetector::create();
+  testRaycastBatchCulling(bullet);
+#endif
+
+  auto dart = DARTCollisionDetector::create();
+  testRaycastBatchCulling(dart);
+}
@@ -856,6 +856,91 @@ TEST(Skeleton, Configurations)
   EXPECT_TRUE(c2.mAccelerations.size() == 0);
 }
 
+SkeletonPtr createTwoTreeSkeleton()
+{
+  SkeletonPtr skel = Skeleton::create("two_trees");
+
+  BodyNode* bn = skel->createJointAndBodyNodePair<FreeJoint>().second;
+  bn = skel->createJointAndBodyNodePair<RevoluteJoint>(bn).second;
+  bn = skel->createJointAndBodyNodePair<BallJoint>(bn).second;
+  bn->createShapeNodeWith<VisualAspect>(
+      std::make_shared<BoxShape>(Eigen::Vector3d::Ones()));
+
+  bn = skel->createJointAndBodyNodePair<RevoluteJoint>().second;
+  skel->createJointAndBodyNodePair<WeldJoint>(bn);
+  skel->createJointAndBodyNodePair<PrismaticJoint>(bn);
+
+  return skel;
+}
+
+TEST(Skeleton, BatchedStateWrites)
+{
+  SkeletonPtr batched = createTwoTreeSkeleton();
+  SkeletonPtr perDof = createTwoTreeSkeleton();
+  ASSERT_EQ(batched->getNumTrees(), 2u);
+
+  const std::size_t numDofs = batched->getNumDofs();
+
+  std::size_t numTransformSignals = 0u;
+  ShapeNode* shapeNode = batched->getBodyNode(2)->getShapeNode(0);
+  common::Connection connection = shapeNode->onTransformUpdated.connect(
+      [&](const Entity*) { ++numTransformSignals; });
+
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    const Eigen::VectorXd q = Eigen::VectorXd::Random(numDofs);
+    const Eigen::VectorXd dq = Eigen::VectorXd::Random(numDofs);
+    const Eigen::VectorXd ddq = Eigen::VectorXd::Random(numDofs);
+
+    batched->setPositions(q);
+    batched->setVelocities(dq);
+    batched->setAccelerations(ddq);
+
+    for (std::size_t j = 0; j < numDofs; ++j)
+    {
+      perDof->getDof(j)->setPosition(q[j]);
+      perDof->getDof(j)->setVelocity(dq[j]);
+      perDof->getDof(j)->setAcceleration(ddq[j]);
+    }
+
+    EXPECT_TRUE(equals(batched->getPositions(), q));
+    EXPECT_TRUE(equals(batched->getVelocities(), dq));
+    EXPECT_TRUE(equals(batched->getAccelerations(), ddq));
+
+    // The cached quantities must have been invalidated by the batched writes
+    for (std::size_t j = 0; j < batched->getNumBodyNodes(); ++j)
+    {
+      const BodyNode* bn1 = batched->getBodyNode(j);
+      const BodyNode* bn2 = perDof->getBodyNode(j);
+      EXPECT_TRUE(equals(
+          bn1->getWorldTransform().matrix(), bn2->getWorldTransform().matrix()));
+      EXPECT_TRUE(equals(bn1->getSpatialVelocity(), bn2->getSpatialVelocity()));
+      EXPECT_TRUE(equals(
+          bn1->getSpatialAcceleration(), bn2->getSpatialAcceleration()));
+      EXPECT_TRUE(equals(bn1->getJacobian(), bn2->getJacobian()));
+    }
+
+    EXPECT_TRUE(equals(batched->getMassMatrix(), perDof->getMassMatrix()));
+    EXPECT_TRUE(
+        equals(batched->getCoriolisForces(), perDof->getCoriolisForces()));
+    EXPECT_TRUE(equals(
+        shapeNode->getWorldTransform().matrix(),
+        perDof->getBodyNode(2)->getShapeNode(0)->getWorldTransform().matrix()));
+  }
+
+  // Subscribers are still notified of batched writes
+  EXPECT_GT(numTransformSignals, 0u);
+
+  // Writing the same state again must not invalidate anything
+  batched->getMassMatrix();
+  numTransformSignals = 0u;
+  batched->setPositions(batched->getPositions());
+  EXPECT_EQ(numTransformSignals, 0u);
+  EXPECT_FALSE(shapeNode->needsTransformUpdate());
+
+  connection.disconnect();
+}
+
 TEST(Skeleton, LinearJacobianDerivOverload)
 {
   // Regression test for #626: Make sure that getLinearJacobianDeriv's overload
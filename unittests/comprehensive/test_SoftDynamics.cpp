@@ -37,6 +37,7 @@
 #include <gtest/gtest.h>
 
 #include "dart/common/Console.hpp"
+#include "dart/dynamics/FreeJoint.hpp"
 #include "dart/dynamics/Joint.hpp"
 #include "dart/dynamics/PointMass.hpp"
 #include "dart/dynamics/Skeleton.hpp"
@@ -459,3 +460,127 @@ TEST_F(SoftDynamicsTest, compareEquationsOfMotion)
   //    compareEquationsOfMotion(getList()[i]);
   //  }
 }
+
+//==============================================================================
+dynamics::SkeletonPtr createSoftSphere(double edgeStiffness)
+{
+  dynamics::SkeletonPtr skel = dynamics::Skeleton::create("soft sphere");
+
+  dynamics::SoftBodyNode::Properties properties(
+      dynamics::BodyNode::Properties(
+          dynamics::BodyNode::AspectProperties("sphere")),
+      dynamics::SoftBodyNodeHelper::makeEllipsoidProperties(
+          Eigen::Vector3d::Constant(0.1),
+          6u,
+          6u,
+          0.1,
+          100.0,
+          edgeStiffness,
+          0.01));
+  skel->createJointAndBodyNodePair<
+      dynamics::FreeJoint,
+      dynamics::SoftBodyNode>(
+      nullptr, dynamics::FreeJoint::Properties(), properties);
+
+  return skel;
+}
+
+//==============================================================================
+TEST(SoftDynamics, ImplicitEdgeSprings)
+{
+  // Without edge springs the PointMasses are decoupled, so both integration
+  // schemes must agree
+  dynamics::SkeletonPtr skel = createSoftSphere(0.0);
+  dynamics::SoftBodyNode* softBody = skel->getSoftBodyNode(0);
+  EXPECT_FALSE(softBody->areEdgeSpringsImplicit());
+
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    skel->setPositions(Eigen::VectorXd::Random(skel->getNumDofs()));
+    skel->setVelocities(Eigen::VectorXd::Random(skel->getNumDofs()));
+    for (std::size_t j = 0; j < softBody->getNumPointMasses(); ++j)
+    {
+      dynamics::PointMass* pointMass = softBody->getPointMass(j);
+      pointMass->setPositions(0.01 * Eigen::Vector3d::Random());
+      pointMass->setVelocities(0.1 * Eigen::Vector3d::Random());
+    }
+
+    softBody->setImplicitEdgeSprings(false);
+    skel->computeForwardDynamics();
+    const Eigen::VectorXd ddq = skel->getAccelerations();
+    const Eigen::Vector3d ddqPointMass
+        = softBody->getPointMass(0)->getAccelerations();
+
+    softBody->setImplicitEdgeSprings(true);
+    skel->computeForwardDynamics();
+    EXPECT_TRUE(equals(skel->getAccelerations(), ddq, 1e-9));
+    EXPECT_TRUE(equals(
+        softBody->getPointMass(0)->getAccelerations(), ddqPointMass, 1e-9));
+  }
+
+  // Stiff edge springs stay bounded at a time step that is far beyond the
+  // stability limit of the explicit treatment
+  simulation::WorldPtr world = simulation::World::create();
+  world->setGravity(Eigen::Vector3d::Zero());
+  world->setTimeStep(1e-3);
+
+  skel = createSoftSphere(1e4);
+  softBody = skel->getSoftBodyNode(0);
+  softBody->setImplicitEdgeSprings(true);
+  EXPECT_TRUE(softBody->getSoftBodyNodeProperties().mImplicitEdgeSprings);
+  for (std::size_t j = 0; j < softBody->getNumPointMasses(); ++j)
+    softBody->getPointMass(j)->setPositions(1e-3 * Eigen::Vector3d::Random());
+  world->addSkeleton(skel);
+
+  for (std::size_t i = 0; i < 1000; ++i)
+    world->step();
+
+  for (std::size_t j = 0; j < softBody->getNumPointMasses(); ++j)
+  {
+    const Eigen::Vector3d& q = softBody->getPointMass(j)->getPositions();
+    EXPECT_FALSE(math::isNan(q));
+    EXPECT_LT(q.norm(), 1e-2);
+  }
+}
+
+//==============================================================================
+TEST(SoftDynamics, PointMassView)
+{
+  dynamics::SkeletonPtr skel = createSoftSphere(10.0);
+  dynamics::SoftBodyNode* softBody = skel->getSoftBodyNode(0);
+  const double dt = skel->getTimeStep();
+  const double kv = softBody->getVertexSpringStiffness();
+  const double kd = softBody->getDampingCoefficient();
+
+  skel->setPositions(Eigen::VectorXd::Random(skel->getNumDofs()));
+  skel->setVelocities(Eigen::VectorXd::Random(skel->getNumDofs()));
+  for (std::size_t i = 0; i < softBody->getNumPointMasses(); ++i)
+  {
+    dynamics::PointMass* pointMass = softBody->getPointMass(i);
+    pointMass->setPositions(0.01 * Eigen::Vector3d::Random());
+    pointMass->setVelocities(0.1 * Eigen::Vector3d::Random());
+  }
+  skel->computeForwardDynamics();
+
+  // The per-vertex values read back from the batched passes of the
+  // SoftBodyNode
+  const Eigen::Vector6d& a = softBody->getSpatialAcceleration();
+  for (std::size_t i = 0; i < softBody->getNumPointMasses(); ++i)
+  {
+    const dynamics::PointMass* pointMass = softBody->getPointMass(i);
+    const double mass = pointMass->getMass();
+    const double implicitPsi = 1.0 / (mass + dt * kd + dt * dt * kv);
+
+    EXPECT_NEAR(pointMass->getPsi(), 1.0 / mass, 1e-12);
+    EXPECT_NEAR(pointMass->getImplicitPsi(), implicitPsi, 1e-12);
+    EXPECT_NEAR(
+        pointMass->getImplicitPi(), mass - mass * mass * implicitPsi, 1e-12);
+
+    const Eigen::Vector3d bodyAcceleration
+        = a.head<3>().cross(pointMass->getLocalPosition()) + a.tail<3>()
+          + pointMass->getPartialAccelerations()
+          + pointMass->getAccelerations();
+    EXPECT_TRUE(
+        equals(pointMass->getBodyAcceleration(), bodyAcceleration, 1e-12));
+  }
+}
@@ -35,9 +35,15 @@
 #include "TestHelpers.hpp"
 
 #include "dart/collision/collision.hpp"
+#include "dart/dynamics/BallJoint.hpp"
 #include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/EulerJoint.hpp"
+#include "dart/dynamics/FreeJoint.hpp"
+#include "dart/dynamics/PlanarJoint.hpp"
+#include "dart/dynamics/PrismaticJoint.hpp"
 #include "dart/dynamics/RevoluteJoint.hpp"
 #include "dart/dynamics/Skeleton.hpp"
+#include "dart/dynamics/UniversalJoint.hpp"
 #include "dart/math/Geometry.hpp"
 #include "dart/utils/SkelParser.hpp"
 #if HAVE_BULLET
@@ -47,6 +53,9 @@
 #include "dart/constraint/BoxedLcpConstraintSolver.hpp"
 #include "dart/constraint/DantzigBoxedLcpSolver.hpp"
 #include "dart/constraint/PgsBoxedLcpSolver.hpp"
+#include "dart/integration/ImplicitMidpointIntegrator.hpp"
+#include "dart/integration/RK4Integrator.hpp"
+#include "dart/integration/SemiImplicitEulerIntegrator.hpp"
 #include "dart/simulation/World.hpp"
 
 using namespace dart;
@@ -180,6 +189,83 @@ TEST(World, AddingAndRemovingSkeletons)
   skeleton1->setName(skeleton4->getName());
 }
 
+//==============================================================================
+TEST(World, AddingAndRemovingSkeletonsInBulk)
+{
+  WorldPtr world = World::create();
+
+  const std::size_t numSkeletons = 50u;
+  std::vector<SkeletonPtr> skeletons;
+  for (std::size_t i = 0u; i < numSkeletons; ++i)
+  {
+    skeletons.push_back(createBox(
+        Eigen::Vector3d::Constant(0.1),
+        Eigen::Vector3d(0.5 * static_cast<double>(i), 0.0, 0.0)));
+  }
+
+  // Skeletons with the same name get unique names, and adding a skeleton
+  // twice is a no-op
+  std::vector<SkeletonPtr> toAdd = skeletons;
+  toAdd.push_back(skeletons.front());
+  const auto names = world->addSkeletons(toAdd);
+  ASSERT_EQ(names.size(), numSkeletons + 1u);
+  EXPECT_EQ(world->getNumSkeletons(), numSkeletons);
+  EXPECT_EQ(names.front(), names.back());
+
+  std::set<std::string> uniqueNames;
+  for (std::size_t i = 0u; i < numSkeletons; ++i)
+  {
+    EXPECT_TRUE(world->hasSkeleton(skeletons[i]));
+    EXPECT_EQ(world->getSkeleton(i), skeletons[i]);
+    EXPECT_EQ(world->getSkeleton(names[i]), skeletons[i]);
+    EXPECT_EQ(world->getIndex(static_cast<int>(i)), static_cast<int>(6u * i));
+    uniqueNames.insert(names[i]);
+  }
+  EXPECT_EQ(uniqueNames.size(), numSkeletons);
+
+  auto group = world->getConstraintSolver()->getCollisionGroup();
+  EXPECT_EQ(group->getNumShapeFrames(), numSkeletons);
+
+  // Remove every other skeleton
+  std::vector<SkeletonPtr> toRemove;
+  std::vector<SkeletonPtr> kept;
+  for (std::size_t i = 0u; i < numSkeletons; ++i)
+    (i % 2u == 0u ? toRemove : kept).push_back(skeletons[i]);
+
+  world->removeSkeletons(toRemove);
+  EXPECT_EQ(world->getNumSkeletons(), kept.size());
+  EXPECT_EQ(group->getNumShapeFrames(), kept.size());
+  for (std::size_t i = 0u; i < kept.size(); ++i)
+  {
+    EXPECT_EQ(world->getSkeleton(i), kept[i]);
+    EXPECT_EQ(world->getIndex(static_cast<int>(i)), static_cast<int>(6u * i));
+    EXPECT_TRUE(group->hasShapeFrame(kept[i]->getBodyNode(0)->getShapeNode(0)));
+  }
+  for (const auto& skeleton : toRemove)
+  {
+    EXPECT_FALSE(world->hasSkeleton(skeleton));
+    EXPECT_FALSE(
+        group->hasShapeFrame(skeleton->getBodyNode(0)->getShapeNode(0)));
+  }
+
+  world->step();
+
+  // The names of the removed skeletons can be issued again
+  world->addSkeletons(toRemove);
+  EXPECT_EQ(world->getNumSkeletons(), numSkeletons);
+  EXPECT_EQ(group->getNumShapeFrames(), numSkeletons);
+  uniqueNames.clear();
+  for (std::size_t i = 0u; i < numSkeletons; ++i)
+    uniqueNames.insert(world->getSkeleton(i)->getName());
+  EXPECT_EQ(uniqueNames.size(), numSkeletons);
+
+  world->step();
+
+  world->removeAllSkeletons();
+  EXPECT_EQ(world->getNumSkeletons(), 0u);
+  EXPECT_EQ(group->getNumShapeFrames(), 0u);
+}
+
 //==============================================================================
 TEST(World, Cloning)
 {
@@ -396,3 +482,556 @@ TEST(World, SetNewConstraintSolver)
   EXPECT_TRUE(world->getConstraintSolver()->getSkeletons().size() == 1);
   EXPECT_TRUE(world->getConstraintSolver()->getConstraints().size() == 1);
 }
+
+//==============================================================================
+SkeletonPtr createPendulumChain(std::size_t numLinks)
+{
+  auto skel = Skeleton::create("pendulum chain");
+
+  BodyNode* parent = nullptr;
+  for (std::size_t i = 0u; i < numLinks; ++i)
+  {
+    RevoluteJoint::Properties jointProps;
+    jointProps.mName = "joint" + std::to_string(i);
+    jointProps.mAxis = Eigen::Vector3d::UnitX();
+    if (parent)
+      jointProps.mT_ParentBodyToJoint.translation()
+          = Eigen::Vector3d(0.0, 0.0, -0.5);
+
+    BodyNode::Properties bodyProps;
+    bodyProps.mName = "body" + std::to_string(i);
+    bodyProps.mInertia.setMass(1.0);
+    bodyProps.mInertia.setLocalCOM(Eigen::Vector3d(0.0, 0.0, -0.25));
+
+    parent = skel->createJointAndBodyNodePair<RevoluteJoint>(
+                     parent, jointProps, bodyProps)
+                 .second;
+  }
+
+  skel->setPositions(Eigen::VectorXd::Constant(numLinks, 0.8));
+
+  return skel;
+}
+
+//==============================================================================
+double computeEnergy(const SkeletonPtr& skel)
+{
+  return skel->computeKineticEnergy()
+         - skel->getMass() * skel->getCOM().dot(skel->getGravity());
+}
+
+//==============================================================================
+double computeMaxEnergyDrift(
+    const std::shared_ptr<integration::Integrator>& integrator, double dt)
+{
+  auto world = World::create();
+  world->setTimeStep(dt);
+  world->setIntegrator(integrator);
+
+  auto skel = createPendulumChain(3u);
+  world->addSkeleton(skel);
+
+  const double energy0 = computeEnergy(skel);
+  double maxDrift = 0.0;
+  for (std::size_t i = 0u; i < 500u; ++i)
+  {
+    world->step();
+    maxDrift = std::max(maxDrift, std::abs(computeEnergy(skel) - energy0));
+  }
+
+  return maxDrift;
+}
+
+//==============================================================================
+TEST(World, SemiImplicitEulerIntegrator)
+{
+  // An explicit SemiImplicitEulerIntegrator reproduces the default scheme
+  auto world1 = createWorld();
+  auto world2 = createWorld();
+  world2->setIntegrator(
+      std::make_shared<integration::SemiImplicitEulerIntegrator>());
+
+  for (std::size_t i = 0u; i < 100u; ++i)
+  {
+    world1->step();
+    world2->step();
+  }
+
+  for (std::size_t i = 0u; i < world1->getNumSkeletons(); ++i)
+  {
+    EXPECT_TRUE(equals(
+        world1->getSkeleton(i)->getPositions(),
+        world2->getSkeleton(i)->getPositions(),
+        1e-12));
+    EXPECT_TRUE(equals(
+        world1->getSkeleton(i)->getVelocities(),
+        world2->getSkeleton(i)->getVelocities(),
+        1e-12));
+  }
+}
+
+//==============================================================================
+TEST(World, ImplicitMidpointIntegrator)
+{
+  const double dt = 0.01;
+  const double semiImplicitDrift = computeMaxEnergyDrift(nullptr, dt);
+
+  // The midpoint rule keeps the energy of the pendulum chain bounded
+  auto midpoint = std::make_shared<integration::ImplicitMidpointIntegrator>();
+  const double midpointDrift = computeMaxEnergyDrift(midpoint, dt);
+  EXPECT_LT(midpointDrift, 1e-2 * semiImplicitDrift);
+  EXPECT_LE(midpoint->getLastNumIterations(), midpoint->getMaxIterations());
+  EXPECT_TRUE(midpoint->hasConverged());
+
+  // A single iteration cannot reach the tolerance, which is reported
+  auto world = World::create();
+  world->setTimeStep(dt);
+  world->addSkeleton(createPendulumChain(3u));
+  auto truncated
+      = std::make_shared<integration::ImplicitMidpointIntegrator>(1u, 1e-14);
+  world->setIntegrator(truncated);
+  world->step();
+  EXPECT_FALSE(truncated->hasConverged());
+
+  // Clones of the World get their own copy of the integrator
+  world->setIntegrator(midpoint);
+  const auto clonedIntegrator = world->clone()->getIntegrator();
+  ASSERT_NE(clonedIntegrator, nullptr);
+  EXPECT_NE(clonedIntegrator, world->getIntegrator());
+  EXPECT_NE(
+      std::dynamic_pointer_cast<integration::ImplicitMidpointIntegrator>(
+          clonedIntegrator),
+      nullptr);
+
+  const double rk4Drift = computeMaxEnergyDrift(
+      std::make_shared<integration::RK4Integrator>(), dt);
+  EXPECT_LT(rk4Drift, 1e-2 * semiImplicitDrift);
+}
+
+//==============================================================================
+Eigen::VectorXd stepState(
+    const WorldPtr& world,
+    const SkeletonPtr& skel,
+    const Eigen::VectorXd& x,
+    const Eigen::VectorXd& u)
+{
+  const auto numDofs = static_cast<int>(skel->getNumDofs());
+  skel->setPositions(x.head(numDofs));
+  skel->setVelocities(x.tail(numDofs));
+  skel->setForces(u);
+  world->step();
+
+  Eigen::VectorXd next(2 * numDofs);
+  next << skel->getPositions(), skel->getVelocities();
+  return next;
+}
+
+//==============================================================================
+/// Take one differentiable step of world, which holds skel only, and compare
+/// its derivatives with central differences of the step
+void expectStepDerivativesMatchFiniteDifferences(
+    const WorldPtr& world, const SkeletonPtr& skel)
+{
+  const int numDofs = static_cast<int>(skel->getNumDofs());
+  world->setDifferentiable(true);
+
+  Eigen::VectorXd x(2 * numDofs);
+  x << skel->getPositions(), skel->getVelocities();
+  const Eigen::VectorXd u = skel->getForces();
+
+  world->step();
+  const StepDerivatives& derivatives = world->getStepDerivatives();
+  const Eigen::MatrixXd A = derivatives.getStateJacobian();
+  const Eigen::MatrixXd B = derivatives.getControlJacobian();
+
+  auto fdWorld = world->clone();
+  fdWorld->setDifferentiable(false);
+  auto fdSkel = fdWorld->getSkeleton(0);
+  const double eps = 1e-6;
+  for (int i = 0; i < 2 * numDofs; ++i)
+  {
+    const Eigen::VectorXd dx = eps * Eigen::VectorXd::Unit(2 * numDofs, i);
+    const Eigen::VectorXd column = (stepState(fdWorld, fdSkel, x + dx, u)
+                                    - stepState(fdWorld, fdSkel, x - dx, u))
+                                   / (2.0 * eps);
+    EXPECT_TRUE(equals(A.col(i), column, 1e-5)) << "state column " << i;
+  }
+  for (int i = 0; i < numDofs; ++i)
+  {
+    const Eigen::VectorXd du = eps * Eigen::VectorXd::Unit(numDofs, i);
+    const Eigen::VectorXd column = (stepState(fdWorld, fdSkel, x, u + du)
+                                    - stepState(fdWorld, fdSkel, x, u - du))
+                                   / (2.0 * eps);
+    EXPECT_TRUE(equals(B.col(i), column, 1e-5)) << "control column " << i;
+  }
+}
+
+//==============================================================================
+TEST(World, StepDerivatives)
+{
+  auto world = World::create();
+  world->setTimeStep(0.001);
+  auto skel = createPendulumChain(3u);
+  skel->setVelocities(Eigen::Vector3d(0.3, -0.2, 0.5));
+  skel->setForces(Eigen::Vector3d(0.1, 0.2, -0.1));
+  world->addSkeleton(skel);
+
+  EXPECT_FALSE(world->isDifferentiable());
+  world->setDifferentiable(true);
+  EXPECT_TRUE(world->isDifferentiable());
+  EXPECT_TRUE(world->clone()->isDifferentiable());
+
+  Eigen::VectorXd x(6);
+  x << skel->getPositions(), skel->getVelocities();
+  const Eigen::VectorXd u = skel->getForces();
+
+  world->step();
+  const StepDerivatives& derivatives = world->getStepDerivatives();
+  EXPECT_EQ(derivatives.getNumDofs(), 3u);
+  EXPECT_EQ(derivatives.getNumActiveConstraints(), 0u);
+  const Eigen::MatrixXd A = derivatives.getStateJacobian();
+  const Eigen::MatrixXd B = derivatives.getControlJacobian();
+
+  // Compare against central differences of whole steps
+  auto fdWorld = world->clone();
+  fdWorld->setDifferentiable(false);
+  auto fdSkel = fdWorld->getSkeleton(0);
+  const double eps = 1e-6;
+  Eigen::MatrixXd fdA(6, 6);
+  for (int i = 0; i < 6; ++i)
+  {
+    const Eigen::VectorXd dx = eps * Eigen::VectorXd::Unit(6, i);
+    fdA.col(i) = (stepState(fdWorld, fdSkel, x + dx, u)
+                  - stepState(fdWorld, fdSkel, x - dx, u))
+                 / (2.0 * eps);
+  }
+  Eigen::MatrixXd fdB(6, 3);
+  for (int i = 0; i < 3; ++i)
+  {
+    const Eigen::VectorXd du = eps * Eigen::VectorXd::Unit(3, i);
+    fdB.col(i) = (stepState(fdWorld, fdSkel, x, u + du)
+                  - stepState(fdWorld, fdSkel, x, u - du))
+                 / (2.0 * eps);
+  }
+  EXPECT_TRUE(equals(A, fdA, 1e-5));
+  EXPECT_TRUE(equals(B, fdB, 1e-5));
+
+  // The products agree with the dense Jacobians
+  const Eigen::VectorXd dx = Eigen::VectorXd::LinSpaced(6, -1.0, 1.0);
+  const Eigen::VectorXd du = Eigen::Vector3d(0.5, -0.25, 1.0);
+  EXPECT_TRUE(equals(derivatives.computeJvp(dx, du), A * dx + B * du, 1e-10));
+
+  const Eigen::VectorXd g = Eigen::VectorXd::LinSpaced(6, 1.0, 6.0);
+  Eigen::VectorXd stateGradient;
+  Eigen::VectorXd controlGradient;
+  derivatives.computeVjp(g, stateGradient, controlGradient);
+  EXPECT_TRUE(equals(stateGradient, A.transpose() * g, 1e-10));
+  EXPECT_TRUE(equals(controlGradient, B.transpose() * g, 1e-10));
+}
+
+//==============================================================================
+TEST(World, StepDerivativesThroughConstraintImpulses)
+{
+  auto world = World::create();
+  world->setTimeStep(0.001);
+  auto skel = createPendulumChain(4u);
+  skel->setVelocities(Eigen::Vector4d(0.3, -0.2, 0.5, 0.1));
+  world->addSkeleton(skel);
+
+  // Tilt one joint out of the plane of the others, so that the three rows of
+  // the constraint below are independent, and pin the tip of the chain to the
+  // world
+  static_cast<RevoluteJoint*>(skel->getJoint(1u))
+      ->setAxis(Eigen::Vector3d::UnitY());
+  BodyNode* tip = skel->getBodyNode(3u);
+  const Eigen::Vector3d pin
+      = tip->getTransform() * Eigen::Vector3d(0.0, 0.0, -0.5);
+  world->getConstraintSolver()->addConstraint(
+      std::make_shared<constraint::BallJointConstraint>(tip, pin));
+  world->setDifferentiable(true);
+
+  Eigen::VectorXd x(8);
+  x << skel->getPositions(), skel->getVelocities();
+  const Eigen::VectorXd u = skel->getForces();
+
+  world->step();
+  const StepDerivatives& derivatives = world->getStepDerivatives();
+  EXPECT_EQ(derivatives.getNumActiveConstraints(), 3u);
+  const Eigen::MatrixXd A = derivatives.getStateJacobian();
+  const Eigen::MatrixXd B = derivatives.getControlJacobian();
+
+  // The constraint Jacobian depends on the positions only, so the derivatives
+  // of the velocities with respect to the velocities and the forces are exact
+  auto fdWorld = world->clone();
+  fdWorld->setDifferentiable(false);
+  fdWorld->getConstraintSolver()->addConstraint(
+      std::make_shared<constraint::BallJointConstraint>(
+          fdWorld->getSkeleton(0)->getBodyNode(3u), pin));
+  auto fdSkel = fdWorld->getSkeleton(0);
+  const double eps = 1e-6;
+  for (int i = 0; i < 4; ++i)
+  {
+    const Eigen::VectorXd dx = eps * Eigen::VectorXd::Unit(8, 4 + i);
+    const Eigen::VectorXd column = (stepState(fdWorld, fdSkel, x + dx, u)
+                                    - stepState(fdWorld, fdSkel, x - dx, u))
+                                   / (2.0 * eps);
+    EXPECT_TRUE(equals(A.col(4 + i), column, 1e-5));
+
+    const Eigen::VectorXd du = eps * Eigen::VectorXd::Unit(4, i);
+    const Eigen::VectorXd controlColumn
+        = (stepState(fdWorld, fdSkel, x, u + du)
+           - stepState(fdWorld, fdSkel, x, u - du))
+          / (2.0 * eps);
+    EXPECT_TRUE(equals(B.col(i), controlColumn, 1e-5));
+  }
+}
+
+//==============================================================================
+TEST(World, StepDerivativesOfFloatingChain)
+{
+  auto world = World::create();
+  world->setTimeStep(0.001);
+
+  // A floating base carrying a ball joint, a sprung and damped revolute
+  // joint, and a prismatic joint
+  auto skel = Skeleton::create("floating chain");
+  BodyNode::Properties bodyProps;
+  bodyProps.mInertia.setMass(1.0);
+  bodyProps.mInertia.setLocalCOM(Eigen::Vector3d(0.1, 0.0, -0.25));
+  bodyProps.mInertia.setMoment(0.02, 0.03, 0.04, 0.001, 0.0, 0.002);
+
+  FreeJoint::Properties freeProps;
+  freeProps.mName = "free";
+  bodyProps.mName = "base";
+  BodyNode* base = skel->createJointAndBodyNodePair<FreeJoint>(
+                           nullptr, freeProps, bodyProps)
+                       .second;
+
+  BallJoint::Properties ballProps;
+  ballProps.mName = "ball";
+  bodyProps.mName = "arm";
+  ballProps.mT_ParentBodyToJoint.translation()
+      = Eigen::Vector3d(0.0, 0.1, -0.5);
+  BodyNode* arm
+      = skel->createJointAndBodyNodePair<BallJoint>(base, ballProps, bodyProps)
+            .second;
+
+  RevoluteJoint::Properties revoluteProps;
+  revoluteProps.mName = "revolute";
+  revoluteProps.mAxis = Eigen::Vector3d(1.0, 1.0, 0.0).normalized();
+  bodyProps.mName = "forearm";
+  revoluteProps.mT_ParentBodyToJoint.translation()
+      = Eigen::Vector3d(0.0, 0.0, -0.5);
+  auto revolute = skel->createJointAndBodyNodePair<RevoluteJoint>(
+      arm, revoluteProps, bodyProps);
+  revolute.first->setSpringStiffness(0u, 5.0);
+  revolute.first->setDampingCoefficient(0u, 0.5);
+
+  PrismaticJoint::Properties prismaticProps;
+  prismaticProps.mName = "prismatic";
+  bodyProps.mName = "hand";
+  prismaticProps.mAxis = Eigen::Vector3d::UnitZ();
+  skel->createJointAndBodyNodePair<PrismaticJoint>(
+      revolute.second, prismaticProps, bodyProps);
+
+  const int numDofs = static_cast<int>(skel->getNumDofs());
+  ASSERT_EQ(numDofs, 11);
+  Eigen::VectorXd positions(numDofs);
+  positions << 0.3, -0.2, 0.4, 0.1, 0.2, 0.3, 0.5, 0.4, -0.3, 0.6, 0.1;
+  skel->setPositions(positions);
+  skel->setVelocities(Eigen::VectorXd::LinSpaced(numDofs, -0.5, 0.8));
+  skel->setForces(Eigen::VectorXd::LinSpaced(numDofs, 0.2, -0.3));
+  world->addSkeleton(skel);
+
+  expectStepDerivativesMatchFiniteDifferences(world, skel);
+}
+
+//==============================================================================
+TEST(World, StepDerivativesOfPositionDependentJoints)
+{
+  auto world = World::create();
+  world->setTimeStep(0.001);
+
+  // The relative Jacobians of planar, universal and Euler joints change with
+  // their positions
+  auto skel = Skeleton::create("position dependent chain");
+  BodyNode::Properties bodyProps;
+  bodyProps.mInertia.setMass(1.0);
+  bodyProps.mInertia.setLocalCOM(Eigen::Vector3d(0.1, -0.05, -0.25));
+  bodyProps.mInertia.setMoment(0.02, 0.03, 0.04, 0.001, 0.0, 0.002);
+
+  PlanarJoint::Properties planarProps;
+  planarProps.mName = "planar";
+  planarProps.mPlaneType = PlanarJoint::PlaneType::ARBITRARY;
+  planarProps.mTransAxis1 = Eigen::Vector3d(1.0, 0.0, 1.0).normalized();
+  planarProps.mTransAxis2 = Eigen::Vector3d::UnitY();
+  planarProps.mRotAxis
+      = planarProps.mTransAxis1.cross(planarProps.mTransAxis2).normalized();
+  bodyProps.mName = "base";
+  BodyNode* base = skel->createJointAndBodyNodePair<PlanarJoint>(
+                           nullptr, planarProps, bodyProps)
+                       .second;
+
+  UniversalJoint::Properties universalProps;
+  universalProps.mName = "universal";
+  universalProps.mAxis[0] = Eigen::Vector3d(1.0, 0.0, 0.2).normalized();
+  universalProps.mAxis[1] = Eigen::Vector3d(0.0, 1.0, 0.3).normalized();
+  universalProps.mT_ParentBodyToJoint.translation()
+      = Eigen::Vector3d(0.0, 0.1, -0.5);
+  bodyProps.mName = "arm";
+  BodyNode* arm = skel->createJointAndBodyNodePair<UniversalJoint>(
+                          base, universalProps, bodyProps)
+                      .second;
+
+  EulerJoint::Properties xyzProps;
+  xyzProps.mName = "euler xyz";
+  xyzProps.mAxisOrder = EulerJoint::AxisOrder::XYZ;
+  xyzProps.mT_ParentBodyToJoint.translation() = Eigen::Vector3d(0.0, 0.0, -0.5);
+  bodyProps.mName = "forearm";
+  BodyNode* forearm = skel->createJointAndBodyNodePair<EulerJoint>(
+                              arm, xyzProps, bodyProps)
+                          .second;
+
+  EulerJoint::Properties zyxProps;
+  zyxProps.mName = "euler zyx";
+  zyxProps.mAxisOrder = EulerJoint::AxisOrder::ZYX;
+  zyxProps.mT_ParentBodyToJoint.translation() = Eigen::Vector3d(0.1, 0.0, -0.4);
+  zyxProps.mT_ChildBodyToJoint.translation() = Eigen::Vector3d(0.0, 0.05, 0.1);
+  bodyProps.mName = "hand";
+  skel->createJointAndBodyNodePair<EulerJoint>(forearm, zyxProps, bodyProps);
+
+  const int numDofs = static_cast<int>(skel->getNumDofs());
+  ASSERT_EQ(numDofs, 11);
+  Eigen::VectorXd positions(numDofs);
+  positions << 0.2, -0.1, 0.4, 0.3, -0.5, 0.2, 0.6, -0.4, 0.5, 0.3, -0.2;
+  skel->setPositions(positions);
+  skel->setVelocities(Eigen::VectorXd::LinSpaced(numDofs, -0.9, 0.7));
+  skel->setForces(Eigen::VectorXd::LinSpaced(numDofs, 0.3, -0.2));
+  skel->getJoint("universal")->setSpringStiffness(1u, 4.0);
+  skel->getJoint("euler xyz")->setDampingCoefficient(2u, 0.3);
+  world->addSkeleton(skel);
+
+  expectStepDerivativesMatchFiniteDifferences(world, skel);
+}
+
+//==============================================================================
+TEST(World, MultiRateStepping)
+{
+  const double dt = 0.002;
+  const std::size_t numSubsteps = 4u;
+
+  auto world = World::create();
+  world->setTimeStep(dt);
+  auto coarse = createPendulumChain(3u);
+  auto fine = createPendulumChain(3u);
+  fine->setVelocities(Eigen::Vector3d(0.5, -1.0, 2.0));
+  world->addSkeleton(coarse);
+  world->addSkeleton(fine);
+
+  EXPECT_EQ(world->getNumSubsteps(fine), 1u);
+  world->setNumSubsteps(fine, numSubsteps);
+  world->setNumSubsteps(fine, 0u);
+  EXPECT_EQ(world->getNumSubsteps(fine), numSubsteps);
+  EXPECT_EQ(world->getNumSubsteps(coarse), 1u);
+  EXPECT_EQ(world->getNumSubsteps(createPendulumChain(1u)), 0u);
+  auto worldClone = world->clone();
+  EXPECT_EQ(
+      worldClone->getNumSubsteps(worldClone->getSkeleton(1u)), numSubsteps);
+
+  // Without contacts, each Skeleton moves as if it were alone in a World that
+  // steps at its own rate
+  auto coarseWorld = World::create();
+  coarseWorld->setTimeStep(dt);
+  auto coarseRef = coarse->cloneSkeleton();
+  coarseWorld->addSkeleton(coarseRef);
+
+  auto fineWorld = World::create();
+  fineWorld->setTimeStep(dt / numSubsteps);
+  auto fineRef = fine->cloneSkeleton();
+  fineWorld->addSkeleton(fineRef);
+
+  for (std::size_t i = 0u; i < 100u; ++i)
+  {
+    world->step();
+    coarseWorld->step();
+    for (std::size_t j = 0u; j < numSubsteps; ++j)
+      fineWorld->step();
+  }
+
+  EXPECT_TRUE(equals(coarse->getPositions(), coarseRef->getPositions(), 1e-12));
+  EXPECT_TRUE(
+      equals(coarse->getVelocities(), coarseRef->getVelocities(), 1e-12));
+  EXPECT_TRUE(equals(fine->getPositions(), fineRef->getPositions(), 1e-12));
+  EXPECT_TRUE(equals(fine->getVelocities(), fineRef->getVelocities(), 1e-12));
+  EXPECT_DOUBLE_EQ(world->getTime(), coarseWorld->getTime());
+  EXPECT_TRUE(fine->isMobile());
+  EXPECT_DOUBLE_EQ(fine->getTimeStep(), dt);
+}
+
+//==============================================================================
+TEST(World, MultiRateSteppingWithContacts)
+{
+  auto world = World::create();
+  world->setTimeStep(0.002);
+
+  // A substepped box rests on the ground and carries a coarse box
+  auto ground = createGround(Eigen::Vector3d(10.0, 10.0, 0.1));
+  world->addSkeleton(ground);
+  auto fine = createBox(
+      Eigen::Vector3d::Constant(0.2), Eigen::Vector3d(0.0, 0.0, 0.15));
+  world->addSkeleton(fine);
+  auto coarse = createBox(
+      Eigen::Vector3d::Constant(0.2), Eigen::Vector3d(0.0, 0.0, 0.35));
+  world->addSkeleton(coarse);
+  world->setNumSubsteps(fine, 4u);
+
+  for (std::size_t i = 0u; i < 500u; ++i)
+    world->step();
+
+  EXPECT_NEAR(
+      fine->getBodyNode(0)->getWorldTransform().translation()[2], 0.15, 1e-2);
+  EXPECT_NEAR(
+      coarse->getBodyNode(0)->getWorldTransform().translation()[2], 0.35, 1e-2);
+  EXPECT_LT(fine->getVelocities().norm(), 1e-2);
+  EXPECT_LT(coarse->getVelocities().norm(), 1e-2);
+}
+
+//==============================================================================
+TEST(World, MultiRateSteppingTreatsOtherGroupsAsInfinitelyHeavy)
+{
+  // A box slides into a resting box of the same mass without gravity. With
+  // the same rate, the plastic contact makes them move on together at half
+  // the speed.
+  const auto simulate = [](std::size_t numSubsteps) {
+    auto world = World::create();
+    world->setTimeStep(0.002);
+    world->setGravity(Eigen::Vector3d::Zero());
+
+    auto striker = createBox(Eigen::Vector3d::Constant(0.2));
+    auto target = createBox(
+        Eigen::Vector3d::Constant(0.2), Eigen::Vector3d(0.205, 0.0, 0.0));
+    striker->setVelocities(
+        (Eigen::Vector6d() << 0.0, 0.0, 0.0, 1.0, 0.0, 0.0).finished());
+    world->addSkeleton(striker);
+    world->addSkeleton(target);
+    world->setNumSubsteps(target, numSubsteps);
+
+    for (std::size_t i = 0u; i < 100u; ++i)
+      world->step();
+
+    return Eigen::Vector2d(
+        striker->getVelocities()[3], target->getVelocities()[3]);
+  };
+
+  const Eigen::Vector2d sameRate = simulate(1u);
+  EXPECT_NEAR(sameRate[0], 0.5, 0.05);
+  EXPECT_NEAR(sameRate[1], 0.5, 0.05);
+
+  // With substeps, the striker reaches the target in the World step and the
+  // target meets it in its substeps, where the striker follows a prescribed
+  // motion as if its mass were infinite. The target is pushed to the speed of
+  // the striker, which doesn't slow down, so the total momentum doubles.
+  const Eigen::Vector2d multiRate = simulate(4u);
+  EXPECT_NEAR(multiRate[0], 1.0, 0.05);
+  EXPECT_NEAR(multiRate[1], 1.0, 0.05);
+}
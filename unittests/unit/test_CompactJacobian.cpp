@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <gtest/gtest.h>
+#include "TestHelpers.hpp"
+
+#include "dart/dynamics/BallJoint.hpp"
+#include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/CompactJacobian.hpp"
+#include "dart/dynamics/FreeJoint.hpp"
+#include "dart/dynamics/RevoluteJoint.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+
+using namespace dart;
+using namespace dynamics;
+
+//==============================================================================
+SkeletonPtr createBranchingSkeleton()
+{
+  SkeletonPtr skel = Skeleton::create();
+
+  BodyNode* root = skel->createJointAndBodyNodePair<FreeJoint>().second;
+
+  // Two branches of a few links each
+  for (std::size_t branch = 0; branch < 2; ++branch)
+  {
+    BodyNode* parent = root;
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+      RevoluteJoint::Properties joint;
+      joint.mT_ParentBodyToJoint.translation() = Eigen::Vector3d::Random();
+      joint.mAxis = Eigen::Vector3d::Random().normalized();
+      parent = skel->createJointAndBodyNodePair<RevoluteJoint>(parent, joint)
+                   .second;
+    }
+    skel->createJointAndBodyNodePair<BallJoint>(parent);
+  }
+
+  // A second tree
+  skel->createJointAndBodyNodePair<BallJoint>();
+
+  for (std::size_t i = 0; i < skel->getNumBodyNodes(); ++i)
+  {
+    BodyNode* bn = skel->getBodyNode(i);
+    bn->setMass(1.0 + i);
+    bn->setLocalCOM(Eigen::Vector3d::Random());
+  }
+
+  skel->setPositions(Eigen::VectorXd::Random(skel->getNumDofs()));
+  skel->setVelocities(Eigen::VectorXd::Random(skel->getNumDofs()));
+
+  return skel;
+}
+
+//==============================================================================
+TEST(CompactJacobian, MatchesDenseJacobian)
+{
+  SkeletonPtr skel = createBranchingSkeleton();
+  const Eigen::Vector3d offset = Eigen::Vector3d::Random();
+
+  for (std::size_t i = 0; i < skel->getNumBodyNodes(); ++i)
+  {
+    const BodyNode* bn = skel->getBodyNode(i);
+
+    const CompactJacobian J = skel->getCompactJacobian(bn);
+    EXPECT_EQ(J.getNumDofs(), skel->getNumDofs());
+    EXPECT_EQ(J.getNumDependentDofs(), bn->getNumDependentGenCoords());
+    EXPECT_TRUE(equals(J.toDense(), skel->getJacobian(bn)));
+
+    EXPECT_TRUE(equals(
+        skel->getCompactJacobian(bn, Frame::World()).toDense(),
+        skel->getJacobian(bn, Frame::World())));
+
+    EXPECT_TRUE(equals(
+        skel->getCompactJacobian(bn, offset, Frame::World()).toDense(),
+        skel->getJacobian(bn, offset, Frame::World())));
+  }
+}
+
+//==============================================================================
+/// Relative Jacobian built from the two full-width Jacobians, as the
+/// MetaSkeleton computes it for a generic set of BodyNodes
+math::Jacobian computeDenseRelativeJacobian(
+    const Skeleton* skel,
+    const JacobianNode* node,
+    const Eigen::Vector3d& offset,
+    const JacobianNode* relativeTo,
+    const Frame* inCoordinatesOf)
+{
+  const Eigen::Isometry3d T = relativeTo->getTransform(node);
+  math::Jacobian result = skel->getJacobian(node)
+                          - math::AdTJac(T, skel->getJacobian(relativeTo));
+  result.bottomRows<3>() += result.topRows<3>().colwise().cross(offset);
+
+  return math::AdRJac(node->getTransform(inCoordinatesOf), result);
+}
+
+//==============================================================================
+TEST(CompactJacobian, RelativeJacobian)
+{
+  SkeletonPtr skel = createBranchingSkeleton();
+  const Eigen::Vector3d offset = Eigen::Vector3d::Random();
+  const MetaSkeleton* meta = skel.get();
+
+  for (std::size_t i = 0; i < skel->getNumBodyNodes(); ++i)
+  {
+    for (std::size_t j = 0; j < skel->getNumBodyNodes(); ++j)
+    {
+      const BodyNode* bn = skel->getBodyNode(i);
+      const BodyNode* relTo = skel->getBodyNode(j);
+
+      const std::vector<const Frame*> frames{bn, relTo, Frame::World()};
+      for (const Frame* frame : frames)
+      {
+        const math::Jacobian J = computeDenseRelativeJacobian(
+            skel.get(), bn, Eigen::Vector3d::Zero(), relTo, frame);
+        const math::Jacobian JOffset = computeDenseRelativeJacobian(
+            skel.get(), bn, offset, relTo, frame);
+
+        EXPECT_TRUE(equals(skel->getJacobian(bn, relTo, frame), J));
+        EXPECT_TRUE(
+            equals(skel->getJacobian(bn, offset, relTo, frame), JOffset));
+
+        EXPECT_TRUE(equals(
+            skel->getLinearJacobian(bn, relTo, frame),
+            math::LinearJacobian(J.bottomRows<3>())));
+        EXPECT_TRUE(equals(
+            skel->getLinearJacobian(bn, offset, relTo, frame),
+            math::LinearJacobian(JOffset.bottomRows<3>())));
+        EXPECT_TRUE(equals(
+            skel->getAngularJacobian(bn, relTo, frame),
+            math::AngularJacobian(J.topRows<3>())));
+
+        // The compact versions override the MetaSkeleton ones, so calls
+        // through the base class take the same path
+        EXPECT_TRUE(equals(meta->getJacobian(bn, relTo, frame), J));
+        EXPECT_TRUE(
+            equals(meta->getJacobian(bn, offset, relTo, frame), JOffset));
+        EXPECT_TRUE(equals(
+            meta->getLinearJacobian(bn, offset, relTo, frame),
+            math::LinearJacobian(JOffset.bottomRows<3>())));
+        EXPECT_TRUE(equals(
+            meta->getAngularJacobian(bn, relTo, frame),
+            math::AngularJacobian(J.topRows<3>())));
+      }
+
+      const CompactJacobian J
+          = skel->getCompactJacobian(bn, relTo, Frame::World());
+      EXPECT_LE(
+          J.getNumDependentDofs(),
+          bn->getNumDependentGenCoords() + relTo->getNumDependentGenCoords());
+    }
+  }
+}
+
+//==============================================================================
+TEST(CompactJacobian, Products)
+{
+  SkeletonPtr skel = createBranchingSkeleton();
+  const std::size_t numDofs = skel->getNumDofs();
+  const Eigen::MatrixXd& invM = skel->getInvMassMatrix();
+  const Eigen::Vector6d f = Eigen::Vector6d::Random();
+
+  for (std::size_t i = 0; i < skel->getNumBodyNodes(); ++i)
+  {
+    const BodyNode* bn = skel->getBodyNode(i);
+    const CompactJacobian J = skel->getCompactJacobian(bn, Frame::World());
+    const math::Jacobian JDense = J.toDense();
+
+    EXPECT_TRUE(equals(
+        J.multiply(skel->getVelocities()),
+        Eigen::Vector6d(JDense * skel->getVelocities())));
+    EXPECT_TRUE(equals(
+        J.multiply(skel->getVelocities()),
+        bn->getSpatialVelocity(Frame::World(), Frame::World())));
+
+    EXPECT_TRUE(equals(
+        J.transposeMultiply(f), Eigen::VectorXd(JDense.transpose() * f)));
+
+    Eigen::VectorXd tau = Eigen::VectorXd::Ones(numDofs);
+    J.addTransposeMultiplyTo(f, tau);
+    EXPECT_TRUE(equals(
+        tau,
+        Eigen::VectorXd(
+            Eigen::VectorXd::Ones(numDofs) + JDense.transpose() * f)));
+
+    EXPECT_TRUE(equals(
+        J.multiplyInvMass(invM),
+        Eigen::Matrix6d(JDense * invM * JDense.transpose())));
+
+    for (std::size_t j = 0; j < skel->getNumBodyNodes(); ++j)
+    {
+      const CompactJacobian J2
+          = skel->getCompactJacobian(skel->getBodyNode(j), Frame::World());
+      EXPECT_TRUE(equals(
+          J.multiplyInvMass(invM, J2),
+          Eigen::Matrix6d(JDense * invM * J2.toDense().transpose())));
+    }
+  }
+}
@@ -607,3 +607,41 @@ TEST(LIE_GROUP_OPERATORS, ADJOINT_MAPPINGS)
       EXPECT_NEAR(dad_V_F(j), dadV_Matrix_F(j), LIE_GROUP_OPT_TOL);
   }
 }
+
+/******************************************************************************/
+TEST(LIE_GROUP_OPERATORS, SINGLE_PRECISION)
+{
+  int numTest = 100;
+  const double tol = 1e-4;
+
+  for (int i = 0; i < numTest; ++i)
+  {
+    const Eigen::Vector6d t = Eigen::Vector6d::Random();
+    const Eigen::Isometry3d T = math::expMap(t);
+    const Eigen::Vector6d V = Eigen::Vector6d::Random();
+    const Eigen::Vector6d W = Eigen::Vector6d::Random();
+    const Eigen::Vector3d v = Eigen::Vector3d::Random();
+    Eigen::Matrix6d I = Eigen::Matrix6d::Random();
+    I = I * I.transpose();
+
+    const Eigen::Isometry3f Tf = T.cast<float>();
+    const Eigen::Matrix<float, 6, 1> Vf = V.cast<float>();
+    const Eigen::Matrix<float, 6, 1> Wf = W.cast<float>();
+    const Eigen::Vector3f vf = v.cast<float>();
+    const Eigen::Matrix<float, 6, 6> If = I.cast<float>();
+
+    EXPECT_TRUE(equals(AdT(Tf, Vf).cast<double>(), AdT(T, V), tol));
+    EXPECT_TRUE(
+        equals(getAdTMatrix(Tf).cast<double>(), getAdTMatrix(T), tol));
+    EXPECT_TRUE(equals(AdR(Tf, Vf).cast<double>(), AdR(T, V), tol));
+    EXPECT_TRUE(equals(AdInvT(Tf, Vf).cast<double>(), AdInvT(T, V), tol));
+    EXPECT_TRUE(equals(
+        AdInvRLinear(Tf, vf).cast<double>(), AdInvRLinear(T, v), tol));
+    EXPECT_TRUE(equals(dAdT(Tf, Vf).cast<double>(), dAdT(T, V), tol));
+    EXPECT_TRUE(equals(dAdInvT(Tf, Vf).cast<double>(), dAdInvT(T, V), tol));
+    EXPECT_TRUE(equals(ad(Vf, Wf).cast<double>(), ad(V, W), tol));
+    EXPECT_TRUE(equals(dad(Vf, Wf).cast<double>(), dad(V, W), tol));
+    EXPECT_TRUE(equals(
+        transformInertia(Tf, If).cast<double>(), transformInertia(T, I), tol));
+  }
+}